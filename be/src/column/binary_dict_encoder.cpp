@@ -0,0 +1,44 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/binary_dict_encoder.h"
+
+#include <algorithm>
+
+#include "column/column_hash.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks::vectorized {
+
+bool BinaryDictEncoder::is_low_cardinality(const BinaryColumn& column, size_t sample_rows, size_t ratio) {
+    size_t sample = std::min(column.size(), sample_rows);
+    SliceNormalHashSet distinct;
+    for (size_t i = 0; i < sample; i++) {
+        distinct.emplace(column.get_slice(i));
+        if (distinct.size() * ratio > sample) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinaryDictEncoder::encode(const BinaryColumn& column, size_t max_dict_size, BinaryColumn* dict,
+                               std::vector<uint32_t>* codes) {
+    size_t rows = column.size();
+    phmap::flat_hash_map<Slice, uint32_t, SliceHash, SliceNormalEqual> positions;
+    uint32_t base = dict->size();
+    codes->resize(rows);
+    for (size_t i = 0; i < rows; i++) {
+        Slice value = column.get_slice(i);
+        auto [iter, inserted] = positions.emplace(value, base + static_cast<uint32_t>(positions.size()));
+        if (inserted) {
+            if (positions.size() > max_dict_size) {
+                return false;
+            }
+            dict->append(value);
+        }
+        (*codes)[i] = iter->second;
+    }
+    return true;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,26 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "column/binary_column.h"
+
+namespace starrocks::vectorized {
+
+// Dictionary encoding of binary columns, shared by the chunk wire format and the evaluation
+// of string functions on the distinct values of a column.
+class BinaryDictEncoder {
+public:
+    // Whether the first |sample_rows| rows of |column| have at most 1/|ratio| distinct values.
+    static bool is_low_cardinality(const BinaryColumn& column, size_t sample_rows, size_t ratio);
+
+    // Append the distinct values of |column| to |dict| in the order of their first occurrence
+    // and set |codes| to their positions in |dict|, one per row. Returns false, leaving |dict|
+    // and |codes| in an unspecified state, once the dictionary grows beyond |max_dict_size|.
+    static bool encode(const BinaryColumn& column, size_t max_dict_size, BinaryColumn* dict,
+                       std::vector<uint32_t>* codes);
+};
+
+} // namespace starrocks::vectorized
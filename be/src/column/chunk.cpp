@@ -2,6 +2,7 @@
 
 #include "column/chunk.h"
 
+#include "column/column_encoder.h"
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
 #include "column/fixed_length_column.h"
@@ -152,6 +153,14 @@ void Chunk::serialize(uint8_t* dst) const {
 }
 
 size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
+    serialize_meta(chunk);
+    size_t size = serialize_size();
+    chunk->mutable_data()->resize(size);
+    serialize((uint8_t*)chunk->mutable_data()->data());
+    return size;
+}
+
+void Chunk::serialize_meta(starrocks::ChunkPB* chunk) const {
     chunk->clear_slot_id_map();
     chunk->mutable_slot_id_map()->Reserve(static_cast<int>(_slot_id_to_index.size()) * 2);
     for (const auto& kv : _slot_id_to_index) {
@@ -179,11 +188,6 @@ size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
     }
 
     DCHECK_EQ(_columns.size(), _tuple_id_to_index.size() + _slot_id_to_index.size());
-
-    size_t size = serialize_size();
-    chunk->mutable_data()->resize(size);
-    serialize((uint8_t*)chunk->mutable_data()->data());
-    return size;
 }
 
 Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta) {
@@ -191,8 +195,9 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
     _tuple_id_to_index = meta.tuple_id_to_index;
     _columns.resize(_slot_id_to_index.size() + _tuple_id_to_index.size());
 
+    const uint8_t* end = src + len;
     uint32_t version = decode_fixed32_le(src);
-    DCHECK_EQ(version, 1);
+    DCHECK(version == 1 || version == ColumnEncoder::kEncodedChunkVersion);
     src += sizeof(uint32_t);
 
     size_t rows = decode_fixed32_le(src);
@@ -202,6 +207,17 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
         _columns[i] = ColumnHelper::create_column(meta.types[i], meta.is_nulls[i], meta.is_consts[i], rows);
     }
 
+    if (version == ColumnEncoder::kEncodedChunkVersion) {
+        for (const auto& column : _columns) {
+            RETURN_IF_ERROR(ColumnEncoder::decode(&src, end, column.get()));
+        }
+        if (UNLIKELY(src != end || num_rows() != rows)) {
+            return Status::InternalError(strings::Substitute(
+                    "deserialize encoded chunk failed. len: $0, rows: $1, except: $2", len, num_rows(), rows));
+        }
+        return Status::OK();
+    }
+
     for (const auto& column : _columns) {
         src = column->deserialize_column(src);
     }
@@ -110,6 +110,9 @@ public:
     // The result value is the chunk data serialize size
     size_t serialize_with_meta(starrocks::ChunkPB* chunk) const;
 
+    // Only serialize chunk meta to ChunkPB
+    void serialize_meta(starrocks::ChunkPB* chunk) const;
+
     // Only serialize chunk data to dst
     // The serialize format:
     //     version(4 byte)
@@ -122,6 +125,7 @@ public:
     void serialize(uint8_t* dst) const;
 
     // Deserialize chunk by |src| (chunk data) and |meta| (chunk meta)
+    // |src| may be either the plain format above or the column encoded format of ColumnEncoder.
     Status deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta);
 
     // Create an empty chunk with the same meta and reserve it of size chunk _num_rows
@@ -0,0 +1,291 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_encoder.h"
+
+#include "column/binary_column.h"
+#include "column/binary_dict_encoder.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/frame_of_reference_coding.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+// Columns shorter than this are always sent PLAIN, the tag and the headers would eat the gain.
+constexpr size_t kMinEncodeRows = 64;
+// Number of leading rows inspected to choose an encoding.
+constexpr size_t kSampleRows = 1024;
+// A binary column is dictionary encoded when its sample has at most 1/kDictSampleRatio distinct values.
+constexpr size_t kDictSampleRatio = 4;
+// Give up dictionary encoding when the dictionary grows beyond this size.
+constexpr size_t kDictMaxSize = 65536;
+// Use RLE when the average run length in the sample is at least this long.
+constexpr size_t kRleMinAvgRunLength = 4;
+
+// Invoke |visitor| with the typed FixedLengthColumnBase if |column| stores integers.
+// DecimalV3 columns share the integer layout, so they are encoded the same way.
+template <typename Visitor>
+bool visit_integer_column(Column* column, Visitor&& visitor) {
+    if (auto* c = dynamic_cast<FixedLengthColumnBase<int8_t>*>(column); c != nullptr) {
+        visitor(c);
+    } else if (auto* c = dynamic_cast<FixedLengthColumnBase<uint8_t>*>(column); c != nullptr) {
+        visitor(c);
+    } else if (auto* c = dynamic_cast<FixedLengthColumnBase<int16_t>*>(column); c != nullptr) {
+        visitor(c);
+    } else if (auto* c = dynamic_cast<FixedLengthColumnBase<int32_t>*>(column); c != nullptr) {
+        visitor(c);
+    } else if (auto* c = dynamic_cast<FixedLengthColumnBase<int64_t>*>(column); c != nullptr) {
+        visitor(c);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void serialize_column(Column* column, faststring* buffer) {
+    size_t offset = buffer->size();
+    buffer->resize(offset + column->serialize_size());
+    column->serialize_column(buffer->data() + offset);
+}
+
+// Layout: uint32 num_runs | (T value, uint32 run_length) * num_runs
+template <typename T>
+void encode_rle(const T* data, size_t rows, faststring* buffer) {
+    size_t header = buffer->size();
+    put_fixed32_le(buffer, 0);
+    uint32_t num_runs = 0;
+    size_t i = 0;
+    while (i < rows) {
+        size_t j = i + 1;
+        while (j < rows && data[j] == data[i]) {
+            j++;
+        }
+        buffer->append(&data[i], sizeof(T));
+        put_fixed32_le(buffer, static_cast<uint32_t>(j - i));
+        num_runs++;
+        i = j;
+    }
+    encode_fixed32_le(buffer->data() + header, num_runs);
+}
+
+// Layout: uint32 encoded_len | ForEncoder<T> output
+template <typename T>
+void encode_for(const T* data, size_t rows, faststring* buffer) {
+    size_t header = buffer->size();
+    put_fixed32_le(buffer, 0);
+    ForEncoder<T> encoder(buffer);
+    encoder.put_batch(data, rows);
+    encoder.flush();
+    encode_fixed32_le(buffer->data() + header, static_cast<uint32_t>(buffer->size() - header - sizeof(uint32_t)));
+}
+
+template <typename T>
+bool try_encode_integer(const FixedLengthColumnBase<T>& column, faststring* buffer) {
+    const T* data = column.get_data().data();
+    size_t rows = column.size();
+    size_t sample = std::min(rows, kSampleRows);
+
+    size_t runs = 1;
+    T min = data[0];
+    T max = data[0];
+    for (size_t i = 1; i < sample; i++) {
+        runs += (data[i] != data[i - 1]);
+        min = std::min(min, data[i]);
+        max = std::max(max, data[i]);
+    }
+
+    if (runs * kRleMinAvgRunLength <= sample) {
+        buffer->push_back(ColumnEncoder::RLE);
+        encode_rle(data, rows, buffer);
+        return true;
+    }
+    using UnsignedT = std::make_unsigned_t<T>;
+    auto range = static_cast<UnsignedT>(static_cast<UnsignedT>(max) - static_cast<UnsignedT>(min));
+    uint8_t bit_width = bits_less_than_64(range);
+    if (bit_width * 4 <= sizeof(T) * 8 * 3) {
+        buffer->push_back(ColumnEncoder::FOR);
+        encode_for(data, rows, buffer);
+        return true;
+    }
+    return false;
+}
+
+// Layout: dictionary as plain BinaryColumn | uint32 encoded_len | ForEncoder<uint32_t> codes
+bool try_encode_dict(const BinaryColumn& column, faststring* buffer) {
+    size_t rows = column.size();
+    if (!BinaryDictEncoder::is_low_cardinality(column, kSampleRows, kDictSampleRatio)) {
+        return false;
+    }
+    BinaryColumn dict_column;
+    std::vector<uint32_t> codes;
+    if (!BinaryDictEncoder::encode(column, kDictMaxSize, &dict_column, &codes)) {
+        return false;
+    }
+
+    buffer->push_back(ColumnEncoder::DICT);
+    serialize_column(&dict_column, buffer);
+    encode_for(codes.data(), rows, buffer);
+    return true;
+}
+
+Status check_remaining(const uint8_t* src, const uint8_t* end, size_t size) {
+    if (UNLIKELY(src > end || static_cast<size_t>(end - src) < size)) {
+        return Status::Corruption("encoded column data is truncated");
+    }
+    return Status::OK();
+}
+
+template <typename T>
+Status decode_rle(const uint8_t** src, const uint8_t* end, FixedLengthColumnBase<T>* column) {
+    const uint8_t* p = *src;
+    RETURN_IF_ERROR(check_remaining(p, end, sizeof(uint32_t)));
+    uint32_t num_runs = decode_fixed32_le(p);
+    p += sizeof(uint32_t);
+    RETURN_IF_ERROR(check_remaining(p, end, num_runs * (sizeof(T) + sizeof(uint32_t))));
+
+    auto& data = column->get_data();
+    for (uint32_t i = 0; i < num_runs; i++) {
+        T value;
+        memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        uint32_t length = decode_fixed32_le(p);
+        p += sizeof(uint32_t);
+        data.insert(data.end(), length, value);
+    }
+    *src = p;
+    return Status::OK();
+}
+
+template <typename T>
+Status decode_for(const uint8_t** src, const uint8_t* end, std::vector<T>* values) {
+    const uint8_t* p = *src;
+    RETURN_IF_ERROR(check_remaining(p, end, sizeof(uint32_t)));
+    uint32_t encoded_len = decode_fixed32_le(p);
+    p += sizeof(uint32_t);
+    RETURN_IF_ERROR(check_remaining(p, end, encoded_len));
+
+    ForDecoder<T> decoder(p, encoded_len);
+    if (UNLIKELY(!decoder.init())) {
+        return Status::Corruption("failed to init frame-of-reference decoder");
+    }
+    size_t offset = values->size();
+    values->resize(offset + decoder.count());
+    if (UNLIKELY(!decoder.get_batch(values->data() + offset, decoder.count()))) {
+        return Status::Corruption("failed to decode frame-of-reference data");
+    }
+    *src = p + encoded_len;
+    return Status::OK();
+}
+
+Status decode_dict(const uint8_t** src, const uint8_t* end, BinaryColumn* column) {
+    BinaryColumn dict_column;
+    RETURN_IF_ERROR(check_remaining(*src, end, 2 * sizeof(uint32_t)));
+    *src = dict_column.deserialize_column(*src);
+    RETURN_IF_ERROR(check_remaining(*src, end, 0));
+
+    std::vector<uint32_t> codes;
+    RETURN_IF_ERROR(decode_for(src, end, &codes));
+
+    size_t dict_size = dict_column.size();
+    size_t byte_size = 0;
+    for (uint32_t code : codes) {
+        if (UNLIKELY(code >= dict_size)) {
+            return Status::Corruption(strings::Substitute("dictionary code $0 out of range $1", code, dict_size));
+        }
+        byte_size += dict_column.get_slice(code).size;
+    }
+    column->reserve(column->size() + codes.size(), column->get_bytes().size() + byte_size);
+    for (uint32_t code : codes) {
+        column->append(dict_column.get_slice(code));
+    }
+    return Status::OK();
+}
+
+} // namespace
+
+void ColumnEncoder::encode(Column* column, faststring* buffer) {
+    if (column->is_nullable() && !column->is_constant()) {
+        auto* nullable = down_cast<NullableColumn*>(column);
+        buffer->push_back(NULLABLE);
+        encode(nullable->mutable_null_column(), buffer);
+        encode(nullable->mutable_data_column(), buffer);
+        return;
+    }
+
+    if (column->size() >= kMinEncodeRows && !column->is_constant()) {
+        size_t start = buffer->size();
+        bool encoded = false;
+        if (column->is_binary()) {
+            encoded = try_encode_dict(*down_cast<BinaryColumn*>(column), buffer);
+        } else {
+            visit_integer_column(column, [&](auto* c) { encoded = try_encode_integer(*c, buffer); });
+        }
+        // Keep the encoded form only if it actually beats the plain layout.
+        if (encoded && buffer->size() - start < column->serialize_size() + 1) {
+            return;
+        }
+        buffer->resize(start);
+    }
+    buffer->push_back(PLAIN);
+    serialize_column(column, buffer);
+}
+
+Status ColumnEncoder::decode(const uint8_t** src, const uint8_t* end, Column* column) {
+    RETURN_IF_ERROR(check_remaining(*src, end, 1));
+    auto type = static_cast<EncodingType>(**src);
+    *src += 1;
+
+    switch (type) {
+    case PLAIN:
+        *src = column->deserialize_column(*src);
+        return check_remaining(*src, end, 0);
+    case NULLABLE: {
+        if (UNLIKELY(!column->is_nullable() || column->is_constant())) {
+            return Status::Corruption("nullable encoding for a non-nullable column");
+        }
+        auto* nullable = down_cast<NullableColumn*>(column);
+        RETURN_IF_ERROR(decode(src, end, nullable->mutable_null_column()));
+        RETURN_IF_ERROR(decode(src, end, nullable->mutable_data_column()));
+        if (UNLIKELY(nullable->null_column()->size() != nullable->data_column()->size())) {
+            return Status::Corruption("null flags and data of nullable column have different sizes");
+        }
+        nullable->update_has_null();
+        return Status::OK();
+    }
+    case DICT:
+        if (UNLIKELY(!column->is_binary())) {
+            return Status::Corruption("dictionary encoding for a non-binary column");
+        }
+        return decode_dict(src, end, down_cast<BinaryColumn*>(column));
+    case RLE:
+    case FOR: {
+        Status st = Status::Corruption("integer encoding for a non-integer column");
+        visit_integer_column(column, [&](auto* c) {
+            if (type == RLE) {
+                st = decode_rle(src, end, c);
+            } else {
+                st = decode_for(src, end, &c->get_data());
+            }
+        });
+        return st;
+    }
+    }
+    return Status::Corruption(strings::Substitute("unknown column encoding $0", static_cast<int>(type)));
+}
+
+size_t ColumnEncoder::encode_chunk(const Chunk& chunk, faststring* buffer) {
+    buffer->clear();
+    put_fixed32_le(buffer, kEncodedChunkVersion);
+    put_fixed32_le(buffer, static_cast<uint32_t>(chunk.num_rows()));
+    for (const auto& column : chunk.columns()) {
+        encode(column.get(), buffer);
+    }
+    return buffer->size();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "util/faststring.h"
+
+namespace starrocks::vectorized {
+
+// Light-weight per-column encodings for the chunk wire format used by exchanges.
+//
+// Every column is prefixed with one byte describing how it was encoded. The encoding is
+// chosen by sampling the head of the column, and the encoder falls back to PLAIN whenever
+// the encoded result turns out to be no smaller than the plain layout, so encoding never
+// inflates the payload by more than the tag byte.
+//
+//  - PLAIN:    Column::serialize_column, used for everything not handled below.
+//  - RLE:      (value, run length) pairs for integer columns with long runs, most notably
+//              the null flags of nullable columns and columns that are constant in practice.
+//  - FOR:      frame-of-reference bit-packing (ForEncoder) for integer columns whose values
+//              span a narrow range.
+//  - DICT:     dictionary + FOR-encoded codes for low-cardinality binary columns.
+//  - NULLABLE: encoded null flags followed by the encoded data column.
+//
+// The serialized chunk produced by encode_chunk() starts with version 2, which lets
+// Chunk::deserialize tell it apart from the plain (version 1) layout.
+class ColumnEncoder {
+public:
+    enum EncodingType : uint8_t {
+        PLAIN = 0,
+        RLE = 1,
+        FOR = 2,
+        DICT = 3,
+        NULLABLE = 4,
+    };
+
+    static constexpr uint32_t kEncodedChunkVersion = 2;
+
+    // Append the encoded |column| to |buffer|.
+    static void encode(Column* column, faststring* buffer);
+
+    // Decode one column from [*src, end) into |column|, which must be an empty column
+    // created from the same type the encoder saw. |*src| is advanced past the column.
+    static Status decode(const uint8_t** src, const uint8_t* end, Column* column);
+
+    // Serialize the columns of |chunk| into |buffer| (cleared first) and return the size.
+    static size_t encode_chunk(const Chunk& chunk, faststring* buffer);
+};
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,380 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/sort_key_encoder.h"
+
+#include <algorithm>
+
+#include "column/const_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "gutil/casts.h"
+#include "runtime/date_value.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/timestamp_value.h"
+#include "util/orlp/pdqsort.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+constexpr uint8_t kNullFirst = 0x00;
+constexpr uint8_t kNotNull = 0x01;
+constexpr uint8_t kNullLast = 0x02;
+
+// The sort column with the const and nullable wrappers taken off.
+struct ColumnView {
+    const Column* data = nullptr;
+    const uint8_t* nulls = nullptr;
+    bool is_const = false;
+
+    size_t index(size_t row) const { return is_const ? 0 : row; }
+    bool is_null(size_t row) const { return nulls != nullptr && nulls[index(row)]; }
+};
+
+ColumnView view_of(const Column* column) {
+    ColumnView view;
+    if (column->is_constant()) {
+        view.is_const = true;
+        column = down_cast<const ConstColumn*>(column)->data_column().get();
+    }
+    if (column->is_nullable()) {
+        const auto* nullable = down_cast<const NullableColumn*>(column);
+        view.nulls = nullable->immutable_null_column_data().data();
+        column = nullable->data_column().get();
+    }
+    view.data = column;
+    return view;
+}
+
+template <typename T>
+struct UnsignedOf {
+    using type = std::make_unsigned_t<T>;
+};
+template <>
+struct UnsignedOf<int128_t> {
+    using type = uint128_t;
+};
+
+// Map a signed integer to an unsigned one with the same order.
+template <typename T>
+typename UnsignedOf<T>::type flip_sign(T value) {
+    using U = typename UnsignedOf<T>::type;
+    return static_cast<U>(value) ^ (static_cast<U>(1) << (sizeof(T) * 8 - 1));
+}
+
+// Map a floating point to an unsigned integer with the same order, -0.0 is mapped as 0.0.
+template <typename T>
+auto normalize_float(T value) {
+    using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    if (value == 0) {
+        value = 0;
+    }
+    U bits;
+    memcpy(&bits, &value, sizeof(T));
+    constexpr U sign = static_cast<U>(1) << (sizeof(T) * 8 - 1);
+    return (bits & sign) ? ~bits : (bits | sign);
+}
+
+template <typename U>
+void put_big_endian(U value, uint8_t* dst) {
+    for (size_t i = 0; i < sizeof(U); i++) {
+        dst[i] = static_cast<uint8_t>(value >> ((sizeof(U) - 1 - i) * 8));
+    }
+}
+
+void invert(uint8_t* begin, uint8_t* end) {
+    for (uint8_t* p = begin; p < end; p++) {
+        *p = ~*p;
+    }
+}
+
+// The key of a non-null value of a fixed length column takes the marker and sizeof(U).
+template <PrimitiveType PT, typename F>
+void encode_fixed(const ColumnView& view, size_t num_rows, bool is_asc, uint8_t null_marker, F normalize,
+                  const uint32_t* offsets, uint32_t* positions, uint8_t* buffer) {
+    using ColumnType = RunTimeColumnType<PT>;
+    using U = decltype(normalize(std::declval<RunTimeCppType<PT>>()));
+    const auto& data = down_cast<const ColumnType*>(view.data)->get_data();
+    for (size_t i = 0; i < num_rows; i++) {
+        uint8_t* dst = buffer + offsets[i] + positions[i];
+        if (view.is_null(i)) {
+            *dst = null_marker;
+            positions[i] += 1;
+            continue;
+        }
+        *dst = kNotNull;
+        put_big_endian(normalize(data[view.index(i)]), dst + 1);
+        if (!is_asc) {
+            invert(dst + 1, dst + 1 + sizeof(U));
+        }
+        positions[i] += 1 + sizeof(U);
+    }
+}
+
+template <PrimitiveType PT, typename F>
+void fixed_sizes(const ColumnView& view, size_t num_rows, F normalize, uint32_t* sizes) {
+    using U = decltype(normalize(std::declval<RunTimeCppType<PT>>()));
+    for (size_t i = 0; i < num_rows; i++) {
+        sizes[i] += view.is_null(i) ? 1 : 1 + sizeof(U);
+    }
+}
+
+void binary_sizes(const ColumnView& view, size_t num_rows, uint32_t* sizes) {
+    const auto* column = down_cast<const BinaryColumn*>(view.data);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (view.is_null(i)) {
+            sizes[i] += 1;
+            continue;
+        }
+        Slice value = column->get_slice(view.index(i));
+        size_t zeros = std::count(value.data, value.data + value.size, '\0');
+        sizes[i] += 1 + value.size + zeros + 2;
+    }
+}
+
+void encode_binary(const ColumnView& view, size_t num_rows, bool is_asc, uint8_t null_marker,
+                   const uint32_t* offsets, uint32_t* positions, uint8_t* buffer) {
+    const auto* column = down_cast<const BinaryColumn*>(view.data);
+    for (size_t i = 0; i < num_rows; i++) {
+        uint8_t* dst = buffer + offsets[i] + positions[i];
+        if (view.is_null(i)) {
+            *dst = null_marker;
+            positions[i] += 1;
+            continue;
+        }
+        *dst = kNotNull;
+        uint8_t* begin = dst + 1;
+        uint8_t* p = begin;
+        Slice value = column->get_slice(view.index(i));
+        for (size_t j = 0; j < value.size; j++) {
+            *p++ = value.data[j];
+            if (value.data[j] == '\0') {
+                *p++ = 0xFF;
+            }
+        }
+        *p++ = 0x00;
+        *p++ = 0x00;
+        if (!is_asc) {
+            invert(begin, p);
+        }
+        positions[i] += p - dst;
+    }
+}
+
+template <typename T>
+T identity(T value) {
+    return value;
+}
+
+// Invoke |fn| with the primitive type and the normalizer of a fixed length |type|.
+template <typename Fn>
+bool visit_fixed_type(PrimitiveType type, Fn&& fn) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+        fn(std::integral_constant<PrimitiveType, TYPE_BOOLEAN>(), identity<uint8_t>);
+        return true;
+    case TYPE_TINYINT:
+        fn(std::integral_constant<PrimitiveType, TYPE_TINYINT>(), flip_sign<int8_t>);
+        return true;
+    case TYPE_SMALLINT:
+        fn(std::integral_constant<PrimitiveType, TYPE_SMALLINT>(), flip_sign<int16_t>);
+        return true;
+    case TYPE_INT:
+        fn(std::integral_constant<PrimitiveType, TYPE_INT>(), flip_sign<int32_t>);
+        return true;
+    case TYPE_BIGINT:
+        fn(std::integral_constant<PrimitiveType, TYPE_BIGINT>(), flip_sign<int64_t>);
+        return true;
+    case TYPE_LARGEINT:
+        fn(std::integral_constant<PrimitiveType, TYPE_LARGEINT>(), flip_sign<int128_t>);
+        return true;
+    case TYPE_DECIMAL32:
+        fn(std::integral_constant<PrimitiveType, TYPE_DECIMAL32>(), flip_sign<int32_t>);
+        return true;
+    case TYPE_DECIMAL64:
+        fn(std::integral_constant<PrimitiveType, TYPE_DECIMAL64>(), flip_sign<int64_t>);
+        return true;
+    case TYPE_DECIMAL128:
+        fn(std::integral_constant<PrimitiveType, TYPE_DECIMAL128>(), flip_sign<int128_t>);
+        return true;
+    case TYPE_FLOAT:
+        fn(std::integral_constant<PrimitiveType, TYPE_FLOAT>(), normalize_float<float>);
+        return true;
+    case TYPE_DOUBLE:
+        fn(std::integral_constant<PrimitiveType, TYPE_DOUBLE>(), normalize_float<double>);
+        return true;
+    case TYPE_TIME:
+        fn(std::integral_constant<PrimitiveType, TYPE_TIME>(), normalize_float<double>);
+        return true;
+    case TYPE_DATE:
+        fn(std::integral_constant<PrimitiveType, TYPE_DATE>(),
+           [](const DateValue& v) { return flip_sign<int32_t>(v.julian()); });
+        return true;
+    case TYPE_DATETIME:
+        fn(std::integral_constant<PrimitiveType, TYPE_DATETIME>(),
+           [](const TimestampValue& v) { return flip_sign<int64_t>(v.timestamp()); });
+        return true;
+    case TYPE_DECIMALV2:
+        fn(std::integral_constant<PrimitiveType, TYPE_DECIMALV2>(),
+           [](const DecimalV2Value& v) { return flip_sign<int128_t>(v.value()); });
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_binary_type(PrimitiveType type) {
+    return type == TYPE_CHAR || type == TYPE_VARCHAR;
+}
+
+// Ranges of rows with fewer rows are sorted with comparisons instead of being distributed further.
+constexpr size_t kRadixSortThreshold = 64;
+
+class KeyRadixSorter {
+public:
+    explicit KeyRadixSorter(const BinaryColumn& keys)
+            : _bytes(keys.get_bytes().data()), _offsets(keys.get_offset().data()) {}
+
+    void sort(uint32_t* rows, size_t num_rows) {
+        std::vector<uint32_t> tmp(num_rows);
+        // Ranges of |rows| whose keys share the first |depth| bytes, left to sort. A stack instead of
+        // recursion, since the depth can be as large as the keys are long.
+        struct Range {
+            size_t begin;
+            size_t size;
+            size_t depth;
+        };
+        std::vector<Range> ranges{{0, num_rows, 0}};
+        while (!ranges.empty()) {
+            Range range = ranges.back();
+            ranges.pop_back();
+            uint32_t* begin = rows + range.begin;
+            if (range.size <= kRadixSortThreshold) {
+                _sort_by_comparison(begin, range.size, range.depth);
+                continue;
+            }
+
+            // Bucket 0 is of the keys that end before |depth|, bucket b + 1 of the keys whose byte at |depth| is b.
+            size_t counts[257] = {0};
+            for (size_t i = 0; i < range.size; i++) {
+                counts[_bucket(begin[i], range.depth)]++;
+            }
+            if (counts[0] == range.size) {
+                // All the keys are equal, the rows stay in the order of their indexes.
+                continue;
+            }
+            size_t starts[257];
+            size_t start = 0;
+            bool single_bucket = false;
+            for (int b = 0; b < 257; b++) {
+                starts[b] = start;
+                start += counts[b];
+                single_bucket |= counts[b] == range.size;
+            }
+            if (!single_bucket) {
+                // A stable distribution, so the rows of each bucket stay in the order of their indexes.
+                for (size_t i = 0; i < range.size; i++) {
+                    tmp[starts[_bucket(begin[i], range.depth)]++] = begin[i];
+                }
+                memcpy(begin, tmp.data(), range.size * sizeof(uint32_t));
+            }
+            start = range.begin + counts[0];
+            for (int b = 1; b < 257; b++) {
+                if (counts[b] > 1) {
+                    ranges.push_back({start, counts[b], range.depth + 1});
+                }
+                start += counts[b];
+            }
+        }
+    }
+
+private:
+    size_t _size(uint32_t row) const { return _offsets[row + 1] - _offsets[row]; }
+
+    int _bucket(uint32_t row, size_t depth) const {
+        return depth < _size(row) ? _bytes[_offsets[row] + depth] + 1 : 0;
+    }
+
+    void _sort_by_comparison(uint32_t* rows, size_t num_rows, size_t depth) const {
+        pdqsort(rows, rows + num_rows, [this, depth](uint32_t l, uint32_t r) {
+            size_t l_size = _size(l) - depth;
+            size_t r_size = _size(r) - depth;
+            int c = memcmp(_bytes + _offsets[l] + depth, _bytes + _offsets[r] + depth, std::min(l_size, r_size));
+            if (c != 0) {
+                return c < 0;
+            }
+            return l_size != r_size ? l_size < r_size : l < r;
+        });
+    }
+
+    const uint8_t* _bytes;
+    const uint32_t* _offsets;
+};
+
+} // namespace
+
+SortKeyEncoder::SortKeyEncoder(std::vector<PrimitiveType> types, std::vector<bool> is_asc,
+                               std::vector<bool> is_null_first)
+        : _types(std::move(types)), _is_asc(std::move(is_asc)), _is_null_first(std::move(is_null_first)) {
+    DCHECK_EQ(_types.size(), _is_asc.size());
+    DCHECK_EQ(_types.size(), _is_null_first.size());
+    for (PrimitiveType type : _types) {
+        _is_supported &= is_supported(type);
+    }
+}
+
+bool SortKeyEncoder::is_supported(PrimitiveType type) {
+    return is_binary_type(type) || visit_fixed_type(type, [](auto, auto) {});
+}
+
+void SortKeyEncoder::encode(const Columns& columns, size_t num_rows, BinaryColumn* keys) const {
+    DCHECK(_is_supported);
+    DCHECK_EQ(columns.size(), _types.size());
+
+    std::vector<ColumnView> views;
+    views.reserve(columns.size());
+    for (const auto& column : columns) {
+        views.emplace_back(view_of(column.get()));
+    }
+
+    // First pass: the size of every key.
+    auto& offsets = keys->get_offset();
+    offsets.assign(num_rows + 1, 0);
+    uint32_t* sizes = offsets.data() + 1;
+    for (size_t col = 0; col < columns.size(); col++) {
+        if (is_binary_type(_types[col])) {
+            binary_sizes(views[col], num_rows, sizes);
+        } else {
+            visit_fixed_type(_types[col], [&](auto pt, auto normalize) {
+                fixed_sizes<decltype(pt)::value>(views[col], num_rows, normalize, sizes);
+            });
+        }
+    }
+    for (size_t i = 1; i <= num_rows; i++) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    // Second pass: append the key of every column to the keys, column by column.
+    auto& bytes = keys->get_bytes();
+    bytes.resize(offsets[num_rows]);
+    std::vector<uint32_t> positions(num_rows, 0);
+    for (size_t col = 0; col < columns.size(); col++) {
+        uint8_t null_marker = _is_null_first[col] ? kNullFirst : kNullLast;
+        if (is_binary_type(_types[col])) {
+            encode_binary(views[col], num_rows, _is_asc[col], null_marker, offsets.data(), positions.data(),
+                          bytes.data());
+        } else {
+            visit_fixed_type(_types[col], [&](auto pt, auto normalize) {
+                encode_fixed<decltype(pt)::value>(views[col], num_rows, _is_asc[col], null_marker, normalize,
+                                                  offsets.data(), positions.data(), bytes.data());
+            });
+        }
+    }
+    keys->invalidate_slice_cache();
+}
+
+void SortKeyEncoder::sort(const BinaryColumn& keys, std::vector<uint32_t>* rows) {
+    KeyRadixSorter(keys).sort(rows->data(), rows->size());
+}
+
+} // namespace starrocks::vectorized
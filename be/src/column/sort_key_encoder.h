@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/vectorized_fwd.h"
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+// Encode the sort keys of rows into normalized keys, byte strings whose memcmp order is
+// the order of the rows, so that sorting and merging compare one Slice instead of calling
+// Column::compare_at() column by column.
+//
+// Every sort column contributes:
+//  - one byte ordering NULL against the other values, it is not inverted for descending
+//    columns so that NULLS FIRST/LAST keep their meaning;
+//  - for non-null values, the value in big-endian with its sign bit flipped (integers,
+//    dates, decimals), the IEEE-754 bits adjusted the same way (floating points), or the
+//    bytes with 0x00 escaped as 0x00 0xFF and terminated by 0x00 0x00 (strings), all bytes
+//    inverted for descending columns.
+//
+// The encoding of every column is prefix-free, so that the keys of several columns can
+// simply be concatenated. Rows with equal keys compare equal with compare_at() as well,
+// except -0.0 and 0.0 which both are encoded as 0.0.
+class SortKeyEncoder {
+public:
+    SortKeyEncoder(std::vector<PrimitiveType> types, std::vector<bool> is_asc, std::vector<bool> is_null_first);
+
+    // Whether all the sort columns have a type that can be normalized. When false,
+    // encode() must not be called.
+    bool is_supported() const { return _is_supported; }
+
+    static bool is_supported(PrimitiveType type);
+
+    // Encode the keys of the first |num_rows| rows of |columns|, which must be the sort
+    // columns in order, into |keys|, one row per key. |keys| is cleared first.
+    void encode(const Columns& columns, size_t num_rows, BinaryColumn* keys) const;
+
+    // Sort |rows|, indexes into |keys| in ascending order, by their keys with an MSD radix sort
+    // on the key bytes. Rows with equal keys stay in the order of their indexes.
+    static void sort(const BinaryColumn& keys, std::vector<uint32_t>* rows);
+
+private:
+    std::vector<PrimitiveType> _types;
+    std::vector<bool> _is_asc;
+    std::vector<bool> _is_null_first;
+    bool _is_supported = true;
+};
+
+} // namespace starrocks::vectorized
@@ -185,6 +185,12 @@ CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_queue_size, "256");
+// number of threads parsing the records of csv loads, the scanner thread parses them alone if 0
+CONF_Int32(csv_parse_thread_pool_size, "8");
+// number of threads encoding the columns of segments being written, columns are encoded one by one if 0
+CONF_Int32(segment_encode_thread_pool_size, "8");
+// segments with fewer columns than this are encoded by the writing thread alone
+CONF_mInt32(segment_parallel_encode_min_columns, "32");
 // port on which to run StarRocks test backend
 CONF_Int32(port, "20001");
 // default thrift client connect timeout(in seconds)
@@ -313,6 +319,8 @@ CONF_Int64(load_data_reserve_hours, "4");
 // log error log will be removed after this time
 CONF_mInt64(load_error_log_reserve_hours, "48");
 CONF_Int32(number_tablet_writer_threads, "16");
+// Number of threads adding the segments shipped by the primary replicas of single replica loads.
+CONF_Int32(number_segment_replicate_threads, "8");
 
 // Automatically detect whether a char/varchar column to use dictionary encoding
 // If the number of keys in a dictionary is greater than this fraction of the total number of rows
@@ -342,6 +350,13 @@ CONF_Int32(tablet_writer_open_rpc_timeout_sec, "60");
 // CONF_Int32(tablet_writer_rpc_timeout_sec, "600");
 // OlapTableSink sender's send interval, should be less than the real response time of a tablet writer rpc.
 CONF_mInt32(olap_table_sink_send_interval_ms, "10");
+// Compress the chunks sent by OlapTableSink to the tablet writers with LZ4. The receiving BE
+// must understand compressed chunks, so only enable it once every BE of the cluster has been upgraded.
+CONF_mBool(olap_table_sink_compress_chunks, "false");
+// Send the rows of a tablet only to its first replica, which writes the segments and ships them to the
+// other replicas, instead of having every replica sort and encode the same rows. Only enable it once
+// every BE of the cluster has been upgraded.
+CONF_mBool(enable_single_replica_load, "false");
 
 // Fragment thread pool
 CONF_Int32(fragment_pool_thread_num_min, "64");
@@ -446,6 +461,12 @@ CONF_Int32(memory_max_alignment, "16");
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
 
+// Whether the memtables of a duplicate keys tablet flushed to reduce the memory usage of loads are
+// spilled to a local file and merged into segments of normal size at close, instead of being written
+// out as small segments one by one. The merge rewrites all the spilled rows while the tablet writer
+// is closed, which adds to the time of the last rpc of the load.
+CONF_mBool(memtable_spill_enable, "false");
+
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
 // NOTICE(cmy): set these default values very large because we don't want to
@@ -483,6 +504,13 @@ CONF_mInt32(max_consumer_num_per_group, "3");
 // this should be larger than FE config 'max_concurrent_task_num_per_be' (default 5)
 CONF_Int32(routine_load_thread_pool_size, "10");
 
+// max number of kafka messages a consumer of routine load hands over to its consumer group at once.
+// the consumer group queues about 500 messages in total, i.e. 500 / routine_load_kafka_batch_size batches.
+CONF_mInt32(routine_load_kafka_batch_size, "100");
+
+// the metrics of a kafka partition are removed once no routine load task has consumed it for this long.
+CONF_mInt64(routine_load_partition_metrics_expire_s, "3600");
+
 // Is set to true, index loading failure will not causing BE exit,
 // and the tablet will be marked as bad, so that FE will try to repair it.
 // CONF_Bool(auto_recover_index_loading_failure, "false");
@@ -561,6 +589,38 @@ CONF_Bool(ignore_rowset_stale_unconsistent_delete, "false");
 // The chunk size for vector query engine
 CONF_Int32(vector_chunk_size, "4096");
 
+// Evaluate the conjuncts of a node in the order of their measured cost per filtered row,
+// so that the cheap and selective ones run first and the others run on fewer rows. Off by
+// default: the conjuncts are ranked again for every chunk, which does not pay off for the
+// conjuncts cheap enough to be evaluated on all the rows anyway.
+CONF_mBool(enable_adaptive_conjunct_order, "false");
+
+// Compute the subtrees repeated in the output expressions of a projection once per chunk.
+CONF_mBool(enable_projection_common_sub_expr_elimination, "true");
+
+// Evaluate the expensive string functions, like regexp_replace, parse_url, get_json_string and
+// md5, on the distinct values of a low-cardinality argument and map the results back to the
+// rows, instead of evaluating them on every row.
+CONF_mBool(enable_string_function_dict_evaluation, "true");
+
+// A row group of the parquet files written by SELECT INTO OUTFILE is written once it has this
+// many rows or bytes, whichever comes first.
+CONF_mInt64(parquet_export_row_group_max_rows, "1048576");
+CONF_mInt64(parquet_export_row_group_max_bytes, "134217728");
+
+// Skip the pages of parquet files whose page index shows that none of their rows matches the
+// min/max conjuncts of the scan.
+CONF_mBool(parquet_page_index_enable, "true");
+
+// Read the parquet columns without conjuncts only for the rows that pass the conjuncts of the
+// other columns.
+CONF_mBool(parquet_late_materialization_enable, "true");
+
+// Split the parquet and orc files of hdfs scan into morsels of about this many bytes, each read by
+// its own scanner. A row group or stripe is read by the morsel holding its first byte.
+// Files are not split if it is not positive.
+CONF_mInt64(hdfs_scan_morsel_bytes, "134217728");
+
 // valid range: [0-1000].
 // `0` will disable late materialization.
 // `1000` will enable late materialization always.
@@ -619,6 +679,31 @@ CONF_Int64(pipeline_yield_max_chunks_moved, "100");
 // yield PipelineDriver when maximum time in nano-seconds has spent
 // in current execution round.
 CONF_Int64(pipeline_yield_max_time_spent, "100000000");
+// Maximum time in micro-seconds the driver poller sleeps when no blocked driver makes
+// progress, it is woken up earlier by events such as exchange RPC completions.
+CONF_mInt64(pipeline_poller_idle_wait_us, "1000");
+// Bytes of chunk data that may be queued for one destination in the pipeline exchange
+// sink buffer before the sink operators sending to it are blocked.
+CONF_mInt64(pipeline_sink_buffer_bytes_per_destination, "16777216");
+
+// Encode exchanged chunks column by column (dictionary, run-length, frame-of-reference)
+// before block compression. The receiving BE must understand the encoded format, so only
+// enable it once every BE of the cluster has been upgraded.
+CONF_mBool(exchange_column_encoding, "false");
+// After rpc_compress_poor_ratio_chunks consecutive chunks compressed worse than
+// rpc_compress_ratio_threshold, the sender stops compressing the next
+// rpc_compress_skip_chunks chunks and then probes again.
+CONF_mInt32(rpc_compress_poor_ratio_chunks, "4");
+CONF_mInt32(rpc_compress_skip_chunks, "64");
+
+// Hand chunks directly to exchange receivers on the same BE instead of serializing
+// them and going through brpc. The chunks handed over are accounted on the memory
+// tracker of the receiver while they are queued.
+CONF_mBool(enable_exchange_pass_through, "true");
+
+// Record the rows routed to every channel of hash-partitioning exchanges and sample the
+// partition keys, reporting per-channel bytes and the heavy-hitter keys in the profile.
+CONF_mBool(enable_exchange_skew_detection, "false");
 } // namespace config
 
 } // namespace starrocks
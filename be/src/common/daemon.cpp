@@ -178,6 +178,8 @@ void* calculate_metrics(void* dummy) {
 
     while (true) {
         StarRocksMetrics::instance()->metrics()->trigger_hook();
+        StarRocksMetrics::instance()->expire_routine_load_partition_metrics(
+                config::routine_load_partition_metrics_expire_s);
 
         if (last_ts == -1L) {
             last_ts = MonotonicSeconds();
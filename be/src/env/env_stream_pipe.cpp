@@ -19,8 +19,8 @@ Status StreamPipeSequentialFile::read(Slice* result) {
     return _file->read(reinterpret_cast<uint8_t*>(result->data), &(result->size), &eof);
 }
 
-Status StreamPipeSequentialFile::read_one_message(std::unique_ptr<uint8_t[]>* buf, size_t* length) {
-    return _file->read_one_message(buf, length);
+Status StreamPipeSequentialFile::read_one_message(ByteBufferPtr* buf) {
+    return _file->read_one_message(buf);
 }
 
 Status StreamPipeSequentialFile::skip(uint64_t n) {
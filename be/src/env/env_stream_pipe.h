@@ -3,6 +3,7 @@
 #pragma once
 
 #include "env/env.h"
+#include "util/byte_buffer.h"
 
 namespace starrocks {
 class StreamLoadPipe;
@@ -16,7 +17,8 @@ public:
     ~StreamPipeSequentialFile() override;
 
     Status read(Slice* result) override;
-    Status read_one_message(std::unique_ptr<uint8_t[]>* buf, size_t* length);
+    // |buf| is set to null if there is no more message.
+    Status read_one_message(ByteBufferPtr* buf);
 
     Status skip(uint64_t n) override;
     const std::string& filename() const override { return _filename; }
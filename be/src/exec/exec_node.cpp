@@ -85,6 +85,7 @@
 #include "simd/simd.h"
 #include "util/debug_util.h"
 #include "util/runtime_profile.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks {
 
@@ -723,6 +724,43 @@ bool ExecNode::eval_conjuncts(ExprContext* const* ctxs, int num_ctxs, TupleRow*
     return true;
 }
 
+// The conjuncts in the order to evaluate them: when config::enable_adaptive_conjunct_order is
+// set, by increasing measured cost per filtered row, the conjuncts without enough statistics first.
+static std::vector<ExprContext*> order_conjuncts(const std::vector<ExprContext*>& ctxs) {
+    if (ctxs.size() <= 1 || !config::enable_adaptive_conjunct_order) {
+        return ctxs;
+    }
+    std::vector<std::pair<double, ExprContext*>> ranked;
+    ranked.reserve(ctxs.size());
+    for (auto* ctx : ctxs) {
+        ranked.emplace_back(ctx->conjunct_rank(), ctx);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    std::vector<ExprContext*> ordered;
+    ordered.reserve(ctxs.size());
+    for (auto& entry : ranked) {
+        ordered.push_back(entry.second);
+    }
+    return ordered;
+}
+
+// Evaluate the conjunct |ctx| on |chunk|, and record its cost and selectivity from time to time
+// if |record_stats|.
+static ColumnPtr eval_conjunct(ExprContext* ctx, vectorized::Chunk* chunk, bool record_stats, size_t* true_count) {
+    if (!record_stats || !ctx->sample_conjunct_stats()) {
+        ColumnPtr column = ctx->evaluate(chunk);
+        *true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+        return column;
+    }
+    MonotonicStopWatch watch;
+    watch.start();
+    ColumnPtr column = ctx->evaluate(chunk);
+    *true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    ctx->update_conjunct_stats(column->size(), *true_count, watch.elapsed_time());
+    return column;
+}
+
 static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk) {
     vectorized::Column::Filter filter(chunk->num_rows(), 1);
     vectorized::Column::Filter* raw_filter = &filter;
@@ -741,9 +779,10 @@ static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, ve
     int prune_threshold = std::max(int(chunk->num_rows() * prune_ratio), prune_min_size);
     int zero_count = 0;
 
-    for (auto* ctx : ctxs) {
-        ColumnPtr column = ctx->evaluate(chunk);
-        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    bool record_stats = ctxs.size() > 1 && config::enable_adaptive_conjunct_order;
+    for (auto* ctx : order_conjuncts(ctxs)) {
+        size_t true_count = 0;
+        ColumnPtr column = eval_conjunct(ctx, chunk, record_stats, &true_count);
 
         if (true_count == column->size()) {
             // all hit, skip
@@ -799,9 +838,10 @@ void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized:
     }
     vectorized::Column::Filter* raw_filter = filter.get();
 
-    for (auto* ctx : ctxs) {
-        ColumnPtr column = ctx->evaluate(chunk);
-        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    bool record_stats = ctxs.size() > 1 && config::enable_adaptive_conjunct_order;
+    for (auto* ctx : order_conjuncts(ctxs)) {
+        size_t true_count = 0;
+        ColumnPtr column = eval_conjunct(ctx, chunk, record_stats, &true_count);
 
         if (true_count == column->size()) {
             // all hit, skip
@@ -107,6 +107,17 @@ Status ColumnChunkReader::next_page() {
     return Status::OK();
 }
 
+Status ColumnChunkReader::skip_page() {
+    DCHECK_EQ(_page_parse_state, PAGE_HEADER_PARSED);
+    RETURN_IF_ERROR(_page_reader->skip_bytes(_page_reader->current_header()->compressed_page_size));
+    _page_parse_state = PAGE_DATA_PARSED;
+    return Status::OK();
+}
+
+const tparquet::PageHeader* ColumnChunkReader::current_page_header() const {
+    return _page_reader->current_header();
+}
+
 Status ColumnChunkReader::_parse_page_header() {
     DCHECK(_page_parse_state == INITIALIZED || _page_parse_state == PAGE_DATA_PARSED);
     RETURN_IF_ERROR(_page_reader->next_header());
@@ -199,7 +210,8 @@ Status ColumnChunkReader::_parse_data_page() {
     }
 
     _cur_decoder->set_type_legth(_type_length);
-    _cur_decoder->set_data(_data);
+    _cur_decoder->set_num_values(_num_values);
+    RETURN_IF_ERROR(_cur_decoder->set_data(_data));
 
     _page_parse_state = PAGE_DATA_PARSED;
     return Status::OK();
@@ -238,7 +250,7 @@ Status ColumnChunkReader::_try_load_dictionary() {
     const EncodingInfo* code_info = nullptr;
     RETURN_IF_ERROR(EncodingInfo::get(metadata().type, dict_encoding, &code_info));
     RETURN_IF_ERROR(code_info->create_decoder(&dict_decoder));
-    dict_decoder->set_data(_data);
+    RETURN_IF_ERROR(dict_decoder->set_data(_data));
     dict_decoder->set_type_legth(_type_length);
 
     // initialize decoder
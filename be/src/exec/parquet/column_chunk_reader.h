@@ -40,6 +40,14 @@ public:
 
     Status next_page();
 
+    // next_page() in two steps: parse the header of the next page, then either load the page
+    // or skip it without reading its data.
+    Status next_header() { return _parse_page_header(); }
+    Status load_page() { return _parse_page_data(); }
+    Status skip_page();
+
+    const tparquet::PageHeader* current_page_header() const;
+
     uint32_t num_values() const { return _num_values; }
 
     // Try to decode n definition levels into 'levels'
@@ -82,6 +90,8 @@ public:
         return _cur_decoder->next_batch(n, content_type, dst);
     }
 
+    Status skip_values(size_t n) { return _cur_decoder->skip(n); }
+
     const tparquet::ColumnMetaData& metadata() const { return _chunk_metadata->meta_data; }
 
     Status get_dict_values(vectorized::Column* column) { return _cur_decoder->get_dict_values(column); }
@@ -355,6 +355,8 @@ public:
 
     Status finish_batch() override { return Status::OK(); }
 
+    Status skip_records(size_t num_records) override { return _reader->skip_records(num_records); }
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
         _reader->get_levels(def_levels, rep_levels, num_levels);
     }
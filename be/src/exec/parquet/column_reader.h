@@ -45,6 +45,11 @@ public:
         return finish_batch();
     }
 
+    // Skip the next |num_records| records, without reading the pages having only skipped ones.
+    virtual Status skip_records(size_t num_records) {
+        return Status::NotSupported("skip_records is not supported");
+    }
+
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
 
     virtual Status get_dict_values(vectorized::Column* column) {
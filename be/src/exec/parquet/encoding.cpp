@@ -2,6 +2,8 @@
 
 #include "exec/parquet/encoding.h"
 
+#include "exec/parquet/encoding_byte_stream_split.h"
+#include "exec/parquet/encoding_delta.h"
 #include "exec/parquet/encoding_dict.h"
 #include "exec/parquet/encoding_plain.h"
 #include "exec/parquet/types.h"
@@ -54,6 +56,54 @@ struct TypeEncodingTraits<tparquet::Type::FIXED_LEN_BYTE_ARRAY, tparquet::Encodi
     }
 };
 
+template <tparquet::Type::type type>
+struct TypeEncodingTraits<type, tparquet::Encoding::DELTA_BINARY_PACKED> {
+    static Status create_decoder(std::unique_ptr<Decoder>* decoder) {
+        decoder->reset(new DeltaBinaryPackedDecoder<typename PhysicalTypeTraits<type>::CppType>());
+        return Status::OK();
+    }
+    static Status create_encoder(std::unique_ptr<Encoder>* encoder) {
+        encoder->reset(new DeltaBinaryPackedEncoder<typename PhysicalTypeTraits<type>::CppType>());
+        return Status::OK();
+    }
+};
+
+template <tparquet::Type::type type>
+struct TypeEncodingTraits<type, tparquet::Encoding::DELTA_LENGTH_BYTE_ARRAY> {
+    static Status create_decoder(std::unique_ptr<Decoder>* decoder) {
+        decoder->reset(new DeltaLengthByteArrayDecoder());
+        return Status::OK();
+    }
+    static Status create_encoder(std::unique_ptr<Encoder>* encoder) {
+        encoder->reset(new DeltaLengthByteArrayEncoder());
+        return Status::OK();
+    }
+};
+
+template <tparquet::Type::type type>
+struct TypeEncodingTraits<type, tparquet::Encoding::DELTA_BYTE_ARRAY> {
+    static Status create_decoder(std::unique_ptr<Decoder>* decoder) {
+        decoder->reset(new DeltaByteArrayDecoder());
+        return Status::OK();
+    }
+    static Status create_encoder(std::unique_ptr<Encoder>* encoder) {
+        encoder->reset(new DeltaByteArrayEncoder());
+        return Status::OK();
+    }
+};
+
+template <tparquet::Type::type type>
+struct TypeEncodingTraits<type, tparquet::Encoding::BYTE_STREAM_SPLIT> {
+    static Status create_decoder(std::unique_ptr<Decoder>* decoder) {
+        decoder->reset(new ByteStreamSplitDecoder<typename PhysicalTypeTraits<type>::CppType>());
+        return Status::OK();
+    }
+    static Status create_encoder(std::unique_ptr<Encoder>* encoder) {
+        encoder->reset(new ByteStreamSplitEncoder<typename PhysicalTypeTraits<type>::CppType>());
+        return Status::OK();
+    }
+};
+
 template <tparquet::Type::type type_arg, tparquet::Encoding::type encoding_arg>
 struct EncodingTraits : TypeEncodingTraits<type_arg, encoding_arg> {
     static constexpr tparquet::Type::type type = type_arg;
@@ -91,10 +141,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
     // INT32
     _add_map<tparquet::Type::INT32, tparquet::Encoding::PLAIN>();
     _add_map<tparquet::Type::INT32, tparquet::Encoding::RLE_DICTIONARY>();
+    _add_map<tparquet::Type::INT32, tparquet::Encoding::DELTA_BINARY_PACKED>();
 
     // INT64
     _add_map<tparquet::Type::INT64, tparquet::Encoding::PLAIN>();
     _add_map<tparquet::Type::INT64, tparquet::Encoding::RLE_DICTIONARY>();
+    _add_map<tparquet::Type::INT64, tparquet::Encoding::DELTA_BINARY_PACKED>();
 
     // INT96
     _add_map<tparquet::Type::INT96, tparquet::Encoding::PLAIN>();
@@ -103,18 +155,23 @@ EncodingInfoResolver::EncodingInfoResolver() {
     // FLOAT
     _add_map<tparquet::Type::FLOAT, tparquet::Encoding::PLAIN>();
     _add_map<tparquet::Type::FLOAT, tparquet::Encoding::RLE_DICTIONARY>();
+    _add_map<tparquet::Type::FLOAT, tparquet::Encoding::BYTE_STREAM_SPLIT>();
 
     // DOUBLE
     _add_map<tparquet::Type::DOUBLE, tparquet::Encoding::PLAIN>();
     _add_map<tparquet::Type::DOUBLE, tparquet::Encoding::RLE_DICTIONARY>();
+    _add_map<tparquet::Type::DOUBLE, tparquet::Encoding::BYTE_STREAM_SPLIT>();
 
     // BYTE_ARRAY encoding
     _add_map<tparquet::Type::BYTE_ARRAY, tparquet::Encoding::PLAIN>();
     _add_map<tparquet::Type::BYTE_ARRAY, tparquet::Encoding::RLE_DICTIONARY>();
+    _add_map<tparquet::Type::BYTE_ARRAY, tparquet::Encoding::DELTA_LENGTH_BYTE_ARRAY>();
+    _add_map<tparquet::Type::BYTE_ARRAY, tparquet::Encoding::DELTA_BYTE_ARRAY>();
 
     // FIXED_LEN_BYTE_ARRAY encoding
     _add_map<tparquet::Type::FIXED_LEN_BYTE_ARRAY, tparquet::Encoding::PLAIN>();
     _add_map<tparquet::Type::FIXED_LEN_BYTE_ARRAY, tparquet::Encoding::RLE_DICTIONARY>();
+    _add_map<tparquet::Type::FIXED_LEN_BYTE_ARRAY, tparquet::Encoding::DELTA_BYTE_ARRAY>();
 }
 
 EncodingInfoResolver::~EncodingInfoResolver() {
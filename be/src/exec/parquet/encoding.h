@@ -59,6 +59,10 @@ public:
     // used to set fixed length
     virtual void set_type_legth(int32_t type_length) {}
 
+    // The number of values of the next page, nulls included. The decoders reading a value
+    // count from the page itself check it against this one.
+    virtual void set_num_values(size_t num_values) {}
+
     // Set a new page to decoded.
     virtual Status set_data(const Slice& data) = 0;
 
@@ -67,6 +71,9 @@ public:
     // It will return ERROR if caller wants to read out-of-bound data.
     virtual Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) = 0;
 
+    // Skip the next |count| values, which must exist like in next_batch.
+    virtual Status skip(size_t count) { return Status::NotSupported("skip is not supported"); }
+
     // Currently, this function is only used to read dictionary values.
     virtual Status next_batch(size_t count, uint8_t* dst) {
         return Status::NotSupported("next_batch is not supportted");
@@ -0,0 +1,147 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <vector>
+
+#include "column/column.h"
+#include "common/status.h"
+#include "exec/parquet/encoding.h"
+#include "gutil/strings/substitute.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks::parquet {
+
+// BYTE_STREAM_SPLIT stores the k-th byte of all the values, then the (k+1)-th, and so on.
+template <typename T>
+class ByteStreamSplitEncoder final : public Encoder {
+public:
+    ByteStreamSplitEncoder() = default;
+    ~ByteStreamSplitEncoder() override = default;
+
+    Status append(const uint8_t* vals, size_t count) override {
+        _values.append(vals, count * sizeof(T));
+        return Status::OK();
+    }
+
+    Slice build() override {
+        size_t num_values = _values.size() / sizeof(T);
+        _buffer.resize(_values.size());
+        for (size_t i = 0; i < num_values; i++) {
+            for (size_t k = 0; k < sizeof(T); k++) {
+                _buffer[k * num_values + i] = _values[i * sizeof(T) + k];
+            }
+        }
+        return {_buffer.data(), _buffer.size()};
+    }
+
+private:
+    faststring _values;
+    faststring _buffer;
+};
+
+template <typename T>
+class ByteStreamSplitDecoder final : public Decoder {
+public:
+    ByteStreamSplitDecoder() = default;
+    ~ByteStreamSplitDecoder() override = default;
+
+    Status set_data(const Slice& data) override {
+        if (data.size % sizeof(T) != 0) {
+            return Status::Corruption(
+                    strings::Substitute("BYTE_STREAM_SPLIT page of $0 bytes for values of $1", data.size, sizeof(T)));
+        }
+        _data = reinterpret_cast<const uint8_t*>(data.data);
+        _num_values = data.size / sizeof(T);
+        _index = 0;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) override {
+        _values.resize(count);
+        RETURN_IF_ERROR(next_batch(count, reinterpret_cast<uint8_t*>(_values.data())));
+        auto n = dst->append_numbers(_values.data(), count * sizeof(T));
+        CHECK_EQ(count, n);
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, uint8_t* dst) override {
+        if (count > _num_values - _index) {
+            return Status::InternalError(strings::Substitute(
+                    "going to read out-of-bounds data, index=$0,count=$1,values=$2", _index, count, _num_values));
+        }
+        size_t i = 0;
+#ifdef __SSE2__
+        if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+            for (; i + 16 <= count; i += 16) {
+                _transpose16(_index + i, dst + i * sizeof(T));
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            for (size_t k = 0; k < sizeof(T); k++) {
+                dst[i * sizeof(T) + k] = _data[k * _num_values + _index + i];
+            }
+        }
+        _index += count;
+        return Status::OK();
+    }
+
+    Status skip(size_t count) override {
+        if (count > _num_values - _index) {
+            return Status::InternalError(strings::Substitute(
+                    "going to skip out-of-bounds data, index=$0,count=$1,values=$2", _index, count, _num_values));
+        }
+        _index += count;
+        return Status::OK();
+    }
+
+private:
+#ifdef __SSE2__
+    // Interleave the bytes of the 16 values from |index| in the streams into |dst|.
+    void _transpose16(size_t index, uint8_t* dst) const {
+        __m128i streams[sizeof(T)];
+        for (size_t k = 0; k < sizeof(T); k++) {
+            streams[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_data + k * _num_values + index));
+        }
+        // Bytes of values 0-7 and 8-15 of each pair of streams.
+        __m128i pairs[sizeof(T)];
+        for (size_t k = 0; k < sizeof(T); k += 2) {
+            pairs[k] = _mm_unpacklo_epi8(streams[k], streams[k + 1]);
+            pairs[k + 1] = _mm_unpackhi_epi8(streams[k], streams[k + 1]);
+        }
+        // Bytes of values 0-3, 4-7, 8-11 and 12-15 of each quad of streams.
+        __m128i quads[sizeof(T) * 2];
+        for (size_t k = 0; k < sizeof(T); k += 4) {
+            quads[k * 2] = _mm_unpacklo_epi16(pairs[k], pairs[k + 2]);
+            quads[k * 2 + 1] = _mm_unpackhi_epi16(pairs[k], pairs[k + 2]);
+            quads[k * 2 + 2] = _mm_unpacklo_epi16(pairs[k + 1], pairs[k + 3]);
+            quads[k * 2 + 3] = _mm_unpackhi_epi16(pairs[k + 1], pairs[k + 3]);
+        }
+        auto* out = reinterpret_cast<__m128i*>(dst);
+        if constexpr (sizeof(T) == 4) {
+            for (size_t q = 0; q < 4; q++) {
+                _mm_storeu_si128(out + q, quads[q]);
+            }
+        } else {
+            // Combine the low and high quads of values 0-1, 2-3, ..., 14-15.
+            for (size_t q = 0; q < 4; q++) {
+                _mm_storeu_si128(out + q * 2, _mm_unpacklo_epi32(quads[q], quads[q + 8]));
+                _mm_storeu_si128(out + q * 2 + 1, _mm_unpackhi_epi32(quads[q], quads[q + 8]));
+            }
+        }
+    }
+#endif
+
+    const uint8_t* _data = nullptr;
+    size_t _num_values = 0;
+    size_t _index = 0;
+    std::vector<T> _values;
+};
+
+} // namespace starrocks::parquet
@@ -0,0 +1,498 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "column/column.h"
+#include "common/status.h"
+#include "exec/parquet/encoding.h"
+#include "gutil/strings/substitute.h"
+#include "util/bit_stream_utils.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/bit_util.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+// The DELTA_BINARY_PACKED, DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY encodings,
+// refer: https://github.com/apache/parquet-format/blob/master/Encodings.md
+namespace starrocks::parquet {
+
+// DELTA_BINARY_PACKED stores the first value and then the deltas between consecutive values in
+// blocks. A block stores the minimum of its deltas and is split into miniblocks of a multiple
+// of 32 values, each bit packed with its own bit width after subtracting the minimum.
+template <typename T>
+class DeltaBinaryPackedEncoder final : public Encoder {
+public:
+    DeltaBinaryPackedEncoder() = default;
+    ~DeltaBinaryPackedEncoder() override = default;
+
+    Status append(const uint8_t* vals, size_t count) override {
+        const T* values = reinterpret_cast<const T*>(vals);
+        _values.insert(_values.end(), values, values + count);
+        return Status::OK();
+    }
+
+    Slice build() override {
+        using UT = std::make_unsigned_t<T>;
+        _buffer.clear();
+        put_varint64(&_buffer, kBlockSize);
+        put_varint64(&_buffer, kNumMiniblocks);
+        put_varint64(&_buffer, _values.size());
+        put_varint64(&_buffer, zigzag(_values.empty() ? 0 : _values[0]));
+
+        faststring packed;
+        for (size_t begin = 1; begin < _values.size(); begin += kBlockSize) {
+            size_t end = std::min(_values.size(), begin + kBlockSize);
+            std::vector<T> deltas(end - begin);
+            for (size_t i = begin; i < end; i++) {
+                deltas[i - begin] = static_cast<T>(static_cast<UT>(_values[i]) - static_cast<UT>(_values[i - 1]));
+            }
+            T min_delta = *std::min_element(deltas.begin(), deltas.end());
+            put_varint64(&_buffer, zigzag(min_delta));
+
+            uint8_t bit_widths[kNumMiniblocks] = {0};
+            size_t num_miniblocks = (deltas.size() + kMiniblockSize - 1) / kMiniblockSize;
+            for (size_t m = 0; m < num_miniblocks; m++) {
+                UT max_value = 0;
+                for (size_t i = m * kMiniblockSize; i < std::min(deltas.size(), (m + 1) * kMiniblockSize); i++) {
+                    max_value = std::max<UT>(max_value, static_cast<UT>(deltas[i]) - static_cast<UT>(min_delta));
+                }
+                bit_widths[m] = max_value == 0 ? 0 : BitUtil::Log2FloorNonZero64(max_value) + 1;
+            }
+            _buffer.append(bit_widths, kNumMiniblocks);
+
+            for (size_t m = 0; m < num_miniblocks; m++) {
+                // The last miniblock is padded to its full size.
+                BitWriter writer(&packed);
+                for (size_t i = m * kMiniblockSize; i < (m + 1) * kMiniblockSize && bit_widths[m] > 0; i++) {
+                    UT value = i < deltas.size() ? static_cast<UT>(deltas[i]) - static_cast<UT>(min_delta) : 0;
+                    writer.PutValue(value, bit_widths[m]);
+                }
+                writer.Flush();
+                _buffer.append(packed.data(), writer.bytes_written());
+            }
+        }
+        return {_buffer.data(), _buffer.size()};
+    }
+
+private:
+    static constexpr size_t kBlockSize = 128;
+    static constexpr size_t kNumMiniblocks = 4;
+    static constexpr size_t kMiniblockSize = kBlockSize / kNumMiniblocks;
+
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    std::vector<T> _values;
+    faststring _buffer;
+};
+
+template <typename T>
+class DeltaBinaryPackedDecoder final : public Decoder {
+public:
+    DeltaBinaryPackedDecoder() = default;
+    ~DeltaBinaryPackedDecoder() override = default;
+
+    Status set_data(const Slice& data) override {
+        _reader.reset(reinterpret_cast<const uint8_t*>(data.data), data.size);
+        _data_end = reinterpret_cast<const uint8_t*>(data.data) + data.size;
+        uint64_t block_size = 0;
+        uint64_t num_miniblocks = 0;
+        uint64_t total_values = 0;
+        uint64_t first_value = 0;
+        if (!_reader.get_lleb_128(&block_size) || !_reader.get_lleb_128(&num_miniblocks) ||
+            !_reader.get_lleb_128(&total_values) || !_reader.get_lleb_128(&first_value)) {
+            return Status::Corruption("truncated DELTA_BINARY_PACKED header");
+        }
+        if (block_size == 0 || block_size % 128 != 0 || block_size > kMaxBlockSize || num_miniblocks == 0 ||
+            block_size % num_miniblocks != 0 || (block_size / num_miniblocks) % 32 != 0) {
+            return Status::Corruption(strings::Substitute(
+                    "invalid DELTA_BINARY_PACKED block, block_size=$0, miniblocks=$1", block_size, num_miniblocks));
+        }
+        _num_miniblocks = num_miniblocks;
+        _values_per_miniblock = block_size / num_miniblocks;
+        _bit_widths.resize(_num_miniblocks);
+        _deltas.resize(_values_per_miniblock);
+        _num_values = total_values;
+        _num_decoded = 0;
+        _last_value = static_cast<UT>(unzigzag(first_value));
+        // Start with an exhausted miniblock of an exhausted block.
+        _miniblock_index = _num_miniblocks;
+        _delta_index = _values_per_miniblock;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) override {
+        _values.resize(count);
+        RETURN_IF_ERROR(decode(count, _values.data()));
+        auto n = dst->append_numbers(_values.data(), count * sizeof(T));
+        CHECK_EQ(count, n);
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, uint8_t* dst) override { return decode(count, reinterpret_cast<T*>(dst)); }
+
+    Status skip(size_t count) override {
+        _values.resize(count);
+        return decode(count, _values.data());
+    }
+
+    Status decode(size_t count, T* out) {
+        if (count > _num_values - _num_decoded) {
+            return Status::InternalError(
+                    strings::Substitute("going to read out-of-bounds data, decoded=$0,count=$1,values=$2",
+                                        _num_decoded, count, _num_values));
+        }
+        size_t i = 0;
+        if (count > 0 && _num_decoded == 0) {
+            out[i++] = static_cast<T>(_last_value);
+            _num_decoded++;
+        }
+        UT last_value = _last_value;
+        while (i < count) {
+            if (_delta_index == _values_per_miniblock) {
+                RETURN_IF_ERROR(_next_miniblock());
+            }
+            size_t n = std::min(count - i, _values_per_miniblock - _delta_index);
+            const UT* deltas = _deltas.data() + _delta_index;
+            for (size_t j = 0; j < n; j++) {
+                last_value += _min_delta + deltas[j];
+                out[i + j] = static_cast<T>(last_value);
+            }
+            i += n;
+            _delta_index += n;
+            _num_decoded += n;
+        }
+        _last_value = last_value;
+        return Status::OK();
+    }
+
+    // Number of values in the page.
+    size_t num_values() const { return _num_values; }
+
+    // Reject a header announcing more values than |page_num_values| or than the rest of the
+    // page can encode, before the caller allocates for them. Every block after the first
+    // value takes at least its minimum delta and the bit widths of its miniblocks.
+    Status check_num_values(size_t page_num_values) const {
+        size_t block_size = _values_per_miniblock * _num_miniblocks;
+        size_t max_num_values = 1 + _reader.bytes_left() / (1 + _num_miniblocks) * block_size;
+        if (_num_values > std::min(page_num_values, max_num_values)) {
+            return Status::Corruption(strings::Substitute(
+                    "DELTA_BINARY_PACKED of $0 values exceeds the page of $1 values and $2 bytes", _num_values,
+                    page_num_values, _reader.bytes_left()));
+        }
+        return Status::OK();
+    }
+
+    // The first byte after the values, once all of them are decoded.
+    const uint8_t* data_end() const { return _data_end - _reader.bytes_left(); }
+
+private:
+    using UT = std::make_unsigned_t<T>;
+
+    // Larger blocks are valid but not written by anyone, reject them before allocating.
+    static constexpr uint64_t kMaxBlockSize = 1 << 16;
+
+    static int64_t unzigzag(uint64_t value) { return static_cast<int64_t>((value >> 1) ^ -(value & 1)); }
+
+    Status _next_miniblock() {
+        if (_miniblock_index == _num_miniblocks) {
+            uint64_t min_delta = 0;
+            if (!_reader.get_lleb_128(&min_delta)) {
+                return Status::Corruption("truncated DELTA_BINARY_PACKED block");
+            }
+            _min_delta = static_cast<UT>(unzigzag(min_delta));
+            for (size_t m = 0; m < _num_miniblocks; m++) {
+                if (!_reader.get_bytes(1, &_bit_widths[m])) {
+                    return Status::Corruption("truncated DELTA_BINARY_PACKED block");
+                }
+            }
+            _miniblock_index = 0;
+        }
+        int bit_width = _bit_widths[_miniblock_index++];
+        if (bit_width > sizeof(T) * 8) {
+            return Status::Corruption(strings::Substitute("invalid DELTA_BINARY_PACKED bit width $0", bit_width));
+        }
+        // The last miniblock is padded to its full size, but do not rely on it and only
+        // require the values left in the page.
+        size_t needed = std::min<size_t>(_values_per_miniblock, _num_values - _num_decoded);
+        if (_reader.unpack_batch(bit_width, _values_per_miniblock, _deltas.data()) < needed) {
+            return Status::Corruption("truncated DELTA_BINARY_PACKED miniblock");
+        }
+        _delta_index = 0;
+        return Status::OK();
+    }
+
+    BatchedBitReader _reader;
+    const uint8_t* _data_end = nullptr;
+    size_t _num_miniblocks = 0;
+    size_t _values_per_miniblock = 0;
+    size_t _num_values = 0;
+    size_t _num_decoded = 0;
+
+    UT _last_value = 0;
+    UT _min_delta = 0;
+    std::vector<uint8_t> _bit_widths;
+    size_t _miniblock_index = 0;
+    // The unpacked deltas of the current miniblock, without the minimum delta.
+    std::vector<UT> _deltas;
+    size_t _delta_index = 0;
+
+    std::vector<T> _values;
+};
+
+// DELTA_LENGTH_BYTE_ARRAY stores the lengths of the values with DELTA_BINARY_PACKED, followed
+// by the concatenated values.
+class DeltaLengthByteArrayEncoder final : public Encoder {
+public:
+    DeltaLengthByteArrayEncoder() = default;
+    ~DeltaLengthByteArrayEncoder() override = default;
+
+    Status append(const uint8_t* vals, size_t count) override {
+        const auto* slices = reinterpret_cast<const Slice*>(vals);
+        for (size_t i = 0; i < count; i++) {
+            int32_t length = slices[i].size;
+            RETURN_IF_ERROR(_lengths.append(reinterpret_cast<const uint8_t*>(&length), 1));
+            _values.append(slices[i].data, slices[i].size);
+        }
+        return Status::OK();
+    }
+
+    Slice build() override {
+        Slice lengths = _lengths.build();
+        _buffer.clear();
+        _buffer.append(lengths.data, lengths.size);
+        _buffer.append(_values.data(), _values.size());
+        return {_buffer.data(), _buffer.size()};
+    }
+
+private:
+    DeltaBinaryPackedEncoder<int32_t> _lengths;
+    faststring _values;
+    faststring _buffer;
+};
+
+class DeltaLengthByteArrayDecoder final : public Decoder {
+public:
+    DeltaLengthByteArrayDecoder() = default;
+    ~DeltaLengthByteArrayDecoder() override = default;
+
+    void set_num_values(size_t num_values) override { _page_num_values = num_values; }
+
+    Status set_data(const Slice& data) override {
+        // The values only start after the last length, so decode all of them at once.
+        RETURN_IF_ERROR(_length_decoder.set_data(data));
+        RETURN_IF_ERROR(_length_decoder.check_num_values(_page_num_values));
+        _lengths.resize(_length_decoder.num_values());
+        RETURN_IF_ERROR(_length_decoder.decode(_lengths.size(), _lengths.data()));
+        const char* values = reinterpret_cast<const char*>(_length_decoder.data_end());
+        size_t values_size = data.data + data.size - values;
+        size_t total_length = 0;
+        for (int32_t length : _lengths) {
+            if (length < 0) {
+                return Status::Corruption("negative DELTA_LENGTH_BYTE_ARRAY length");
+            }
+            total_length += length;
+        }
+        if (total_length > values_size) {
+            return Status::Corruption(strings::Substitute(
+                    "DELTA_LENGTH_BYTE_ARRAY values of $0 bytes exceed the page of $1", total_length, values_size));
+        }
+        _values = values;
+        _index = 0;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) override {
+        _slices.resize(count);
+        RETURN_IF_ERROR(next_slices(count, _slices.data()));
+        // The values are adjacent in the page and copied at once.
+        if (!dst->append_continuous_strings(_slices)) {
+            return Status::InternalError("append strings to column failed");
+        }
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, uint8_t* dst) override {
+        return next_slices(count, reinterpret_cast<Slice*>(dst));
+    }
+
+    Status skip(size_t count) override {
+        if (count > _lengths.size() - _index) {
+            return Status::InternalError(strings::Substitute(
+                    "going to skip out-of-bounds data, index=$0,count=$1,values=$2", _index, count, _lengths.size()));
+        }
+        for (size_t i = 0; i < count; i++) {
+            _values += _lengths[_index + i];
+        }
+        _index += count;
+        return Status::OK();
+    }
+
+    // Set |slices| to the next |count| values, which point into the page.
+    Status next_slices(size_t count, Slice* slices) {
+        if (count > _lengths.size() - _index) {
+            return Status::InternalError(strings::Substitute(
+                    "going to read out-of-bounds data, index=$0,count=$1,values=$2", _index, count, _lengths.size()));
+        }
+        for (size_t i = 0; i < count; i++) {
+            slices[i] = Slice(_values, _lengths[_index + i]);
+            _values += _lengths[_index + i];
+        }
+        _index += count;
+        return Status::OK();
+    }
+
+    size_t num_values() const { return _lengths.size(); }
+
+private:
+    DeltaBinaryPackedDecoder<int32_t> _length_decoder;
+    // Unbounded unless set_num_values() was called.
+    size_t _page_num_values = std::numeric_limits<size_t>::max();
+    std::vector<int32_t> _lengths;
+    const char* _values = nullptr;
+    size_t _index = 0;
+    std::vector<Slice> _slices;
+};
+
+// DELTA_BYTE_ARRAY stores the length of the prefix each value shares with the previous one
+// with DELTA_BINARY_PACKED, followed by the rest of the values with DELTA_LENGTH_BYTE_ARRAY.
+class DeltaByteArrayEncoder final : public Encoder {
+public:
+    DeltaByteArrayEncoder() = default;
+    ~DeltaByteArrayEncoder() override = default;
+
+    Status append(const uint8_t* vals, size_t count) override {
+        const auto* slices = reinterpret_cast<const Slice*>(vals);
+        for (size_t i = 0; i < count; i++) {
+            const Slice& value = slices[i];
+            int32_t prefix = 0;
+            size_t max_prefix = std::min(value.size, _last_value.size());
+            while (prefix < max_prefix && value.data[prefix] == _last_value[prefix]) {
+                prefix++;
+            }
+            RETURN_IF_ERROR(_prefix_lengths.append(reinterpret_cast<const uint8_t*>(&prefix), 1));
+            Slice suffix(value.data + prefix, value.size - prefix);
+            RETURN_IF_ERROR(_suffixes.append(reinterpret_cast<const uint8_t*>(&suffix), 1));
+            _last_value.assign(value.data, value.size);
+        }
+        return Status::OK();
+    }
+
+    Slice build() override {
+        Slice prefix_lengths = _prefix_lengths.build();
+        Slice suffixes = _suffixes.build();
+        _buffer.clear();
+        _buffer.append(prefix_lengths.data, prefix_lengths.size);
+        _buffer.append(suffixes.data, suffixes.size);
+        return {_buffer.data(), _buffer.size()};
+    }
+
+private:
+    DeltaBinaryPackedEncoder<int32_t> _prefix_lengths;
+    DeltaLengthByteArrayEncoder _suffixes;
+    std::string _last_value;
+    faststring _buffer;
+};
+
+class DeltaByteArrayDecoder final : public Decoder {
+public:
+    DeltaByteArrayDecoder() = default;
+    ~DeltaByteArrayDecoder() override = default;
+
+    void set_num_values(size_t num_values) override {
+        _page_num_values = num_values;
+        _suffix_decoder.set_num_values(num_values);
+    }
+
+    Status set_data(const Slice& data) override {
+        RETURN_IF_ERROR(_prefix_length_decoder.set_data(data));
+        RETURN_IF_ERROR(_prefix_length_decoder.check_num_values(_page_num_values));
+        _prefix_lengths.resize(_prefix_length_decoder.num_values());
+        RETURN_IF_ERROR(_prefix_length_decoder.decode(_prefix_lengths.size(), _prefix_lengths.data()));
+        const char* suffixes = reinterpret_cast<const char*>(_prefix_length_decoder.data_end());
+        RETURN_IF_ERROR(_suffix_decoder.set_data(Slice(suffixes, data.data + data.size - suffixes)));
+        if (_suffix_decoder.num_values() != _prefix_lengths.size()) {
+            return Status::Corruption(strings::Substitute("DELTA_BYTE_ARRAY has $0 prefixes but $1 suffixes",
+                                                          _prefix_lengths.size(), _suffix_decoder.num_values()));
+        }
+        _index = 0;
+        _last_value.clear();
+        return Status::OK();
+    }
+
+    Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) override {
+        RETURN_IF_ERROR(_decode(count));
+        if (!dst->append_continuous_strings(_slices)) {
+            return Status::InternalError("append strings to column failed");
+        }
+        return Status::OK();
+    }
+
+    // The values stay valid until the next call.
+    Status next_batch(size_t count, uint8_t* dst) override {
+        RETURN_IF_ERROR(_decode(count));
+        std::copy(_slices.begin(), _slices.end(), reinterpret_cast<Slice*>(dst));
+        return Status::OK();
+    }
+
+    // The values are rebuilt all the same, as each one may share a prefix with the previous one.
+    Status skip(size_t count) override { return _decode(count); }
+
+private:
+    // Rebuild the next |count| values adjacently in _buffer and point _slices to them.
+    Status _decode(size_t count) {
+        _slices.resize(count);
+        RETURN_IF_ERROR(_suffix_decoder.next_slices(count, _slices.data()));
+        // The first pass checks the prefixes and sizes the values.
+        size_t last_size = _last_value.size();
+        size_t total_size = 0;
+        for (size_t i = 0; i < count; i++) {
+            int32_t prefix = _prefix_lengths[_index + i];
+            if (prefix < 0 || prefix > last_size) {
+                return Status::Corruption(strings::Substitute(
+                        "DELTA_BYTE_ARRAY prefix of $0 bytes, the previous value has $1", prefix, last_size));
+            }
+            last_size = prefix + _slices[i].size;
+            total_size += last_size;
+        }
+        // The previous value of the first one is kept before the values.
+        _buffer.resize(_last_value.size() + total_size);
+        char* begin = reinterpret_cast<char*>(_buffer.data());
+        memcpy(begin, _last_value.data(), _last_value.size());
+        const char* last = begin;
+        char* pos = begin + _last_value.size();
+        for (size_t i = 0; i < count; i++) {
+            int32_t prefix = _prefix_lengths[_index + i];
+            memcpy(pos, last, prefix);
+            memcpy(pos + prefix, _slices[i].data, _slices[i].size);
+            _slices[i] = Slice(pos, prefix + _slices[i].size);
+            last = pos;
+            pos += _slices[i].size;
+        }
+        if (count > 0) {
+            _last_value.assign(_slices[count - 1].data, _slices[count - 1].size);
+        }
+        _index += count;
+        return Status::OK();
+    }
+
+    DeltaBinaryPackedDecoder<int32_t> _prefix_length_decoder;
+    size_t _page_num_values = std::numeric_limits<size_t>::max();
+    std::vector<int32_t> _prefix_lengths;
+    DeltaLengthByteArrayDecoder _suffix_decoder;
+    size_t _index = 0;
+
+    std::string _last_value;
+    faststring _buffer;
+    std::vector<Slice> _slices;
+};
+
+} // namespace starrocks::parquet
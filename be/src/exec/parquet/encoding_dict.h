@@ -70,6 +70,18 @@ private:
     faststring _buffer;
 };
 
+// Skip the next |count| codes of |decoder|, decoding them into |indexes| batch by batch.
+inline Status skip_dict_codes(RleBatchDecoder<uint32_t>* decoder, std::vector<uint32_t>* indexes, size_t count) {
+    while (count > 0) {
+        auto batch = static_cast<int32_t>(std::min(count, indexes->size()));
+        if (decoder->GetBatch(indexes->data(), batch) != batch) {
+            return Status::InternalError("going to skip out-of-bounds dict codes");
+        }
+        count -= batch;
+    }
+    return Status::OK();
+}
+
 // TODO(zc): support read run later. however should add more interface to Column first
 template <typename T>
 class DictDecoder final : public Decoder {
@@ -125,6 +137,8 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override { return skip_dict_codes(&_index_batch_decoder, &_indexes, count); }
+
 private:
     enum { SIZE_OF_TYPE = sizeof(T) };
 
@@ -228,6 +242,8 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override { return skip_dict_codes(&_index_batch_decoder, &_indexes, count); }
+
 private:
     enum { SIZE_OF_DICT_CODE_TYPE = sizeof(int32_t) };
     std::unordered_map<Slice, int32_t, SliceHasher> _dict_code_by_value;
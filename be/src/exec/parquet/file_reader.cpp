@@ -58,6 +58,21 @@ Status FileReader::get_next(vectorized::ChunkPtr* chunk) {
 }
 
 Status FileReader::_parse_footer() {
+    auto* meta_cache = _param.meta_cache;
+    if (meta_cache == nullptr) {
+        return _read_footer(&_file_metadata);
+    }
+
+    // the scanners of the other morsels of the file wait for the first one to parse the footer
+    std::lock_guard<std::mutex> l(meta_cache->mutex);
+    if (meta_cache->parquet_metadata == nullptr) {
+        RETURN_IF_ERROR(_read_footer(&meta_cache->parquet_metadata));
+    }
+    _file_metadata = meta_cache->parquet_metadata;
+    return Status::OK();
+}
+
+Status FileReader::_read_footer(std::shared_ptr<FileMetaData>* file_metadata) {
     // try
     constexpr uint64_t footer_buf_size = 16 * 1024;
 
@@ -80,8 +95,9 @@ Status FileReader::_parse_footer() {
     tparquet::FileMetaData t_metadata;
     // deserialize footer
     RETURN_IF_ERROR(deserialize_thrift_msg(footer_buf + to_read - 8 - footer_size, &footer_size, true, &t_metadata));
-    _file_metadata.reset(new FileMetaData());
-    RETURN_IF_ERROR(_file_metadata->init(t_metadata));
+    auto metadata = std::make_shared<FileMetaData>();
+    RETURN_IF_ERROR(metadata->init(t_metadata));
+    *file_metadata = std::move(metadata);
 
     return Status::OK();
 }
@@ -198,6 +214,168 @@ Status FileReader::_filter_group(const tparquet::RowGroup& row_group, bool* is_f
     return Status::OK();
 }
 
+Status FileReader::_filter_pages(const tparquet::RowGroup& row_group, vectorized::SparseRange* row_ranges) {
+    *row_ranges = vectorized::SparseRange(0, row_group.num_rows);
+    if (!config::parquet_page_index_enable || _param.min_max_conjunct_ctxs.empty()) {
+        return Status::OK();
+    }
+    // rows can only be skipped in the columns that are not repeated
+    for (const auto& column : _read_cols) {
+        const auto* field = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+        if (field->type.type == TYPE_ARRAY) {
+            return Status::OK();
+        }
+    }
+
+    SCOPED_RAW_TIMER(&_param.stats->page_index_read_ns);
+    const auto& slots = _param.min_max_tuple_desc->slots();
+    for (size_t i = 0; i < slots.size(); i++) {
+        std::vector<ExprContext*> conjunct_ctxs;
+        for (ExprContext* ctx : _param.min_max_conjunct_ctxs) {
+            std::vector<SlotId> slot_ids;
+            ctx->root()->get_slot_ids(&slot_ids);
+            if (slot_ids.size() == 1 && slot_ids[0] == slots[i]->id()) {
+                conjunct_ctxs.emplace_back(ctx);
+            }
+        }
+        if (conjunct_ctxs.empty()) {
+            continue;
+        }
+        RETURN_IF_ERROR(_filter_column_pages(row_group, i, conjunct_ctxs, row_ranges));
+        if (row_ranges->empty()) {
+            break;
+        }
+    }
+
+    _param.stats->page_index_filtered_rows += row_group.num_rows - row_ranges->span_size();
+    return Status::OK();
+}
+
+Status FileReader::_filter_column_pages(const tparquet::RowGroup& row_group, size_t slot_idx,
+                                        const std::vector<ExprContext*>& conjunct_ctxs,
+                                        vectorized::SparseRange* row_ranges) {
+    const auto* slot = _param.min_max_tuple_desc->slots()[slot_idx];
+    const ParquetField* field = _file_metadata->schema().resolve_by_name(slot->col_name());
+    if (field == nullptr || field->type.type == TYPE_ARRAY || field->type.type == TYPE_MAP ||
+        field->type.type == TYPE_STRUCT || field->max_rep_level() > 0) {
+        return Status::OK();
+    }
+
+    // the values in page index must be appended to the column of the slot as they are
+    PrimitiveType slot_type = slot->type().type;
+    bool type_matched = (field->physical_type == tparquet::Type::type::INT32 && slot_type == TYPE_INT) ||
+                        (field->physical_type == tparquet::Type::type::INT64 && slot_type == TYPE_BIGINT) ||
+                        (field->physical_type == tparquet::Type::type::BYTE_ARRAY && slot->type().is_string_type());
+    if (!type_matched) {
+        return Status::OK();
+    }
+
+    const tparquet::ColumnOrder* column_order = nullptr;
+    if (_file_metadata->t_metadata().__isset.column_orders) {
+        const auto& column_orders = _file_metadata->t_metadata().column_orders;
+        int column_idx = field->physical_column_index;
+        column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+    }
+    if (!_can_use_stats(field->physical_type, column_order)) {
+        return Status::OK();
+    }
+
+    const tparquet::ColumnChunk& column_chunk = row_group.columns[field->physical_column_index];
+    if (!column_chunk.__isset.column_index_offset || !column_chunk.__isset.column_index_length ||
+        !column_chunk.__isset.offset_index_offset || !column_chunk.__isset.offset_index_length) {
+        return Status::OK();
+    }
+
+    // read page index of the column
+    tparquet::ColumnIndex column_index;
+    tparquet::OffsetIndex offset_index;
+    {
+        std::vector<uint8_t> buffer(column_chunk.column_index_length);
+        RETURN_IF_ERROR(_file->read_at(column_chunk.column_index_offset, Slice(buffer.data(), buffer.size())));
+        uint32_t length = buffer.size();
+        Status status = deserialize_thrift_msg(buffer.data(), &length, true, &column_index);
+        if (!status.ok()) {
+            LOG(WARNING) << "Fail to deserialize column index of column " << slot->col_name() << ": "
+                         << status.to_string();
+            return Status::OK();
+        }
+
+        buffer.resize(column_chunk.offset_index_length);
+        RETURN_IF_ERROR(_file->read_at(column_chunk.offset_index_offset, Slice(buffer.data(), buffer.size())));
+        length = buffer.size();
+        status = deserialize_thrift_msg(buffer.data(), &length, true, &offset_index);
+        if (!status.ok()) {
+            LOG(WARNING) << "Fail to deserialize offset index of column " << slot->col_name() << ": "
+                         << status.to_string();
+            return Status::OK();
+        }
+    }
+
+    const auto& page_locations = offset_index.page_locations;
+    size_t num_pages = page_locations.size();
+    if (num_pages == 0 || column_index.null_pages.size() != num_pages || column_index.min_values.size() != num_pages ||
+        column_index.max_values.size() != num_pages) {
+        LOG(WARNING) << "Invalid page index of column " << slot->col_name();
+        return Status::OK();
+    }
+
+    // make min/max chunk with a row for each page
+    auto min_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, num_pages);
+    auto max_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, num_pages);
+    for (size_t i = 0; i < min_chunk->num_columns(); i++) {
+        if (i != slot_idx) {
+            min_chunk->columns()[i]->append_default(num_pages);
+            max_chunk->columns()[i]->append_default(num_pages);
+        }
+    }
+    vectorized::ColumnPtr& min_column = min_chunk->columns()[slot_idx];
+    vectorized::ColumnPtr& max_column = max_chunk->columns()[slot_idx];
+    for (size_t i = 0; i < num_pages; i++) {
+        if (column_index.null_pages[i]) {
+            min_column->append_default();
+            max_column->append_default();
+            continue;
+        }
+        Status status = _decode_min_max_value(field->physical_type, column_index.min_values[i],
+                                              column_index.max_values[i], &min_column, &max_column);
+        if (!status.ok()) {
+            LOG(WARNING) << "Fail to decode page index of column " << slot->col_name() << ": " << status.to_string();
+            return Status::OK();
+        }
+    }
+
+    // a page is filtered if it has only nulls, as min/max conjuncts reject nulls,
+    // or a conjunct is false for both the min value and the max value of it.
+    std::vector<uint8_t> selected(num_pages);
+    for (size_t i = 0; i < num_pages; i++) {
+        selected[i] = !column_index.null_pages[i];
+    }
+    {
+        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+        for (ExprContext* ctx : conjunct_ctxs) {
+            auto min_result = ctx->evaluate(min_chunk.get());
+            auto max_result = ctx->evaluate(max_chunk.get());
+            for (size_t i = 0; i < num_pages; i++) {
+                bool min_false = !min_result->is_null(i) && min_result->get(i).get_int8() == 0;
+                bool max_false = !max_result->is_null(i) && max_result->get(i).get_int8() == 0;
+                if (min_false && max_false) {
+                    selected[i] = 0;
+                }
+            }
+        }
+    }
+
+    vectorized::SparseRange page_ranges;
+    for (size_t i = 0; i < num_pages; i++) {
+        if (selected[i]) {
+            int64_t end = i + 1 < num_pages ? page_locations[i + 1].first_row_index : row_group.num_rows;
+            page_ranges.add(vectorized::Range(page_locations[i].first_row_index, end));
+        }
+    }
+    *row_ranges &= page_ranges;
+    return Status::OK();
+}
+
 Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vectorized::ChunkPtr* min_chunk,
                                        vectorized::ChunkPtr* max_chunk, bool* exist) const {
     for (size_t i = 0; i < _param.min_max_tuple_desc->slots().size(); i++) {
@@ -259,45 +437,47 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
         return Status::NotSupported("min max statistics not supported");
     }
 
-    switch (column_meta.type) {
+    const tparquet::Statistics& statistics = column_meta.statistics;
+    if (statistics.__isset.min_value) {
+        return _decode_min_max_value(column_meta.type, statistics.min_value, statistics.max_value, min_column,
+                                     max_column);
+    }
+    return _decode_min_max_value(column_meta.type, statistics.min, statistics.max, min_column, max_column);
+}
+
+Status FileReader::_decode_min_max_value(tparquet::Type::type type, const std::string& min_value,
+                                         const std::string& max_value, vectorized::ColumnPtr* min_column,
+                                         vectorized::ColumnPtr* max_column) {
+    switch (type) {
     case tparquet::Type::type::INT32: {
-        int32_t min_value = 0;
-        int32_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max, &max_value));
+        if (min_value.size() < sizeof(int32_t) || max_value.size() < sizeof(int32_t)) {
+            return Status::Corruption("invalid int32 min max value");
         }
-        (*min_column)->append_numbers(&min_value, sizeof(int32_t));
-        (*max_column)->append_numbers(&max_value, sizeof(int32_t));
+        int32_t min = 0;
+        int32_t max = 0;
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(min_value, &min));
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(max_value, &max));
+        (*min_column)->append_numbers(&min, sizeof(int32_t));
+        (*max_column)->append_numbers(&max, sizeof(int32_t));
         return Status::OK();
     }
     case tparquet::Type::type::INT64: {
-        int64_t min_value = 0;
-        int64_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max, &max_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min, &min_value));
+        if (min_value.size() < sizeof(int64_t) || max_value.size() < sizeof(int64_t)) {
+            return Status::Corruption("invalid int64 min max value");
         }
-        (*min_column)->append_numbers(&min_value, sizeof(int64_t));
-        (*max_column)->append_numbers(&max_value, sizeof(int64_t));
+        int64_t min = 0;
+        int64_t max = 0;
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(min_value, &min));
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(max_value, &max));
+        (*min_column)->append_numbers(&min, sizeof(int64_t));
+        (*max_column)->append_numbers(&max, sizeof(int64_t));
         return Status::OK();
     }
     case tparquet::Type::type::BYTE_ARRAY: {
         Slice min_slice;
         Slice max_slice;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min_value, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max_value, &max_slice));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max, &max_slice));
-        }
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(min_value, &min_slice));
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(max_value, &max_slice));
         (*min_column)->append_strings(std::vector<Slice>{min_slice});
         (*max_column)->append_strings(std::vector<Slice>{max_slice});
         return Status::OK();
@@ -343,7 +523,7 @@ bool FileReader::_is_integer_type(const tparquet::Type::type& type) {
            type == tparquet::Type::type::INT96;
 }
 
-Status FileReader::_create_and_init_group_reader(int row_group_number) {
+Status FileReader::_create_and_init_group_reader(int row_group_number, const vectorized::SparseRange& row_ranges) {
     auto row_group_reader = _row_group(row_group_number);
 
     GroupReaderParam param;
@@ -352,6 +532,9 @@ Status FileReader::_create_and_init_group_reader(int row_group_number) {
     param.read_cols = _read_cols;
     param.timezone = _param.timezone;
     param.stats = _param.stats;
+    if (row_ranges.span_size() < _file_metadata->t_metadata().row_groups[row_group_number].num_rows) {
+        param.row_ranges = row_ranges;
+    }
 
     RETURN_IF_ERROR(row_group_reader->init(param));
     _row_group_readers.emplace_back(row_group_reader);
@@ -385,7 +568,14 @@ Status FileReader::_init_group_reader() {
                 continue;
             }
 
-            RETURN_IF_ERROR(_create_and_init_group_reader(i));
+            vectorized::SparseRange row_ranges;
+            RETURN_IF_ERROR(_filter_pages(_file_metadata->t_metadata().row_groups[i], &row_ranges));
+            if (row_ranges.empty()) {
+                LOG(INFO) << "row group " << i << " of file has been filtered by page index";
+                continue;
+            }
+
+            RETURN_IF_ERROR(_create_and_init_group_reader(i, row_ranges));
 
             _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
         } else {
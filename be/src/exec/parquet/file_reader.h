@@ -34,8 +34,9 @@ public:
     Status get_next(vectorized::ChunkPtr* chunk);
 
 private:
-    // parse footer of parquet file
+    // parse footer of parquet file, or get it from the meta cache
     Status _parse_footer();
+    Status _read_footer(std::shared_ptr<FileMetaData>* file_metadata);
 
     // pre process schema columns, get the three type columns
     // (1) columns of direct read
@@ -51,7 +52,7 @@ private:
     void _filter_file();
 
     // create and inti group reader
-    Status _create_and_init_group_reader(int row_group_number);
+    Status _create_and_init_group_reader(int row_group_number, const vectorized::SparseRange& row_ranges);
 
     // create row group reader
     std::shared_ptr<GroupReader> _row_group(int i);
@@ -62,6 +63,13 @@ private:
     // filter row group by min/max conjuncts
     Status _filter_group(const tparquet::RowGroup& group, bool* is_filter);
 
+    // get the rows of pages not filtered by min/max conjuncts from page index
+    Status _filter_pages(const tparquet::RowGroup& row_group, vectorized::SparseRange* row_ranges);
+
+    // intersect |row_ranges| with the pages of the column of the slot not filtered by |conjunct_ctxs|
+    Status _filter_column_pages(const tparquet::RowGroup& row_group, size_t slot_idx,
+                                const std::vector<ExprContext*>& conjunct_ctxs, vectorized::SparseRange* row_ranges);
+
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
     // TODO: later modify the larger block should be read
@@ -94,6 +102,10 @@ private:
     static Status _decode_min_max_column(const tparquet::ColumnMetaData& column_meta,
                                          const tparquet::ColumnOrder* column_order, vectorized::ColumnPtr* min_column,
                                          vectorized::ColumnPtr* max_column);
+    // decode min/max value in plain encoding
+    static Status _decode_min_max_value(tparquet::Type::type type, const std::string& min_value,
+                                        const std::string& max_value, vectorized::ColumnPtr* min_column,
+                                        vectorized::ColumnPtr* max_column);
     static bool _can_use_min_max_stats(const tparquet::ColumnMetaData& column_meta,
                                        const tparquet::ColumnOrder* column_order);
     // statistics.min_value max_value
@@ -6,6 +6,7 @@
 #include "column/column_helper.h"
 #include "exec/exec_node.h"
 #include "exprs/expr.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/types.h"
 #include "simd/simd.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -19,10 +20,16 @@ GroupReader::GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, in
         : _file(file), _file_metadata(file_metadata), _row_group_number(row_group_number) {
     _row_group_metadata =
             std::make_shared<tparquet::RowGroup>(_file_metadata->t_metadata().row_groups[row_group_number]);
+    _row_ranges = vectorized::SparseRange(0, _row_group_metadata->num_rows);
+    _range_iter = _row_ranges.new_iterator();
 }
 
 Status GroupReader::init(const GroupReaderParam& param) {
     _param = param;
+    if (!_param.row_ranges.empty()) {
+        _row_ranges = _param.row_ranges;
+        _range_iter = _row_ranges.new_iterator();
+    }
     // the calling order matters, do not change unless you know why.
     RETURN_IF_ERROR(_init_column_readers());
     _pre_process_columns_and_conjunct_ctxs();
@@ -41,6 +48,9 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     size_t count = *row_count;
     bool has_dict_filter = !_dict_filter_preds.empty();
     bool has_more_filter = !_left_conjunct_ctxs.empty();
+    bool has_lazy_read = !_lazy_read_columns.empty();
+    // with lazy columns, filter the other columns first and record the selected rows in _selection
+    vectorized::Chunk* filter_chunk = has_lazy_read ? _active_chunk.get() : _read_chunk.get();
     Status status;
 
     {
@@ -53,18 +63,48 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
         }
     }
 
+    if (has_lazy_read) {
+        if (_selection.size() < count) {
+            raw::stl_vector_resize_uninitialized(&_selection, count);
+            raw::stl_vector_resize_uninitialized(&_lazy_selection, count);
+        }
+        memset(_selection.data(), 1, count);
+    }
+
     // dict filter
     if (has_dict_filter) {
         SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
         SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
-        _dict_filter();
-        _read_chunk->check_or_die();
+        _dict_filter(filter_chunk);
+        filter_chunk->check_or_die();
     }
 
     // other filter that not dict
     if (has_more_filter) {
         SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
-        ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get());
+        if (has_lazy_read) {
+            vectorized::FilterPtr filter;
+            ExecNode::eval_conjuncts(_left_conjunct_ctxs, filter_chunk, &filter);
+            // the filter is on the rows left by the dict filter
+            if (filter_chunk->num_rows() == 0) {
+                memset(_selection.data(), 0, count);
+            } else if (filter != nullptr) {
+                size_t filter_index = 0;
+                for (size_t i = 0; i < count; i++) {
+                    if (_selection[i]) {
+                        _selection[i] = (*filter)[filter_index++];
+                    }
+                }
+            }
+        } else {
+            ExecNode::eval_conjuncts(_left_conjunct_ctxs, filter_chunk);
+        }
+        filter_chunk->check_or_die();
+    }
+
+    if (has_lazy_read) {
+        SCOPED_RAW_TIMER(&_param.stats->group_chunk_read_ns);
+        RETURN_IF_ERROR(_read_lazy_columns());
         _read_chunk->check_or_die();
     }
 
@@ -120,6 +160,31 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
             }
         }
     }
+
+    // read the columns without conjuncts after the conjuncts filtered the rows
+    bool has_conjuncts = !_dict_filter_columns.empty() || !_left_conjunct_ctxs.empty();
+    if (!config::parquet_late_materialization_enable || !has_conjuncts || !_can_skip_rows()) {
+        return;
+    }
+    std::vector<GroupReaderParam::Column> direct_read_columns;
+    for (const auto& column : _direct_read_columns) {
+        if (conjunct_ctxs_by_slot.find(column.slot_id) != conjunct_ctxs_by_slot.end()) {
+            direct_read_columns.emplace_back(column);
+        } else {
+            _lazy_read_columns.emplace_back(column);
+        }
+    }
+    _direct_read_columns.swap(direct_read_columns);
+}
+
+bool GroupReader::_can_skip_rows() const {
+    for (const auto& column : _param.read_cols) {
+        const auto* field = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+        if (field->type.type == TYPE_ARRAY) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotIdExprContextsMap& conjunct_ctxs_by_slot,
@@ -274,59 +339,115 @@ void GroupReader::_init_read_chunk() {
         dict_code_column->reserve(chunk_size);
         _read_chunk->update_column(dict_code_column, slot_id);
     }
+
+    if (!_lazy_read_columns.empty()) {
+        // share the columns with _read_chunk
+        _active_chunk = std::make_shared<vectorized::Chunk>();
+        for (const auto& column : _dict_filter_columns) {
+            _active_chunk->append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+        }
+        for (const auto& column : _direct_read_columns) {
+            _active_chunk->append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+        }
+        raw::stl_vector_resize_uninitialized(&_lazy_selection, chunk_size);
+    }
 }
 
 Status GroupReader::_read(size_t* row_count) {
-    size_t count = *row_count;
+    _batch_ranges.clear();
+    size_t count = 0;
+    while (count < *row_count && _range_iter.has_more()) {
+        vectorized::Range range = _range_iter.next(*row_count - count);
+        RETURN_IF_ERROR(_read_range(_dict_filter_columns, ColumnContentType::DICT_CODE, range, _next_row));
+        RETURN_IF_ERROR(_read_range(_direct_read_columns, ColumnContentType::VALUE, range, _next_row));
+        _next_row = range.end();
+        _batch_ranges.emplace_back(range);
+        count += range.span_size();
+    }
 
-    for (const auto& column : _dict_filter_columns) {
-        SlotId slot_id = column.slot_id;
-        count = *row_count;
-        Status status = _column_readers[slot_id]->next_batch(&count, ColumnContentType::DICT_CODE,
-                                                             _read_chunk->get_column_by_slot_id(slot_id).get());
-        if (!status.ok() && !status.is_end_of_file()) {
-            return status;
-        }
+    *row_count = count;
+    if (!_range_iter.has_more()) {
+        return Status::EndOfFile("");
     }
+    return Status::OK();
+}
 
-    for (const auto& column : _direct_read_columns) {
+Status GroupReader::_read_range(const std::vector<GroupReaderParam::Column>& columns, ColumnContentType content_type,
+                                const vectorized::Range& range, size_t next_row) {
+    for (const auto& column : columns) {
         SlotId slot_id = column.slot_id;
-        count = *row_count;
-        Status status = _column_readers[slot_id]->next_batch(&count, ColumnContentType::VALUE,
+        if (range.begin() > next_row) {
+            RETURN_IF_ERROR(_column_readers[slot_id]->skip_records(range.begin() - next_row));
+        }
+        size_t count = range.span_size();
+        Status status = _column_readers[slot_id]->next_batch(&count, content_type,
                                                              _read_chunk->get_column_by_slot_id(slot_id).get());
         if (!status.ok() && !status.is_end_of_file()) {
             return status;
         }
+        if (count != range.span_size()) {
+            return Status::Corruption(strings::Substitute("Read $0 rows of row group $1 from row $2, expect $3", count,
+                                                          _row_group_number, range.begin(), range.span_size()));
+        }
     }
+    return Status::OK();
+}
 
-    if (count != *row_count) {
-        *row_count = count;
-        return Status::EndOfFile("");
+Status GroupReader::_read_lazy_columns() {
+    // read the rows from the first selected one to the last selected one of each range
+    size_t offset = 0;
+    size_t num_read = 0;
+    for (const auto& range : _batch_ranges) {
+        const uint8_t* selection = _selection.data() + offset;
+        size_t span_size = range.span_size();
+        offset += span_size;
+
+        size_t first = 0;
+        while (first < span_size && !selection[first]) {
+            first++;
+        }
+        if (first == span_size) {
+            continue;
+        }
+        size_t last = span_size;
+        while (!selection[last - 1]) {
+            last--;
+        }
+
+        vectorized::Range read_range(range.begin() + first, range.begin() + last);
+        RETURN_IF_ERROR(_read_range(_lazy_read_columns, ColumnContentType::VALUE, read_range, _lazy_next_row));
+        _lazy_next_row = read_range.end();
+        memcpy(_lazy_selection.data() + num_read, selection + first, last - first);
+        num_read += last - first;
     }
 
-    *row_count = count;
+    if (SIMD::count_nonzero(_lazy_selection.data(), num_read) != num_read) {
+        for (const auto& column : _lazy_read_columns) {
+            _read_chunk->get_column_by_slot_id(column.slot_id)->filter_range(_lazy_selection, 0, num_read);
+        }
+    }
     return Status::OK();
 }
 
-void GroupReader::_dict_filter() {
+void GroupReader::_dict_filter(vectorized::Chunk* chunk) {
     DCHECK(!_dict_filter_preds.empty());
 
-    size_t count = _read_chunk->num_rows();
+    size_t count = chunk->num_rows();
     auto iter = _dict_filter_preds.begin();
     SlotId slot_id = iter->first;
     auto pred = iter->second;
-    pred->evaluate(_read_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
+    pred->evaluate(chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
     while (++iter != _dict_filter_preds.end()) {
         slot_id = iter->first;
         pred = iter->second;
-        pred->evaluate_and(_read_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
+        pred->evaluate_and(chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
     }
 
     auto hit_count = SIMD::count_nonzero(_selection.data(), count);
     if (hit_count == 0) {
-        _read_chunk->set_num_rows(0);
+        chunk->set_num_rows(0);
     } else if (hit_count != count) {
-        _read_chunk->filter_range(_selection, 0, count);
+        chunk->filter_range(_selection, 0, count);
     }
 }
 
@@ -359,6 +480,11 @@ Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
         SlotId slot_id = column.slot_id;
         (*chunk)->get_column_by_slot_id(slot_id)->swap_column(*(_read_chunk->get_column_by_slot_id(slot_id)));
     }
+
+    for (const auto& column : _lazy_read_columns) {
+        SlotId slot_id = column.slot_id;
+        (*chunk)->get_column_by_slot_id(slot_id)->swap_column(*(_read_chunk->get_column_by_slot_id(slot_id)));
+    }
     return Status::OK();
 }
 } // namespace starrocks::parquet
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "gen_cpp/parquet_types.h"
 #include "runtime/descriptors.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/range.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks {
@@ -48,6 +49,9 @@ struct GroupReaderParam {
 
     std::string timezone;
 
+    // rows of the row group to read, all of them if empty
+    vectorized::SparseRange row_ranges;
+
     vectorized::HdfsScanStats* stats = nullptr;
 };
 
@@ -72,9 +76,16 @@ private:
     bool _column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata);
     Status _rewrite_dict_column_predicates();
     void _init_read_chunk();
+    // Returns true if the column readers can skip rows, which reading a part of the row group needs
+    bool _can_skip_rows() const;
 
     Status _read(size_t* row_count);
-    void _dict_filter();
+    // read |range| of the row group into |columns|, skipping the rows from |next_row|
+    Status _read_range(const std::vector<GroupReaderParam::Column>& columns, ColumnContentType content_type,
+                       const vectorized::Range& range, size_t next_row);
+    // read the lazy columns of the rows in _selection
+    Status _read_lazy_columns();
+    void _dict_filter(vectorized::Chunk* chunk);
     Status _dict_decode(vectorized::ChunkPtr* chunk);
 
     RandomAccessFile* _file;
@@ -101,12 +112,27 @@ private:
     std::vector<GroupReaderParam::Column> _dict_filter_columns;
     // direct read conlumns
     std::vector<GroupReaderParam::Column> _direct_read_columns;
+    // columns without conjuncts, read only for the rows that pass the conjuncts of the other columns
+    std::vector<GroupReaderParam::Column> _lazy_read_columns;
+
+    // rows of the row group to read
+    vectorized::SparseRange _row_ranges;
+    vectorized::SparseRangeIterator _range_iter;
+    // ranges of the rows read in the current batch
+    std::vector<vectorized::Range> _batch_ranges;
+    // next row of the dict filter and direct read columns
+    size_t _next_row = 0;
+    // next row of the lazy columns
+    size_t _lazy_next_row = 0;
 
     // dict value is empty after conjunct eval, file group can be skipped
     bool _is_group_filtered = false;
 
     vectorized::ChunkPtr _read_chunk;
+    // columns of _read_chunk that are not lazy, to eval conjuncts on
+    vectorized::ChunkPtr _active_chunk;
     vectorized::Buffer<uint8_t> _selection;
+    vectorized::Buffer<uint8_t> _lazy_selection;
 
     // param for read row group
     GroupReaderParam _param;
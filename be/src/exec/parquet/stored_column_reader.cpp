@@ -93,6 +93,8 @@ public:
         }
     }
 
+    Status skip_records(size_t num_records) override;
+
     void set_needs_levels(bool needs_levels) { _needs_levels = needs_levels; }
 
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
@@ -143,6 +145,7 @@ public:
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
+        _num_values_left_in_cur_page = _reader->num_values();
         return Status::OK();
     }
 
@@ -150,6 +153,8 @@ public:
 
     Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) override;
 
+    Status skip_records(size_t num_records) override;
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) {
         *def_levels = nullptr;
         *rep_levels = nullptr;
@@ -430,6 +435,48 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
     return Status::OK();
 }
 
+Status OptionalStoredColumnReader::skip_records(size_t num_records) {
+    DCHECK(!_needs_levels);
+    SCOPED_RAW_TIMER(&_opts.stats->column_read_ns);
+    while (num_records > 0) {
+        if (_num_values_left_in_cur_page == 0) {
+            SCOPED_RAW_TIMER(&_opts.stats->page_read_ns);
+            RETURN_IF_ERROR(_skip_pages(&num_records, &_num_values_left_in_cur_page));
+            continue;
+        }
+
+        // Only the rows that are not null have values in the page.
+        size_t records_to_skip = std::min(num_records, _num_values_left_in_cur_page);
+        size_t values_to_skip = 0;
+        {
+            SCOPED_RAW_TIMER(&_opts.stats->level_decode_ns);
+            size_t repeated_count = _reader->def_level_decoder().next_repeated_count();
+            if (repeated_count > 0) {
+                records_to_skip = std::min(records_to_skip, repeated_count);
+                level_t def_level = _reader->def_level_decoder().get_repeated_value(records_to_skip);
+                values_to_skip = def_level >= _field->max_def_level() ? records_to_skip : 0;
+            } else {
+                if (records_to_skip > _levels_capacity) {
+                    _levels_capacity = BitUtil::next_power_of_two(records_to_skip);
+                    _def_levels.resize(_levels_capacity);
+                }
+                _reader->decode_def_levels(records_to_skip, &_def_levels[0]);
+                for (size_t i = 0; i < records_to_skip; ++i) {
+                    values_to_skip += _def_levels[i] >= _field->max_def_level();
+                }
+            }
+        }
+        if (values_to_skip > 0) {
+            SCOPED_RAW_TIMER(&_opts.stats->value_decode_ns);
+            RETURN_IF_ERROR(_reader->skip_values(values_to_skip));
+        }
+
+        _num_values_left_in_cur_page -= records_to_skip;
+        num_records -= records_to_skip;
+    }
+    return Status::OK();
+}
+
 Status OptionalStoredColumnReader::_next_page() {
     do {
         RETURN_IF_ERROR(_reader->next_page());
@@ -483,6 +530,20 @@ Status RequiredStoredColumnReader::read_records(size_t* num_records, ColumnConte
     return Status::OK();
 }
 
+Status RequiredStoredColumnReader::skip_records(size_t num_records) {
+    while (num_records > 0) {
+        if (_num_values_left_in_cur_page == 0) {
+            RETURN_IF_ERROR(_skip_pages(&num_records, &_num_values_left_in_cur_page));
+            continue;
+        }
+        size_t records_to_skip = std::min(num_records, _num_values_left_in_cur_page);
+        RETURN_IF_ERROR(_reader->skip_values(records_to_skip));
+        num_records -= records_to_skip;
+        _num_values_left_in_cur_page -= records_to_skip;
+    }
+    return Status::OK();
+}
+
 Status RequiredStoredColumnReader::_next_page() {
     do {
         RETURN_IF_ERROR(_reader->next_page());
@@ -491,6 +552,24 @@ Status RequiredStoredColumnReader::_next_page() {
     return Status::OK();
 }
 
+Status StoredColumnReader::_skip_pages(size_t* num_rows, size_t* num_values_in_page) {
+    *num_values_in_page = 0;
+    while (*num_rows > 0) {
+        RETURN_IF_ERROR(_reader->next_header());
+        const tparquet::PageHeader* header = _reader->current_page_header();
+        // The values of a page are its rows as the column is not repeated.
+        if (header->type == tparquet::PageType::DATA_PAGE && header->data_page_header.num_values <= *num_rows) {
+            RETURN_IF_ERROR(_reader->skip_page());
+            *num_rows -= header->data_page_header.num_values;
+            continue;
+        }
+        RETURN_IF_ERROR(_reader->load_page());
+        *num_values_in_page = _reader->num_values();
+        break;
+    }
+    return Status::OK();
+}
+
 Status StoredColumnReader::create(RandomAccessFile* file, const ParquetField* field,
                                   const tparquet::ColumnChunk* chunk_metadata, const StoredColumnReaderOptions& opts,
                                   std::unique_ptr<StoredColumnReader>* out) {
@@ -50,6 +50,10 @@ public:
     // this function will fill (1, 2, 3, 4, 5, 6) into 'dst'.
     virtual Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) = 0;
 
+    // Skip the next |num_rows| rows. The pages having only skipped rows are not read. Only
+    // supported by the readers of columns that are not repeated.
+    virtual Status skip_records(size_t num_rows) { return Status::NotSupported("skip_records is not supported"); }
+
     // This function can only be called after calling read_values. This function returns the
     // levels for last read_values.
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
@@ -65,6 +69,11 @@ public:
     }
 
 protected:
+    // Skip the pages that only have rows of the next |*num_rows| ones, and load the page after
+    // them unless they end at a page boundary. |*num_rows| is decreased by the rows of the
+    // skipped pages, and |*num_values_in_page| is set to the values of the loaded page.
+    Status _skip_pages(size_t* num_rows, size_t* num_values_in_page);
+
     std::unique_ptr<ColumnChunkReader> _reader;
 };
 
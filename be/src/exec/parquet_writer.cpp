@@ -25,16 +25,24 @@
 #include <arrow/status.h>
 #include <time.h>
 
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "exec/file_writer.h"
+#include "exec/vectorized/starrocks_to_arrow_converter.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/broker_mgr.h"
 #include "runtime/client_cache.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/tuple.h"
+#include "util/arrow/utils.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
@@ -64,6 +72,9 @@ arrow::Status ParquetOutputStream::Tell(int64_t* position) const {
 }
 
 arrow::Status ParquetOutputStream::Close() {
+    if (_is_closed) {
+        return arrow::Status::OK();
+    }
     Status st = _file_writer->close();
     if (!st.ok()) {
         return arrow::Status::IOError(st.get_error_msg());
@@ -74,18 +85,127 @@ arrow::Status ParquetOutputStream::Close() {
 
 /// ParquetWriterWrapper
 ParquetWriterWrapper::ParquetWriterWrapper(FileWriter* file_writer, const std::vector<ExprContext*>& output_expr_ctxs)
-        : _output_expr_ctxs(output_expr_ctxs) {
-    // TODO(cmy): implement
-    _outstream = new ParquetOutputStream(file_writer);
+        : _outstream(std::make_shared<ParquetOutputStream>(file_writer)), _output_expr_ctxs(output_expr_ctxs) {}
+
+Status ParquetWriterWrapper::init() {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (size_t i = 0; i < _output_expr_ctxs.size(); i++) {
+        const TypeDescriptor& type = _output_expr_ctxs[i]->root()->type();
+        std::shared_ptr<arrow::DataType> arrow_type;
+        RETURN_IF_ERROR(vectorized::to_arrow_type(type, &arrow_type));
+        fields.push_back(arrow::field(strings::Substitute("col$0", i), arrow_type, true));
+        _columns.push_back(vectorized::ColumnHelper::create_column(type, true));
+    }
+    _schema = arrow::schema(std::move(fields));
+
+    try {
+        RETURN_IF_ERROR(to_status(parquet::arrow::FileWriter::Open(*_schema, arrow::default_memory_pool(), _outstream,
+                                                                   parquet::default_writer_properties(),
+                                                                   parquet::default_arrow_writer_properties(),
+                                                                   &_writer)));
+    } catch (const parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("open parquet writer failed: $0", e.what()));
+    }
+    _writer_thread = std::thread(&ParquetWriterWrapper::_write_row_groups, this);
+    return Status::OK();
 }
 
-Status ParquetWriterWrapper::write(const RowBatch& row_batch) {
-    // TODO(cmy): implement
+Status ParquetWriterWrapper::write(vectorized::Chunk* chunk) {
+    size_t num_rows = chunk->num_rows();
+    size_t bytes = 0;
+    for (size_t i = 0; i < _output_expr_ctxs.size(); i++) {
+        const TypeDescriptor& type = _output_expr_ctxs[i]->root()->type();
+        vectorized::ColumnPtr column = _output_expr_ctxs[i]->evaluate(chunk);
+        column = vectorized::ColumnHelper::unfold_const_column(type, num_rows, column);
+        _columns[i]->append(*column, 0, num_rows);
+        bytes += _columns[i]->byte_size();
+    }
+    _num_rows += num_rows;
+
+    if (_num_rows >= config::parquet_export_row_group_max_rows ||
+        bytes >= config::parquet_export_row_group_max_bytes) {
+        return _flush_row_group();
+    }
     return Status::OK();
 }
 
-void ParquetWriterWrapper::close() {
-    // TODO(cmy): implement
+Status ParquetWriterWrapper::_flush_row_group() {
+    if (_num_rows == 0) {
+        return Status::OK();
+    }
+    std::vector<std::shared_ptr<arrow::Array>> arrays(_columns.size());
+    for (size_t i = 0; i < _columns.size(); i++) {
+        RETURN_IF_ERROR(vectorized::convert_column_to_arrow(_output_expr_ctxs[i]->root()->type(), _columns[i],
+                                                            arrow::default_memory_pool(), &arrays[i]));
+        // The arrays own the filled columns from now on.
+        _columns[i] = _columns[i]->clone_empty();
+    }
+    auto table = arrow::Table::Make(_schema, arrays, _num_rows);
+    _num_rows = 0;
+    if (!_row_groups.blocking_put(std::move(table))) {
+        return _write_status();
+    }
+    return Status::OK();
+}
+
+void ParquetWriterWrapper::_write_row_groups() {
+    std::shared_ptr<arrow::Table> table;
+    while (_row_groups.blocking_get(&table)) {
+        Status st;
+        try {
+            // A chunk size of the number of rows writes the table as one row group.
+            st = to_status(_writer->WriteTable(*table, table->num_rows()));
+        } catch (const parquet::ParquetException& e) {
+            st = Status::InternalError(strings::Substitute("write parquet row group failed: $0", e.what()));
+        }
+        table.reset();
+        if (!st.ok()) {
+            {
+                std::lock_guard<std::mutex> l(_status_lock);
+                _status = st;
+            }
+            // Wake up and fail the thread appending chunks.
+            _row_groups.shutdown();
+            return;
+        }
+    }
+}
+
+Status ParquetWriterWrapper::_write_status() {
+    std::lock_guard<std::mutex> l(_status_lock);
+    return _status;
+}
+
+Status ParquetWriterWrapper::close() {
+    if (_closed) {
+        return Status::OK();
+    }
+    _closed = true;
+
+    Status st = _flush_row_group();
+    _row_groups.shutdown();
+    if (_writer_thread.joinable()) {
+        _writer_thread.join();
+    }
+    if (st.ok()) {
+        st = _write_status();
+    }
+    if (_writer != nullptr) {
+        try {
+            Status close_st = to_status(_writer->Close());
+            st = st.ok() ? close_st : st;
+        } catch (const parquet::ParquetException& e) {
+            st = st.ok() ? Status::InternalError(strings::Substitute("close parquet writer failed: $0", e.what())) : st;
+        }
+    }
+    Status close_st = to_status(_outstream->Close());
+    return st.ok() ? close_st : st;
+}
+
+int64_t ParquetWriterWrapper::written_len() const {
+    int64_t position = 0;
+    _outstream->Tell(&position);
+    return position;
 }
 
 ParquetWriterWrapper::~ParquetWriterWrapper() {
@@ -33,19 +33,23 @@
 #include <parquet/exception.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
+#include "column/vectorized_fwd.h"
 #include "common/status.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gen_cpp/Types_types.h"
+#include "util/blocking_queue.hpp"
 
 namespace starrocks {
 
 class ExprContext;
 class FileWriter;
-class RowBatch;
 
 class ParquetOutputStream : public arrow::io::OutputStream {
 public:
@@ -61,23 +65,51 @@ public:
 
 private:
     FileWriter* _file_writer; // not owned
-    int64_t _cur_pos = 0;     // current write position
+    // written by the thread encoding row groups, read by the one appending chunks
+    std::atomic<int64_t> _cur_pos{0}; // current write position
     bool _is_closed = false;
 };
 
-// a wrapper of parquet output stream
+// Write chunks to a parquet file.
+// The output columns of the chunks are appended to the columns of a row group. Once the row
+// group is full, its columns are converted to Arrow arrays sharing their memory and handed to
+// a thread which encodes and writes it, while the next row group is filled.
 class ParquetWriterWrapper {
 public:
     ParquetWriterWrapper(FileWriter* file_writer, const std::vector<ExprContext*>& output_expr_ctxs);
     virtual ~ParquetWriterWrapper();
 
-    Status write(const RowBatch& row_batch);
+    Status init();
 
-    void close();
+    Status write(vectorized::Chunk* chunk);
+
+    // Write the buffered rows and the footer, and close the file writer.
+    Status close();
+
+    // Bytes written to the file, the rows being buffered or encoded are not counted yet.
+    int64_t written_len() const;
 
 private:
-    ParquetOutputStream* _outstream;
+    Status _flush_row_group();
+    void _write_row_groups();
+    Status _write_status();
+
+    std::shared_ptr<ParquetOutputStream> _outstream;
     const std::vector<ExprContext*>& _output_expr_ctxs;
+    std::shared_ptr<arrow::Schema> _schema;
+    std::unique_ptr<parquet::arrow::FileWriter> _writer;
+
+    // the row group being filled
+    vectorized::Columns _columns;
+    size_t _num_rows = 0;
+
+    // Full row groups waiting for the writer thread. One of them is encoded while the next
+    // one is filled, more would only hold memory.
+    BlockingQueue<std::shared_ptr<arrow::Table>> _row_groups{1};
+    std::thread _writer_thread;
+    std::mutex _status_lock;
+    Status _status;
+    bool _closed = false;
 };
 
 } // namespace starrocks
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <memory>
 
+#include "column/column_encoder.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exprs/expr.h"
 #include "gen_cpp/Types_types.h"
@@ -77,6 +78,8 @@ public:
 
     TUniqueId get_fragment_instance_id() { return _fragment_instance_id; }
 
+    const PUniqueId& finst_id() const { return _finst_id; }
+
 private:
     Status _close_internal();
 
@@ -94,6 +97,8 @@ private:
 
     PBackendService_Stub* _brpc_stub = nullptr;
 
+    // Chunks batched until there are enough bytes to send a request.
+    PTransmitChunkParams _chunk_request;
     size_t _current_request_bytes = 0;
 
     bool _is_inited = false;
@@ -143,15 +148,9 @@ Status ExchangeSinkOperator::Channel::add_rows_selective(vectorized::Chunk* chun
 }
 
 Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* chunk, bool eos) {
-    PTransmitChunkParams request;
-    request.set_allocated_finst_id(&_finst_id);
-    request.set_node_id(_dest_node_id);
-    request.set_sender_id(_parent->_sender_id);
-    request.set_be_number(_parent->_be_number);
-
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
-        auto pchunk = request.add_chunks();
+        auto pchunk = _chunk_request.add_chunks();
         RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk));
         _current_request_bytes += pchunk->data().size();
     }
@@ -159,34 +158,37 @@ Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* ch
     // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
     // last packet
     if (_current_request_bytes > _parent->_request_bytes_threshold || eos) {
-        request.set_eos(eos);
-        TransmitChunkInfo info = {std::move(request), _brpc_stub};
-        _parent->_buffer->add_request(info);
+        TransmitChunkInfo info = {std::move(_chunk_request), _brpc_stub};
+        _chunk_request.Clear();
+        info.params.mutable_finst_id()->CopyFrom(_finst_id);
+        info.params.set_node_id(_dest_node_id);
+        info.params.set_sender_id(_parent->_sender_id);
+        info.params.set_be_number(_parent->_be_number);
+        info.params.set_eos(eos);
+        _parent->_buffer->add_request(std::move(info));
         _current_request_bytes = 0;
-        // The original design is bad, we must release_finst_id here!
-        info.params.release_finst_id();
     }
 
     return Status::OK();
 }
 
 Status ExchangeSinkOperator::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
-    params->set_allocated_finst_id(&_finst_id);
-    params->set_node_id(_dest_node_id);
-    params->set_sender_id(_parent->_sender_id);
-    params->set_be_number(_parent->_be_number);
-
-    params->set_eos(false);
-    TransmitChunkInfo info = {std::move(*params), _brpc_stub};
-    _parent->_buffer->add_request(info);
-
-    // The original design is bad, we must release_finst_id here!
-    info.params.release_finst_id();
-
+    // |params| is shared by all the channels, every destination gets its own copy.
+    TransmitChunkInfo info = {*params, _brpc_stub};
+    info.params.mutable_finst_id()->CopyFrom(_finst_id);
+    info.params.set_node_id(_dest_node_id);
+    info.params.set_sender_id(_parent->_sender_id);
+    info.params.set_be_number(_parent->_be_number);
+    info.params.set_eos(false);
+    _parent->_buffer->add_request(std::move(info));
     return Status::OK();
 }
 
 Status ExchangeSinkOperator::Channel::_close_internal() {
+    if (_fragment_instance_id.lo == -1) {
+        // dest bucket is no used, there is no one to receive eos
+        return Status::OK();
+    }
     RETURN_IF_ERROR(send_one_chunk(nullptr, true));
     return Status::OK();
 }
@@ -231,6 +233,7 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
         _compress_type = CompressionTypePB::LZ4;
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    _encode_columns = config::exchange_column_encoding;
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -272,8 +275,17 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
             "OverallThroughput", TUnit::BYTES_PER_SECOND,
             std::bind<int64_t>(&RuntimeProfile::units_per_second, _bytes_sent_counter, profile()->total_time_counter()),
             "");
+    _network_blocked_timer = ADD_TIMER(profile(), "NetworkBlockedTime");
     for (int i = 0; i < _channels.size(); ++i) {
         RETURN_IF_ERROR(_channels[i]->init(state));
+        // Every channel sends eos once on finish, including the duplicated ones.
+        if (_channels[i]->get_fragment_instance_id().lo != -1) {
+            _buffer->register_sinker(_channels[i]->finst_id());
+        }
+    }
+    if (_part_type == TPartitionType::HASH_PARTITIONED ||
+        _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) {
+        _skew_monitor.init(profile(), _channels.size());
     }
 
     // set eos for all channels.
@@ -289,7 +301,25 @@ bool ExchangeSinkOperator::is_finished() const {
 }
 
 bool ExchangeSinkOperator::need_input() {
-    return !_is_finished && !_buffer->is_full();
+    if (_is_finished) {
+        return false;
+    }
+    bool is_full = false;
+    for (const auto& channel : _channels) {
+        if (channel->get_fragment_instance_id().lo != -1 && _buffer->is_full(channel->finst_id())) {
+            is_full = true;
+            break;
+        }
+    }
+    // Account the time this sink has been blocked by the network, from the first time it
+    // reports full until the sink buffer has room again.
+    if (is_full) {
+        _network_blocked_watch.start();
+    } else {
+        _network_blocked_watch.stop();
+        COUNTER_SET(_network_blocked_timer, static_cast<int64_t>(_network_blocked_watch.elapsed_time()));
+    }
+    return !is_full;
 }
 
 StatusOr<vectorized::ChunkPtr> ExchangeSinkOperator::pull_chunk(RuntimeState* state) {
@@ -328,6 +358,8 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
                 }
             }
 
+            _skew_monitor.sample(_hash_values.data(), num_rows);
+
             // Compute row indexes for each channel
             _channel_row_idx_start_points.assign(num_channels + 1, 0);
             for (uint16_t i = 0; i < num_rows; ++i) {
@@ -347,6 +379,7 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
             }
         }
 
+        int64_t row_bytes = _skew_monitor.enabled() ? chunk->bytes_usage() / num_rows : 0;
         for (int i = 0; i < num_channels; ++i) {
             size_t from = _channel_row_idx_start_points[i];
             size_t size = _channel_row_idx_start_points[i + 1] - from;
@@ -354,6 +387,7 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
                 // no data for this channel continue;
                 continue;
             }
+            _skew_monitor.add_rows(i, size, size * row_bytes);
 
             if (_channels[i]->get_fragment_instance_id().lo == -1) {
                 // dest bucket is no used, continue
@@ -395,6 +429,7 @@ void ExchangeSinkOperator::finish(RuntimeState* state) {
 
 Status ExchangeSinkOperator::close(RuntimeState* state) {
     ScopedTimer<MonotonicStopWatch> close_timer(_profile != nullptr ? _profile->total_time_counter() : nullptr);
+    _skew_monitor.close();
     Expr::close(_partition_expr_ctxs, state);
     Operator::close(state);
     return _close_status;
@@ -409,12 +444,17 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
         dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            uncompressed_size = src->serialize_with_meta(dst);
+            src->serialize_meta(dst);
             *is_first_chunk = false;
         } else {
             dst->clear_is_nulls();
             dst->clear_is_consts();
             dst->clear_slot_id_map();
+        }
+        if (_encode_columns) {
+            uncompressed_size = vectorized::ColumnEncoder::encode_chunk(*src, &_encode_buffer);
+            dst->mutable_data()->assign(reinterpret_cast<const char*>(_encode_buffer.data()), uncompressed_size);
+        } else {
             uncompressed_size = src->serialize_size();
             // TODO(kks): resize without initializing the new bytes
             dst->mutable_data()->resize(uncompressed_size);
@@ -429,7 +469,7 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
 
     dst->set_uncompressed_size(uncompressed_size);
     // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    if (_compress_codec != nullptr && uncompressed_size > 0 && _compress_policy.should_compress()) {
         SCOPED_TIMER(_compress_timer);
 
         // Try compressing data to _compression_scratch, swap if compressed data is smaller
@@ -442,6 +482,7 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
         Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
         _compress_codec->compress(dst->data(), &compressed_slice);
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
+        _compress_policy.update(compress_ratio);
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
             _compression_scratch.resize(compressed_slice.size);
             dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
@@ -468,7 +509,6 @@ void ExchangeSinkOperator::construct_brpc_attachment(PTransmitChunkParams* param
 }
 
 OperatorPtr ExchangeSinkOperatorFactory::create(int32_t driver_instance_count, int32_t driver_sequence) {
-    _buffer->set_sinker_number(driver_instance_count);
     if (_part_type == TPartitionType::UNPARTITIONED || _destinations.size() == 1) {
         return std::make_shared<ExchangeSinkOperator>(_id, _plan_node_id, _buffer, _part_type, _destinations,
                                                       _sender_id, _dest_node_id, _partition_expr_ctxs);
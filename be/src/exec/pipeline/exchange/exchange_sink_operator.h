@@ -10,6 +10,9 @@
 #include "exec/pipeline/operator.h"
 #include "gen_cpp/data.pb.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "runtime/shuffle_skew_monitor.h"
+#include "util/compression_utils.h"
+#include "util/faststring.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -88,6 +91,12 @@ private:
     // to (we don't compress directly into the ChunkPB in case the compressed data is
     // longer than the uncompressed data).
     raw::RawString _compression_scratch;
+    // Skips compression while the exchanged data turns out to be incompressible.
+    AdaptiveCompressionPolicy _compress_policy;
+    // Whether to encode columns with ColumnEncoder, fixed at prepare so all chunks of a
+    // stream use the same format.
+    bool _encode_columns = false;
+    faststring _encode_buffer;
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
@@ -106,6 +115,9 @@ private:
 
     RuntimeProfile::Counter* _send_request_timer{};
     RuntimeProfile::Counter* _wait_response_timer{};
+    // Time this sink has been blocked because the sink buffer of a destination was full
+    RuntimeProfile::Counter* _network_blocked_timer{};
+    MonotonicStopWatch _network_blocked_watch;
     // Throughput per total time spent in sender
     RuntimeProfile::Counter* _overall_throughput{};
 
@@ -126,6 +138,7 @@ private:
     // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
     // the last.
     std::vector<uint32_t> _row_indexes;
+    ShuffleSkewMonitor _skew_monitor;
 };
 
 class ExchangeSinkOperatorFactory final : public OperatorFactory {
@@ -0,0 +1,139 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include "common/config.h"
+#include "exec/pipeline/pipeline_driver_dispatcher.h"
+
+namespace starrocks::pipeline {
+
+SinkBuffer::~SinkBuffer() {
+    std::unique_lock<std::mutex> l(_mutex);
+    _rpc_finished_cv.wait(l, [this] { return _num_in_flight_rpcs == 0; });
+}
+
+void SinkBuffer::register_sinker(const PUniqueId& instance_id) {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto& dest = _destinations[instance_id.lo()];
+    if (dest == nullptr) {
+        dest = std::make_unique<Destination>();
+    }
+    dest->num_sinkers++;
+}
+
+void SinkBuffer::add_request(TransmitChunkInfo&& request) {
+    if (_is_cancelled) {
+        return;
+    }
+    int64_t bytes = _request_bytes(request);
+    Destination* dest = nullptr;
+    TransmitChunkInfo next;
+    bool send = false;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto iter = _destinations.find(request.params.finst_id().lo());
+        DCHECK(iter != _destinations.end());
+        dest = iter->second.get();
+        if (request.params.eos()) {
+            // Only the last sinker of a destination sends eos, because eos can only be sent once.
+            if (++dest->num_eos < dest->num_sinkers) {
+                if (request.params.chunks_size() == 0) {
+                    return;
+                }
+                request.params.set_eos(false);
+            }
+        }
+        _num_pending_requests++;
+        dest->queued_bytes += bytes;
+        dest->requests.emplace_back(std::move(request));
+        if (!dest->in_flight) {
+            send = _pop_request(dest, &next);
+            DCHECK(send);
+            _num_in_flight_rpcs++;
+        }
+    }
+    if (send) {
+        _send_rpc(dest, std::move(next));
+    }
+}
+
+bool SinkBuffer::is_full(const PUniqueId& instance_id) const {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto iter = _destinations.find(instance_id.lo());
+    if (iter == _destinations.end()) {
+        return false;
+    }
+    return iter->second->queued_bytes > config::pipeline_sink_buffer_bytes_per_destination;
+}
+
+int64_t SinkBuffer::_request_bytes(const TransmitChunkInfo& request) {
+    int64_t bytes = 0;
+    for (const auto& chunk : request.params.chunks()) {
+        bytes += chunk.data().size();
+    }
+    return bytes;
+}
+
+bool SinkBuffer::_pop_request(Destination* dest, TransmitChunkInfo* request) {
+    if (dest->requests.empty()) {
+        return false;
+    }
+    *request = std::move(dest->requests.front());
+    dest->requests.pop_front();
+    dest->queued_bytes -= _request_bytes(*request);
+    dest->in_flight = true;
+    // Sequences are per destination, the receiver drops packets that are not increasing.
+    request->params.set_sequence(dest->sequence++);
+    return true;
+}
+
+void SinkBuffer::_send_rpc(Destination* dest, TransmitChunkInfo&& request) {
+    auto* closure = new CallBackClosure<PTransmitChunkResult>();
+    closure->ref();
+    closure->addFailedHandler([this, dest]() {
+        LOG(WARNING) << " transmit chunk rpc failed, ";
+        _on_rpc_finished(dest, false);
+    });
+    closure->addSuccessHandler([this, dest](const PTransmitChunkResult& result) {
+        Status status(result.status());
+        if (!status.ok()) {
+            LOG(WARNING) << " transmit chunk rpc failed, " << status.to_string();
+        }
+        _on_rpc_finished(dest, status.ok());
+    });
+    closure->cntl.set_timeout_ms(500);
+    request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
+}
+
+void SinkBuffer::_on_rpc_finished(Destination* dest, bool ok) {
+    if (!ok) {
+        _is_cancelled = true;
+    }
+    _num_pending_requests--;
+
+    TransmitChunkInfo next;
+    bool send = false;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        dest->in_flight = false;
+        if (!_is_cancelled) {
+            send = _pop_request(dest, &next);
+        }
+    }
+    // The destination has room again, wake up the sink operators blocked on it.
+    if (_dispatcher != nullptr) {
+        _dispatcher->notify_blocked_drivers();
+    }
+
+    if (send) {
+        // Keep the destination busy, the in-flight RPC count is handed over to the next request.
+        // Nothing of this buffer may be touched afterwards, it can be destroyed once that RPC finishes.
+        _send_rpc(dest, std::move(next));
+    } else {
+        std::lock_guard<std::mutex> l(_mutex);
+        _num_in_flight_rpcs--;
+        _rpc_finished_cv.notify_all();
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -2,118 +2,87 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include "column/chunk.h"
 #include "gen_cpp/BackendService.h"
-#include "util/blocking_queue.hpp"
 #include "util/brpc_stub_cache.h"
 #include "util/callback_closure.h"
 
 namespace starrocks::pipeline {
 
+class DriverDispatcher;
+
 struct TransmitChunkInfo {
     PTransmitChunkParams params;
     PBackendService_Stub* brpc_stub;
 };
 
+// SinkBuffer is shared by all the ExchangeSinkOperators of a fragment instance and sends
+// their requests to the destination fragment instances.
+//
+// Every destination has its own queue and at most one transmit_chunk RPC in flight, which
+// keeps the packets of a destination in sequence order. Requests are sent directly from
+// add_request() when the destination is idle, otherwise from the completion callback of
+// the previous RPC. A destination is full once the bytes queued for it exceed
+// config::pipeline_sink_buffer_bytes_per_destination; the sink operators writing to it
+// then block and are woken up through the driver poller when an RPC completes, instead
+// of polling the buffer.
 class SinkBuffer {
 public:
-    SinkBuffer(size_t channel_number) : _closure_size(channel_number) {
-        for (size_t i = 0; i < channel_number; ++i) {
-            auto _chunk_closure = new CallBackClosure<PTransmitChunkResult>();
-            _chunk_closure->ref();
-            _chunk_closure->addFailedHandler([this]() {
-                _in_flight_rpc_num--;
-                _is_cancelled = true;
-                LOG(WARNING) << " transmit chunk rpc failed, ";
-            });
-
-            _chunk_closure->addSuccessHandler([this](const PTransmitChunkResult& result) {
-                _in_flight_rpc_num--;
-                Status status(result.status());
-                if (!status.ok()) {
-                    _is_cancelled = true;
-                    LOG(WARNING) << " transmit chunk rpc failed, ";
-                }
-            });
-            _closures.push_back(_chunk_closure);
-        }
-
-        _thread = std::thread{&SinkBuffer::process, this};
-    }
-
-    ~SinkBuffer() {
-        _pending_chunks.shutdown();
-        _thread.join();
-        for (auto* closure : _closures) {
-            if (closure->unref()) {
-                delete closure;
-            }
-        }
-    }
-
-    void add_request(TransmitChunkInfo request) {
-        _in_flight_rpc_num++;
-        _pending_chunks.put(request);
-    }
-
-    void process() {
-        while (true) {
-            // If the head closure has flight rpc, means all closures are busy
-            if (_closures.front()->has_in_flight_rpc()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                continue;
-            }
-
-            TransmitChunkInfo info;
-            if (!_pending_chunks.blocking_get(&info)) {
-                break;
-            }
-            _send_rpc(info);
-
-            // The original design is bad, we must release_finst_id here!
-            info.params.release_finst_id();
-        }
-    }
-
-    bool is_full() const { return _in_flight_rpc_num >= _closure_size; }
-
-    bool is_finished() const { return _in_flight_rpc_num == 0 || _is_cancelled; }
+    explicit SinkBuffer(DriverDispatcher* dispatcher) : _dispatcher(dispatcher) {}
 
-    bool is_cancelled() const { return _is_cancelled; }
+    // Wait for the in-flight RPCs, their callbacks refer to this buffer.
+    ~SinkBuffer();
+
+    // Called by every sink operator for each of its channels, so that the buffer knows how
+    // many eos packets to expect from the sinkers of a destination. Must be done before
+    // any request is added.
+    void register_sinker(const PUniqueId& instance_id);
 
-    void set_sinker_number(int64_t sinker_number) { _sinker_number = sinker_number; }
+    // |request| must have its finst_id set.
+    void add_request(TransmitChunkInfo&& request);
+
+    bool is_full(const PUniqueId& instance_id) const;
+
+    bool is_finished() const { return _num_pending_requests == 0 || _is_cancelled; }
+
+    bool is_cancelled() const { return _is_cancelled; }
 
 private:
-    void _send_rpc(TransmitChunkInfo& request) {
-        if (request.params.eos()) {
-            // Only send eos for last sinker, because we could only send eos once
-            if (--_sinker_number > 0) {
-                _in_flight_rpc_num--;
-                return;
-            }
-        }
-        request.params.set_sequence(_request_seq);
-        auto* closure = _closures.front();
-        DCHECK(!closure->has_in_flight_rpc());
-        // Move the closure has flight rpc to tail
-        _closures.pop_front();
-        _closures.push_back(closure);
-        closure->ref();
-        closure->cntl.Reset();
-        closure->cntl.set_timeout_ms(500);
-        request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
-        _request_seq++;
-    }
-
-    // To avoid lock
-    const int32_t _closure_size;
-    int64_t _request_seq = 0;
-    int64_t _sinker_number = 0;
-    std::atomic<int32_t> _in_flight_rpc_num = 0;
+    struct Destination {
+        std::deque<TransmitChunkInfo> requests;
+        // Bytes of chunk data in |requests|, read without lock by is_full().
+        std::atomic<int64_t> queued_bytes{0};
+        bool in_flight = false;
+        int64_t sequence = 0;
+        int32_t num_sinkers = 0;
+        int32_t num_eos = 0;
+    };
+
+    static int64_t _request_bytes(const TransmitChunkInfo& request);
+
+    // Pop the next request of |dest| to send. Must hold _mutex.
+    bool _pop_request(Destination* dest, TransmitChunkInfo* request);
+    void _send_rpc(Destination* dest, TransmitChunkInfo&& request);
+    void _on_rpc_finished(Destination* dest, bool ok);
+
+    DriverDispatcher* _dispatcher;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _rpc_finished_cv;
+    // Keyed by the lo part of the fragment instance id, the same as the sink channels.
+    std::unordered_map<int64_t, std::unique_ptr<Destination>> _destinations;
+    int32_t _num_in_flight_rpcs = 0;
+
+    // Requests added but not yet acknowledged by their destination.
+    std::atomic<int64_t> _num_pending_requests{0};
     std::atomic<bool> _is_cancelled{false};
-    std::deque<CallBackClosure<PTransmitChunkResult>*> _closures;
-    std::thread _thread;
-    UnboundedBlockingQueue<TransmitChunkInfo> _pending_chunks;
 };
 
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
@@ -102,6 +102,10 @@ void GlobalDriverDispatcher::dispatch(DriverPtr driver) {
     this->_driver_queue->put_back(driver);
 }
 
+void GlobalDriverDispatcher::notify_blocked_drivers() {
+    _blocked_driver_poller->notify();
+}
+
 void GlobalDriverDispatcher::report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done,
                                                bool clean) {
     this->_exec_state_reporter->submit(fragment_ctx, status, done, clean);
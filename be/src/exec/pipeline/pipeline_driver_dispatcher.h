@@ -29,6 +29,10 @@ public:
     virtual void change_num_threads(int32_t num_threads) {}
     virtual void dispatch(DriverPtr driver){};
 
+    // Notify that some blocked drivers may be able to make progress, e.g. a sink buffer
+    // has room again after an RPC completed.
+    virtual void notify_blocked_drivers() {}
+
     // When all the root drivers (the drivers have no successors in the same fragment) have finished,
     // just notify FE timely the completeness of fragment via invocation of report_exec_state, but
     // the FragmentContext is not unregistered until all the drivers has finished, because some
@@ -49,6 +53,7 @@ public:
     void initialize(int32_t num_threads) override;
     void change_num_threads(int32_t num_threads) override;
     void dispatch(DriverPtr driver) override;
+    void notify_blocked_drivers() override;
     void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean) override;
 
 private:
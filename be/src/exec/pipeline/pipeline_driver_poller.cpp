@@ -2,12 +2,17 @@
 
 #include "pipeline_driver_poller.h"
 
-#include <emmintrin.h>
-
+#include <algorithm>
 #include <chrono>
+
+#include "common/config.h"
 namespace starrocks {
 namespace pipeline {
 
+// The first sleep of the poller when no blocked driver makes progress, doubled on every
+// idle round up to config::pipeline_poller_idle_wait_us.
+static constexpr int64_t kMinIdleWaitUs = 10;
+
 void PipelineDriverPoller::start() {
     DCHECK(this->_polling_thread == nullptr);
     auto status = Thread::create(
@@ -28,7 +33,7 @@ void PipelineDriverPoller::run_internal() {
     this->_polling_thread = Thread::current_thread();
     this->_is_polling_thread_initialized.store(true, std::memory_order_release);
     typeof(this->_blocked_drivers) local_blocked_drivers;
-    int spin_count = 0;
+    int64_t idle_wait_us = kMinIdleWaitUs;
     while (!_is_shutdown.load(std::memory_order_acquire)) {
         {
             std::unique_lock<std::mutex> lock(this->_mutex);
@@ -66,22 +71,29 @@ void PipelineDriverPoller::run_internal() {
                 ++driver_it;
             }
         }
-        size_t curr_num_blocked_drivers = local_blocked_drivers.size();
-        if (curr_num_blocked_drivers == previous_num_blocked_drivers) {
-            spin_count += 1;
-        } else {
-            spin_count = 0;
-        }
-        if (spin_count != 0 && spin_count % 64 == 0) {
-            _mm_pause();
-        }
-        if (spin_count != 0 && spin_count == 640) {
-            spin_count = 0;
-            sched_yield();
+        if (local_blocked_drivers.size() != previous_num_blocked_drivers) {
+            idle_wait_us = kMinIdleWaitUs;
+            continue;
         }
+        // Nothing changed, sleep until a new driver is blocked or notify() is called. Not every
+        // blocked driver has someone to notify the poller, so the sleep is bounded and backs off.
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        _cond.wait_for(lock, std::chrono::microseconds(idle_wait_us), [this]() {
+            return _is_notified || !_blocked_drivers.empty() || _is_shutdown.load(std::memory_order_acquire);
+        });
+        _is_notified = false;
+        idle_wait_us = std::min<int64_t>(idle_wait_us * 2, config::pipeline_poller_idle_wait_us);
     }
 }
 
+void PipelineDriverPoller::notify() {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        _is_notified = true;
+    }
+    this->_cond.notify_one();
+}
+
 void PipelineDriverPoller::add_blocked_driver(DriverPtr driver) {
     std::unique_lock<std::mutex> lock(this->_mutex);
     this->_blocked_drivers.push_back(driver);
@@ -31,6 +31,9 @@ public:
     void shutdown();
     // add blocked driver to poller
     void add_blocked_driver(DriverPtr driver);
+    // wake up the poller to re-check the blocked drivers, e.g. when an RPC of a sink
+    // buffer finished.
+    void notify();
 
 private:
     void run_internal();
@@ -45,6 +48,8 @@ private:
     Thread* _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
     std::atomic<bool> _is_shutdown;
+    // Set by notify(), guarded by _mutex.
+    bool _is_notified = false;
 };
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
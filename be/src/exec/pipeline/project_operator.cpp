@@ -2,6 +2,8 @@
 
 #include "exec/pipeline/project_operator.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
@@ -19,6 +21,7 @@ Status ProjectOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Expr::open(_expr_ctxs, state));
     RETURN_IF_ERROR(Expr::open(_common_sub_expr_ctxs, state));
 
+    _saved_evaluations_counter = ADD_COUNTER(_runtime_profile, "CommonSubExprSavedEvaluations", TUnit::UNIT);
     return Status::OK();
 }
 
@@ -37,12 +40,20 @@ Status ProjectOperator::push_chunk(RuntimeState* state, const vectorized::ChunkP
     for (size_t i = 0; i < _common_sub_column_ids.size(); ++i) {
         chunk->append_column(_common_sub_expr_ctxs[i]->evaluate(chunk.get()), _common_sub_column_ids[i]);
     }
+    COUNTER_UPDATE(_saved_evaluations_counter, _num_saved_evaluations);
 
     using namespace vectorized;
     vectorized::Columns result_columns(_column_ids.size());
+    std::vector<const Column*> evaluated(_column_ids.size());
     {
         for (size_t i = 0; i < _column_ids.size(); ++i) {
             result_columns[i] = _expr_ctxs[i]->evaluate(chunk.get());
+            evaluated[i] = result_columns[i].get();
+            // The outputs referring to the same common sub-expression get the same column,
+            // which must not be shared by the result columns.
+            if (std::find(evaluated.begin(), evaluated.begin() + i, evaluated[i]) != evaluated.begin() + i) {
+                result_columns[i] = result_columns[i]->clone_shared();
+            }
 
             if (result_columns[i]->only_null()) {
                 result_columns[i] = ColumnHelper::create_column(_expr_ctxs[i]->root()->type(), true);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "exec/pipeline/operator.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 class ExprContext;
@@ -12,13 +13,14 @@ public:
     ProjectOperator(int32_t id, int32_t plan_node_id, std::vector<int32_t>& column_ids,
                     const std::vector<ExprContext*>& expr_ctxs, const std::vector<bool>& type_is_nullable,
                     const std::vector<int32_t>& common_sub_column_ids,
-                    const std::vector<ExprContext*>& common_sub_expr_ctxs)
+                    const std::vector<ExprContext*>& common_sub_expr_ctxs, int64_t num_saved_evaluations)
             : Operator(id, "project", plan_node_id),
               _column_ids(column_ids),
               _expr_ctxs(expr_ctxs),
               _type_is_nullable(type_is_nullable),
               _common_sub_column_ids(common_sub_column_ids),
-              _common_sub_expr_ctxs(common_sub_expr_ctxs) {}
+              _common_sub_expr_ctxs(common_sub_expr_ctxs),
+              _num_saved_evaluations(num_saved_evaluations) {}
 
     ~ProjectOperator() override = default;
 
@@ -45,6 +47,8 @@ private:
 
     const std::vector<int32_t>& _common_sub_column_ids;
     const std::vector<ExprContext*>& _common_sub_expr_ctxs;
+    const int64_t _num_saved_evaluations;
+    RuntimeProfile::Counter* _saved_evaluations_counter = nullptr;
 
     bool _is_finished = false;
     vectorized::ChunkPtr _cur_chunk = nullptr;
@@ -55,19 +59,20 @@ public:
     ProjectOperatorFactory(int32_t id, int32_t plan_node_id, std::vector<int32_t>&& column_ids,
                            std::vector<ExprContext*>&& expr_ctxs, std::vector<bool>&& type_is_nullable,
                            std::vector<int32_t>&& common_sub_column_ids,
-                           std::vector<ExprContext*>&& common_sub_expr_ctxs)
+                           std::vector<ExprContext*>&& common_sub_expr_ctxs, int64_t num_saved_evaluations = 0)
             : OperatorFactory(id, plan_node_id),
               _column_ids(std::move(column_ids)),
               _expr_ctxs(std::move(expr_ctxs)),
               _type_is_nullable(std::move(type_is_nullable)),
               _common_sub_column_ids(std::move(common_sub_column_ids)),
-              _common_sub_expr_ctxs(std::move(common_sub_expr_ctxs)) {}
+              _common_sub_expr_ctxs(std::move(common_sub_expr_ctxs)),
+              _num_saved_evaluations(num_saved_evaluations) {}
 
     ~ProjectOperatorFactory() override = default;
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
         return std::make_shared<ProjectOperator>(_id, _plan_node_id, _column_ids, _expr_ctxs, _type_is_nullable,
-                                                 _common_sub_column_ids, _common_sub_expr_ctxs);
+                                                 _common_sub_column_ids, _common_sub_expr_ctxs, _num_saved_evaluations);
     }
 
 private:
@@ -77,6 +82,7 @@ private:
 
     std::vector<int32_t> _common_sub_column_ids;
     std::vector<ExprContext*> _common_sub_expr_ctxs;
+    int64_t _num_saved_evaluations;
 };
 
 } // namespace pipeline
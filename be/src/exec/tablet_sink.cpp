@@ -38,6 +38,7 @@
 #include "service/brpc.h"
 #include "simd/simd.h"
 #include "storage/hll.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
 #include "util/monotime.h"
 #include "util/uid_util.h"
@@ -101,6 +102,9 @@ Status NodeChannel::init(RuntimeState* state) {
         _cur_add_chunk_request.set_sender_id(_parent->_sender_id);
         _cur_add_chunk_request.set_eos(false);
         _cur_chunk = std::make_unique<vectorized::Chunk>();
+        if (config::olap_table_sink_compress_chunks) {
+            RETURN_IF_ERROR(get_block_compression_codec(CompressionTypePB::LZ4, &_compress_codec));
+        }
     } else {
         _row_desc = std::make_unique<RowDescriptor>(_tuple_desc, false);
         _batch_size = state->batch_size();
@@ -130,6 +134,12 @@ void NodeChannel::open() {
         auto ptablet = request.add_tablets();
         ptablet->set_partition_id(tablet.partition_id);
         ptablet->set_tablet_id(tablet.tablet_id);
+        auto it = _secondary_replicas.find(tablet.tablet_id);
+        if (it != _secondary_replicas.end()) {
+            for (const auto& replica : it->second) {
+                *ptablet->add_secondary_replicas() = replica;
+            }
+        }
     }
     request.set_num_senders(_parent->_num_senders);
     request.set_need_gen_rollup(_parent->_need_gen_rollup);
@@ -182,12 +192,7 @@ Status NodeChannel::open_wait() {
         Status status(result.status());
         if (status.ok()) {
             if (is_last_rpc) {
-                for (auto& tablet : result.tablet_vec()) {
-                    TTabletCommitInfo commit_info;
-                    commit_info.tabletId = tablet.tablet_id();
-                    commit_info.backendId = _node_id;
-                    _tablet_commit_infos.emplace_back(std::move(commit_info));
-                }
+                _add_tablet_commit_infos(result.tablet_vec());
                 _add_batches_finished = true;
             }
         } else {
@@ -428,7 +433,9 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
         return 0;
     }
 
-    if (!_add_batch_closure->is_packet_in_flight() && _pending_batches_num > 0) {
+    // Serialize the next pending chunk even if the previous rpc is still in flight, so that the cost of
+    // serialization and compression is overlapped with the rpc instead of being paid after it.
+    if (_prepared_add_chunk_request == nullptr && _pending_batches_num > 0) {
         SCOPED_RAW_TIMER(&_actual_consume_ns);
         AddChunkReq send_chunk;
         {
@@ -441,21 +448,34 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
 
         auto chunk = std::move(send_chunk.first);
         DCHECK(chunk != nullptr);
-        auto request = std::move(send_chunk.second); // doesn't need to be saved in heap
+        _prepared_add_chunk_request = std::make_unique<PTabletWriterAddChunkRequest>(std::move(send_chunk.second));
 
         // tablet_ids has already set when add row
-        request.set_packet_seq(_next_packet_seq);
         if (chunk->num_rows() > 0) {
             SCOPED_RAW_TIMER(&_serialize_batch_ns);
-            chunk->serialize_with_meta(request.mutable_chunk());
+            auto st = _serialize_chunk(chunk.get(), _prepared_add_chunk_request->mutable_chunk());
+            if (!st.ok()) {
+                LOG(WARNING) << name() << " serialize chunk failed: " << st.to_string() << ", " << _load_info;
+                _cancelled = true;
+            }
+        }
+        _mem_tracker->release(chunk->memory_usage());
+        if (_cancelled) {
+            return 0;
         }
+    }
+
+    if (_prepared_add_chunk_request != nullptr && !_add_batch_closure->is_packet_in_flight()) {
+        SCOPED_RAW_TIMER(&_actual_consume_ns);
+        auto request = std::move(_prepared_add_chunk_request);
+        request->set_packet_seq(_next_packet_seq);
 
         _add_batch_closure->reset();
         _add_batch_closure->cntl.set_timeout_ms(_rpc_timeout_ms);
 
-        if (request.eos()) {
+        if (request->eos()) {
             for (auto pid : _parent->_partition_ids) {
-                request.add_partition_ids(pid);
+                request->add_partition_ids(pid);
             }
 
             // eos request must be the last request
@@ -465,15 +485,52 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
         }
 
         _add_batch_closure->set_in_flight();
-        _stub->tablet_writer_add_chunk(&_add_batch_closure->cntl, &request, &_add_batch_closure->result,
+        _stub->tablet_writer_add_chunk(&_add_batch_closure->cntl, request.get(), &_add_batch_closure->result,
                                        _add_batch_closure);
-        _mem_tracker->release(chunk->memory_usage());
         _next_packet_seq++;
     }
 
     return _send_finished ? 0 : 1;
 }
 
+void NodeChannel::_add_tablet_commit_infos(const google::protobuf::RepeatedPtrField<PTabletInfo>& tablet_vec) {
+    for (auto& tablet : tablet_vec) {
+        TTabletCommitInfo commit_info;
+        commit_info.tabletId = tablet.tablet_id();
+        commit_info.backendId = tablet.has_node_id() ? tablet.node_id() : _node_id;
+        _tablet_commit_infos.emplace_back(std::move(commit_info));
+    }
+}
+
+Status NodeChannel::_serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst) {
+    size_t uncompressed_size = chunk->serialize_with_meta(dst);
+    dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+    dst->set_uncompressed_size(uncompressed_size);
+    if (_compress_codec == nullptr || !_compress_policy.should_compress()) {
+        return Status::OK();
+    }
+    if (_compress_codec->exceed_max_input_size(uncompressed_size)) {
+        return Status::InternalError("The input size for compression should be less than " +
+                                     std::to_string(_compress_codec->max_input_size()));
+    }
+
+    // Try compressing data to _compression_scratch, swap if compressed data is smaller
+    size_t max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
+    if (_compression_scratch.size() < max_compressed_size) {
+        _compression_scratch.resize(max_compressed_size);
+    }
+    Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
+    RETURN_IF_ERROR(_compress_codec->compress(dst->data(), &compressed_slice));
+    double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
+    _compress_policy.update(compress_ratio);
+    if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
+        _compression_scratch.resize(compressed_slice.size);
+        dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
+        dst->set_compress_type(CompressionTypePB::LZ4);
+    }
+    return Status::OK();
+}
+
 Status NodeChannel::none_of(std::initializer_list<bool> vars) {
     bool none = std::none_of(vars.begin(), vars.end(), [](bool var) { return var; });
     Status st = Status::OK();
@@ -501,6 +558,7 @@ void NodeChannel::clear_all_batches() {
             _mem_tracker->release(_cur_chunk->memory_usage());
             _cur_chunk.reset();
         }
+        _prepared_add_chunk_request.reset();
     } else {
         std::queue<AddBatchReq> empty;
         std::swap(_pending_batches, empty);
@@ -511,6 +569,9 @@ void NodeChannel::clear_all_batches() {
 IndexChannel::~IndexChannel() {}
 
 Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPartition>& tablets) {
+    _single_replica = _parent->_is_vectorized && config::enable_single_replica_load;
+    // BeId -> ordinal in _ordered_node_channels
+    std::unordered_map<int64_t, uint32_t> node_ordinals;
     for (const auto& tablet : tablets) {
         auto* location = _parent->_location->find_tablet(tablet.tablet_id);
         if (location == nullptr) {
@@ -518,23 +579,47 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
             return Status::InternalError("unknown tablet");
         }
         std::vector<NodeChannel*> channels;
-        std::vector<int64_t> bes;
-        for (auto& node_id : location->node_ids) {
+        std::vector<uint32_t> ordinals;
+        // In a single replica load, the rows of a tablet are only sent to its first replica, which ships
+        // the segments to the others.
+        size_t num_channels = location->node_ids.size();
+        if (_single_replica) {
+            num_channels = std::min<size_t>(1, num_channels);
+        }
+        for (size_t i = 0; i < num_channels; i++) {
+            int64_t node_id = location->node_ids[i];
             NodeChannel* channel = nullptr;
             auto it = _node_channels.find(node_id);
             if (it == std::end(_node_channels)) {
                 auto channel_ptr = std::make_unique<NodeChannel>(_parent, _index_id, node_id, _schema_hash);
                 channel = channel_ptr.get();
                 _node_channels.emplace(node_id, std::move(channel_ptr));
+                node_ordinals.emplace(node_id, _ordered_node_channels.size());
+                _ordered_node_channels.push_back(channel);
             } else {
                 channel = it->second.get();
             }
             channel->add_tablet(tablet);
             channels.push_back(channel);
-            bes.emplace_back(node_id);
+            ordinals.push_back(node_ordinals[node_id]);
+        }
+        if (num_channels < location->node_ids.size()) {
+            std::vector<PReplicaInfo> replicas;
+            for (size_t i = num_channels; i < location->node_ids.size(); i++) {
+                const NodeInfo* node_info = _parent->_nodes_info->find_node(location->node_ids[i]);
+                if (node_info == nullptr) {
+                    LOG(WARNING) << "unknown node, node_id=" << location->node_ids[i];
+                    return Status::InternalError("unknown node");
+                }
+                PReplicaInfo& replica = replicas.emplace_back();
+                replica.set_node_id(node_info->id);
+                replica.set_host(node_info->host);
+                replica.set_brpc_port(node_info->brpc_port);
+            }
+            channels[0]->add_secondary_replicas(tablet.tablet_id, std::move(replicas));
         }
         _channels_by_tablet.emplace(tablet.tablet_id, std::move(channels));
-        _tablet_to_be.emplace(tablet.tablet_id, std::move(bes));
+        _tablet_to_node_ordinals.emplace(tablet.tablet_id, std::move(ordinals));
     }
     for (auto& it : _node_channels) {
         RETURN_IF_ERROR(it.second->init(state));
@@ -561,6 +646,10 @@ Status IndexChannel::add_row(Tuple* tuple, int64_t tablet_id) {
 }
 
 bool IndexChannel::has_intolerable_failure() {
+    if (_single_replica) {
+        // the failed node is the only one that receives the rows of its tablets
+        return !_failed_channels.empty();
+    }
     return _failed_channels.size() >= ((_parent->_num_repicas + 1) / 2);
 }
 
@@ -936,19 +1025,33 @@ Status OlapTableSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk)
 
 Status OlapTableSink::_send_chunk_by_node(vectorized::Chunk* chunk, IndexChannel* channel,
                                           std::vector<uint16_t>& selection_idx) {
-    for (auto& it : channel->_node_channels) {
-        int64_t be_id = it.first;
-        _node_select_idx.clear();
-        _node_select_idx.reserve(selection_idx.size());
-        for (uint32_t j = 0; j < selection_idx.size(); ++j) {
-            uint16_t selection = selection_idx[j];
-            std::vector<int64_t>& be_ids = channel->_tablet_to_be.find(_tablet_ids[selection])->second;
-            if (std::find(be_ids.begin(), be_ids.end(), be_id) != be_ids.end()) {
-                _node_select_idx.emplace_back(selection);
-            }
+    // Distribute the selected rows to the nodes of their tablets in one pass. Rows of the same tablet
+    // are often adjacent, so the nodes of the last tablet are reused without looking up the map.
+    size_t num_nodes = channel->_ordered_node_channels.size();
+    _node_select_idxs.resize(num_nodes);
+    for (auto& node_select_idx : _node_select_idxs) {
+        node_select_idx.clear();
+        node_select_idx.reserve(selection_idx.size());
+    }
+    int64_t last_tablet_id = -1;
+    const std::vector<uint32_t>* node_ordinals = nullptr;
+    for (uint16_t selection : selection_idx) {
+        int64_t tablet_id = _tablet_ids[selection];
+        if (tablet_id != last_tablet_id) {
+            auto it = channel->_tablet_to_node_ordinals.find(tablet_id);
+            DCHECK(it != channel->_tablet_to_node_ordinals.end()) << "unknown tablet, tablet_id=" << tablet_id;
+            node_ordinals = &it->second;
+            last_tablet_id = tablet_id;
+        }
+        for (uint32_t ordinal : *node_ordinals) {
+            _node_select_idxs[ordinal].emplace_back(selection);
         }
-        NodeChannel* node = it.second.get();
-        auto st = node->add_chunk(chunk, _tablet_ids.data(), _node_select_idx.data(), 0, _node_select_idx.size());
+    }
+
+    for (size_t i = 0; i < num_nodes; ++i) {
+        NodeChannel* node = channel->_ordered_node_channels[i];
+        const auto& node_select_idx = _node_select_idxs[i];
+        auto st = node->add_chunk(chunk, _tablet_ids.data(), node_select_idx.data(), 0, node_select_idx.size());
 
         if (!st.ok()) {
             channel->mark_as_failed(node);
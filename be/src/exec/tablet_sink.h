@@ -37,12 +37,15 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "util/bitmap.h"
+#include "util/compression_utils.h"
+#include "util/raw_container.h"
 #include "util/ref_count_closure.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
 
 class Bitmap;
+class BlockCompressionCodec;
 class MemTracker;
 class RuntimeProfile;
 class RowDescriptor;
@@ -149,6 +152,10 @@ public:
 
     // called before open, used to add tablet loacted in this backend
     void add_tablet(const TTabletWithPartition& tablet) { _all_tablets.emplace_back(tablet); }
+    // called before open, used to add the other replicas of a tablet in a single replica load
+    void add_secondary_replicas(int64_t tablet_id, std::vector<PReplicaInfo> replicas) {
+        _secondary_replicas.emplace(tablet_id, std::move(replicas));
+    }
 
     Status init(RuntimeState* state);
 
@@ -197,6 +204,13 @@ public:
     void clear_all_batches();
 
 private:
+    // Serializes |chunk| into |dst|, and compresses the data if it is worth it.
+    Status _serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst);
+
+    // Adds the commit infos of the tablets written by the node. The secondary replicas of a single replica
+    // load are reported by the primary one with their node ids.
+    void _add_tablet_commit_infos(const google::protobuf::RepeatedPtrField<PTabletInfo>& tablet_vec);
+
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
 
     OlapTableSink* _parent = nullptr;
@@ -240,6 +254,8 @@ private:
     ReusableClosure<PTabletWriterAddBatchResult>* _add_batch_closure = nullptr;
 
     std::vector<TTabletWithPartition> _all_tablets;
+    // tablet_id -> the secondary replicas, which add the segments written by this node
+    std::unordered_map<int64_t, std::vector<PReplicaInfo>> _secondary_replicas;
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
 
     AddBatchCounter _add_batch_counter;
@@ -251,6 +267,13 @@ private:
     using AddChunkReq = std::pair<std::unique_ptr<vectorized::Chunk>, PTabletWriterAddChunkRequest>;
     std::queue<AddChunkReq> _pending_chunks;
     PTabletWriterAddChunkRequest _cur_add_chunk_request;
+    // The request of the next pending chunk, which is serialized while the previous rpc is in flight,
+    // so that it could be sent as soon as the previous rpc is responsed.
+    std::unique_ptr<PTabletWriterAddChunkRequest> _prepared_add_chunk_request;
+
+    const BlockCompressionCodec* _compress_codec = nullptr;
+    AdaptiveCompressionPolicy _compress_policy;
+    raw::RawString _compression_scratch;
 
     int64_t _mem_exceeded_block_ns = 0;
     int64_t _queue_push_lock_ns = 0;
@@ -286,10 +309,14 @@ private:
     std::unordered_map<int64_t, std::unique_ptr<NodeChannel>> _node_channels;
     // map tablet_id to backend channel
     std::unordered_map<int64_t, std::vector<NodeChannel*>> _channels_by_tablet;
-    // map tablet_id to backend id
-    std::unordered_map<int64_t, std::vector<int64_t>> _tablet_to_be;
+    // node channels in the order of their first tablets, indexed by the ordinals below
+    std::vector<NodeChannel*> _ordered_node_channels;
+    // map tablet_id to the ordinals of its backend channels
+    std::unordered_map<int64_t, std::vector<uint32_t>> _tablet_to_node_ordinals;
     // BeId
     std::set<int64_t> _failed_channels;
+    // whether the rows are only sent to the first replica of each tablet
+    bool _single_replica = false;
 };
 
 // Write data to Olap Table.
@@ -416,8 +443,8 @@ private:
     std::vector<uint16_t> _validate_select_idx;
     // one chunk selection for data validation
     std::vector<uint8_t> _validate_selection;
-    // one chunk selection for BE node
-    std::vector<uint32_t> _node_select_idx;
+    // one chunk selection for each BE node of an index channel
+    std::vector<std::vector<uint32_t>> _node_select_idxs;
     std::vector<int64_t> _tablet_ids;
     vectorized::OlapTablePartitionParam* _vectorized_partition;
     // Store the output expr comput result column
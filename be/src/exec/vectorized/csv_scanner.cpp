@@ -2,11 +2,19 @@
 
 #include "exec/vectorized/csv_scanner.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
 #include "column/column_helper.h"
 #include "column/hash_set.h"
 #include "env/env.h"
+#include "env/env_stream_pipe.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
+#include "runtime/routine_load/kafka_consumer_pipe.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
 #include "util/utf8_check.h"
 
 namespace starrocks::vectorized {
@@ -34,6 +42,39 @@ Status CSVScanner::CSVReader::next_record(Record* record) {
     return Status::OK();
 }
 
+Status CSVScanner::CSVReader::next_records(size_t max_records, csv::DelimiterIndex* index) {
+    DCHECK_GT(max_records, 0);
+    if (_limit > 0 && _parsed_bytes > _limit) {
+        return Status::EndOfFile("Reached limit");
+    }
+    // Make sure that the buffer holds a whole record.
+    size_t pos = 0;
+    while (_buff.find(_record_delimiter, pos) == nullptr) {
+        pos = _buff.available();
+        _buff.compact();
+        if (_buff.free_space() == 0) {
+            RETURN_IF_ERROR(_expand_buffer());
+        }
+        RETURN_IF_ERROR(_fill_buffer());
+    }
+    size_t n = index->split(_buff.position(), _buff.limit(), max_records);
+    DCHECK_GT(index->num_records(), 0);
+    if (_limit > 0) {
+        // The records starting after the limit belong to the next scan range.
+        size_t bytes = 0;
+        for (size_t i = 0; i < index->num_records(); i++) {
+            if (_parsed_bytes + bytes > _limit) {
+                n = index->truncate(i);
+                break;
+            }
+            bytes += index->record(i).size + 1;
+        }
+    }
+    _buff.skip(n);
+    _parsed_bytes += n;
+    return Status::OK();
+}
+
 Status CSVScanner::CSVReader::_fill_buffer() {
     SCOPED_RAW_TIMER(&_counter->file_read_ns);
 
@@ -76,25 +117,15 @@ Status CSVScanner::CSVReader::_expand_buffer() {
     return Status::OK();
 }
 
-void CSVScanner::CSVReader::split_record(const Record& record, Fields* fields) const {
-    const char* value = record.data;
-    const char* ptr = record.data;
-    const size_t size = record.size;
-    for (size_t i = 0; i < size; ++i, ++ptr) {
-        if (*ptr == _field_delimiter) {
-            fields->emplace_back(value, ptr - value);
-            value = ptr + 1;
-        }
-    }
-    fields->emplace_back(value, ptr - value);
-}
-
 CSVScanner::CSVScanner(RuntimeState* state, RuntimeProfile* profile, const TBrokerScanRange& scan_range,
                        ScannerCounter* counter)
         : FileScanner(state, profile, scan_range.params, counter),
           _scan_range(scan_range),
           _record_delimiter(scan_range.params.row_delimiter),
-          _field_delimiter(scan_range.params.column_separator) {}
+          _field_delimiter(scan_range.params.column_separator),
+          _index(_record_delimiter, _field_delimiter) {}
+
+CSVScanner::~CSVScanner() = default;
 
 Status CSVScanner::open() {
     RETURN_IF_ERROR(FileScanner::open());
@@ -149,9 +180,24 @@ Status CSVScanner::open() {
         _converters.emplace_back(std::move(conv));
     }
 
+    ExecEnv* exec_env = _state->exec_env();
+    if (exec_env != nullptr && exec_env->csv_parse_thread_pool() != nullptr) {
+        _parse_token = exec_env->csv_parse_thread_pool()->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    }
+
     return Status::OK();
 }
 
+void CSVScanner::close() {
+    if (_parse_token != nullptr) {
+        _parse_token->shutdown();
+    }
+    if (_kafka_pipe != nullptr) {
+        _kafka_pipe->close();
+        _kafka_pipe.reset();
+    }
+}
+
 StatusOr<ChunkPtr> CSVScanner::get_next() {
     SCOPED_RAW_TIMER(&_counter->total_ns);
 
@@ -161,36 +207,20 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
     src_chunk->reserve(chunk_capacity);
 
     do {
-        if (_curr_reader == nullptr && ++_curr_file_index < _scan_range.ranges.size()) {
-            std::shared_ptr<SequentialFile> file;
-            const TBrokerRangeDesc& range_desc = _scan_range.ranges[_curr_file_index];
-            Status st = create_sequential_file(range_desc, _scan_range.broker_addresses[0], _scan_range.params, &file);
-            if (!st.ok()) {
-                LOG(WARNING) << "Failed to create sequential files: " << st.to_string();
-                return st;
-            }
-
-            _curr_reader = std::make_unique<CSVReader>(file, _record_delimiter, _field_delimiter);
-            _curr_reader->set_counter(_counter);
-            if (_scan_range.ranges[_curr_file_index].size > 0 &&
-                _scan_range.ranges[_curr_file_index].format_type == TFileFormatType::FORMAT_CSV_PLAIN) {
-                // Does not set limit for compressed file.
-                _curr_reader->set_limit(_scan_range.ranges[_curr_file_index].size);
-            }
-            if (_scan_range.ranges[_curr_file_index].start_offset > 0) {
-                // Skip the first record started from |start_offset|.
-                file->skip(_scan_range.ranges[_curr_file_index].start_offset);
-                CSVReader::Record dummy;
-                RETURN_IF_ERROR(_curr_reader->next_record(&dummy));
-            }
-        } else if (_curr_reader == nullptr) {
+        if (_curr_reader == nullptr && _kafka_pipe == nullptr && ++_curr_file_index < _scan_range.ranges.size()) {
+            RETURN_IF_ERROR(_open_range(_scan_range.ranges[_curr_file_index]));
+        } else if (_curr_reader == nullptr && _kafka_pipe == nullptr) {
             return Status::EndOfFile("CSVScanner");
         }
 
         src_chunk->set_num_rows(0);
-        Status status = _parse_csv(src_chunk.get());
+        Status status = _kafka_pipe != nullptr ? _parse_kafka_msgs(src_chunk.get()) : _parse_csv(src_chunk.get());
         if (status.is_end_of_file()) {
             _curr_reader = nullptr;
+            if (_kafka_pipe != nullptr) {
+                _kafka_pipe->close();
+                _kafka_pipe.reset();
+            }
             DCHECK_EQ(0, src_chunk->num_rows());
         } else if (!status.ok()) {
             return status;
@@ -203,71 +233,244 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
     return std::move(chunk);
 }
 
-Status CSVScanner::_parse_csv(Chunk* chunk) {
-    const int capacity = config::vector_chunk_size;
-    DCHECK_EQ(0, chunk->num_rows());
-    Status status;
-    CSVReader::Record record;
-    CSVReader::Fields fields;
+Status CSVScanner::_open_range(const TBrokerRangeDesc& range_desc) {
+    std::shared_ptr<SequentialFile> file;
+    if (range_desc.file_type == TFileType::FILE_STREAM && range_desc.format_type == TFileFormatType::FORMAT_CSV_PLAIN) {
+        auto pipe = _state->exec_env()->load_stream_mgr()->get(range_desc.load_id);
+        if (pipe == nullptr) {
+            return Status::InternalError("Invalid or outdated load id " + print_id(range_desc.load_id));
+        }
+        // The msgs of kafka are parsed as they are, instead of being read from the pipe as bytes.
+        _kafka_pipe = std::dynamic_pointer_cast<KafkaConsumerPipe>(pipe);
+        if (_kafka_pipe != nullptr) {
+            return Status::OK();
+        }
+        file = std::make_shared<StreamPipeSequentialFile>(std::move(pipe));
+    } else {
+        Status st = create_sequential_file(range_desc, _scan_range.broker_addresses[0], _scan_range.params, &file);
+        if (!st.ok()) {
+            LOG(WARNING) << "Failed to create sequential files: " << st.to_string();
+            return st;
+        }
+    }
 
-    int num_columns = chunk->num_columns();
-    _column_raw_ptrs.resize(num_columns);
-    for (int i = 0; i < num_columns; i++) {
-        _column_raw_ptrs[i] = chunk->get_column_by_index(i).get();
+    _curr_reader = std::make_unique<CSVReader>(file, _record_delimiter);
+    _curr_reader->set_counter(_counter);
+    if (range_desc.size > 0 && range_desc.format_type == TFileFormatType::FORMAT_CSV_PLAIN) {
+        // Does not set limit for compressed file.
+        _curr_reader->set_limit(range_desc.size);
     }
+    if (range_desc.start_offset > 0) {
+        // Skip the first record started from |start_offset|.
+        file->skip(range_desc.start_offset);
+        CSVReader::Record dummy;
+        RETURN_IF_ERROR(_curr_reader->next_record(&dummy));
+    }
+    return Status::OK();
+}
 
-    csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
+Status CSVScanner::_parse_csv(Chunk* chunk) {
+    const int capacity = config::vector_chunk_size;
+    DCHECK_EQ(0, chunk->num_rows());
+    std::vector<ParseError> errors;
 
-    for (size_t num_rows = chunk->num_rows(); num_rows < capacity; /**/) {
-        status = _curr_reader->next_record(&record);
+    while (chunk->num_rows() < capacity) {
+        Status status = _curr_reader->next_records(capacity - chunk->num_rows(), &_index);
         if (status.is_end_of_file()) {
             break;
         } else if (!status.ok()) {
             return status;
-        } else if (record.empty()) {
-            // always skip blank lines.
-            continue;
         }
+        _parse_index(chunk, &errors);
+    }
+    return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
+}
 
-        fields.clear();
-        _curr_reader->split_record(record, &fields);
+Status CSVScanner::_parse_kafka_msgs(Chunk* chunk) {
+    const int capacity = config::vector_chunk_size;
+    DCHECK_EQ(0, chunk->num_rows());
+    std::vector<ParseError> errors;
+
+    while (chunk->num_rows() < capacity) {
+        if (_kafka_records_pos == _kafka_records.size()) {
+            if (_kafka_batch == nullptr || _next_kafka_msg == _kafka_msg_order.size()) {
+                {
+                    SCOPED_RAW_TIMER(&_counter->file_read_ns);
+                    RETURN_IF_ERROR(_kafka_pipe->read_batch(&_kafka_batch));
+                }
+                if (_kafka_batch == nullptr) {
+                    break;
+                }
+                // The msgs of a batch are interleaved from the partitions of a consumer. Group them by partition,
+                // keeping the order of the msgs of each partition.
+                const auto& msgs = *_kafka_batch;
+                _kafka_msg_order.resize(msgs.size());
+                std::iota(_kafka_msg_order.begin(), _kafka_msg_order.end(), 0);
+                std::stable_sort(_kafka_msg_order.begin(), _kafka_msg_order.end(), [&msgs](uint32_t a, uint32_t b) {
+                    return msgs[a]->partition() < msgs[b]->partition();
+                });
+                _next_kafka_msg = 0;
+            }
 
-        if (fields.size() != _num_fields_in_csv) {
-            std::stringstream error_msg;
-            error_msg << "column count mismatch, expect=" << _num_fields_in_csv << " real=" << fields.size();
-            if (_counter->num_rows_filtered++ < 50) {
-                _report_error(record.to_string(), error_msg.str());
+            // Copy the msgs of the next partition, each one followed by the record delimiter, which is the only copy
+            // of them before being parsed.
+            const RdKafka::Message& first = *(*_kafka_batch)[_kafka_msg_order[_next_kafka_msg]];
+            const int32_t partition = first.partition();
+            _kafka_partition_metrics =
+                    StarRocksMetrics::instance()->routine_load_partition_metrics(first.topic_name(), partition);
+            _kafka_records.clear();
+            _kafka_records_pos = 0;
+            for (; _next_kafka_msg < _kafka_msg_order.size(); _next_kafka_msg++) {
+                const RdKafka::Message& msg = *(*_kafka_batch)[_kafka_msg_order[_next_kafka_msg]];
+                if (msg.partition() != partition) {
+                    break;
+                }
+                size_t size = _kafka_records.size();
+                _kafka_records.resize(size + msg.len() + 1);
+                memcpy(_kafka_records.data() + size, msg.payload(), msg.len());
+                _kafka_records[size + msg.len()] = _record_delimiter;
             }
+        }
+
+        // every msg is followed by the record delimiter, so the records are split as a whole
+        const char* begin = _kafka_records.data() + _kafka_records_pos;
+        _kafka_records_pos += _index.split(begin, _kafka_records.data() + _kafka_records.size(),
+                                           capacity - chunk->num_rows());
+        _kafka_partition_metrics->filtered_rows.increment(_parse_index(chunk, &errors));
+    }
+    return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
+}
+
+size_t CSVScanner::_parse_index(Chunk* chunk, std::vector<ParseError>* errors) {
+    errors->clear();
+    {
+        SCOPED_RAW_TIMER(&_counter->fill_ns);
+        size_t num_blocks = 1;
+        if (_parse_token != nullptr) {
+            num_blocks = std::min<size_t>(config::csv_parse_thread_pool_size + 1,
+                                          _index.num_records() / kMinRecordsPerParseBlock);
+        }
+        if (num_blocks > 1) {
+            _parse_records_in_parallel(chunk, num_blocks, errors);
+        } else {
+            _parse_records(0, _index.num_records(), chunk, errors);
+        }
+    }
+    for (const auto& error : *errors) {
+        if (_counter->num_rows_filtered++ < 50) {
+            _report_error(error.record.to_string(), error.msg);
+        }
+    }
+    return errors->size();
+}
+
+void CSVScanner::_parse_records(size_t from, size_t to, Chunk* chunk, std::vector<ParseError>* errors) const {
+    // records to convert
+    std::vector<uint32_t> records;
+    records.reserve(to - from);
+    for (size_t i = from; i < to; i++) {
+        const CSVReader::Record& record = _index.record(i);
+        if (record.empty()) {
+            // always skip blank lines.
+            continue;
+        }
+        const size_t num_fields = _index.num_fields(i);
+        if (num_fields != _num_fields_in_csv) {
+            std::stringstream error_msg;
+            error_msg << "column count mismatch, expect=" << _num_fields_in_csv << " real=" << num_fields;
+            errors->push_back({record, error_msg.str()});
             continue;
         }
         if (!validate_utf8(record.data, record.size)) {
-            if (_counter->num_rows_filtered++ < 50) {
-                _report_error(record.to_string(), "Invalid UTF-8 data");
-            }
+            errors->push_back({record, "Invalid UTF-8 data"});
             continue;
         }
+        records.push_back(i);
+    }
+    const size_t num_records = records.size();
+    if (num_records == 0) {
+        return;
+    }
 
-        SCOPED_RAW_TIMER(&_counter->fill_ns);
-        bool has_error = false;
-        for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
-            if (_src_slot_descriptors[j] == nullptr) {
-                continue;
-            }
-            const Slice& field = fields[j];
-            options.type_desc = &(_src_slot_descriptors[j]->type());
-            if (!_converters[k]->read_string(_column_raw_ptrs[k], field, options)) {
-                chunk->set_num_rows(num_rows);
-                if (_counter->num_rows_filtered++ < 50) {
-                    _report_error(record.to_string(), "invalid value '" + field.to_string() + "'");
+    // Convert the records column by column, so that each converter reads all the fields of its column
+    // in one call. A record with an invalid field is filtered out after all the columns are converted.
+    csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
+    std::vector<Slice> fields(num_records);
+    std::vector<uint8_t> invalid(num_records);
+    // the first invalid field of each record, -1 if none
+    std::vector<int> invalid_field(num_records, -1);
+    size_t num_invalid_records = 0;
+    for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
+        if (_src_slot_descriptors[j] == nullptr) {
+            continue;
+        }
+        for (size_t r = 0; r < num_records; r++) {
+            fields[r] = _index.fields(records[r])[j];
+        }
+        std::fill(invalid.begin(), invalid.end(), 0);
+        options.type_desc = &(_src_slot_descriptors[j]->type());
+        Column* column = chunk->get_column_by_index(k).get();
+        if (_converters[k]->read_strings(column, fields.data(), num_records, options, invalid.data()) > 0) {
+            for (size_t r = 0; r < num_records; r++) {
+                if (invalid[r] && invalid_field[r] < 0) {
+                    invalid_field[r] = j;
+                    num_invalid_records++;
                 }
-                has_error = true;
-                break;
             }
-            k++;
         }
-        num_rows += !has_error;
+        k++;
+    }
+    if (num_invalid_records == 0) {
+        return;
+    }
+
+    const size_t offset = chunk->num_rows() - num_records;
+    Column::Filter filter(chunk->num_rows(), 1);
+    for (size_t r = 0; r < num_records; r++) {
+        if (invalid_field[r] >= 0) {
+            filter[offset + r] = 0;
+            const CSVReader::Record& record = _index.record(records[r]);
+            const Slice& field = _index.fields(records[r])[invalid_field[r]];
+            errors->push_back({record, "invalid value '" + field.to_string() + "'"});
+        }
+    }
+    chunk->filter_range(filter, offset, chunk->num_rows());
+    // keep the errors in the order of the records
+    std::stable_sort(errors->begin(), errors->end(),
+                     [](const ParseError& a, const ParseError& b) { return a.record.data < b.record.data; });
+}
+
+void CSVScanner::_parse_records_in_parallel(Chunk* chunk, size_t num_blocks, std::vector<ParseError>* errors) {
+    const size_t num_records = _index.num_records();
+    const size_t block_size = (num_records + num_blocks - 1) / num_blocks;
+    std::vector<ChunkPtr> block_chunks(num_blocks);
+    std::vector<std::vector<ParseError>> block_errors(num_blocks);
+
+    for (size_t i = 1; i < num_blocks; i++) {
+        size_t from = i * block_size;
+        size_t to = std::min(num_records, from + block_size);
+        if (from >= to) {
+            break;
+        }
+        block_chunks[i] = _create_chunk(_src_slot_descriptors);
+        auto task = [this, &block_chunks, &block_errors, i, from, to]() {
+            _parse_records(from, to, block_chunks[i].get(), &block_errors[i]);
+        };
+        if (!_parse_token->submit_func(task).ok()) {
+            // parse the block in this thread if the pool is busy or shut down
+            task();
+        }
+    }
+    // the first block is parsed by the scanner thread, straight into |chunk|
+    _parse_records(0, std::min(num_records, block_size), chunk, &block_errors[0]);
+    _parse_token->wait();
+
+    for (size_t i = 0; i < num_blocks; i++) {
+        if (block_chunks[i] != nullptr) {
+            chunk->append(*block_chunks[i]);
+        }
+        errors->insert(errors->end(), block_errors[i].begin(), block_errors[i].end());
     }
-    return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
 }
 
 ChunkPtr CSVScanner::_create_chunk(const std::vector<SlotDescriptor*>& slots) {
@@ -7,12 +7,20 @@
 
 #include "exec/vectorized/file_scanner.h"
 #include "formats/csv/converter.h"
+#include "formats/csv/delimiter_index.h"
 #include "util/logging.h"
 #include "util/raw_container.h"
+#include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
+
+namespace RdKafka {
+class Message;
+}
 
 namespace starrocks {
+class KafkaConsumerPipe;
 class SequentialFile;
-}
+} // namespace starrocks
 
 namespace starrocks::vectorized {
 
@@ -24,16 +32,20 @@ class CSVScanner final : public FileScanner {
     constexpr static size_t kMinBufferSize = 128 * 1024L;
     constexpr static size_t kMaxBufferSize = 512 * 1024L;
 #endif
+    // Records are parsed in parallel only if each block has at least this many records.
+    constexpr static size_t kMinRecordsPerParseBlock = 1024;
 
 public:
     CSVScanner(RuntimeState* state, RuntimeProfile* profile, const TBrokerScanRange& scan_range,
                ScannerCounter* counter);
 
+    ~CSVScanner() override;
+
     Status open() override;
 
     StatusOr<ChunkPtr> get_next() override;
 
-    void close() override{};
+    void close() override;
 
 private:
     class Buffer {
@@ -87,21 +99,20 @@ private:
     class CSVReader {
     public:
         using Record = Slice;
-        using Field = Slice;
-        using Fields = std::vector<Field>;
 
-        CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, char field_delimiter)
+        CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter)
                 : _file(std::move(file)),
                   _record_delimiter(record_delimiter),
-                  _field_delimiter(field_delimiter),
                   _storage(kMinBufferSize),
                   _buff(_storage.data(), _storage.size()) {}
 
         Status next_record(Record* record);
 
-        void set_limit(size_t limit) { _limit = limit; }
+        // Reads up to |max_records| records, at least one, and splits them into fields with |index|.
+        // The records and fields point into the reader's buffer and are valid until the next read.
+        Status next_records(size_t max_records, csv::DelimiterIndex* index);
 
-        void split_record(const Record& record, Fields* fields) const;
+        void set_limit(size_t limit) { _limit = limit; }
 
         void set_counter(ScannerCounter* counter) { _counter = counter; }
 
@@ -111,7 +122,6 @@ private:
 
         std::shared_ptr<SequentialFile> _file;
         char _record_delimiter;
-        char _field_delimiter;
         raw::RawVector<char> _storage;
         Buffer _buff;
         size_t _parsed_bytes = 0;
@@ -121,7 +131,24 @@ private:
 
     ChunkPtr _create_chunk(const std::vector<SlotDescriptor*>& slots);
 
+    struct ParseError {
+        Slice record;
+        std::string msg;
+    };
+
+    // Opens |range_desc| to be read by _curr_reader, or by _kafka_pipe if it is the pipe of a kafka routine load.
+    Status _open_range(const TBrokerRangeDesc& range_desc);
     Status _parse_csv(Chunk* chunk);
+    // Parses the msgs of a kafka routine load into |chunk|, the msgs of a partition at a time.
+    Status _parse_kafka_msgs(Chunk* chunk);
+    // Converts the records of |_index| into rows appended to |chunk| and reports the invalid ones.
+    // Returns the number of the invalid records.
+    size_t _parse_index(Chunk* chunk, std::vector<ParseError>* errors);
+    // Converts the records [from, to) of |_index| into rows appended to |chunk|.
+    void _parse_records(size_t from, size_t to, Chunk* chunk, std::vector<ParseError>* errors) const;
+    // Splits the records of |_index| into |num_blocks| blocks parsed on the csv parse thread pool,
+    // then appends their rows to |chunk| in the order of the records.
+    void _parse_records_in_parallel(Chunk* chunk, size_t num_blocks, std::vector<ParseError>* errors);
     ChunkPtr _materialize(ChunkPtr& src_chunk);
     void _report_error(const std::string& line, const std::string& err_msg);
 
@@ -129,13 +156,26 @@ private:
     using CSVReaderPtr = std::unique_ptr<CSVReader>;
 
     const TBrokerScanRange& _scan_range;
-    std::vector<Column*> _column_raw_ptrs;
     char _record_delimiter;
     char _field_delimiter;
     int _num_fields_in_csv = 0;
     int _curr_file_index = -1;
     CSVReaderPtr _curr_reader;
     std::vector<ConverterPtr> _converters;
+    csv::DelimiterIndex _index;
+    std::unique_ptr<ThreadPoolToken> _parse_token;
+
+    // Set when the range is the pipe of a kafka routine load, whose msgs are parsed without reading the
+    // pipe as bytes.
+    std::shared_ptr<KafkaConsumerPipe> _kafka_pipe;
+    std::unique_ptr<std::vector<std::unique_ptr<RdKafka::Message>>> _kafka_batch;
+    // indexes of the msgs of _kafka_batch, grouped by partition in the order of the msgs
+    std::vector<uint32_t> _kafka_msg_order;
+    size_t _next_kafka_msg = 0;
+    // the msgs of a partition, each one followed by the record delimiter, and the bytes of them parsed
+    raw::RawVector<char> _kafka_records;
+    size_t _kafka_records_pos = 0;
+    std::shared_ptr<StarRocksMetrics::RoutineLoadPartitionMetrics> _kafka_partition_metrics;
 };
 
 } // namespace starrocks::vectorized
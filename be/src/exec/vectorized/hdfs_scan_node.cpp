@@ -140,7 +140,19 @@ Status HdfsScanNode::_start_scan_thread(RuntimeState* state) {
         if (hdfs_file->file_length == 0) {
             continue;
         }
-        RETURN_IF_ERROR(_create_and_init_scanner(state, *hdfs_file));
+        auto morsels = _split_into_morsels(*hdfs_file);
+        if (morsels.size() == 1) {
+            RETURN_IF_ERROR(_create_and_init_scanner(state, *hdfs_file, morsels[0], hdfs_file->fs, nullptr));
+            continue;
+        }
+        auto meta_cache = std::make_shared<HdfsFileMetaCache>();
+        for (size_t i = 0; i < morsels.size(); i++) {
+            std::shared_ptr<RandomAccessFile> fs = hdfs_file->fs;
+            if (i > 0) {
+                RETURN_IF_ERROR(_open_morsel_file(hdfs_file, &fs));
+            }
+            RETURN_IF_ERROR(_create_and_init_scanner(state, *hdfs_file, morsels[i], fs, meta_cache));
+        }
     }
 
     // init chunk pool
@@ -162,11 +174,74 @@ Status HdfsScanNode::_start_scan_thread(RuntimeState* state) {
     return Status::OK();
 }
 
-Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc) {
+std::vector<std::vector<const THdfsScanRange*>> HdfsScanNode::_split_into_morsels(const HdfsFileDesc& hdfs_file_desc) {
+    int64_t morsel_bytes = config::hdfs_scan_morsel_bytes;
+    bool splittable = hdfs_file_desc.hdfs_file_format == THdfsFileFormat::PARQUET ||
+                      hdfs_file_desc.hdfs_file_format == THdfsFileFormat::ORC;
+    if (morsel_bytes <= 0 || !splittable) {
+        return {hdfs_file_desc.splits};
+    }
+
+    // cut the large splits and merge the small ones. a row group or stripe is read by the scanner
+    // whose scan ranges contain its first byte, so each of them is still read once.
+    std::vector<std::vector<const THdfsScanRange*>> morsels;
+    std::vector<const THdfsScanRange*> morsel;
+    int64_t size = 0;
+    for (const auto* split : hdfs_file_desc.splits) {
+        int64_t end = split->offset + split->length;
+        for (int64_t offset = split->offset; offset < end;) {
+            int64_t length = std::min(morsel_bytes - size, end - offset);
+            if (length == split->length) {
+                morsel.emplace_back(split);
+            } else {
+                auto* range = _pool->add(new THdfsScanRange(*split));
+                range->__set_offset(offset);
+                range->__set_length(length);
+                morsel.emplace_back(range);
+            }
+            offset += length;
+            size += length;
+            if (size >= morsel_bytes) {
+                morsels.emplace_back(std::move(morsel));
+                morsel.clear();
+                size = 0;
+            }
+        }
+    }
+    if (!morsel.empty()) {
+        morsels.emplace_back(std::move(morsel));
+    }
+    if (morsels.empty()) {
+        return {hdfs_file_desc.splits};
+    }
+    return morsels;
+}
+
+Status HdfsScanNode::_open_morsel_file(HdfsFileDesc* hdfs_file_desc, std::shared_ptr<RandomAccessFile>* file) {
+    if (hdfs_file_desc->hdfs_fs == nullptr) {
+        // local file, which can be read concurrently
+        *file = hdfs_file_desc->fs;
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_open_file_timer);
+    auto* hdfs_file = hdfsOpenFile(hdfs_file_desc->hdfs_fs, hdfs_file_desc->native_path.c_str(), O_RDONLY, 0, 0, 0);
+    if (hdfs_file == nullptr) {
+        return Status::InternalError(strings::Substitute("open file failed, file=$0", hdfs_file_desc->native_path));
+    }
+    hdfs_file_desc->morsel_hdfs_files.emplace_back(hdfs_file);
+    *file = std::make_shared<HdfsRandomAccessFile>(hdfs_file_desc->hdfs_fs, hdfs_file, hdfs_file_desc->native_path);
+    return Status::OK();
+}
+
+Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc,
+                                              const std::vector<const THdfsScanRange*>& scan_ranges,
+                                              std::shared_ptr<RandomAccessFile> fs,
+                                              std::shared_ptr<HdfsFileMetaCache> meta_cache) {
     HdfsScannerParams scanner_params;
     scanner_params.runtime_filter_collector = &_runtime_filter_collector;
-    scanner_params.scan_ranges = hdfs_file_desc.splits;
-    scanner_params.fs = hdfs_file_desc.fs;
+    scanner_params.scan_ranges = scan_ranges;
+    scanner_params.fs = std::move(fs);
     scanner_params.tuple_desc = _tuple_desc;
     scanner_params.materialize_slots = _materialize_slots;
     scanner_params.materialize_index_in_chunk = _materialize_index_in_chunk;
@@ -179,6 +254,7 @@ Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFil
     scanner_params.min_max_conjunct_ctxs = _min_max_conjunct_ctxs;
     scanner_params.min_max_tuple_desc = _min_max_tuple_desc;
     scanner_params.hive_column_names = &_hive_column_names;
+    scanner_params.meta_cache = std::move(meta_cache);
     scanner_params.parent = this;
 
     HdfsScanner* scanner = nullptr;
@@ -429,6 +505,9 @@ Status HdfsScanNode::close(RuntimeState* state) {
         if (hdfsFile->hdfs_fs != nullptr && hdfsFile->hdfs_file != nullptr) {
             hdfsCloseFile(hdfsFile->hdfs_fs, hdfsFile->hdfs_file);
         }
+        for (auto* morsel_hdfs_file : hdfsFile->morsel_hdfs_files) {
+            hdfsCloseFile(hdfsFile->hdfs_fs, morsel_hdfs_file);
+        }
     }
 
     _close_pending_scanners();
@@ -556,6 +635,7 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
         hdfs_file_desc->fs = std::make_shared<HdfsRandomAccessFile>(hdfs, file, native_file_path);
         hdfs_file_desc->partition_id = scan_range.partition_id;
         hdfs_file_desc->path = scan_range.relative_path;
+        hdfs_file_desc->native_path = native_file_path;
         hdfs_file_desc->file_length = scan_range.file_length;
         hdfs_file_desc->splits.emplace_back(&scan_range);
         hdfs_file_desc->hdfs_file_format = scan_range.file_format;
@@ -624,6 +704,10 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     // reader init
     _footer_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitFooterRead");
     _column_reader_init_timer = ADD_TIMER(_runtime_profile, "ReaderInitColumnReaderInit");
+    _page_index_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitPageIndexRead");
+
+    // page index
+    _page_index_filtered_rows_counter = ADD_COUNTER(_runtime_profile, "PageIndexFilterRows", TUnit::UNIT);
 
     // dict filter
     _group_chunk_read_timer = ADD_TIMER(_runtime_profile, "GroupChunkRead");
@@ -21,8 +21,13 @@ struct HdfsFileDesc {
 
     int partition_id = 0;
     std::string path;
+    std::string native_path;
     int64_t file_length = 0;
     std::vector<const THdfsScanRange*> splits;
+
+    // handles of the hdfs file opened for the morsels other than the first one,
+    // as a handle can not be read concurrently
+    std::vector<hdfsFile> morsel_hdfs_files;
 };
 
 class HdfsScanNode final : public starrocks::ScanNode {
@@ -78,7 +83,14 @@ private:
     void _init_partition_expr_map();
     bool _filter_partition(const std::vector<ExprContext*>& partition_exprs);
     Status _find_and_insert_hdfs_file(const THdfsScanRange& scan_range);
-    Status _create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc);
+    Status _create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc,
+                                    const std::vector<const THdfsScanRange*>& scan_ranges,
+                                    std::shared_ptr<RandomAccessFile> fs,
+                                    std::shared_ptr<HdfsFileMetaCache> meta_cache);
+    // split the scan ranges of the file into morsels of config::hdfs_scan_morsel_bytes
+    std::vector<std::vector<const THdfsScanRange*>> _split_into_morsels(const HdfsFileDesc& hdfs_file_desc);
+    // open another handle of the file for a morsel
+    Status _open_morsel_file(HdfsFileDesc* hdfs_file_desc, std::shared_ptr<RandomAccessFile>* file);
 
     bool _submit_scanner(HdfsScanner* scanner, bool blockable);
     void _scanner_thread(HdfsScanner* scanner);
@@ -175,6 +187,10 @@ private:
     // reader init
     RuntimeProfile::Counter* _footer_read_timer = nullptr;
     RuntimeProfile::Counter* _column_reader_init_timer = nullptr;
+    RuntimeProfile::Counter* _page_index_read_timer = nullptr;
+
+    // page index
+    RuntimeProfile::Counter* _page_index_filtered_rows_counter = nullptr;
 
     // dict filter
     RuntimeProfile::Counter* _group_chunk_read_timer = nullptr;
@@ -92,6 +92,7 @@ void HdfsScanner::_build_file_read_param() {
     param.min_max_tuple_desc = _scanner_params.min_max_tuple_desc;
     param.timezone = _runtime_state->timezone();
     param.stats = &_stats;
+    param.meta_cache = _scanner_params.meta_cache.get();
 }
 
 Status HdfsScanner::get_next(RuntimeState* runtime_state, ChunkPtr* chunk) {
@@ -219,6 +220,8 @@ void HdfsParquetScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_page_read_timer, _stats.page_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_footer_read_timer, _stats.footer_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_reader_init_timer, _stats.column_reader_init_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_page_index_read_timer, _stats.page_index_read_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_page_index_filtered_rows_counter, _stats.page_index_filtered_rows);
     COUNTER_UPDATE(_scanner_params.parent->_group_chunk_read_timer, _stats.group_chunk_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_group_dict_filter_timer, _stats.group_dict_filter_ns);
     COUNTER_UPDATE(_scanner_params.parent->_group_dict_decode_timer, _stats.group_dict_decode_ns);
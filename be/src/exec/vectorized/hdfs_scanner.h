@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <utility>
 
 #include "column/chunk.h"
@@ -11,7 +12,8 @@
 #include "util/runtime_profile.h"
 namespace starrocks::parquet {
 class FileReader;
-}
+class FileMetaData;
+} // namespace starrocks::parquet
 namespace starrocks::vectorized {
 
 class HdfsScanNode;
@@ -31,12 +33,25 @@ struct HdfsScanStats {
     // reader init
     int64_t footer_read_ns = 0;
     int64_t column_reader_init_ns = 0;
+    // page index
+    int64_t page_index_read_ns = 0;
+    int64_t page_index_filtered_rows = 0;
     // dict filter
     int64_t group_chunk_read_ns = 0;
     int64_t group_dict_filter_ns = 0;
     int64_t group_dict_decode_ns = 0;
 };
 
+// Metadata of a file shared by the scanners of its morsels,
+// so that the footer is read and parsed by the first scanner only.
+struct HdfsFileMetaCache {
+    std::mutex mutex;
+    // footer of parquet file
+    std::shared_ptr<parquet::FileMetaData> parquet_metadata;
+    // serialized file tail of orc file
+    std::string orc_file_tail;
+};
+
 struct HdfsScannerParams {
     // one file split (parition_id, file_path, file_length, offset, length, file_format)
     std::vector<const THdfsScanRange*> scan_ranges;
@@ -76,6 +91,9 @@ struct HdfsScannerParams {
 
     std::vector<std::string>* hive_column_names;
 
+    // shared with the other scanners of the file if it is split into morsels
+    std::shared_ptr<HdfsFileMetaCache> meta_cache;
+
     HdfsScanNode* parent = nullptr;
 };
 
@@ -113,6 +131,8 @@ struct HdfsFileReaderParam {
 
     vectorized::HdfsScanStats* stats = nullptr;
 
+    HdfsFileMetaCache* meta_cache = nullptr;
+
     // set column names from file.
     // and to update not_existed slots and conjuncts.
     // and to update `conjunct_ctxs_by_slot` field.
@@ -308,9 +308,22 @@ Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
     auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs,
                                                             _scanner_params.scan_ranges[0]->file_length, &_stats);
     std::unique_ptr<orc::Reader> reader;
+    auto* meta_cache = _scanner_params.meta_cache.get();
     try {
         orc::ReaderOptions options;
-        reader = orc::createReader(std::move(input_stream), options);
+        if (meta_cache == nullptr) {
+            reader = orc::createReader(std::move(input_stream), options);
+        } else {
+            // the scanners of the other morsels of the file wait for the first one to read the file tail
+            std::lock_guard<std::mutex> l(meta_cache->mutex);
+            if (!meta_cache->orc_file_tail.empty()) {
+                options.setSerializedFileTail(meta_cache->orc_file_tail);
+            }
+            reader = orc::createReader(std::move(input_stream), options);
+            if (meta_cache->orc_file_tail.empty()) {
+                meta_cache->orc_file_tail = reader->getSerializedFileTail();
+            }
+        }
     } catch (std::exception& e) {
         auto s = strings::Substitute("HdfsOrcScanner::do_open failed. reason = $0", e.what());
         LOG(WARNING) << s;
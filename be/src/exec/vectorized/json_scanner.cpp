@@ -325,28 +325,55 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
     return Status::OK();
 }
 
-// read one json string from file read and parse it to json doc.
-Status JsonReader::_read_and_parse_json() {
+Status JsonReader::_read_next_message() {
 #ifdef BE_TEST
-    [[maybe_unused]] size_t message_size = 0;
     Slice result(_buf.data(), _buf_size);
     RETURN_IF_ERROR(_file->read(&result));
-    if (result.size == 0) {
-        return Status::EndOfFile("EOF of reading file");
-    }
-    _origin_json_doc.Parse(result.data, result.size);
+    _message_data = result.data;
+    _message_size = result.size;
 #else
-    std::unique_ptr<uint8_t[]> json_binary = nullptr;
-    size_t length = 0;
     StreamPipeSequentialFile* stream_file = reinterpret_cast<StreamPipeSequentialFile*>(_file.get());
-    RETURN_IF_ERROR(stream_file->read_one_message(&json_binary, &length));
-    if (length == 0) {
+    RETURN_IF_ERROR(stream_file->read_one_message(&_message));
+    _message_data = _message != nullptr ? _message->ptr + _message->pos : nullptr;
+    _message_size = _message != nullptr ? _message->remaining() : 0;
+#endif
+    _message_offset = 0;
+    if (_message_size == 0) {
         return Status::EndOfFile("EOF of reading file");
     }
-    _origin_json_doc.Parse((char*)json_binary.get(), length);
-#endif
+    return Status::OK();
+}
+
+void JsonReader::_skip_whitespaces() {
+    while (_message_offset < _message_size) {
+        char c = _message_data[_message_offset];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            break;
+        }
+        _message_offset++;
+    }
+}
+
+// parse the next json document of the current message, reading a new message when the current one is consumed.
+Status JsonReader::_read_and_parse_json() {
+    _skip_whitespaces();
+    while (_message_offset >= _message_size) {
+        RETURN_IF_ERROR(_read_next_message());
+        _skip_whitespaces();
+    }
+
+    // Release the values of the previous document, the allocator of the document only grows otherwise.
+    _json_doc = nullptr;
+    _origin_json_doc.SetNull();
+    _origin_json_doc.GetAllocator().Clear();
+
+    rapidjson::MemoryStream stream(_message_data + _message_offset, _message_size - _message_offset);
+    rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> input(stream);
+    _origin_json_doc.ParseStream<rapidjson::kParseStopWhenDoneFlag>(input);
 
     if (_origin_json_doc.HasParseError()) {
+        // The end of a malformed document is unknown, skip the rest of the message.
+        _message_offset = _message_size;
         std::string err_msg = strings::Substitute("Failed to parse string to json. code=$0, error=$1",
                                                   _origin_json_doc.GetParseError(),
                                                   rapidjson::GetParseError_En(_origin_json_doc.GetParseError()));
@@ -354,6 +381,7 @@ Status JsonReader::_read_and_parse_json() {
         _counter->num_rows_filtered++;
         return Status::DataQualityError(err_msg.c_str());
     }
+    _message_offset += input.Tell();
 
     _json_doc = &_origin_json_doc;
     if (!_scanner->_root_paths.empty()) {
@@ -384,6 +412,11 @@ Status JsonReader::_read_and_parse_json() {
     return Status::OK();
 }
 
+void JsonReader::_append_string(Column* column, const Slice& value) {
+    _slices[0] = value;
+    column->append_strings(_slices);
+}
+
 void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column* column,
                                    const TypeDescriptor& type_desc) {
     if (objectValue.GetType() != rapidjson::kArrayType && type_desc.type == TYPE_ARRAY) {
@@ -398,35 +431,35 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
         break;
     }
     case rapidjson::Type::kFalseType: {
-        column->append_strings(std::vector<Slice>{Slice("0")});
+        _append_string(column, Slice("0"));
         break;
     }
     case rapidjson::Type::kTrueType: {
-        column->append_strings(std::vector<Slice>{Slice("1")});
+        _append_string(column, Slice("1"));
         break;
     }
     case rapidjson::Type::kNumberType: {
         if (objectValue.IsUint()) {
             auto f = fmt::format_int(objectValue.GetUint());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt()) {
             auto f = fmt::format_int(objectValue.GetInt());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsUint64()) {
             auto f = fmt::format_int(objectValue.GetUint64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt64()) {
             auto f = fmt::format_int(objectValue.GetInt64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else {
             int len = d2s_buffered_n(objectValue.GetDouble(), buf);
-            column->append_strings(std::vector<Slice>{Slice(buf, len)});
+            _append_string(column, Slice(buf, len));
         }
         break;
     }
     case rapidjson::Type::kStringType: {
         const char* str_value = objectValue.GetString();
-        column->append_strings(std::vector<Slice>{Slice(str_value, objectValue.GetStringLength())});
+        _append_string(column, Slice(str_value, objectValue.GetStringLength()));
         break;
     }
     case rapidjson::Type::kArrayType: {
@@ -445,13 +478,13 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
             offsets->append_numbers(&size, 4);
         } else {
             std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-            column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+            _append_string(column, Slice(json_str.c_str(), json_str.length()));
         }
         break;
     }
     case rapidjson::Type::kObjectType: {
         std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-        column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+        _append_string(column, Slice(json_str.c_str(), json_str.length()));
         break;
     }
     }
@@ -8,7 +8,9 @@ DIAGNOSTIC_IGNORE("-Wclass-memaccess")
 #include <rapidjson/document.h>
 DIAGNOSTIC_POP
 
+#include <rapidjson/encodedstream.h>
 #include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -83,6 +85,9 @@ public:
 
 private:
     Status _read_and_parse_json();
+    Status _read_next_message();
+    void _skip_whitespaces();
+    void _append_string(Column* column, const Slice& value);
     void _construct_column(const rapidjson::Value& objectValue, Column* column, const TypeDescriptor& type_desc);
 
 private:
@@ -102,6 +107,18 @@ private:
     rapidjson::Document _origin_json_doc;  // origin json document object from parsed json string
     rapidjson::Value* _json_doc = nullptr; // _json_doc equals _final_json_doc iff not set `json_root`
 
+    // The message being parsed. It holds one JSON document, or several ones separated by
+    // whitespaces (NDJSON) which are parsed one after another from the same buffer.
+    // The buffer may be the one received by the stream load pipe, which is not copied.
+    ByteBufferPtr _message;
+    const char* _message_data = nullptr;
+    size_t _message_size = 0;
+    // The position of the next document in the message.
+    size_t _message_offset = 0;
+
+    // Reused by _append_string(), Column only appends strings in batches.
+    std::vector<Slice> _slices{1};
+
     // only used in unit test.
     // TODO: The semantics of Streaming Load And Routine Load is non-consistent.
     //       Import a json library supporting streaming parse.
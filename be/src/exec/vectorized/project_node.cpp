@@ -2,6 +2,7 @@
 
 #include "exec/vectorized/project_node.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/chunk.h"
@@ -13,6 +14,7 @@
 #include "exec/pipeline/project_operator.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/common_sub_expr.h"
 #include "exprs/vectorized/runtime_filter.h"
 #include "runtime/runtime_state.h"
 
@@ -36,15 +38,37 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         slot_null_mapping[slot->id()] = slot->is_nullable();
     }
 
+    std::vector<TExpr> exprs;
+    exprs.reserve(column_size);
     for (auto const& [key, val] : tnode.project_node.slot_map) {
         _slot_ids.emplace_back(key);
+        exprs.emplace_back(val);
+        _type_is_nullable.emplace_back(slot_null_mapping[key]);
+    }
+
+    // The subtrees repeated in the output expressions are computed once, after the common
+    // sub-expressions of the plan, which they may refer to.
+    std::vector<std::pair<SlotId, TExpr>> eliminated_exprs;
+    if (config::enable_projection_common_sub_expr_elimination) {
+        SlotId next_slot_id = state->desc_tbl().max_slot_id() + 1;
+        if (!tnode.project_node.common_slot_map.empty()) {
+            next_slot_id = std::max(next_slot_id, tnode.project_node.common_slot_map.rbegin()->first + 1);
+        }
+        std::vector<TExpr*> targets;
+        targets.reserve(exprs.size());
+        for (auto& expr : exprs) {
+            targets.push_back(&expr);
+        }
+        _num_saved_evaluations = eliminate_common_sub_exprs(targets, next_slot_id, &eliminated_exprs);
+    }
+
+    for (const auto& expr : exprs) {
         ExprContext* context;
-        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, expr, &context));
         _expr_ctxs.emplace_back(context);
-        _type_is_nullable.emplace_back(slot_null_mapping[key]);
     }
 
-    size_t common_sub_column_size = tnode.project_node.common_slot_map.size();
+    size_t common_sub_column_size = tnode.project_node.common_slot_map.size() + eliminated_exprs.size();
     _common_sub_expr_ctxs.reserve(common_sub_column_size);
     _common_sub_slot_ids.reserve(common_sub_column_size);
 
@@ -54,6 +78,12 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _common_sub_slot_ids.emplace_back(key);
         _common_sub_expr_ctxs.emplace_back(context);
     }
+    for (auto const& [key, val] : eliminated_exprs) {
+        ExprContext* context;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
+        _common_sub_slot_ids.emplace_back(key);
+        _common_sub_expr_ctxs.emplace_back(context);
+    }
 
     return Status::OK();
 }
@@ -67,6 +97,7 @@ Status ProjectNode::prepare(RuntimeState* state) {
 
     _expr_compute_timer = ADD_TIMER(runtime_profile(), "ExprComputeTime");
     _common_sub_expr_compute_timer = ADD_TIMER(runtime_profile(), "CommonSubExprComputeTime");
+    _saved_evaluations_counter = ADD_COUNTER(runtime_profile(), "CommonSubExprSavedEvaluations", TUnit::UNIT);
     return Status::OK();
 }
 
@@ -105,14 +136,22 @@ Status ProjectNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         for (size_t i = 0; i < _common_sub_slot_ids.size(); ++i) {
             (*chunk)->append_column(_common_sub_expr_ctxs[i]->evaluate((*chunk).get()), _common_sub_slot_ids[i]);
         }
+        COUNTER_UPDATE(_saved_evaluations_counter, _num_saved_evaluations);
     }
 
     // ToDo(kks): we could reuse result columns, if the parent node isn't sort node
     Columns result_columns(_slot_ids.size());
+    std::vector<const Column*> evaluated(_slot_ids.size());
     {
         SCOPED_TIMER(_expr_compute_timer);
         for (size_t i = 0; i < _slot_ids.size(); ++i) {
             result_columns[i] = _expr_ctxs[i]->evaluate((*chunk).get());
+            evaluated[i] = result_columns[i].get();
+            // The outputs referring to the same common sub-expression get the same column,
+            // which must not be shared by the result columns.
+            if (std::find(evaluated.begin(), evaluated.begin() + i, evaluated[i]) != evaluated.begin() + i) {
+                result_columns[i] = result_columns[i]->clone_shared();
+            }
 
             if (result_columns[i]->only_null()) {
                 result_columns[i] = ColumnHelper::create_column(_expr_ctxs[i]->root()->type(), true);
@@ -224,7 +263,9 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
         }
         bool match = false;
         for (int i = 0; i < _slot_ids.size(); i++) {
-            if (_slot_ids[i] == slot_id) {
+            // The common sub-expressions are only computed in this node, the expressions
+            // referring to them cannot be evaluated below it.
+            if (_slot_ids[i] == slot_id && !_refers_to_common_sub_exprs(_expr_ctxs[i])) {
                 // replace with new probe expr
                 ExprContext* new_probe_expr_ctx = _expr_ctxs[i];
                 rf_desc->replace_probe_expr_ctx(state, row_desc(), expr_mem_tracker(), new_probe_expr_ctx);
@@ -247,12 +288,25 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
     }
 }
 
+bool ProjectNode::_refers_to_common_sub_exprs(ExprContext* ctx) const {
+    std::vector<SlotId> slot_ids;
+    ctx->root()->get_slot_ids(&slot_ids);
+    for (SlotId slot_id : slot_ids) {
+        if (std::find(_common_sub_slot_ids.begin(), _common_sub_slot_ids.end(), slot_id) !=
+            _common_sub_slot_ids.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 pipeline::OpFactories ProjectNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators = _children[0]->decompose_to_pipeline(context);
     operators.emplace_back(std::make_shared<ProjectOperatorFactory>(
             context->next_operator_id(), id(), std::move(_slot_ids), std::move(_expr_ctxs),
-            std::move(_type_is_nullable), std::move(_common_sub_slot_ids), std::move(_common_sub_expr_ctxs)));
+            std::move(_type_is_nullable), std::move(_common_sub_slot_ids), std::move(_common_sub_expr_ctxs),
+            _num_saved_evaluations));
     if (limit() != -1) {
         operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
     }
@@ -31,15 +31,20 @@ public:
             pipeline::PipelineBuilderContext* context) override;
 
 private:
+    bool _refers_to_common_sub_exprs(ExprContext* ctx) const;
+
     std::vector<SlotId> _slot_ids;
     std::vector<ExprContext*> _expr_ctxs;
     std::vector<bool> _type_is_nullable;
 
     std::vector<SlotId> _common_sub_slot_ids;
     std::vector<ExprContext*> _common_sub_expr_ctxs;
+    // Evaluations of subtrees saved per chunk by the common sub-expressions found in init().
+    int64_t _num_saved_evaluations = 0;
 
     RuntimeProfile::Counter* _expr_compute_timer = nullptr;
     RuntimeProfile::Counter* _common_sub_expr_compute_timer = nullptr;
+    RuntimeProfile::Counter* _saved_evaluations_counter = nullptr;
 };
 
 } // namespace starrocks::vectorized
\ No newline at end of file
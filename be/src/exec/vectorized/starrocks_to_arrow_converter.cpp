@@ -0,0 +1,222 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/starrocks_to_arrow_converter.h"
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
+#include <arrow/type.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/date_value.h"
+#include "runtime/large_int_value.h"
+#include "runtime/timestamp_value.h"
+#include "simd/simd.h"
+#include "util/arrow/utils.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+// A buffer on the memory of a column, which it keeps alive.
+class ColumnBuffer final : public arrow::Buffer {
+public:
+    ColumnBuffer(const void* data, size_t size, ColumnPtr column)
+            : arrow::Buffer(static_cast<const uint8_t*>(data), size), _column(std::move(column)) {}
+
+private:
+    ColumnPtr _column;
+};
+
+template <PrimitiveType PT>
+std::shared_ptr<arrow::Buffer> values_buffer(const ColumnPtr& column) {
+    const auto& data = down_cast<const RunTimeColumnType<PT>*>(column.get())->get_data();
+    return std::make_shared<ColumnBuffer>(data.data(), data.size() * sizeof(RunTimeCppType<PT>), column);
+}
+
+// Pack |flags|, one byte per row, into an Arrow bitmap, in which a set bit is a non-zero flag
+// when |set_if_zero| is false and a zero flag otherwise.
+Status pack_bitmap(const uint8_t* flags, size_t rows, bool set_if_zero, arrow::MemoryPool* pool,
+                   std::shared_ptr<arrow::Buffer>* bitmap) {
+    RETURN_IF_ERROR(to_status(arrow::AllocateBuffer(pool, (rows + 7) / 8, bitmap)));
+    uint8_t* bits = (*bitmap)->mutable_data();
+    for (size_t i = 0; i < rows; i += 8) {
+        size_t n = std::min<size_t>(8, rows - i);
+        uint8_t byte = 0;
+        for (size_t j = 0; j < n; j++) {
+            byte |= static_cast<uint8_t>((flags[i + j] == 0) == set_if_zero) << j;
+        }
+        bits[i / 8] = byte;
+    }
+    return Status::OK();
+}
+
+// The values of a date, datetime or largeint column as strings.
+ColumnPtr to_binary_column(const TypeDescriptor& type, const Column& column) {
+    auto binary = BinaryColumn::create();
+    size_t rows = column.size();
+    binary->reserve(rows);
+    switch (type.type) {
+    case TYPE_DATE: {
+        const auto& data = down_cast<const DateColumn&>(column).get_data();
+        for (size_t i = 0; i < rows; i++) {
+            binary->append(data[i].to_string());
+        }
+        break;
+    }
+    case TYPE_DATETIME: {
+        const auto& data = down_cast<const TimestampColumn&>(column).get_data();
+        for (size_t i = 0; i < rows; i++) {
+            binary->append(data[i].to_string());
+        }
+        break;
+    }
+    case TYPE_LARGEINT: {
+        const auto& data = down_cast<const Int128Column&>(column).get_data();
+        char buf[48];
+        for (size_t i = 0; i < rows; i++) {
+            int len = sizeof(buf);
+            char* begin = LargeIntValue::to_string(data[i], buf, &len);
+            binary->append(Slice(begin, len));
+        }
+        break;
+    }
+    default:
+        DCHECK(false) << "unexpected type " << type.debug_string();
+        break;
+    }
+    return binary;
+}
+
+} // namespace
+
+Status to_arrow_type(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* result) {
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        *result = arrow::boolean();
+        break;
+    case TYPE_TINYINT:
+        *result = arrow::int8();
+        break;
+    case TYPE_SMALLINT:
+        *result = arrow::int16();
+        break;
+    case TYPE_INT:
+        *result = arrow::int32();
+        break;
+    case TYPE_BIGINT:
+        *result = arrow::int64();
+        break;
+    case TYPE_FLOAT:
+        *result = arrow::float32();
+        break;
+    case TYPE_DOUBLE:
+    case TYPE_TIME:
+        *result = arrow::float64();
+        break;
+    case TYPE_DECIMALV2:
+        *result = arrow::decimal(27, 9);
+        break;
+    case TYPE_DECIMAL128:
+        *result = arrow::decimal(type.precision, type.scale);
+        break;
+    case TYPE_VARCHAR:
+    case TYPE_CHAR:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_LARGEINT:
+        *result = arrow::utf8();
+        break;
+    default:
+        return Status::NotSupported(
+                strings::Substitute("type $0 cannot be converted to an Arrow type", type.debug_string()));
+    }
+    return Status::OK();
+}
+
+Status convert_column_to_arrow(const TypeDescriptor& type, const ColumnPtr& column, arrow::MemoryPool* pool,
+                               std::shared_ptr<arrow::Array>* result) {
+    std::shared_ptr<arrow::DataType> arrow_type;
+    RETURN_IF_ERROR(to_arrow_type(type, &arrow_type));
+
+    size_t rows = column->size();
+    ColumnPtr data_column = ColumnHelper::unfold_const_column(type, rows, column);
+    std::shared_ptr<arrow::Buffer> validity;
+    int64_t null_count = 0;
+    if (data_column->is_nullable()) {
+        auto* nullable = down_cast<NullableColumn*>(data_column.get());
+        if (nullable->has_null()) {
+            const uint8_t* nulls = nullable->null_column()->get_data().data();
+            null_count = SIMD::count_nonzero(nulls, rows);
+            RETURN_IF_ERROR(pack_bitmap(nulls, rows, true, pool, &validity));
+        }
+        data_column = nullable->data_column();
+    }
+    if (type.type == TYPE_DATE || type.type == TYPE_DATETIME || type.type == TYPE_LARGEINT) {
+        data_column = to_binary_column(type, *data_column);
+    }
+
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers{validity};
+    switch (type.type) {
+    case TYPE_BOOLEAN: {
+        // Booleans are bytes in columns and bits in Arrow.
+        std::shared_ptr<arrow::Buffer> values;
+        const uint8_t* data = down_cast<BooleanColumn*>(data_column.get())->get_data().data();
+        RETURN_IF_ERROR(pack_bitmap(data, rows, false, pool, &values));
+        buffers.push_back(std::move(values));
+        break;
+    }
+    case TYPE_TINYINT:
+        buffers.push_back(values_buffer<TYPE_TINYINT>(data_column));
+        break;
+    case TYPE_SMALLINT:
+        buffers.push_back(values_buffer<TYPE_SMALLINT>(data_column));
+        break;
+    case TYPE_INT:
+        buffers.push_back(values_buffer<TYPE_INT>(data_column));
+        break;
+    case TYPE_BIGINT:
+        buffers.push_back(values_buffer<TYPE_BIGINT>(data_column));
+        break;
+    case TYPE_FLOAT:
+        buffers.push_back(values_buffer<TYPE_FLOAT>(data_column));
+        break;
+    case TYPE_DOUBLE:
+        buffers.push_back(values_buffer<TYPE_DOUBLE>(data_column));
+        break;
+    case TYPE_TIME:
+        buffers.push_back(values_buffer<TYPE_TIME>(data_column));
+        break;
+    // Both are 128 bit little endian integers of the unscaled value.
+    case TYPE_DECIMALV2:
+        buffers.push_back(values_buffer<TYPE_DECIMALV2>(data_column));
+        break;
+    case TYPE_DECIMAL128:
+        buffers.push_back(values_buffer<TYPE_DECIMAL128>(data_column));
+        break;
+    default: {
+        const auto* binary = down_cast<const BinaryColumn*>(data_column.get());
+        const auto& offsets = binary->get_offset();
+        const auto& bytes = binary->get_bytes();
+        if (bytes.size() > std::numeric_limits<int32_t>::max()) {
+            return Status::NotSupported("strings of more than 2GB cannot be converted to an Arrow array");
+        }
+        buffers.push_back(std::make_shared<ColumnBuffer>(offsets.data(), offsets.size() * sizeof(uint32_t),
+                                                         data_column));
+        buffers.push_back(std::make_shared<ColumnBuffer>(bytes.data(), bytes.size(), data_column));
+        break;
+    }
+    }
+
+    *result = arrow::MakeArray(arrow::ArrayData::Make(arrow_type, rows, std::move(buffers), null_count));
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,31 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "runtime/types.h"
+
+namespace arrow {
+class Array;
+class DataType;
+class MemoryPool;
+} // namespace arrow
+
+namespace starrocks::vectorized {
+
+// The Arrow type the columns of |type| are converted to. Dates, datetimes and largeints are
+// converted to strings, like in the row based conversion.
+Status to_arrow_type(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* result);
+
+// Convert |column|, whose values are of |type|, to an Arrow array of to_arrow_type(type).
+// Fixed-length values and the bytes and offsets of strings have the same layout in both and
+// are shared with the array, which keeps the column alive, so the column must not be modified
+// while the array is in use. Only the null flags are packed into a bitmap, and the types
+// converted to strings are copied. Buffers allocated by the conversion come from |pool|.
+Status convert_column_to_arrow(const TypeDescriptor& type, const ColumnPtr& column, arrow::MemoryPool* pool,
+                               std::shared_ptr<arrow::Array>* result);
+
+} // namespace starrocks::vectorized
@@ -192,9 +192,18 @@ void OlapTablePartitionParam::find_tablets(Chunk* chunk, std::vector<OlapTablePa
         ChunkRow row;
         row.columns = &partition_columns;
         row.index = 0;
+        // Rows of a chunk usually come in runs of the same partition, e.g. loaded in time order,
+        // so the partition of the previous row is checked before searching the partitions map.
+        OlapTablePartition* last_partition = nullptr;
         for (size_t i = 0; i < num_rows; ++i) {
             if ((*selection)[i]) {
                 row.index = i;
+                if (last_partition != nullptr && PartionKeyComparator()(&row, &last_partition->end_key) &&
+                    _part_contains(last_partition, &row)) {
+                    (*partitions)[i] = last_partition;
+                    (*indexes)[i] = (*indexes)[i] % last_partition->num_buckets;
+                    continue;
+                }
                 auto it = _partitions_map.upper_bound(&row);
                 if (UNLIKELY(it == _partitions_map.end())) {
                     (*partitions)[i] = nullptr;
@@ -205,6 +214,7 @@ void OlapTablePartitionParam::find_tablets(Chunk* chunk, std::vector<OlapTablePa
                 } else if (LIKELY(_part_contains(it->second, &row))) {
                     (*partitions)[i] = it->second;
                     (*indexes)[i] = (*indexes)[i] % it->second->num_buckets;
+                    last_partition = it->second;
                 } else {
                     (*partitions)[i] = nullptr;
                     (*selection)[i] = 0;
@@ -23,6 +23,7 @@
 
 #include <gperftools/profiler.h>
 
+#include <algorithm>
 #include <sstream>
 
 #include "exprs/anyval_util.h"
@@ -439,4 +440,31 @@ ColumnPtr ExprContext::evaluate(Expr* e, vectorized::Chunk* chunk) {
     return ptr;
 }
 
+void ExprContext::update_conjunct_stats(size_t input_rows, size_t output_rows, int64_t cost_ns) {
+    // Halve the statistics from time to time, so that recent chunks weigh more.
+    constexpr int64_t kDecayRows = 1 << 20;
+    if (_conjunct_input_rows.fetch_add(input_rows, std::memory_order_relaxed) > kDecayRows) {
+        _conjunct_input_rows.store(_conjunct_input_rows.load(std::memory_order_relaxed) / 2,
+                                   std::memory_order_relaxed);
+        _conjunct_output_rows.store(_conjunct_output_rows.load(std::memory_order_relaxed) / 2,
+                                    std::memory_order_relaxed);
+        _conjunct_cost_ns.store(_conjunct_cost_ns.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+    _conjunct_output_rows.fetch_add(output_rows, std::memory_order_relaxed);
+    _conjunct_cost_ns.fetch_add(cost_ns, std::memory_order_relaxed);
+}
+
+double ExprContext::conjunct_rank() const {
+    constexpr int64_t kMinRows = 8192;
+    int64_t input_rows = _conjunct_input_rows.load(std::memory_order_relaxed);
+    if (input_rows < kMinRows) {
+        return -1;
+    }
+    int64_t output_rows = std::min(_conjunct_output_rows.load(std::memory_order_relaxed), input_rows);
+    double cost_per_row = double(_conjunct_cost_ns.load(std::memory_order_relaxed)) / input_rows;
+    // Conjuncts filtering nothing get a large but finite rank, ordered by their cost.
+    double filtered_ratio = std::max(double(input_rows - output_rows) / input_rows, 0.001);
+    return cost_per_row / filtered_ratio;
+}
+
 } // namespace starrocks
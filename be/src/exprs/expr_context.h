@@ -182,6 +182,21 @@ public:
 
     ColumnPtr evaluate(Expr* expr, vectorized::Chunk* chunk);
 
+    // Record an evaluation of this context as a conjunct, which kept |output_rows| of
+    // |input_rows| rows and took |cost_ns|. May be called concurrently by the operators
+    // sharing this context.
+    void update_conjunct_stats(size_t input_rows, size_t output_rows, int64_t cost_ns);
+
+    // Whether this evaluation of the conjunct should be measured, only one out of
+    // kConjunctStatsInterval evaluations is.
+    bool sample_conjunct_stats() {
+        return _conjunct_evals.fetch_add(1, std::memory_order_relaxed) % kConjunctStatsInterval == 0;
+    }
+
+    // The measured cost in nano-seconds per row filtered out by this conjunct, the lower
+    // the earlier it should be evaluated. Negative before enough rows were seen.
+    double conjunct_rank() const;
+
 private:
     friend class Expr;
     friend class ScalarFnCall;
@@ -219,6 +234,13 @@ private:
     // In operator, the ExprContext::close method will be called concurrently
     std::atomic<bool> _closed;
 
+    // Statistics of the evaluations as a conjunct, decayed so that they follow the data.
+    std::atomic<int64_t> _conjunct_input_rows{0};
+    std::atomic<int64_t> _conjunct_output_rows{0};
+    std::atomic<int64_t> _conjunct_cost_ns{0};
+    static constexpr int64_t kConjunctStatsInterval = 8;
+    std::atomic<int64_t> _conjunct_evals{0};
+
     /// Calls the appropriate Get*Val() function on 'e' and stores the result in result_.
     /// This is used by Exprs to call GetValue() on a child expr, rather than root_.
     void* get_value(Expr* e, TupleRow* row);
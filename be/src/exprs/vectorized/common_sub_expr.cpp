@@ -0,0 +1,176 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+#include "common/logging.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+// The nodes [begin, end) of exprs[expr], a subtree in depth-first order.
+struct Subtree {
+    size_t expr;
+    size_t begin;
+    size_t end;
+
+    size_t size() const { return end - begin; }
+};
+
+bool is_non_deterministic(const TExprNode& node) {
+    if (!node.__isset.fn) {
+        return false;
+    }
+    const std::string& name = node.fn.name.function_name;
+    return name == "rand" || name == "random" || name == "sleep";
+}
+
+// Set ends[i] to the end of the subtree rooted at nodes[i], for the nodes of the subtree
+// rooted at nodes[begin], and return the end of the latter.
+size_t fill_subtree_ends(const std::vector<TExprNode>& nodes, size_t begin, std::vector<size_t>* ends) {
+    DCHECK_LT(begin, nodes.size());
+    size_t end = begin + 1;
+    for (int i = 0; i < nodes[begin].num_children; i++) {
+        end = fill_subtree_ends(nodes, end, ends);
+    }
+    (*ends)[begin] = end;
+    return end;
+}
+
+// The subtrees worth computing once: the ones with children, with slot references and
+// without non-deterministic functions.
+void collect_candidates(const std::vector<TExpr*>& exprs, std::vector<Subtree>* candidates) {
+    for (size_t e = 0; e < exprs.size(); e++) {
+        const auto& nodes = exprs[e]->nodes;
+        if (nodes.empty()) {
+            continue;
+        }
+        std::vector<size_t> ends(nodes.size());
+        fill_subtree_ends(nodes, 0, &ends);
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i].num_children == 0) {
+                continue;
+            }
+            bool has_slot_ref = false;
+            bool is_deterministic = true;
+            for (size_t j = i; j < ends[i] && is_deterministic; j++) {
+                has_slot_ref |= nodes[j].node_type == TExprNodeType::SLOT_REF;
+                is_deterministic = !is_non_deterministic(nodes[j]);
+            }
+            if (has_slot_ref && is_deterministic) {
+                candidates->push_back({e, i, ends[i]});
+            }
+        }
+    }
+}
+
+bool equals(const std::vector<TExpr*>& exprs, const Subtree& lhs, const Subtree& rhs) {
+    const auto& lhs_nodes = exprs[lhs.expr]->nodes;
+    const auto& rhs_nodes = exprs[rhs.expr]->nodes;
+    return lhs.size() == rhs.size() && std::equal(lhs_nodes.begin() + lhs.begin, lhs_nodes.begin() + lhs.end,
+                                                  rhs_nodes.begin() + rhs.begin);
+}
+
+// A reference to |slot_id| holding the result of the subtree rooted at |root|.
+TExprNode make_slot_ref(const TExprNode& root, SlotId slot_id) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = root.type;
+    node.num_children = 0;
+    node.output_scale = root.output_scale;
+    TSlotRef slot_ref;
+    slot_ref.slot_id = slot_id;
+    slot_ref.tuple_id = 0;
+    node.__set_slot_ref(slot_ref);
+    if (root.__isset.use_vectorized) {
+        node.__set_use_vectorized(root.use_vectorized);
+    }
+    if (root.__isset.is_nullable) {
+        node.__set_is_nullable(root.is_nullable);
+    }
+    return node;
+}
+
+} // namespace
+
+int64_t eliminate_common_sub_exprs(const std::vector<TExpr*>& exprs, SlotId next_slot_id,
+                                   std::vector<std::pair<SlotId, TExpr>>* common_sub_exprs) {
+    // The extracted subtrees are rewritten as well, they may contain smaller common subtrees.
+    std::vector<TExpr*> targets = exprs;
+    std::deque<TExpr> extracted;
+    std::vector<SlotId> extracted_slot_ids;
+    int64_t saved_evaluations = 0;
+
+    while (true) {
+        std::vector<Subtree> candidates;
+        collect_candidates(targets, &candidates);
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const Subtree& lhs, const Subtree& rhs) { return lhs.size() > rhs.size(); });
+
+        // The occurrences of the largest subtree occurring more than once. Equal subtrees
+        // have the same size, so none of them contains another.
+        std::vector<Subtree> occurrences;
+        for (size_t i = 0; i < candidates.size() && occurrences.empty(); i++) {
+            for (size_t j = i + 1; j < candidates.size() && candidates[j].size() == candidates[i].size(); j++) {
+                if (equals(targets, candidates[i], candidates[j])) {
+                    if (occurrences.empty()) {
+                        occurrences.push_back(candidates[i]);
+                    }
+                    occurrences.push_back(candidates[j]);
+                }
+            }
+        }
+        if (occurrences.empty()) {
+            break;
+        }
+
+        SlotId slot_id = next_slot_id++;
+        const Subtree& first = occurrences[0];
+        const auto& first_nodes = targets[first.expr]->nodes;
+        TExpr common;
+        common.nodes.assign(first_nodes.begin() + first.begin, first_nodes.begin() + first.end);
+        TExprNode slot_ref = make_slot_ref(common.nodes[0], slot_id);
+
+        // Replace from the back, so that the positions of the other occurrences stay valid.
+        std::sort(occurrences.begin(), occurrences.end(), [](const Subtree& lhs, const Subtree& rhs) {
+            return lhs.expr != rhs.expr ? lhs.expr > rhs.expr : lhs.begin > rhs.begin;
+        });
+        for (const Subtree& occurrence : occurrences) {
+            auto& nodes = targets[occurrence.expr]->nodes;
+            nodes.erase(nodes.begin() + occurrence.begin + 1, nodes.begin() + occurrence.end);
+            nodes[occurrence.begin] = slot_ref;
+        }
+        saved_evaluations += occurrences.size() - 1;
+
+        extracted.emplace_back(std::move(common));
+        targets.push_back(&extracted.back());
+        extracted_slot_ids.push_back(slot_id);
+    }
+
+    // Order the extracted subtrees after the ones they refer to.
+    std::unordered_set<SlotId> pending(extracted_slot_ids.begin(), extracted_slot_ids.end());
+    std::vector<bool> emitted(extracted.size(), false);
+    for (size_t num_emitted = 0; num_emitted < extracted.size();) {
+        for (size_t i = 0; i < extracted.size(); i++) {
+            if (emitted[i]) {
+                continue;
+            }
+            bool ready = std::none_of(extracted[i].nodes.begin(), extracted[i].nodes.end(), [&](const TExprNode& n) {
+                return n.node_type == TExprNodeType::SLOT_REF && pending.count(n.slot_ref.slot_id) > 0;
+            });
+            if (ready) {
+                pending.erase(extracted_slot_ids[i]);
+                emitted[i] = true;
+                num_emitted++;
+                common_sub_exprs->emplace_back(extracted_slot_ids[i], std::move(extracted[i]));
+            }
+        }
+    }
+    return saved_evaluations;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,28 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/global_types.h"
+#include "gen_cpp/Exprs_types.h"
+
+namespace starrocks::vectorized {
+
+// Common sub-expression elimination of the expressions of a projection.
+//
+// The output expressions of a projection often repeat costly subtrees, e.g. substr(url, ...),
+// parse_url(url, 'HOST') or casts used by several columns, which are otherwise computed for
+// every occurrence. The subtrees that occur more than once in |exprs| are moved to common
+// sub-expressions, computed once per chunk into new slots numbered from |next_slot_id|, and
+// their occurrences are replaced with references to these slots. Subtrees without slot
+// references or with non-deterministic functions are kept as they are.
+//
+// The common sub-expressions are appended to |common_sub_exprs|, in an order in which each
+// one only refers to the input slots and to the slots of the ones before it. Returns the
+// number of subtree evaluations saved per chunk.
+int64_t eliminate_common_sub_exprs(const std::vector<TExpr*>& exprs, SlotId next_slot_id,
+                                   std::vector<std::pair<SlotId, TExpr>>* common_sub_exprs);
+
+} // namespace starrocks::vectorized
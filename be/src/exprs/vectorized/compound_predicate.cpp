@@ -2,14 +2,132 @@
 
 #include "exprs/vectorized/compound_predicate.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "column/nullable_column.h"
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
 #include "exprs/vectorized/binary_function.h"
 #include "exprs/vectorized/unary_function.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks {
 namespace vectorized {
 
+// Evaluates the right child of AND/OR, either on all the rows or only on the rows whose
+// result is not decided by the left child yet. The latter costs gathering the columns the
+// right child reads and scattering its result back, which is worth it when few rows are
+// left and the right child is expensive, e.g. a LIKE after a cheap comparison. The cost
+// per row of the right child is measured on every evaluation to make that choice.
+class RightChildEvaluator {
+public:
+    RightChildEvaluator() = default;
+    RightChildEvaluator(const RightChildEvaluator& other) : _ns_per_row(other._ns_per_row.load()) {}
+
+    // |decided_value|: the rows where |left| is not null and equal to it have their result
+    // decided, there are |num_undecided| other rows.
+    ColumnPtr evaluate(ExprContext* context, Expr* right, Chunk* chunk, const ColumnPtr& left, uint8_t decided_value,
+                       size_t num_undecided) {
+        size_t num_rows = left->size();
+        double ns_per_row = _ns_per_row.load(std::memory_order_relaxed);
+        std::vector<SlotId> slot_ids;
+        if (chunk != nullptr && !left->is_constant() && ns_per_row > 0 && num_undecided < num_rows) {
+            right->get_slot_ids(&slot_ids);
+            std::sort(slot_ids.begin(), slot_ids.end());
+            slot_ids.erase(std::unique(slot_ids.begin(), slot_ids.end()), slot_ids.end());
+        }
+        double selective_cost = num_undecided * (ns_per_row + kScatterNsPerValue * (slot_ids.size() + 1));
+        if (slot_ids.empty() || selective_cost >= num_rows * ns_per_row) {
+            MonotonicStopWatch watch;
+            watch.start();
+            ColumnPtr result = right->evaluate(context, chunk);
+            _update_cost(watch.elapsed_time(), num_rows);
+            return result;
+        }
+
+        std::vector<uint32_t> indexes;
+        indexes.reserve(num_undecided);
+        const Column* left_data = left.get();
+        const uint8_t* left_nulls = nullptr;
+        if (left->is_nullable()) {
+            const auto* nullable = down_cast<const NullableColumn*>(left_data);
+            left_nulls = nullable->immutable_null_column_data().data();
+            left_data = nullable->data_column().get();
+        }
+        const uint8_t* left_values = down_cast<const BooleanColumn*>(left_data)->get_data().data();
+        for (uint32_t i = 0; i < num_rows; i++) {
+            if ((left_nulls != nullptr && left_nulls[i]) || (left_values[i] != 0) != decided_value) {
+                indexes.push_back(i);
+            }
+        }
+
+        Chunk undecided;
+        for (SlotId slot_id : slot_ids) {
+            if (!chunk->is_slot_exist(slot_id)) {
+                return right->evaluate(context, chunk);
+            }
+            const ColumnPtr& src = chunk->get_column_by_slot_id(slot_id);
+            ColumnPtr dst = src->clone_empty();
+            dst->append_selective(*src, indexes.data(), 0, indexes.size());
+            undecided.append_column(std::move(dst), slot_id);
+        }
+        MonotonicStopWatch watch;
+        watch.start();
+        ColumnPtr result = right->evaluate(context, &undecided);
+        _update_cost(watch.elapsed_time(), indexes.size());
+        return _scatter(result, indexes, num_rows, decided_value);
+    }
+
+private:
+    // The estimated cost to gather a value of an input column or scatter a value of the result.
+    static constexpr double kScatterNsPerValue = 2;
+
+    void _update_cost(int64_t elapsed_ns, size_t num_rows) {
+        if (num_rows == 0) {
+            return;
+        }
+        double ns_per_row = double(elapsed_ns) / num_rows;
+        double old = _ns_per_row.load(std::memory_order_relaxed);
+        _ns_per_row.store(old > 0 ? old * 0.9 + ns_per_row * 0.1 : ns_per_row, std::memory_order_relaxed);
+    }
+
+    // Spread |result|, evaluated on the rows |indexes| of a chunk of |num_rows| rows, to a
+    // column of |num_rows| rows in which the other rows are |fill|.
+    static ColumnPtr _scatter(const ColumnPtr& result, const std::vector<uint32_t>& indexes, size_t num_rows,
+                              uint8_t fill) {
+        const Column* data = result.get();
+        bool is_const = data->is_constant();
+        if (is_const) {
+            data = down_cast<const ConstColumn*>(data)->data_column().get();
+        }
+        const uint8_t* nulls = nullptr;
+        if (data->is_nullable()) {
+            const auto* nullable = down_cast<const NullableColumn*>(data);
+            nulls = nullable->immutable_null_column_data().data();
+            data = nullable->data_column().get();
+        }
+        const uint8_t* values = down_cast<const BooleanColumn*>(data)->get_data().data();
+
+        auto data_column = BooleanColumn::create(num_rows, fill);
+        uint8_t* dst = data_column->get_data().data();
+        for (size_t i = 0; i < indexes.size(); i++) {
+            dst[indexes[i]] = values[is_const ? 0 : i];
+        }
+        if (nulls == nullptr) {
+            return data_column;
+        }
+        auto null_column = NullColumn::create(num_rows, 0);
+        uint8_t* dst_nulls = null_column->get_data().data();
+        for (size_t i = 0; i < indexes.size(); i++) {
+            dst_nulls[indexes[i]] = nulls[is_const ? 0 : i];
+        }
+        return NullableColumn::create(std::move(data_column), std::move(null_column));
+    }
+
+    std::atomic<double> _ns_per_row{0};
+};
+
 #define DEFINE_COMPOUND_CONSTRUCT(CLASS)              \
     CLASS(const TExprNode& node) : Predicate(node) {} \
     virtual ~CLASS() {}                               \
@@ -41,10 +159,14 @@ public:
             return l->clone();
         }
 
-        auto r = _children[1]->evaluate(context, ptr);
+        // The rows where the left is false are false whatever the right is.
+        auto r = _right_evaluator.evaluate(context, _children[1], ptr, l, 0, l->size() - l_falses);
 
         return VectorizedLogicPredicateBinaryFunction<AndNullImpl, AndImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    RightChildEvaluator _right_evaluator;
 };
 
 /**
@@ -73,10 +195,14 @@ public:
             return l->clone();
         }
 
-        auto r = _children[1]->evaluate(context, ptr);
+        // The rows where the left is true are true whatever the right is.
+        auto r = _right_evaluator.evaluate(context, _children[1], ptr, l, 1, l->size() - l_trues);
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    RightChildEvaluator _right_evaluator;
 };
 
 DEFINE_UNARY_FN_WITH_IMPL(CompoundPredNot, l) {
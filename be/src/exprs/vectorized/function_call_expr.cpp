@@ -2,16 +2,44 @@
 
 #include "exprs/vectorized/function_call_expr.h"
 
+#include <algorithm>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <unordered_set>
+
+#include "column/binary_dict_encoder.h"
 #include "column/column_helper.h"
 #include "column/const_column.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
 #include "exprs/anyval_util.h"
 #include "exprs/vectorized/builtin_functions.h"
+#include "exprs/vectorized/function_helper.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/user_function_cache.h"
 
 namespace starrocks::vectorized {
 
+namespace {
+
+// String functions worth evaluating once per distinct value of their first argument: cheap
+// ones like upper or substr cost less per row than building the dictionary. They are
+// deterministic and return null for a null first argument, whatever their other arguments are,
+// because the results of the null rows are replaced by null. Functions skipping null arguments,
+// like md5sum and concat_ws, must not be listed.
+const std::unordered_set<std::string> kDictEvaluableFunctions = {
+        "md5",          "parse_url",       "regexp",          "regexp_extract", "regexp_replace",
+        "get_json_int", "get_json_double", "get_json_string"};
+
+// Chunks with fewer rows are evaluated row by row, the dictionary would not pay off.
+constexpr size_t kDictMinRows = 256;
+// Number of leading rows inspected to decide whether to build the dictionary.
+constexpr size_t kDictSampleRows = 256;
+// The sample and the whole chunk must have at most 1/kDictSampleRatio distinct values.
+constexpr size_t kDictSampleRatio = 4;
+
+} // namespace
+
 VectorizedFunctionCallExpr::VectorizedFunctionCallExpr(const TExprNode& node) : Expr(node), _fn_desc(nullptr) {}
 
 Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const starrocks::RowDescriptor& row_desc,
@@ -89,6 +117,13 @@ Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrock
         _is_rand_function = false;
     }
 
+    _is_dict_evaluable = false;
+    if (!_children.empty() && (_children[0]->type().type == TYPE_VARCHAR || _children[0]->type().type == TYPE_CHAR) &&
+        kDictEvaluableFunctions.count(boost::algorithm::to_lower_copy(_fn.name.function_name)) > 0) {
+        _is_dict_evaluable = std::all_of(_children.begin() + 1, _children.end(),
+                                         [](const Expr* child) { return child->is_constant(); });
+    }
+
     return Status::OK();
 }
 
@@ -142,6 +177,13 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     }
 #endif
 
+    if (_is_dict_evaluable && ptr != nullptr && config::enable_string_function_dict_evaluation) {
+        ColumnPtr result = _evaluate_on_dict(fn_ctx, args);
+        if (result != nullptr) {
+            return result;
+        }
+    }
+
     ColumnPtr result = _fn_desc->scalar_function(fn_ctx, args);
     // For no args function call (pi, e)
     if (result->is_constant() && ptr != nullptr) {
@@ -150,4 +192,61 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     return result;
 }
 
+ColumnPtr VectorizedFunctionCallExpr::_evaluate_on_dict(FunctionContext* fn_ctx, const Columns& args) {
+    const ColumnPtr& input = args[0];
+    size_t num_rows = input->size();
+    if (num_rows < kDictMinRows || input->is_constant()) {
+        return nullptr;
+    }
+    for (size_t i = 1; i < args.size(); i++) {
+        if (!args[i]->is_constant()) {
+            return nullptr;
+        }
+    }
+    const ColumnPtr& data_column = FunctionHelper::get_real_data_column(input);
+    if (!data_column->is_binary()) {
+        return nullptr;
+    }
+    const auto& strings = *down_cast<const BinaryColumn*>(data_column.get());
+    if (!BinaryDictEncoder::is_low_cardinality(strings, kDictSampleRows, kDictSampleRatio)) {
+        return nullptr;
+    }
+    auto dict = BinaryColumn::create();
+    std::vector<uint32_t> codes;
+    if (!BinaryDictEncoder::encode(strings, num_rows / kDictSampleRatio, dict.get(), &codes)) {
+        return nullptr;
+    }
+
+    // The values under null rows are encoded as well, their results are masked below.
+    size_t dict_size = dict->size();
+    Columns dict_args;
+    dict_args.reserve(args.size());
+    dict_args.emplace_back(std::move(dict));
+    for (size_t i = 1; i < args.size(); i++) {
+        const auto* const_column = down_cast<const ConstColumn*>(args[i].get());
+        dict_args.emplace_back(ConstColumn::create(const_column->data_column(), dict_size));
+    }
+    ColumnPtr dict_result = _fn_desc->scalar_function(fn_ctx, dict_args);
+
+    ColumnPtr result;
+    if (dict_result->is_constant()) {
+        result = ColumnHelper::unfold_const_column(_type, num_rows, dict_result);
+    } else {
+        result = dict_result->clone_empty();
+        result->append_selective(*dict_result, codes.data(), 0, num_rows);
+    }
+
+    if (input->is_nullable()) {
+        const NullColumnPtr& input_nulls = down_cast<const NullableColumn*>(input.get())->null_column();
+        if (result->is_nullable()) {
+            auto* nullable = down_cast<NullableColumn*>(result.get());
+            result = NullableColumn::create(nullable->data_column(),
+                                            FunctionHelper::union_null_column(nullable->null_column(), input_nulls));
+        } else {
+            result = NullableColumn::create(result, ColumnHelper::as_column<NullColumn>(input_nulls->clone_shared()));
+        }
+    }
+    return result;
+}
+
 } // namespace starrocks::vectorized
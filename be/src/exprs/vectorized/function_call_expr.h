@@ -29,10 +29,18 @@ protected:
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override;
 
 private:
+    // Evaluate the function on the distinct values of args[0] and map the results back through
+    // the dictionary codes, or return nullptr when args[0] is not worth dictionary encoding.
+    ColumnPtr _evaluate_on_dict(FunctionContext* fn_ctx, const Columns& args);
+
     const FunctionDescriptor* _fn_desc;
 
     // is rand/random function.
     bool _is_rand_function = false;
+
+    // Whether the function can be evaluated on the dictionary of its first argument: a string
+    // function of a string column and constants, which is deterministic and null on null input.
+    bool _is_dict_evaluable = false;
 };
 
 } // namespace vectorized
@@ -9,11 +9,13 @@
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/tokenizer.hpp>
+#include <memory>
 
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "common/status.h"
 #include "rapidjson/error/en.h"
+#include "util/json_binary.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -22,6 +24,10 @@ namespace vectorized {
 // json path cannot contains: ", [, ]
 static const re2::RE2 JSON_PATTERN("^([^\\\"\\[\\]]*)(?:\\[([0-9]+|\\*)\\])?");
 
+// Size of the buffer holding the values of the documents parsed by the get_json_* functions,
+// larger documents allocate additional chunks.
+static constexpr size_t kJsonValueBufferSize = 64 * 1024;
+
 void JsonFunctions::get_parsed_paths(const std::vector<std::string>& path_exprs, std::vector<JsonPath>* parsed_paths) {
     if (path_exprs[0] != "$") {
         parsed_paths->emplace_back("", -1, false);
@@ -235,6 +241,45 @@ rapidjson::Value* JsonFunctions::match_value(const std::vector<JsonPath>& parsed
     return root;
 }
 
+rapidjson::Value* JsonFunctions::match_binary_value(const std::vector<JsonPath>& parsed_paths, const Slice& json_value,
+                                                    rapidjson::Document* document) {
+    JsonBinaryValue root = JsonBinaryValue::root(json_value);
+    for (int i = 1; i < parsed_paths.size(); i++) {
+        if (root.type() == JsonBinary::NULL_VALUE || root.type() == JsonBinary::INVALID) {
+            return nullptr;
+        }
+
+        if (UNLIKELY(!parsed_paths[i].is_valid)) {
+            return nullptr;
+        }
+
+        const std::string& col = parsed_paths[i].key;
+        int index = parsed_paths[i].idx;
+        // Paths collecting several values are evaluated on the decoded document.
+        if ((!col.empty() && root.type() == JsonBinary::ARRAY) || index == -2) {
+            JsonBinaryValue::root(json_value).to_rapidjson(document, document->GetAllocator());
+            return match_value(parsed_paths, document, document->GetAllocator());
+        }
+
+        JsonBinaryValue child;
+        if (!col.empty()) {
+            if (!root.member(Slice(col), &child)) {
+                return nullptr;
+            }
+            root = child;
+        }
+
+        if (UNLIKELY(index != -1)) {
+            if (!root.element(index, &child)) {
+                return nullptr;
+            }
+            root = child;
+        }
+    }
+    root.to_rapidjson(document, document->GetAllocator());
+    return document;
+}
+
 void JsonFunctions::parse_json_paths(const std::string& path_string, std::vector<JsonPath>* parsed_paths) {
     // split path by ".", and escape quota by "\"
     // eg:
@@ -247,57 +292,37 @@ void JsonFunctions::parse_json_paths(const std::string& path_string, std::vector
     get_parsed_paths(paths, parsed_paths);
 }
 
-rapidjson::Value* JsonFunctions::get_json_object(FunctionContext* context, const std::string& json_string,
-                                                 const std::string& path_string, const JsonFunctionType& fntype,
-                                                 rapidjson::Document* document) {
-    // split path by ".", and escape quota by "\"
-    // eg:
-    //    '$.text#abc.xyz'  ->  [$, text#abc, xyz]
-    //    '$."text.abc".xyz'  ->  [$, text.abc, xyz]
-    //    '$."text.abc"[1].xyz'  ->  [$, text.abc[1], xyz]
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
-#ifndef BE_TEST
-    parsed_paths =
-            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    if (parsed_paths == nullptr) {
-        boost::tokenizer<boost::escaped_list_separator<char> > tok(
-                path_string, boost::escaped_list_separator<char>("\\", ".", "\""));
-        std::vector<std::string> paths(tok.begin(), tok.end());
-        get_parsed_paths(paths, &tmp_parsed_paths);
-        parsed_paths = &tmp_parsed_paths;
-    }
-#else
-    boost::tokenizer<boost::escaped_list_separator<char> > tok(path_string,
-                                                               boost::escaped_list_separator<char>("\\", ".", "\""));
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
-#endif
-
-    VLOG(10) << "first parsed path: " << (*parsed_paths)[0].debug_string();
+rapidjson::Value* JsonFunctions::get_json_object(const Slice& json_value, const std::vector<JsonPath>& parsed_paths,
+                                                 const JsonFunctionType& fntype, rapidjson::Document* document) {
+    VLOG(10) << "first parsed path: " << parsed_paths[0].debug_string();
 
-    if (!(*parsed_paths)[0].is_valid) {
+    if (!parsed_paths[0].is_valid) {
         return document;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
+    if (JsonBinary::is_encoded(json_value)) {
+        if (UNLIKELY(parsed_paths.size() == 1 && fntype != JSON_FUN_STRING)) {
+            return document;
+        }
+        return match_binary_value(parsed_paths, json_value, document);
+    }
+
+    if (UNLIKELY(parsed_paths.size() == 1)) {
         if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.c_str(), document->GetAllocator());
+            document->SetString(json_value.data, json_value.size, document->GetAllocator());
         } else {
             return document;
         }
     }
 
-    //rapidjson::Document document;
-    document->Parse(json_string.c_str());
+    document->Parse(json_value.data, json_value.size);
     if (UNLIKELY(document->HasParseError())) {
         VLOG(1) << "Error at offset " << document->GetErrorOffset() << ": "
                 << GetParseError_En(document->GetParseError());
         document->SetNull();
         return document;
     }
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, document->GetAllocator());
 }
 
 JsonFunctionType JsonTypeTraits<TYPE_INT>::JsonType = JSON_FUN_INT;
@@ -309,6 +334,21 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
     auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
 
+    // A constant path is parsed once by json_path_prepare(), the others for every row.
+    const std::vector<JsonPath>* const_paths = nullptr;
+#ifndef BE_TEST
+    const_paths =
+            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+#endif
+
+    // The rows are parsed into the same document, whose memory is recycled from row to row
+    // instead of being allocated and freed for every row.
+    std::unique_ptr<char[]> value_buffer(new char[kJsonValueBufferSize]);
+    rapidjson::MemoryPoolAllocator<> allocator(value_buffer.get(), kJsonValueBufferSize);
+    rapidjson::Document document(&allocator);
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+
     ColumnBuilder<primitive_type> result;
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
@@ -322,19 +362,25 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             result.append_null();
             continue;
         }
-        std::string json_string(json_value.data, json_value.size);
 
-        auto path_value = path_viewer.value(row);
-        std::string path_string(path_value.data, path_value.size);
-        // Must remove or replace the escape sequence.
-        path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
-        if (path_string.empty()) {
-            result.append_null();
-            continue;
+        const std::vector<JsonPath>* parsed_paths = const_paths;
+        std::vector<JsonPath> row_paths;
+        if (parsed_paths == nullptr) {
+            auto path_value = path_viewer.value(row);
+            std::string path_string(path_value.data, path_value.size);
+            // Must remove or replace the escape sequence.
+            path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
+            if (path_string.empty()) {
+                result.append_null();
+                continue;
+            }
+            parse_json_paths(path_string, &row_paths);
+            parsed_paths = &row_paths;
         }
 
-        rapidjson::Document document;
-        rapidjson::Value* root = JsonFunctions::get_json_object(context, json_string, path_string,
+        document.SetNull();
+        allocator.Clear();
+        rapidjson::Value* root = JsonFunctions::get_json_object(json_value, *parsed_paths,
                                                                 JsonTypeTraits<primitive_type>::JsonType, &document);
 
         if constexpr (primitive_type == TYPE_INT) {
@@ -357,12 +403,12 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             if (root == nullptr || root->IsNull()) {
                 result.append_null();
             } else if (root->IsString()) {
-                result.append(Slice(root->GetString()));
+                result.append(Slice(root->GetString(), root->GetStringLength()));
             } else {
-                rapidjson::StringBuffer buf;
-                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                buf.Clear();
+                writer.Reset(buf);
                 root->Accept(writer);
-                result.append(Slice(buf.GetString()));
+                result.append(Slice(buf.GetString(), buf.GetSize()));
             }
         }
     }
@@ -382,6 +428,53 @@ ColumnPtr JsonFunctions::get_json_string(FunctionContext* context, const Columns
     return JsonFunctions::template iterate_rows<TYPE_VARCHAR>(context, columns);
 }
 
+ColumnPtr JsonFunctions::parse_json(FunctionContext* context, const Columns& columns) {
+    auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
+    ColumnBuilder<TYPE_VARCHAR> result;
+    std::string encoded;
+    auto size = columns[0]->size();
+    for (int row = 0; row < size; ++row) {
+        if (json_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+        auto json_value = json_viewer.value(row);
+        if (JsonBinary::is_encoded(json_value)) {
+            result.append(json_value);
+            continue;
+        }
+        encoded.clear();
+        if (JsonBinary::encode(json_value, &encoded)) {
+            result.append(Slice(encoded));
+        } else {
+            result.append_null();
+        }
+    }
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
+ColumnPtr JsonFunctions::json_string(FunctionContext* context, const Columns& columns) {
+    auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
+    ColumnBuilder<TYPE_VARCHAR> result;
+    std::string text;
+    auto size = columns[0]->size();
+    for (int row = 0; row < size; ++row) {
+        if (json_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+        auto json_value = json_viewer.value(row);
+        if (!JsonBinary::is_encoded(json_value)) {
+            result.append(json_value);
+            continue;
+        }
+        text.clear();
+        JsonBinary::to_json_string(json_value, &text);
+        result.append(Slice(text));
+    }
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
 std::string JsonFunctions::get_raw_json_string(const rapidjson::Value& value) {
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
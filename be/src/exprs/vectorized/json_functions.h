@@ -98,6 +98,22 @@ public:
      */
     DEFINE_VECTORIZED_FN(get_json_string);
 
+    /**
+     * Encode JSON texts in the binary format of JsonBinary, which get_json_* read without parsing.
+     * @param: [json_string]
+     * @paramType: [BinaryColumn]
+     * @return: BinaryColumn, NULL for invalid JSON texts
+     */
+    DEFINE_VECTORIZED_FN(parse_json);
+
+    /**
+     * Convert binary encoded JSON documents back to text, other strings are returned as they are.
+     * @param: [json]
+     * @paramType: [BinaryColumn]
+     * @return: BinaryColumn
+     */
+    DEFINE_VECTORIZED_FN(json_string);
+
     /**
      * The `document` parameter must be has parsed.
      * return Value Is Array object
@@ -123,9 +139,14 @@ private:
     template <PrimitiveType primitive_type>
     static ColumnPtr iterate_rows(FunctionContext* context, const Columns& columns);
 
-    static rapidjson::Value* get_json_object(FunctionContext* context, const std::string& json_string,
-                                             const std::string& path_string, const JsonFunctionType& fntype,
-                                             rapidjson::Document* document);
+    // Parse |json_value| into |document| and return the value at |parsed_paths|.
+    static rapidjson::Value* get_json_object(const Slice& json_value, const std::vector<JsonPath>& parsed_paths,
+                                             const JsonFunctionType& fntype, rapidjson::Document* document);
+
+    // Walk |parsed_paths| over the binary document |json_value|, looking up object members by
+    // binary search, and copy the value found into |document|.
+    static rapidjson::Value* match_binary_value(const std::vector<JsonPath>& parsed_paths, const Slice& json_value,
+                                                rapidjson::Document* document);
 
     static rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjson::Value* document,
                                          rapidjson::Document::AllocatorType& mem_allocator,
@@ -2,6 +2,7 @@
 
 #include "exprs/vectorized/like_predicate.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column_builder.h"
@@ -10,7 +11,7 @@
 #include "exprs/vectorized/binary_function.h"
 #include "glog/logging.h"
 #include "gutil/strings/substitute.h"
-#include "runtime/vectorized/Volnitsky.h"
+#include "runtime/vectorized/StringSearcher.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -282,6 +283,8 @@ ColumnPtr LikePredicate::constant_substring_fn(FunctionContext* context,
     } else {
         const std::vector<uint32_t>& offsets = haystack->get_offset();
         res->resize(haystack->size());
+        size_t type_size = res->type_size();
+        memset(res->mutable_raw_data(), 0, res->size() * type_size);
 
         const char* begin = haystack->get_slice(0).data;
         const char* pos = begin;
@@ -290,28 +293,16 @@ ColumnPtr LikePredicate::constant_substring_fn(FunctionContext* context,
         /// Current index in the array of strings.
         size_t i = 0;
 
-        auto searcher = VolnitskyUTF8(needle.data, needle.size, end - pos);
+        auto searcher = FirstLastByteStringSearcher(needle.data, needle.size);
         /// We will search for the next occurrence in all strings at once.
         while (pos < end && end != (pos = searcher.search(pos, end - pos))) {
-            /// Determine which index it refers to.
-            while (begin + offsets[i + 1] <= pos) {
-                res->get_data()[i] = false;
-                ++i;
-            }
+            /// Determine which index it refers to, the rows between two hits are skipped at once.
+            i = std::upper_bound(offsets.begin() + i + 1, offsets.end(), pos - begin) - offsets.begin() - 1;
             /// We check that the entry does not pass through the boundaries of strings.
-            if (pos + needle.size > begin + offsets[i + 1]) {
-                res->get_data()[i] = false;
-            } else {
-                res->get_data()[i] = true;
-            }
+            res->get_data()[i] = pos + needle.size <= begin + offsets[i + 1];
             pos = begin + offsets[i + 1];
             ++i;
         }
-
-        if (i < res->size()) {
-            size_t type_size = res->type_size();
-            memset(res->mutable_raw_data() + i * type_size, 0, (res->size() - i) * type_size);
-        }
     }
 
     if (columns[0]->has_null()) {
@@ -8,19 +8,19 @@
 #include "column/column_viewer.h"
 #include "common/status.h"
 #include "exprs/vectorized/string_functions.h"
-#include "runtime/vectorized/Volnitsky.h"
+#include "runtime/vectorized/StringSearcher.h"
 #include "util/utf8.h"
 
 namespace starrocks {
 namespace vectorized {
 
 struct LocateCaseSensitiveUTF8 {
-    using SearcherInBigHaystack = VolnitskyUTF8;
+    using SearcherInBigHaystack = FirstLastByteStringSearcher;
     using SearcherInSmallHaystack = LibcASCIICaseSensitiveStringSearcher;
 
     static SearcherInBigHaystack createSearcherInBigHaystack(const char* needle_data, size_t needle_size,
                                                              size_t haystack_size_hint) {
-        return SearcherInBigHaystack(needle_data, needle_size, haystack_size_hint);
+        return SearcherInBigHaystack(needle_data, needle_size);
     }
 
     static SearcherInSmallHaystack createSearcherInSmallHaystack(const char* needle_data, size_t needle_size) {
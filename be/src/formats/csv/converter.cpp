@@ -2,6 +2,7 @@
 
 #include "formats/csv/converter.h"
 
+#include "column/column.h"
 #include "formats/csv/array_converter.h"
 #include "formats/csv/binary_converter.h"
 #include "formats/csv/boolean_converter.h"
@@ -16,6 +17,22 @@
 
 namespace starrocks::vectorized::csv {
 
+size_t Converter::read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                               uint8_t* invalid) const {
+    size_t num_invalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t size = column->size();
+        if (!read_string(column, fields[i], options)) {
+            // drop what a nested value may have appended before failing
+            column->resize(size);
+            column->append_default();
+            invalid[i] = 1;
+            num_invalid++;
+        }
+    }
+    return num_invalid;
+}
+
 static std::unique_ptr<Converter> get_converter(const TypeDescriptor& t) {
     switch (t.type) {
     case TYPE_BOOLEAN:
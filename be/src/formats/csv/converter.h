@@ -58,6 +58,12 @@ public:
 
     virtual bool read_quoted_string(Column* column, Slice s, const Options& options) const = 0;
 
+    // Reads the |n| fields of |fields| into |column|, appending exactly |n| values. A field that can not
+    // be read is appended as the default value and sets its flag in |invalid|, which the caller zeroes.
+    // Returns the number of invalid fields.
+    virtual size_t read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                                uint8_t* invalid) const;
+
 protected:
     template <char quote>
     static inline bool remove_enclosing_quotes(Slice* s) {
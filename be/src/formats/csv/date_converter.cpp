@@ -9,6 +9,34 @@
 
 namespace starrocks::vectorized::csv {
 
+// Returns the number of the |n| digits at |p|, or a negative number if any of them is not a digit.
+static inline int parse_digits(const char* p, int n) {
+    int v = 0;
+    unsigned not_digit = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned d = static_cast<unsigned char>(p[i]) - '0';
+        not_digit |= d > 9;
+        v = v * 10 + d;
+    }
+    return not_digit ? -1 : v;
+}
+
+// Parses the 'YYYY-MM-DD' dates, which most of the loaded dates are, without the format detection
+// of DateValue::from_string. Returns false for anything else, left to DateValue::from_string.
+static inline bool parse_fixed_date(Slice s, DateValue* v) {
+    if (s.size != 10 || s.data[4] != '-' || s.data[7] != '-') {
+        return false;
+    }
+    int year = parse_digits(s.data, 4);
+    int month = parse_digits(s.data + 5, 2);
+    int day = parse_digits(s.data + 8, 2);
+    if ((year | month | day) < 0 || !date::check(year, month, day)) {
+        return false;
+    }
+    v->from_date(year, month, day);
+    return true;
+}
+
 Status DateConverter::write_string(OutputStream* os, const Column& column, size_t row_num,
                                    const Options& options) const {
     auto date_column = down_cast<const FixedLengthColumn<DateValue>*>(&column);
@@ -24,7 +52,7 @@ Status DateConverter::write_quoted_string(OutputStream* os, const Column& column
 
 bool DateConverter::read_string(Column* column, Slice s, const Options& options) const {
     DateValue v{};
-    bool r = v.from_string(s.data, s.size);
+    bool r = parse_fixed_date(s, &v) || v.from_string(s.data, s.size);
     if (r) {
         down_cast<FixedLengthColumn<DateValue>*>(column)->append(v);
     }
@@ -38,4 +66,22 @@ bool DateConverter::read_quoted_string(Column* column, Slice s, const Options& o
     return read_string(column, s, options);
 }
 
+size_t DateConverter::read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                                   uint8_t* invalid) const {
+    auto& data = down_cast<FixedLengthColumn<DateValue>*>(column)->get_data();
+    const size_t offset = data.size();
+    data.resize(offset + n);
+    DateValue* values = data.data() + offset;
+    size_t num_invalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        const Slice& s = fields[i];
+        if (!parse_fixed_date(s, &values[i]) && !values[i].from_string(s.data, s.size)) {
+            values[i] = DateValue();
+            invalid[i] = 1;
+            num_invalid++;
+        }
+    }
+    return num_invalid;
+}
+
 } // namespace starrocks::vectorized::csv
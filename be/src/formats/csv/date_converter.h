@@ -13,6 +13,8 @@ public:
                                const Options& options) const override;
     bool read_string(Column* column, Slice s, const Options& options) const override;
     bool read_quoted_string(Column* column, Slice s, const Options& options) const override;
+    size_t read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                        uint8_t* invalid) const override;
 };
 
 } // namespace starrocks::vectorized::csv
\ No newline at end of file
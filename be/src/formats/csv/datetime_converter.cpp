@@ -9,6 +9,40 @@
 
 namespace starrocks::vectorized::csv {
 
+// Returns the number of the |n| digits at |p|, or a negative number if any of them is not a digit.
+static inline int parse_digits(const char* p, int n) {
+    int v = 0;
+    unsigned not_digit = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned d = static_cast<unsigned char>(p[i]) - '0';
+        not_digit |= d > 9;
+        v = v * 10 + d;
+    }
+    return not_digit ? -1 : v;
+}
+
+// Parses the 'YYYY-MM-DD HH:MM:SS' datetimes, which most of the loaded datetimes are, without the format
+// detection of TimestampValue::from_string. Returns false for anything else, left to
+// TimestampValue::from_string.
+static inline bool parse_fixed_datetime(Slice s, TimestampValue* v) {
+    const char* p = s.data;
+    if (s.size != 19 || p[4] != '-' || p[7] != '-' || p[10] != ' ' || p[13] != ':' || p[16] != ':') {
+        return false;
+    }
+    int year = parse_digits(p, 4);
+    int month = parse_digits(p + 5, 2);
+    int day = parse_digits(p + 8, 2);
+    int hour = parse_digits(p + 11, 2);
+    int minute = parse_digits(p + 14, 2);
+    int second = parse_digits(p + 17, 2);
+    if ((year | month | day | hour | minute | second) < 0 ||
+        !timestamp::check(year, month, day, hour, minute, second, 0)) {
+        return false;
+    }
+    v->from_timestamp(year, month, day, hour, minute, second, 0);
+    return true;
+}
+
 Status DatetimeConverter::write_string(OutputStream* os, const Column& column, size_t row_num,
                                        const Options& options) const {
     auto datetime_column = down_cast<const FixedLengthColumn<TimestampValue>*>(&column);
@@ -24,7 +58,7 @@ Status DatetimeConverter::write_quoted_string(OutputStream* os, const Column& co
 
 bool DatetimeConverter::read_string(Column* column, Slice s, const Options& options) const {
     TimestampValue v{};
-    bool r = v.from_string(s.data, s.size);
+    bool r = parse_fixed_datetime(s, &v) || v.from_string(s.data, s.size);
     if (r) {
         down_cast<FixedLengthColumn<TimestampValue>*>(column)->append(v);
     }
@@ -38,4 +72,22 @@ bool DatetimeConverter::read_quoted_string(Column* column, Slice s, const Option
     return read_string(column, s, options);
 }
 
+size_t DatetimeConverter::read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                                       uint8_t* invalid) const {
+    auto& data = down_cast<FixedLengthColumn<TimestampValue>*>(column)->get_data();
+    const size_t offset = data.size();
+    data.resize(offset + n);
+    TimestampValue* values = data.data() + offset;
+    size_t num_invalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        const Slice& s = fields[i];
+        if (!parse_fixed_datetime(s, &values[i]) && !values[i].from_string(s.data, s.size)) {
+            values[i] = TimestampValue();
+            invalid[i] = 1;
+            num_invalid++;
+        }
+    }
+    return num_invalid;
+}
+
 } // namespace starrocks::vectorized::csv
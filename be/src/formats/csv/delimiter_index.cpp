@@ -0,0 +1,99 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "formats/csv/delimiter_index.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/logging.h"
+
+namespace starrocks::vectorized::csv {
+
+uint64_t DelimiterIndex::match64(const char* p, char c) {
+#ifdef __AVX2__
+    const __m256i target = _mm256_set1_epi8(c);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    uint64_t lo_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, target)));
+    uint64_t hi_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, target)));
+    return lo_mask | (hi_mask << 32);
+#elif defined(__SSE2__)
+    const __m128i target = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, target)))) << (i * 16);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i++) {
+        mask |= static_cast<uint64_t>(p[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+size_t DelimiterIndex::split(const char* begin, const char* end, size_t max_records) {
+    _records.clear();
+    _fields.clear();
+    _field_offsets.assign(1, 0);
+    if (max_records == 0) {
+        return 0;
+    }
+
+    const char* record_begin = begin;
+    const char* field_begin = begin;
+    // Returns true if |max_records| records have been split.
+    auto on_delimiter = [&](const char* d, bool is_record_delimiter) {
+        _fields.emplace_back(field_begin, d - field_begin);
+        field_begin = d + 1;
+        if (!is_record_delimiter) {
+            return false;
+        }
+        _records.emplace_back(record_begin, d - record_begin);
+        _field_offsets.push_back(_fields.size());
+        record_begin = d + 1;
+        return _records.size() == max_records;
+    };
+
+    const char* p = begin;
+    for (; end - p >= 64; p += 64) {
+        uint64_t record_mask = match64(p, _record_delimiter);
+        uint64_t mask = record_mask | match64(p, _field_delimiter);
+        while (mask != 0) {
+            int i = __builtin_ctzll(mask);
+            if (on_delimiter(p + i, (record_mask >> i) & 1)) {
+                return record_begin - begin;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; p < end; p++) {
+        if (*p == _record_delimiter || *p == _field_delimiter) {
+            if (on_delimiter(p, *p == _record_delimiter)) {
+                return record_begin - begin;
+            }
+        }
+    }
+    // drop the fields of the last record, which is not ended in the buffer
+    _fields.resize(_field_offsets.back());
+    return record_begin - begin;
+}
+
+size_t DelimiterIndex::truncate(size_t num_records) {
+    DCHECK_LE(num_records, _records.size());
+    _records.resize(num_records);
+    _field_offsets.resize(num_records + 1);
+    _fields.resize(_field_offsets.back());
+    if (num_records == 0) {
+        return 0;
+    }
+    const Slice& last = _records.back();
+    return last.data + last.size + 1 - _records.front().data;
+}
+
+} // namespace starrocks::vectorized::csv
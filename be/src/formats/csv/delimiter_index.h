@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "util/slice.h"
+
+namespace starrocks::vectorized::csv {
+
+// Splits a buffer of CSV records into records and fields in one pass. The record and the field
+// delimiters of 64 bytes are located at once as two bitmasks, and the set bits are walked in order,
+// so the bytes between two delimiters are never looked at one by one.
+class DelimiterIndex {
+public:
+    DelimiterIndex(char record_delimiter, char field_delimiter)
+            : _record_delimiter(record_delimiter), _field_delimiter(field_delimiter) {}
+
+    // Splits the records of [begin, end) that are ended by the record delimiter, at most |max_records|
+    // of them, replacing the records and fields of the previous split.
+    // Returns the number of bytes of the split records, record delimiters included.
+    size_t split(const char* begin, const char* end, size_t max_records);
+
+    // Keeps the first |num_records| records only.
+    // Returns the number of bytes of them, record delimiters included.
+    size_t truncate(size_t num_records);
+
+    size_t num_records() const { return _records.size(); }
+
+    const Slice& record(size_t i) const { return _records[i]; }
+
+    size_t num_fields(size_t i) const { return _field_offsets[i + 1] - _field_offsets[i]; }
+
+    // Returns the first field of the |i|-th record.
+    const Slice* fields(size_t i) const { return _fields.data() + _field_offsets[i]; }
+
+    // Returns the bitmask of the bytes equal to |c| in [p, p + 64).
+    static uint64_t match64(const char* p, char c);
+
+private:
+    const char _record_delimiter;
+    const char _field_delimiter;
+    std::vector<Slice> _records;
+    std::vector<Slice> _fields;
+    // fields of the i-th record are _fields[_field_offsets[i], _field_offsets[i + 1])
+    std::vector<uint32_t> _field_offsets;
+};
+
+} // namespace starrocks::vectorized::csv
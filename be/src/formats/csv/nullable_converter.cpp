@@ -47,6 +47,28 @@ bool NullableConverter::read_string(Column* column, Slice s, const Options& opti
     }
 }
 
+size_t NullableConverter::read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                                       uint8_t* invalid) const {
+    auto* nullable = down_cast<NullableColumn*>(column);
+    // The null literals are invalid or ignored values of the data column.
+    _base_converter->read_strings(nullable->data_column().get(), fields, n, options, invalid);
+
+    auto& nulls = nullable->null_column_data();
+    const size_t offset = nulls.size();
+    nulls.resize(offset + n);
+    uint8_t has_null = 0;
+    size_t num_invalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint8_t is_null = (fields[i] == "\\N") | (invalid[i] & options.invalid_field_as_null);
+        nulls[offset + i] = is_null;
+        has_null |= is_null;
+        invalid[i] &= !is_null;
+        num_invalid += invalid[i];
+    }
+    nullable->set_has_null(has_null);
+    return num_invalid;
+}
+
 bool NullableConverter::read_quoted_string(Column* column, Slice s, const Options& options) const {
     auto* nullable = down_cast<NullableColumn*>(column);
     auto* data = nullable->data_column().get();
@@ -25,12 +25,43 @@ Status NumericConverter<T>::write_quoted_string(OutputStream* os, const Column&
     return write_string(os, column, row_num, options);
 }
 
+// Parses a plain decimal integer of at most 18 digits with an optional leading '-', which most of the
+// fields of numeric columns are. Returns false for anything else, left to the full parser.
 template <typename T>
-bool NumericConverter<T>::read_string(Column* column, Slice s, const Options& options) const {
+static inline bool parse_short_int(const char* p, size_t size, T* v) {
+    const bool negative = size > 0 && p[0] == '-';
+    size_t i = negative;
+    if (size == i || size - i > 18) {
+        return false;
+    }
+    int64_t n = 0;
+    unsigned not_digit = 0;
+    for (; i < size; i++) {
+        unsigned d = static_cast<unsigned char>(p[i]) - '0';
+        not_digit |= d > 9;
+        n = n * 10 + d;
+    }
+    if (not_digit) {
+        return false;
+    }
+    n = negative ? -n : n;
+    if constexpr (sizeof(T) < sizeof(int64_t)) {
+        if (n < std::numeric_limits<T>::min() || n > std::numeric_limits<T>::max()) {
+            return false;
+        }
+    }
+    *v = static_cast<T>(n);
+    return true;
+}
+
+template <typename T>
+bool NumericConverter<T>::_parse(Slice s, DataType* v) {
+    if (parse_short_int(s.data, s.size, v)) {
+        return true;
+    }
     StringParser::ParseResult r;
-    DataType v = StringParser::string_to_int<DataType>(s.data, s.size, &r);
+    *v = StringParser::string_to_int<DataType>(s.data, s.size, &r);
     if (r == StringParser::PARSE_SUCCESS) {
-        down_cast<FixedLengthColumn<DataType>*>(column)->append(v);
         return true;
     } else if (r != StringParser::PARSE_OVERFLOW && r != StringParser::PARSE_UNDERFLOW) {
         if constexpr (sizeof(DataType) <= sizeof(int32_t)) {
@@ -45,7 +76,7 @@ bool NumericConverter<T>::read_string(Column* column, Slice s, const Options& op
                 if (implicit_cast<double>(n) != d) {
                     return false;
                 } else {
-                    down_cast<FixedLengthColumn<DataType>*>(column)->append(n);
+                    *v = n;
                     return true;
                 }
             } else {
@@ -57,7 +88,7 @@ bool NumericConverter<T>::read_string(Column* column, Slice s, const Options& op
                 return false;
             } else {
                 int64_t n = decimal.int_value();
-                down_cast<FixedLengthColumn<DataType>*>(column)->append(implicit_cast<DataType>(n));
+                *v = implicit_cast<DataType>(n);
                 return true;
             }
         }
@@ -66,11 +97,39 @@ bool NumericConverter<T>::read_string(Column* column, Slice s, const Options& op
     }
 }
 
+template <typename T>
+bool NumericConverter<T>::read_string(Column* column, Slice s, const Options& options) const {
+    DataType v;
+    if (_parse(s, &v)) {
+        down_cast<FixedLengthColumn<DataType>*>(column)->append(v);
+        return true;
+    }
+    return false;
+}
+
 template <typename T>
 bool NumericConverter<T>::read_quoted_string(Column* column, Slice s, const Options& options) const {
     return read_string(column, s, options);
 }
 
+template <typename T>
+size_t NumericConverter<T>::read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                                         uint8_t* invalid) const {
+    auto& data = down_cast<FixedLengthColumn<DataType>*>(column)->get_data();
+    const size_t offset = data.size();
+    data.resize(offset + n);
+    DataType* values = data.data() + offset;
+    size_t num_invalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!_parse(fields[i], &values[i])) {
+            values[i] = DataType();
+            invalid[i] = 1;
+            num_invalid++;
+        }
+    }
+    return num_invalid;
+}
+
 /// Explicit template instantiations
 template class NumericConverter<int8_t>;
 template class NumericConverter<int16_t>;
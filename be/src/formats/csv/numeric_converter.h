@@ -18,6 +18,11 @@ public:
                                const Options& options) const override;
     bool read_string(Column* column, Slice s, const Options& options) const override;
     bool read_quoted_string(Column* column, Slice s, const Options& options) const override;
+    size_t read_strings(Column* column, const Slice* fields, size_t n, const Options& options,
+                        uint8_t* invalid) const override;
+
+private:
+    static bool _parse(Slice s, DataType* v);
 };
 
 } // namespace starrocks::vectorized::csv
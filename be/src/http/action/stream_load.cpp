@@ -24,6 +24,7 @@
 #include <deque>
 #include <future>
 #include <sstream>
+#include <vector>
 
 // use string iequal
 #include <event2/buffer.h>
@@ -293,18 +294,30 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
     auto evbuf = evhttp_request_get_input_buffer(ev_req);
 
     int64_t start_read_data_time = MonotonicNanos();
-    while (evbuffer_get_length(evbuf) > 0) {
-        auto bb = ByteBuffer::allocate(4096);
-        auto remove_bytes = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
-        bb->pos = remove_bytes;
-        bb->flip();
+    size_t length = evbuffer_get_length(evbuf);
+    if (length == 0) {
+        return;
+    }
+    // Move the received chunks of the body out of the input buffer of the request, which doesn't copy
+    // them, and append them to the sink as they are. They are freed once all of them have been consumed.
+    std::shared_ptr<evbuffer> body(evbuffer_new(), evbuffer_free);
+    if (body == nullptr || evbuffer_remove_buffer(evbuf, body.get(), length) != static_cast<int>(length)) {
+        LOG(WARNING) << "move body content failed." << ctx->brief();
+        ctx->status = Status::InternalError("failed to move body content");
+        return;
+    }
+    int num_segments = evbuffer_peek(body.get(), -1, nullptr, nullptr, 0);
+    std::vector<evbuffer_iovec> segments(num_segments);
+    evbuffer_peek(body.get(), -1, nullptr, segments.data(), num_segments);
+    for (auto& segment : segments) {
+        auto bb = ByteBuffer::wrap(static_cast<char*>(segment.iov_base), segment.iov_len, body);
         auto st = ctx->body_sink->append(bb);
         if (!st.ok()) {
             LOG(WARNING) << "append body content failed. errmsg=" << st.get_error_msg() << ctx->brief();
             ctx->status = st;
             return;
         }
-        ctx->receive_bytes += remove_bytes;
+        ctx->receive_bytes += segment.iov_len;
     }
     ctx->read_data_cost_nanos += (MonotonicNanos() - start_read_data_time);
 }
@@ -24,6 +24,7 @@
 #include <boost/thread/thread.hpp>
 #include <iostream>
 
+#include "column/chunk.h"
 #include "gen_cpp/InternalService_types.h"
 #include "gen_cpp/types.pb.h" // PUniqueId
 #include "runtime/data_stream_recvr.h"
@@ -165,6 +166,28 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
     return Status::OK();
 }
 
+Status DataStreamMgr::transmit_chunk_local(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                           int be_number, vectorized::ChunkUniquePtr chunk, bool eos,
+                                           const PQueryStatistics* query_statistics,
+                                           ::google::protobuf::Closure** done) {
+    std::shared_ptr<DataStreamRecvr> recvr = find_recvr(fragment_instance_id, node_id);
+    if (recvr == nullptr) {
+        // The receiver has already been closed, see transmit_chunk().
+        return Status::OK();
+    }
+
+    if (query_statistics != nullptr) {
+        recvr->add_sub_plan_statistics(*query_statistics, sender_id);
+    }
+    if (chunk != nullptr && !chunk->is_empty()) {
+        RETURN_IF_ERROR(recvr->add_chunk_local(sender_id, std::move(chunk), eos ? nullptr : done));
+    }
+    if (eos) {
+        recvr->remove_sender(sender_id, be_number);
+    }
+    return Status::OK();
+}
+
 Status DataStreamMgr::deregister_recvr(const TUniqueId& fragment_instance_id, PlanNodeId node_id) {
     std::shared_ptr<DataStreamRecvr> targert_recvr;
     VLOG_QUERY << "deregister_recvr(): fragment_instance_id=" << fragment_instance_id << ", node=" << node_id;
@@ -28,6 +28,7 @@
 #include <mutex>
 #include <set>
 
+#include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
@@ -85,6 +86,15 @@ public:
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
     Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+
+    // Hand |chunk| over to a receiver living in this process, skipping serialization and brpc.
+    // The receiver takes the ownership of |chunk|, which may be nullptr when only eos is sent.
+    // Like transmit_chunk(), |*done| is kept pending and set to nullptr when the receiver's
+    // buffer is full, otherwise the caller is responsible for running it.
+    Status transmit_chunk_local(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                int be_number, vectorized::ChunkUniquePtr chunk, bool eos,
+                                const PQueryStatistics* query_statistics, ::google::protobuf::Closure** done);
+
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
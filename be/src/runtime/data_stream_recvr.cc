@@ -80,6 +80,11 @@ public:
     // the queue is considered full and the call blocks until a chunk is dequeued.
     Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
 
+    // Same as add_chunks(), but |chunk| comes from a sender in the same process and is queued
+    // as is. Its buffer accounting uses the in-memory size of the chunk, which is consumed on
+    // the tracker of the receiver until the chunk is dequeued.
+    Status add_chunk_local(ChunkUniquePtr chunk, ::google::protobuf::Closure** done);
+
     // Decrement the number of remaining senders for this queue and signal eos ("new data")
     // if the count drops to 0. The number of senders will be 1 for a merging
     // DataStreamRecvr.
@@ -124,7 +129,18 @@ private:
     typedef list<pair<int, RowBatch*>> RowBatchQueue;
     RowBatchQueue _batch_queue;
 
-    typedef std::list<std::pair<int, ChunkUniquePtr>> ChunkQueue;
+    struct ChunkItem {
+        ChunkItem(int64_t chunk_bytes_, ChunkUniquePtr chunk_, bool is_local_ = false)
+                : chunk_bytes(chunk_bytes_), chunk(std::move(chunk_)), is_local(is_local_) {}
+
+        // Counted in the buffer limit of the receiver.
+        int64_t chunk_bytes;
+        ChunkUniquePtr chunk;
+        // Handed over by a sender in this process, |chunk_bytes| are consumed on the
+        // tracker of the receiver until the chunk is dequeued.
+        bool is_local;
+    };
+    typedef std::list<ChunkItem> ChunkQueue;
     ChunkQueue _chunk_queue;
     vectorized::RuntimeChunkMeta _chunk_meta;
     vectorized::Buffer<uint8_t> _uncompressed_chunk_data;
@@ -223,8 +239,12 @@ Status DataStreamRecvr::SenderQueue::get_chunk(vectorized::Chunk** chunk) {
         return Status::OK();
     }
 
-    *chunk = _chunk_queue.front().second.release();
-    _recvr->_num_buffered_bytes -= _chunk_queue.front().first;
+    auto& item = _chunk_queue.front();
+    *chunk = item.chunk.release();
+    _recvr->_num_buffered_bytes -= item.chunk_bytes;
+    if (item.is_local) {
+        _recvr->_mem_tracker->release(item.chunk_bytes);
+    }
     VLOG_ROW << "DataStreamRecvr fetched #rows=" << (*chunk)->num_rows();
     _chunk_queue.pop_front();
 
@@ -423,8 +443,8 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
         std::unique_lock<std::mutex> l(_lock);
         wait_timer.stop();
 
-        for (auto& pair : chunks) {
-            _chunk_queue.emplace_back(std::move(pair));
+        for (auto& item : chunks) {
+            _chunk_queue.emplace_back(std::move(item));
         }
         // if done is nullptr, this function can't delay this response
         if (done != nullptr && _recvr->exceeds_limit(total_chunk_bytes)) {
@@ -439,6 +459,32 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
     return Status::OK();
 }
 
+Status DataStreamRecvr::SenderQueue::add_chunk_local(ChunkUniquePtr chunk, ::google::protobuf::Closure** done) {
+    DCHECK(chunk != nullptr);
+    size_t chunk_bytes = chunk->memory_usage();
+    ScopedTimer<MonotonicStopWatch> wait_timer(_recvr->_sender_wait_lock_timer);
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        wait_timer.stop();
+        if (_is_cancelled || _num_remaining_senders <= 0) {
+            return Status::OK();
+        }
+
+        _chunk_queue.emplace_back(chunk_bytes, std::move(chunk), true);
+        _recvr->_mem_tracker->consume(chunk_bytes);
+        // if done is nullptr, this function can't delay this response
+        if (done != nullptr && _recvr->exceeds_limit(chunk_bytes)) {
+            MonotonicStopWatch monotonicStopWatch;
+            DCHECK(*done != nullptr);
+            _pending_closures.emplace_back(*done, monotonicStopWatch);
+            *done = nullptr;
+        }
+        _recvr->_num_buffered_bytes += chunk_bytes;
+    }
+    _data_arrival_cv.notify_one();
+    return Status::OK();
+}
+
 Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk,
                                                         faststring* uncompressed_buffer) {
     if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
@@ -519,6 +565,12 @@ void DataStreamRecvr::SenderQueue::close() {
     for (RowBatchQueue::iterator it = _batch_queue.begin(); it != _batch_queue.end(); ++it) {
         delete it->second;
     }
+    for (auto& item : _chunk_queue) {
+        if (item.is_local) {
+            _recvr->_mem_tracker->release(item.chunk_bytes);
+        }
+    }
+    _chunk_queue.clear();
 
     _current_batch.reset();
 }
@@ -598,6 +650,7 @@ DataStreamRecvr::DataStreamRecvr(DataStreamMgr* stream_mgr, MemTracker* parent_t
     _data_arrival_timer = ADD_TIMER(_profile, "DataArrivalWaitTime");
     _decompress_row_batch_timer = ADD_TIMER(_profile, "DecompressRowBatchTimer");
     _deserialize_chunk_meta_timer = ADD_TIMER(_profile, "DeserializeChunkMetaTimer");
+    _local_chunks_received_counter = ADD_COUNTER(_profile, "LocalChunksReceived", TUnit::UNIT);
     _buffer_full_total_timer = ADD_TIMER(_profile, "SendersBlockedTotalTimer(*)");
     _first_batch_wait_total_timer = ADD_TIMER(_profile, "FirstBatchArrivalWaitTime");
 
@@ -630,6 +683,14 @@ Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google
     return _sender_queues[use_sender_id]->add_chunks(request, done);
 }
 
+Status DataStreamRecvr::add_chunk_local(int sender_id, ChunkUniquePtr chunk, ::google::protobuf::Closure** done) {
+    SCOPED_TIMER(_sender_total_timer);
+    COUNTER_UPDATE(_local_chunks_received_counter, 1);
+    int use_sender_id = _is_merging ? sender_id : 0;
+    // Add all chunks to the same queue if _is_merging is false.
+    return _sender_queues[use_sender_id]->add_chunk_local(std::move(chunk), done);
+}
+
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->decrement_senders(be_number);
@@ -136,6 +136,9 @@ private:
     // If receive queue is full, done is enqueue pending, and return with *done is nullptr
     Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
 
+    // Same as add_chunks(), for a chunk handed over by a sender in the same process.
+    Status add_chunk_local(int sender_id, vectorized::ChunkUniquePtr chunk, ::google::protobuf::Closure** done);
+
     // Indicate that a particular sender is done. Delegated to the appropriate
     // sender queue. Called from DataStreamMgr.
     void remove_sender(int sender_id, int be_number);
@@ -198,6 +201,8 @@ private:
     RuntimeProfile::Counter* _deserialize_row_batch_timer;
     RuntimeProfile::Counter* _decompress_row_batch_timer;
     RuntimeProfile::Counter* _request_received_counter;
+    // Number of chunks handed over by senders in the same process
+    RuntimeProfile::Counter* _local_chunks_received_counter;
 
     // Time spent waiting until the first batch arrives across all queues.
     // TODO: Turn this into a wall-clock timer.
@@ -31,6 +31,7 @@
 #include <memory>
 
 #include "column/chunk.h"
+#include "column/column_encoder.h"
 #include "common/logging.h"
 #include "exprs/expr.h"
 #include "gen_cpp/BackendService.h"
@@ -44,6 +45,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
@@ -56,6 +58,46 @@
 
 namespace starrocks {
 
+// Stand-in for the brpc done closure when a chunk is handed over to a receiver in the same
+// process: the receiver keeps it pending while its buffer is full, and the sender waits for it
+// before handing over more data, the same way it waits for the previous transmit_chunk RPC.
+class PassThroughClosure : public google::protobuf::Closure {
+public:
+    void ref() { _refs.fetch_add(1); }
+
+    // If unref() returns true, this object should be delete
+    bool unref() { return _refs.fetch_sub(1) == 1; }
+
+    // Must be called before the closure is handed to the receiver.
+    void prepare() {
+        ref();
+        std::lock_guard<std::mutex> l(_lock);
+        _finished = false;
+    }
+
+    void Run() override {
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _finished = true;
+        }
+        _cv.notify_all();
+        if (unref()) {
+            delete this;
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> l(_lock);
+        _cv.wait(l, [this] { return _finished; });
+    }
+
+private:
+    std::atomic<int> _refs{0};
+    std::mutex _lock;
+    std::condition_variable _cv;
+    bool _finished = true;
+};
+
 // A channel sends data asynchronously via calls to transmit_data
 // to a single destination ipaddress/node.
 // It has a fixed-capacity buffer and allows the caller either to add rows to
@@ -96,6 +138,10 @@ public:
             delete _chunk_closure;
         }
         _chunk_request.release_finst_id();
+
+        if (_pass_through_closure != nullptr && _pass_through_closure->unref()) {
+            delete _pass_through_closure;
+        }
     }
 
     // Initialize channel.
@@ -129,6 +175,14 @@ public:
     // by all the channels.
     Status send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment);
 
+    // Hand a copy of |chunk| to the receiver in this process. Only valid if use_pass_through().
+    // This function is only used when broadcast, instead of send_chunk_request().
+    Status send_chunk_local(const vectorized::Chunk* chunk);
+
+    // Whether the receiver lives in this process and chunks are handed over directly
+    // instead of being serialized and sent through brpc.
+    bool use_pass_through() const { return _pass_through; }
+
     // Flush buffered rows and close channel. This function don't wait the response
     // of close operation, client should call close_wait() to finish channel's close.
     // We split one close operation into two phases in order to make multiple channels
@@ -164,6 +218,10 @@ private:
 
     inline Status _wait_prev_request() {
         SCOPED_TIMER(_parent->_wait_response_timer);
+        if (_pass_through) {
+            _pass_through_closure->wait();
+            return Status::OK();
+        }
         if (_request_seq == 0) {
             return Status::OK();
         }
@@ -185,6 +243,12 @@ private:
 
     Status _do_send_chunk_rpc(PTransmitChunkParams* request, const butil::IOBuf& attachment);
 
+    // Hand |chunk| over to the receiver in this process, which takes its ownership.
+    // |chunk| may be nullptr when only eos is sent.
+    Status _send_chunk_local(vectorized::ChunkUniquePtr chunk, bool eos);
+    // A copy of |chunk| to hand over, consumed on the tracker of the sender.
+    vectorized::ChunkUniquePtr _copy_chunk(const vectorized::Chunk* chunk);
+
     Status close_internal();
 
     DataStreamSender* _parent;
@@ -229,6 +293,10 @@ private:
     bool _is_transfer_chain;
     bool _send_query_statistics_with_every_batch;
     bool _is_inited = false;
+
+    bool _pass_through = false;
+    PassThroughClosure* _pass_through_closure = nullptr;
+    DataStreamMgr* _stream_mgr = nullptr;
 };
 
 Status DataStreamSender::Channel::init(RuntimeState* state) {
@@ -269,6 +337,15 @@ Status DataStreamSender::Channel::init(RuntimeState* state) {
     }
     _brpc_stub = state->exec_env()->brpc_stub_cache()->get_stub(_brpc_dest_addr);
 
+    _pass_through = _parent->_is_vectorized && config::enable_exchange_pass_through &&
+                    _brpc_dest_addr.hostname == BackendOptions::get_localhost() &&
+                    _brpc_dest_addr.port == config::brpc_port;
+    if (_pass_through) {
+        _stream_mgr = state->exec_env()->stream_mgr();
+        _pass_through_closure = new PassThroughClosure();
+        _pass_through_closure->ref();
+    }
+
     _need_close = true;
     _is_inited = true;
     return Status::OK();
@@ -306,6 +383,15 @@ Status DataStreamSender::Channel::send_batch(PRowBatch* batch, bool eos) {
 Status DataStreamSender::Channel::send_one_chunk(const vectorized::Chunk* chunk, bool eos, bool* is_real_sent) {
     *is_real_sent = false;
 
+    if (_pass_through) {
+        vectorized::ChunkUniquePtr copy;
+        if (chunk != nullptr) {
+            copy = _copy_chunk(chunk);
+        }
+        *is_real_sent = true;
+        return _send_chunk_local(std::move(copy), eos);
+    }
+
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
         auto pchunk = _chunk_request.add_chunks();
@@ -347,6 +433,50 @@ Status DataStreamSender::Channel::send_chunk_request(PTransmitChunkParams* param
     return status;
 }
 
+Status DataStreamSender::Channel::send_chunk_local(const vectorized::Chunk* chunk) {
+    DCHECK(_pass_through);
+    return _send_chunk_local(_copy_chunk(chunk), false);
+}
+
+vectorized::ChunkUniquePtr DataStreamSender::Channel::_copy_chunk(const vectorized::Chunk* chunk) {
+    vectorized::ChunkUniquePtr copy = chunk->clone_empty_with_tuple();
+    copy->append(*chunk);
+    // The copy is on the sender until it is handed over to the receiver.
+    _parent->_mem_tracker->consume(copy->memory_usage());
+    return copy;
+}
+
+Status DataStreamSender::Channel::_send_chunk_local(vectorized::ChunkUniquePtr chunk, bool eos) {
+    int64_t chunk_bytes = chunk != nullptr ? chunk->memory_usage() : 0;
+    // Wait until the receiver has room for more data, like waiting for the last RPC.
+    Status st = _wait_prev_request();
+    // The chunk leaves the sender: the receiver consumes it on its own tracker once it has
+    // queued it, otherwise it is freed.
+    _parent->_mem_tracker->release(chunk_bytes);
+    RETURN_IF_ERROR(st);
+    SCOPED_TIMER(_parent->_send_request_timer);
+
+    PQueryStatistics statistics;
+    const PQueryStatistics* statistics_ptr = nullptr;
+    if (_is_transfer_chain && (_send_query_statistics_with_every_batch || eos)) {
+        _parent->_query_statistics->to_pb(&statistics);
+        statistics_ptr = &statistics;
+    }
+    if (chunk != nullptr) {
+        COUNTER_UPDATE(_parent->_pass_through_chunk_counter, 1);
+    }
+
+    _pass_through_closure->prepare();
+    google::protobuf::Closure* done = _pass_through_closure;
+    st = _stream_mgr->transmit_chunk_local(_fragment_instance_id, _dest_node_id, _parent->_sender_id,
+                                           _parent->_be_number, std::move(chunk), eos, statistics_ptr, &done);
+    // The receiver did not keep the closure pending, it is our responsibility to run it.
+    if (done != nullptr) {
+        done->Run();
+    }
+    return st;
+}
+
 Status DataStreamSender::Channel::_do_send_chunk_rpc(PTransmitChunkParams* request, const butil::IOBuf& attachment) {
     SCOPED_TIMER(_parent->_send_request_timer);
 
@@ -417,6 +547,13 @@ Status DataStreamSender::Channel::send_current_batch(bool eos) {
 }
 
 Status DataStreamSender::Channel::_send_current_chunk(bool eos) {
+    if (_pass_through) {
+        // Hand the accumulated chunk itself over to the receiver and start a new one.
+        vectorized::ChunkUniquePtr chunk = std::move(_chunk);
+        _chunk = chunk->clone_empty_with_tuple();
+        return _send_chunk_local(std::move(chunk), eos);
+    }
+
     bool is_real_sent = false;
     RETURN_IF_ERROR(send_one_chunk(_chunk.get(), eos, &is_real_sent));
 
@@ -574,6 +711,7 @@ Status DataStreamSender::prepare(RuntimeState* state) {
         _compress_type = CompressionTypePB::LZ4;
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    _encode_columns = config::exchange_column_encoding;
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -613,12 +751,20 @@ Status DataStreamSender::prepare(RuntimeState* state) {
     _wait_response_timer = ADD_TIMER(profile(), "WaitResponseTime");
     _shuffle_dispatch_timer = ADD_TIMER(profile(), "ShuffleDispatchTime");
     _shuffle_hash_timer = ADD_TIMER(profile(), "ShuffleHashTime");
+    _pass_through_chunk_counter = ADD_COUNTER(profile(), "PassThroughChunkNum", TUnit::UNIT);
+    if (_part_type == TPartitionType::HASH_PARTITIONED ||
+        _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) {
+        _skew_monitor.init(profile(), _channels.size());
+    }
     _overall_throughput = profile()->add_derived_counter(
             "OverallThroughput", TUnit::BYTES_PER_SECOND,
             std::bind<int64_t>(&RuntimeProfile::units_per_second, _bytes_sent_counter, profile()->total_time_counter()),
             "");
     for (int i = 0; i < _channels.size(); ++i) {
         RETURN_IF_ERROR(_channels[i]->init(state));
+        if (!_channels[i]->use_pass_through()) {
+            _num_remote_channels++;
+        }
     }
 
     // set eos for all channels.
@@ -711,18 +857,29 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
     }
     // Unpartition or _channel size
     if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
+        // Receivers in this process get their own copy of the chunk.
+        for (auto channel : _channels) {
+            if (channel->use_pass_through()) {
+                RETURN_IF_ERROR(channel->send_chunk_local(chunk));
+            }
+        }
+        if (_num_remote_channels == 0) {
+            return Status::OK();
+        }
         // We use sender request to avoid serialize chunk many times.
         // 1. create a new chunk PB to serialize
         ChunkPB* pchunk = _chunk_request.add_chunks();
         // 2. serialize input chunk to pchunk
-        RETURN_IF_ERROR(serialize_chunk(chunk, pchunk, &_is_first_chunk, _channels.size()));
+        RETURN_IF_ERROR(serialize_chunk(chunk, pchunk, &_is_first_chunk, _num_remote_channels));
         _current_request_bytes += pchunk->data().size();
         // 3. if request bytes exceede the threshold, send current request
         if (_current_request_bytes > _request_bytes_threshold) {
             butil::IOBuf attachment;
             construct_brpc_attachment(&_chunk_request, &attachment);
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
+                if (!channel->use_pass_through()) {
+                    RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
+                }
             }
             _current_request_bytes = 0;
             _chunk_request.clear_chunks();
@@ -764,6 +921,8 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
                 }
             }
 
+            _skew_monitor.sample(_hash_values.data(), num_rows);
+
             // compute row indexes for each channel
             _channel_row_idx_start_points.assign(num_channels + 1, 0);
             for (uint16_t i = 0; i < num_rows; ++i) {
@@ -783,6 +942,7 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
             }
         }
 
+        int64_t row_bytes = _skew_monitor.enabled() ? chunk->bytes_usage() / num_rows : 0;
         for (int i = 0; i < num_channels; ++i) {
             size_t from = _channel_row_idx_start_points[i];
             size_t size = _channel_row_idx_start_points[i + 1] - from;
@@ -790,6 +950,7 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
                 // no data for this channel continue;
                 continue;
             }
+            _skew_monitor.add_rows(i, size, size * row_bytes);
             if (_channels[i]->get_fragment_instance_id().lo == -1) {
                 // dest bucket is no used, continue
                 continue;
@@ -910,7 +1071,11 @@ Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
         butil::IOBuf attachment;
         construct_brpc_attachment(&_chunk_request, &attachment);
         for (int i = 0; i < _channels.size(); ++i) {
-            _channels[i]->send_chunk_request(&_chunk_request, attachment);
+            if (_channels[i]->use_pass_through()) {
+                _channels[i]->close(state);
+            } else {
+                _channels[i]->send_chunk_request(&_chunk_request, attachment);
+            }
         }
     } else {
         for (int i = 0; i < _channels.size(); ++i) {
@@ -922,6 +1087,7 @@ Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
     for (int i = 0; i < _channels.size(); ++i) {
         _channels[i]->close_wait(state);
     }
+    _skew_monitor.close();
     for (auto iter : _partition_infos) {
         auto st = iter->close(state);
         if (!st.ok()) {
@@ -968,12 +1134,17 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
         dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            uncompressed_size = src->serialize_with_meta(dst);
+            src->serialize_meta(dst);
             *is_first_chunk = false;
         } else {
             dst->clear_is_nulls();
             dst->clear_is_consts();
             dst->clear_slot_id_map();
+        }
+        if (_encode_columns) {
+            uncompressed_size = vectorized::ColumnEncoder::encode_chunk(*src, &_encode_buffer);
+            dst->mutable_data()->assign(reinterpret_cast<const char*>(_encode_buffer.data()), uncompressed_size);
+        } else {
             uncompressed_size = src->serialize_size();
             // TODO(kks): resize without initializing the new bytes
             dst->mutable_data()->resize(uncompressed_size);
@@ -988,7 +1159,7 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
 
     dst->set_uncompressed_size(uncompressed_size);
     // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    if (_compress_codec != nullptr && uncompressed_size > 0 && _compress_policy.should_compress()) {
         SCOPED_TIMER(_compress_timer);
 
         // Try compressing data to _compression_scratch, swap if compressed data is smaller
@@ -1001,6 +1172,7 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
         Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
         _compress_codec->compress(dst->data(), &compressed_slice);
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
+        _compress_policy.update(compress_ratio);
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
             _compression_scratch.resize(compressed_slice.size);
             dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
@@ -32,6 +32,9 @@
 #include "exec/data_sink.h"
 #include "gen_cpp/data.pb.h" // for PRowBatch
 #include "gen_cpp/internal_service.pb.h"
+#include "runtime/shuffle_skew_monitor.h"
+#include "util/compression_utils.h"
+#include "util/faststring.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -161,6 +164,8 @@ private:
     PTransmitChunkParams _chunk_request;
     size_t _current_request_bytes = 0;
     size_t _request_bytes_threshold = 0;
+    // Number of channels whose receiver is in another process, only those need _chunk_request.
+    size_t _num_remote_channels = 0;
 
     std::vector<uint32_t> _hash_values;
     vectorized::Columns _partitions_columns;
@@ -170,6 +175,12 @@ private:
     // to (we don't compress directly into the ChunkPB in case the compressed data is
     // longer than the uncompressed data).
     raw::RawString _compression_scratch;
+    // Skips compression while the exchanged data turns out to be incompressible.
+    AdaptiveCompressionPolicy _compress_policy;
+    // Whether to encode columns with ColumnEncoder, fixed at prepare so all chunks of a
+    // stream use the same format.
+    bool _encode_columns = false;
+    faststring _encode_buffer;
     // vector query engine data struct
 
     std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
@@ -213,6 +224,8 @@ private:
 
     RuntimeProfile::Counter* _shuffle_dispatch_timer{};
     RuntimeProfile::Counter* _shuffle_hash_timer{};
+    RuntimeProfile::Counter* _pass_through_chunk_counter{};
+    ShuffleSkewMonitor _skew_monitor;
 
     std::unique_ptr<MemTracker> _mem_tracker;
 
@@ -21,6 +21,7 @@
 
 #include "runtime/descriptors.h"
 
+#include <algorithm>
 #include <boost/algorithm/string/join.hpp>
 #include <ios>
 #include <sstream>
@@ -556,6 +557,14 @@ TupleDescriptor* DescriptorTbl::get_tuple_descriptor(TupleId id) const {
     }
 }
 
+SlotId DescriptorTbl::max_slot_id() const {
+    SlotId max_id = -1;
+    for (const auto& [id, desc] : _slot_desc_map) {
+        max_id = std::max(max_id, id);
+    }
+    return max_id;
+}
+
 SlotDescriptor* DescriptorTbl::get_slot_descriptor(SlotId id) const {
     // TODO: is there some boost function to do exactly this?
     SlotDescriptorMap::const_iterator i = _slot_desc_map.find(id);
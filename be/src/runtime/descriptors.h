@@ -324,6 +324,9 @@ public:
     TupleDescriptor* get_tuple_descriptor(TupleId id) const;
     SlotDescriptor* get_slot_descriptor(SlotId id) const;
 
+    // The largest id of the slots, -1 if there is no slot.
+    SlotId max_slot_id() const;
+
     // return all registered tuple descriptors
     void get_tuple_descs(std::vector<TupleDescriptor*>* descs) const;
 
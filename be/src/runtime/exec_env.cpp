@@ -64,6 +64,7 @@
 #include "util/pretty_printer.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 namespace starrocks {
 
 // Calculate the total memory limit of all load tasks on this BE
@@ -97,6 +98,24 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _pipeline_io_thread_pool = new PriorityThreadPool(4, config::doris_scanner_thread_pool_queue_size);
     _num_scan_operators = 0;
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size, config::etl_thread_pool_queue_size);
+    if (config::csv_parse_thread_pool_size > 0) {
+        std::unique_ptr<ThreadPool> csv_parse_thread_pool;
+        RETURN_IF_ERROR(ThreadPoolBuilder("csv_parse_thread_pool")
+                                .set_min_threads(0)
+                                .set_max_threads(config::csv_parse_thread_pool_size)
+                                .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                                .build(&csv_parse_thread_pool));
+        _csv_parse_thread_pool = csv_parse_thread_pool.release();
+    }
+    if (config::segment_encode_thread_pool_size > 0) {
+        std::unique_ptr<ThreadPool> segment_encode_thread_pool;
+        RETURN_IF_ERROR(ThreadPoolBuilder("segment_encode_thread_pool")
+                                .set_min_threads(0)
+                                .set_max_threads(config::segment_encode_thread_pool_size)
+                                .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                                .build(&segment_encode_thread_pool));
+        _segment_encode_thread_pool = segment_encode_thread_pool.release();
+    }
     _fragment_mgr = new FragmentMgr(this);
 
     std::unique_ptr<ThreadPool> driver_dispatcher_thread_pool;
@@ -252,6 +271,8 @@ void ExecEnv::_destory() {
     delete _master_info;
     delete _driver_dispatcher;
     delete _fragment_mgr;
+    delete _segment_encode_thread_pool;
+    delete _csv_parse_thread_pool;
     delete _etl_thread_pool;
     delete _thread_pool;
     delete _thread_mgr;
@@ -131,6 +131,8 @@ public:
     size_t increment_num_scan_operators(size_t n) { return _num_scan_operators.fetch_add(n); }
     size_t decrement_num_scan_operators(size_t n) { return _num_scan_operators.fetch_sub(n); }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
+    ThreadPool* csv_parse_thread_pool() { return _csv_parse_thread_pool; }
+    ThreadPool* segment_encode_thread_pool() { return _segment_encode_thread_pool; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
     starrocks::pipeline::DriverDispatcher* driver_dispatcher() { return _driver_dispatcher; }
     TMasterInfo* master_info() { return _master_info; }
@@ -217,6 +219,8 @@ private:
     PriorityThreadPool* _pipeline_io_thread_pool = nullptr;
     std::atomic<size_t> _num_scan_operators;
     PriorityThreadPool* _etl_thread_pool = nullptr;
+    ThreadPool* _csv_parse_thread_pool = nullptr;
+    ThreadPool* _segment_encode_thread_pool = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
     starrocks::pipeline::DriverDispatcher* _driver_dispatcher;
     TMasterInfo* _master_info = nullptr;
@@ -21,6 +21,7 @@
 
 #include "runtime/file_result_writer.h"
 
+#include "column/chunk.h"
 #include "exec/broker_writer.h"
 #include "exec/local_file_writer.h"
 #include "exec/parquet_writer.h"
@@ -80,6 +81,7 @@ Status FileResultWriter::_create_file_writer() {
         break;
     case TFileFormatType::FORMAT_PARQUET:
         _parquet_writer = new ParquetWriterWrapper(_file_writer, _output_expr_ctxs);
+        RETURN_IF_ERROR(_parquet_writer->init());
         break;
     default:
         return Status::InternalError(strings::Substitute("unsupport file format: $0", _file_opts->file_format));
@@ -112,18 +114,42 @@ Status FileResultWriter::append_row_batch(const RowBatch* batch) {
         return Status::OK();
     }
 
-    SCOPED_TIMER(_append_row_batch_timer);
     if (_parquet_writer != nullptr) {
-        RETURN_IF_ERROR(_parquet_writer->write(*batch));
-    } else {
-        RETURN_IF_ERROR(_write_csv_file(*batch));
+        return Status::NotSupported("parquet files are only written from chunks");
     }
+    SCOPED_TIMER(_append_row_batch_timer);
+    RETURN_IF_ERROR(_write_csv_file(*batch));
 
     _written_rows += batch->num_rows();
     return Status::OK();
 }
 
 Status FileResultWriter::append_chunk(vectorized::Chunk* chunk) {
+    if (nullptr == chunk || 0 == chunk->num_rows() || _parquet_writer == nullptr) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_append_row_batch_timer);
+    RETURN_IF_ERROR(_parquet_writer->write(chunk));
+    _written_rows += chunk->num_rows();
+    _update_parquet_written_bytes();
+    // split file if exceed limit
+    return _create_new_file_if_exceed_size();
+}
+
+void FileResultWriter::_update_parquet_written_bytes() {
+    int64_t written_len = _parquet_writer->written_len();
+    COUNTER_UPDATE(_written_data_bytes, written_len - _current_written_bytes);
+    _current_written_bytes = written_len;
+}
+
+Status FileResultWriter::_close_parquet_writer() {
+    if (_parquet_writer == nullptr) {
+        return Status::OK();
+    }
+    // the last row group and the footer are written by close
+    RETURN_IF_ERROR(_parquet_writer->close());
+    _update_parquet_written_bytes();
     return Status::OK();
 }
 
@@ -285,6 +311,7 @@ Status FileResultWriter::_create_new_file_if_exceed_size() {
     // and create new one
     {
         SCOPED_TIMER(_writer_close_timer);
+        RETURN_IF_ERROR(_close_parquet_writer());
         RETURN_IF_ERROR(_close_file_writer(false));
     }
     _current_written_bytes = 0;
@@ -293,12 +320,13 @@ Status FileResultWriter::_create_new_file_if_exceed_size() {
 
 Status FileResultWriter::_close_file_writer(bool done) {
     if (_parquet_writer != nullptr) {
-        _parquet_writer->close();
+        Status st = _parquet_writer->close();
         delete _parquet_writer;
         _parquet_writer = nullptr;
-        if (!done) {
-            //TODO(cmy): implement parquet writer later
-        }
+        // closed by the parquet writer
+        delete _file_writer;
+        _file_writer = nullptr;
+        RETURN_IF_ERROR(st);
     } else if (_file_writer != nullptr) {
         _file_writer->close();
         delete _file_writer;
@@ -320,6 +348,7 @@ Status FileResultWriter::close() {
     // so does the profile in RuntimeState.
     COUNTER_SET(_written_rows_counter, _written_rows);
     SCOPED_TIMER(_writer_close_timer);
+    RETURN_IF_ERROR(_close_parquet_writer());
     RETURN_IF_ERROR(_close_file_writer(true));
     return Status::OK();
 }
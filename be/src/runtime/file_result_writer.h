@@ -81,6 +81,11 @@ private:
     // if buffer exceed the limit, write the data buffered in _plain_text_outstream via file_writer
     // if eos, write the data even if buffer is not full.
     Status _flush_plain_text_outstream(bool eos);
+    // add the bytes written by _parquet_writer since the last call to the counters
+    void _update_parquet_written_bytes();
+    // write the rest of the parquet file, so that the counters include it; the writer is
+    // deleted by _close_file_writer
+    Status _close_parquet_writer();
     void _init_profile();
 
     Status _create_file_writer();
@@ -96,10 +101,10 @@ private:
     const ResultFileOptions* _file_opts;
     const std::vector<ExprContext*>& _output_expr_ctxs;
 
-    // If the result file format is plain text, like CSV, this _file_writer is owned by this FileResultWriter.
-    // If the result file format is Parquet, this _file_writer is owned by _parquet_writer.
+    // This _file_writer is owned by this FileResultWriter.
+    // If the result file format is Parquet, it is written and closed by _parquet_writer.
     FileWriter* _file_writer = nullptr;
-    // parquet file writer
+    // parquet file writer, which is only written from chunks
     ParquetWriterWrapper* _parquet_writer = nullptr;
     // Used to buffer the export data of plain text
     // TODO(cmy): I simply use a stringstrteam to buffer the data, to avoid calling
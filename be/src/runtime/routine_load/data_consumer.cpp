@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gutil/strings/split.h"
 #include "runtime/small_file_mgr.h"
@@ -36,6 +37,9 @@
 
 namespace starrocks {
 
+// a batch of kafka msgs is handed over to the consumer group at most this long after its first msg
+static const int64_t kMaxBatchWaitNs = 100 * 1000 * 1000;
+
 // init kafka consumer will only set common configs such as
 // brokers, groupid
 Status KafkaDataConsumer::init(StreamLoadContext* ctx) {
@@ -134,7 +138,9 @@ Status KafkaDataConsumer::assign_topic_partitions(const std::map<int32_t, int64_
     // create TopicPartitions
     std::stringstream ss;
     std::vector<RdKafka::TopicPartition*> topic_partitions;
+    _assigned_partitions.clear();
     for (auto& entry : begin_partition_offset) {
+        _assigned_partitions.push_back(entry.first);
         RdKafka::TopicPartition* tp1 = RdKafka::TopicPartition::create(topic, entry.first, entry.second);
         topic_partitions.push_back(tp1);
         ss << "[" << entry.first << ": " << entry.second << "] ";
@@ -160,17 +166,39 @@ Status KafkaDataConsumer::assign_topic_partitions(const std::map<int32_t, int64_
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms) {
+Status KafkaDataConsumer::group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms) {
     _last_visit_time = time(nullptr);
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id << ", max running time(ms): " << left_time;
 
     int64_t received_rows = 0;
     int64_t put_rows = 0;
+    int64_t put_batches = 0;
     Status st = Status::OK();
     MonotonicStopWatch consumer_watch;
     MonotonicStopWatch watch;
     watch.start();
+
+    // msgs are handed over to the group in batches, so that the queue is not locked for every msg
+    const size_t max_batch_size = std::max(config::routine_load_kafka_batch_size, 1);
+    auto batch = std::make_unique<KafkaMessageBatch>();
+    int64_t batch_begin_ns = 0;
+    // return false if the queue is shutdown
+    auto put_batch = [&]() {
+        if (batch->empty()) {
+            return true;
+        }
+        size_t num_msgs = batch->size();
+        if (!queue->blocking_put(batch.get())) {
+            return false;
+        }
+        batch.release(); // release the ownership, the batch will be deleted after being processed
+        batch = std::make_unique<KafkaMessageBatch>();
+        put_rows += num_msgs;
+        ++put_batches;
+        return true;
+    };
+
     while (true) {
         {
             std::unique_lock<std::mutex> l(_lock);
@@ -190,19 +218,21 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
         consumer_watch.stop();
         switch (msg->err()) {
         case RdKafka::ERR_NO_ERROR:
-            if (!queue->blocking_put(msg.get())) {
-                // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
+            if (batch->empty()) {
+                batch_begin_ns = watch.elapsed_time();
             }
+            batch->emplace_back(std::move(msg));
             ++received_rows;
+            if (batch->size() >= max_batch_size || watch.elapsed_time() - batch_begin_ns >= kMaxBatchWaitNs) {
+                // queue is shutdown if failed
+                done = !put_batch();
+            }
             break;
         case RdKafka::ERR__TIMED_OUT:
             // leave the status as OK, because this may happend
             // if there is no data in kafka.
             LOG(INFO) << "kafka consume timeout: " << _id;
+            done = !put_batch();
             break;
         case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
             done = true;
@@ -224,15 +254,34 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
             break;
         }
     }
+    if (st.ok()) {
+        // the group may be still receiving if this consumer runs out of time first
+        put_batch();
+    }
 
     LOG(INFO) << "kafka consume done: " << _id << ", grp: " << _grp_id << ". cancelled: " << _cancelled
               << ", left time(ms): " << left_time << ", total cost(ms): " << watch.elapsed_time() / 1000 / 1000
               << ", consume cost(ms): " << consumer_watch.elapsed_time() / 1000 / 1000
-              << ", received rows: " << received_rows << ", put rows: " << put_rows;
+              << ", received rows: " << received_rows << ", put rows: " << put_rows << ", put batches: " << put_batches;
 
     return st;
 }
 
+void KafkaDataConsumer::get_partition_lags(const std::map<int32_t, int64_t>& cmt_offset,
+                                           std::map<int32_t, int64_t>* lags) {
+    for (int32_t p_id : _assigned_partitions) {
+        auto iter = cmt_offset.find(p_id);
+        int64_t low = 0;
+        int64_t high = 0;
+        if (iter == cmt_offset.end() ||
+            _k_consumer->get_watermark_offsets(_topic, p_id, &low, &high) != RdKafka::ERR_NO_ERROR || high < 0) {
+            continue;
+        }
+        // the commit offset is inclusive, and the high watermark is the offset of the next msg
+        (*lags)[p_id] = std::max<int64_t>(high - iter->second - 1, 0);
+    }
+}
+
 Status KafkaDataConsumer::get_partition_offset(std::vector<int32_t>* partition_ids,
                                                std::vector<int64_t>* beginning_offsets,
                                                std::vector<int64_t>* latest_offsets) {
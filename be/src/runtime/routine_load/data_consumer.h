@@ -22,8 +22,11 @@
 #pragma once
 
 #include <ctime>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -36,6 +39,9 @@ class KafkaConsumerPipe;
 class Status;
 class StreamLoadPipe;
 
+// messages consumed in a row by one kafka consumer, which are handed over to the consumer group at once
+using KafkaMessageBatch = std::vector<std::unique_ptr<RdKafka::Message>>;
+
 class DataConsumer {
 public:
     DataConsumer(StreamLoadContext* ctx)
@@ -136,8 +142,12 @@ public:
     Status assign_topic_partitions(const std::map<int32_t, int64_t>& begin_partition_offset, const std::string& topic,
                                    StreamLoadContext* ctx);
 
-    // start the consumer and put msgs to queue
-    Status group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    // start the consumer and put batches of msgs to queue
+    virtual Status group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
+
+    // get the lags of the assigned partitions consumed up to |cmt_offset|, by the high watermarks
+    // cached by the consumer. partitions whose watermarks are unknown are skipped.
+    virtual void get_partition_lags(const std::map<int32_t, int64_t>& cmt_offset, std::map<int32_t, int64_t>* lags);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
@@ -150,6 +160,7 @@ private:
     std::string _brokers;
     std::string _topic;
     std::unordered_map<std::string, std::string> _custom_properties;
+    std::vector<int32_t> _assigned_partitions;
 
     KafkaEventCb _k_event_cb;
     RdKafka::KafkaConsumer* _k_consumer = nullptr;
@@ -25,6 +25,7 @@
 #include "runtime/routine_load/data_consumer.h"
 #include "runtime/routine_load/kafka_consumer_pipe.h"
 #include "runtime/stream_load/stream_load_context.h"
+#include "util/starrocks_metrics.h"
 
 namespace starrocks {
 
@@ -55,10 +56,9 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
     // clean the msgs left in queue
     _queue.shutdown();
     while (true) {
-        RdKafka::Message* msg;
-        if (_queue.blocking_get(&msg)) {
-            delete msg;
-            msg = nullptr;
+        KafkaMessageBatch* batch;
+        if (_queue.blocking_get(&batch)) {
+            delete batch;
         } else {
             break;
         }
@@ -104,13 +104,9 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     // copy one
     std::map<int32_t, int64_t> cmt_offset = ctx->kafka_info->cmt_offset;
 
-    //improve performance
-    Status (KafkaConsumerPipe::*append_data)(const char* data, size_t size, char row_delimiter);
+    bool is_json = ctx->format == TFileFormatType::FORMAT_JSON;
     char row_delimiter = '\n';
-    if (ctx->format == TFileFormatType::FORMAT_JSON) {
-        append_data = &KafkaConsumerPipe::append_json;
-    } else {
-        append_data = &KafkaConsumerPipe::append_with_row_delimiter;
+    if (!is_json) {
         auto& per_node_scan_ranges = ctx->put_result.params.params.per_node_scan_ranges;
 
         if (!per_node_scan_ranges.empty()) {
@@ -126,6 +122,7 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     watch.start();
     Status st;
     bool eos = false;
+    std::map<int32_t, PartitionStat> batch_stats;
     while (true) {
         if (eos || left_time <= 0 || left_bytes <= 0) {
             LOG(INFO) << "consumer group done: " << _grp_id
@@ -146,6 +143,12 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             _thread_pool.shutdown();
             _thread_pool.join();
 
+            _report_partition_stats(ctx, cmt_offset, ctx->max_interval_s * 1000 - left_time);
+
+            if (result_st.ok() && !st.ok()) {
+                // failed to append msgs to the pipe
+                result_st = st;
+            }
             if (!result_st.ok()) {
                 // some of consumers encounter errors, cancel this task
                 return result_st;
@@ -165,26 +168,53 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             }
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
+        KafkaMessageBatch* batch;
+        bool res = _queue.blocking_get(&batch);
         if (res) {
-            VLOG(3) << "get kafka message"
-                    << ", partition: " << msg->partition() << ", offset: " << msg->offset() << ", len: " << msg->len();
+            std::unique_ptr<KafkaMessageBatch> batch_guard(batch);
+            VLOG(3) << "get kafka message batch, size: " << batch->size();
 
-            (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()),
-                                             row_delimiter);
+            // the msgs are owned by the pipe once appended, take their stats before
+            size_t batch_rows = batch->size();
+            int64_t batch_bytes = 0;
+            batch_stats.clear();
+            for (const auto& msg : *batch) {
+                batch_bytes += msg->len();
+                PartitionStat& stat = batch_stats[msg->partition()];
+                stat.rows++;
+                stat.bytes += msg->len();
+                stat.offset = msg->offset();
+                VLOG(3) << "consume partition[" << msg->partition() << " - " << msg->offset() << "]";
+            }
+
+            if (is_json) {
+                st = kafka_pipe->append_json_batch(std::move(batch_guard));
+            } else {
+                st = kafka_pipe->append_batch_with_row_delimiter(std::move(batch_guard), row_delimiter);
+            }
 
             if (st.ok()) {
-                received_rows++;
-                left_bytes -= msg->len();
-                cmt_offset[msg->partition()] = msg->offset();
-                VLOG(3) << "consume partition[" << msg->partition() << " - " << msg->offset() << "]";
+                for (const auto& [partition, batch_stat] : batch_stats) {
+                    cmt_offset[partition] = batch_stat.offset;
+                    PartitionStat& stat = _partition_stats[partition];
+                    if (stat.metrics == nullptr) {
+                        stat.metrics = StarRocksMetrics::instance()->routine_load_partition_metrics(
+                                ctx->kafka_info->topic, partition);
+                    }
+                    stat.rows += batch_stat.rows;
+                    stat.bytes += batch_stat.bytes;
+                    stat.metrics->receive_rows.increment(batch_stat.rows);
+                    stat.metrics->receive_bytes.increment(batch_stat.bytes);
+                }
+                received_rows += batch_rows;
+                left_bytes -= batch_bytes;
+                StarRocksMetrics::instance()->routine_load_receive_rows_total.increment(batch_rows);
+                StarRocksMetrics::instance()->routine_load_receive_bytes_total.increment(batch_bytes);
             } else {
-                // failed to append this msg, we must stop
-                LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
+                // failed to append this batch, we must stop
+                LOG(WARNING) << "failed to append msgs to pipe. grp: " << _grp_id << ", err: " << st.to_string();
                 eos = true;
             }
-            delete msg;
         } else {
             // queue is empty and shutdown
             eos = true;
@@ -196,8 +226,33 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     return Status::OK();
 }
 
+void KafkaDataConsumerGroup::_report_partition_stats(StreamLoadContext* ctx,
+                                                     const std::map<int32_t, int64_t>& cmt_offset,
+                                                     int64_t consume_time_ms) {
+    std::map<int32_t, int64_t> lags;
+    for (auto& consumer : _consumers) {
+        std::static_pointer_cast<KafkaDataConsumer>(consumer)->get_partition_lags(cmt_offset, &lags);
+    }
+    std::stringstream ss;
+    int64_t time_ms = std::max<int64_t>(consume_time_ms, 1);
+    for (auto& [partition, cmt] : cmt_offset) {
+        const PartitionStat& stat = _partition_stats[partition];
+        ss << "[" << partition << ": rows=" << stat.rows << ", bytes=" << stat.bytes
+           << ", rows/s=" << stat.rows * 1000 / time_ms << ", bytes/s=" << stat.bytes * 1000 / time_ms
+           << ", offset=" << cmt;
+        auto iter = lags.find(partition);
+        if (iter != lags.end()) {
+            ss << ", lag=" << iter->second;
+            StarRocksMetrics::instance()->routine_load_partition_metrics(ctx->kafka_info->topic, partition)
+                    ->lag.set_value(iter->second);
+        }
+        ss << "] ";
+    }
+    LOG(INFO) << "consumer group partition stats: " << _grp_id << ", " << ss.str() << ctx->brief();
+}
+
 void KafkaDataConsumerGroup::actual_consume(std::shared_ptr<DataConsumer> consumer,
-                                            TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                                            TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                                             ConsumeFinishCallback cb) {
     Status st = std::static_pointer_cast<KafkaDataConsumer>(consumer)->group_consume(queue, max_running_time_ms);
     cb(st);
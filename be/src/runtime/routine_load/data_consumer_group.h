@@ -21,9 +21,13 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "runtime/routine_load/data_consumer.h"
 #include "util/blocking_queue.hpp"
 #include "util/priority_thread_pool.hpp"
+#include "util/starrocks_metrics.h"
 
 namespace starrocks {
 
@@ -67,7 +71,11 @@ protected:
 // for kafka
 class KafkaDataConsumerGroup : public DataConsumerGroup {
 public:
-    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(500) {}
+    // About kMaxQueuedMsgs msgs are queued whatever the size of the batches, and every consumer holds
+    // one more batch at most.
+    KafkaDataConsumerGroup()
+            : DataConsumerGroup(),
+              _queue(std::max(1, kMaxQueuedMsgs / std::max(config::routine_load_kafka_batch_size, 1))) {}
 
     virtual ~KafkaDataConsumerGroup();
 
@@ -77,12 +85,27 @@ public:
 
 private:
     // start a single consumer
-    void actual_consume(std::shared_ptr<DataConsumer> consumer, TimedBlockingQueue<RdKafka::Message*>* queue,
+    void actual_consume(std::shared_ptr<DataConsumer> consumer, TimedBlockingQueue<KafkaMessageBatch*>* queue,
                         int64_t max_running_time_ms, ConsumeFinishCallback cb);
 
+    // update the lag metric and log the rows, bytes and lag of every partition consumed
+    void _report_partition_stats(StreamLoadContext* ctx, const std::map<int32_t, int64_t>& cmt_offset,
+                                 int64_t consume_time_ms);
+
+    struct PartitionStat {
+        int64_t rows = 0;
+        int64_t bytes = 0;
+        // the offset of the last msg
+        int64_t offset = -1;
+        std::shared_ptr<StarRocksMetrics::RoutineLoadPartitionMetrics> metrics;
+    };
+
 private:
-    // blocking queue to receive msgs from all consumers
-    TimedBlockingQueue<RdKafka::Message*> _queue;
+    static constexpr int kMaxQueuedMsgs = 500;
+
+    // blocking queue to receive batches of msgs from all consumers
+    TimedBlockingQueue<KafkaMessageBatch*> _queue;
+    std::map<int32_t, PartitionStat> _partition_stats;
 };
 
 } // end namespace starrocks
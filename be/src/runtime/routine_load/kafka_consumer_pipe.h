@@ -23,36 +23,223 @@
 
 #include <stdint.h>
 
-#include <map>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "exec/file_reader.h"
 #include "librdkafka/rdkafka.h"
 #include "runtime/message_body_sink.h"
+#include "runtime/routine_load/data_consumer.h"
 #include "runtime/stream_load/stream_load_pipe.h"
 
 namespace starrocks {
 
+// The pipe of a kafka routine load task. The consumer group hands the batches of msgs over to it as they
+// are, so that the payloads are not copied into the byte queue of StreamLoadPipe before being read:
+// - the csv scanner takes the batches by read_batch() and parses the msgs straight into chunks;
+// - the other readers of bytes read the payloads, each one followed by the row delimiter of csv;
+// - the readers of messages, i.e. the json scanners, read the payloads one by one without copying them.
+// A batch is taken by one reader only. The pipe buffers up to |max_buffered_bytes| bytes of payloads,
+// unless a single batch is larger.
 class KafkaConsumerPipe : public StreamLoadPipe {
 public:
     KafkaConsumerPipe(size_t max_buffered_bytes = 1024 * 1024, size_t min_chunk_size = 64 * 1024)
-            : StreamLoadPipe(max_buffered_bytes, min_chunk_size) {}
+            : StreamLoadPipe(max_buffered_bytes, min_chunk_size), _max_buffered_bytes(max_buffered_bytes) {}
 
-    virtual ~KafkaConsumerPipe() {}
+    ~KafkaConsumerPipe() override = default;
 
-    Status append_with_row_delimiter(const char* data, size_t size, char row_delimiter) {
-        Status st = append(data, size);
-        if (!st.ok()) {
-            return st;
+    // The msgs of a csv load, each one is followed by |row_delimiter| when read as bytes.
+    Status append_batch_with_row_delimiter(std::unique_ptr<KafkaMessageBatch> batch, char row_delimiter) {
+        return _append_batch(std::move(batch), static_cast<unsigned char>(row_delimiter));
+    }
+
+    // The msgs of a json load, each one is read as a whole.
+    Status append_json_batch(std::unique_ptr<KafkaMessageBatch> batch) {
+        return _append_batch(std::move(batch), kNoRowDelimiter);
+    }
+
+    // Only batches of msgs are appended to this pipe.
+    Status append(const char* data, size_t size) override {
+        return Status::NotSupported("append bytes to kafka consumer pipe");
+    }
+
+    Status append(const ByteBufferPtr& buf) override {
+        return Status::NotSupported("append bytes to kafka consumer pipe");
+    }
+
+    // Takes the next batch of msgs, |batch| is set to null if the pipe is finished.
+    Status read_batch(std::unique_ptr<KafkaMessageBatch>* batch) {
+        std::unique_lock<std::mutex> l(_batch_lock);
+        RETURN_IF_ERROR(_wait_batch(l));
+        if (_batches.empty()) {
+            batch->reset();
+            return Status::OK();
+        }
+        DCHECK(_read_msg == 0 && _read_pos == 0) << "batch partially read as bytes";
+        *batch = std::move(_batches.front().msgs);
+        _pop_batch();
+        return Status::OK();
+    }
+
+    Status read(uint8_t* data, size_t* data_size, bool* eof) override {
+        size_t bytes_read = 0;
+        std::unique_lock<std::mutex> l(_batch_lock);
+        while (bytes_read < *data_size) {
+            RETURN_IF_ERROR(_wait_batch(l));
+            // finished
+            if (_batches.empty()) {
+                *data_size = bytes_read;
+                *eof = (bytes_read == 0);
+                return Status::OK();
+            }
+            const RdKafka::Message& msg = *(*_batches.front().msgs)[_read_msg];
+            if (_read_pos < msg.len()) {
+                size_t copy_size = std::min(*data_size - bytes_read, msg.len() - _read_pos);
+                memcpy(data + bytes_read, static_cast<const char*>(msg.payload()) + _read_pos, copy_size);
+                _read_pos += copy_size;
+                bytes_read += copy_size;
+                continue;
+            }
+            if (_row_delimiter != kNoRowDelimiter) {
+                data[bytes_read++] = static_cast<uint8_t>(_row_delimiter);
+            }
+            _next_msg();
+        }
+        *eof = false;
+        return Status::OK();
+    }
+
+    Status read_one_message(std::unique_ptr<uint8_t[]>* data, size_t* length) override {
+        ByteBufferPtr buf;
+        RETURN_IF_ERROR(read_one_message(&buf));
+        if (buf == nullptr) {
+            data->reset();
+            *length = 0;
+            return Status::OK();
+        }
+        *length = buf->remaining();
+        data->reset(new uint8_t[*length]);
+        buf->get_bytes(reinterpret_cast<char*>(data->get()), *length);
+        return Status::OK();
+    }
+
+    // The payload of the next msg, the buffer keeps the msg alive instead of copying it.
+    Status read_one_message(ByteBufferPtr* buf) override {
+        std::unique_lock<std::mutex> l(_batch_lock);
+        RETURN_IF_ERROR(_wait_batch(l));
+        if (_batches.empty()) {
+            buf->reset();
+            return Status::OK();
         }
+        DCHECK_EQ(0, _read_pos) << "msg partially read as bytes";
+        std::shared_ptr<RdKafka::Message> msg(std::move((*_batches.front().msgs)[_read_msg]));
+        *buf = ByteBuffer::wrap(static_cast<char*>(msg->payload()), msg->len(), msg);
+        _next_msg();
+        return Status::OK();
+    }
 
-        // append the row delimiter
-        st = append(&row_delimiter, 1);
-        return st;
+    // called when producer finished
+    Status finish() override {
+        {
+            std::lock_guard<std::mutex> l(_batch_lock);
+            _batch_finished = true;
+        }
+        _batch_get_cond.notify_all();
+        return StreamLoadPipe::finish();
     }
 
-    Status append_json(const char* data, size_t size, char row_delimiter) { return append_and_flush(data, size); }
+    // called when producer/comsumer failed
+    void cancel() override {
+        {
+            std::lock_guard<std::mutex> l(_batch_lock);
+            _batch_cancelled = true;
+        }
+        _batch_get_cond.notify_all();
+        _batch_put_cond.notify_all();
+        StreamLoadPipe::cancel();
+    }
+
+private:
+    static constexpr int kNoRowDelimiter = -1;
+
+    struct Batch {
+        std::unique_ptr<KafkaMessageBatch> msgs;
+        // bytes of the payloads
+        size_t bytes;
+    };
+
+    Status _append_batch(std::unique_ptr<KafkaMessageBatch> batch, int row_delimiter) {
+        if (batch->empty()) {
+            return Status::OK();
+        }
+        size_t bytes = 0;
+        for (const auto& msg : *batch) {
+            bytes += msg->len();
+        }
+        {
+            std::unique_lock<std::mutex> l(_batch_lock);
+            // if no batch is buffered, we append this batch without size check
+            while (!_batch_cancelled && !_batches.empty() && _buffered_bytes + bytes > _max_buffered_bytes) {
+                _batch_put_cond.wait(l);
+            }
+            if (_batch_cancelled) {
+                return Status::InternalError("cancelled");
+            }
+            _row_delimiter = row_delimiter;
+            _batches.push_back({std::move(batch), bytes});
+            _buffered_bytes += bytes;
+        }
+        _batch_get_cond.notify_one();
+        return Status::OK();
+    }
+
+    // wait until a batch is buffered or the pipe is finished, return error if it is cancelled
+    Status _wait_batch(std::unique_lock<std::mutex>& l) {
+        while (!_batch_cancelled && !_batch_finished && _batches.empty()) {
+            _batch_get_cond.wait(l);
+        }
+        if (_batch_cancelled) {
+            return Status::InternalError("cancelled");
+        }
+        DCHECK(!_batches.empty() || _batch_finished);
+        return Status::OK();
+    }
+
+    // move the read position to the next msg, the batch is dropped when all its msgs are read
+    void _next_msg() {
+        _read_pos = 0;
+        if (++_read_msg == _batches.front().msgs->size()) {
+            _read_msg = 0;
+            _pop_batch();
+        }
+    }
+
+    void _pop_batch() {
+        _buffered_bytes -= _batches.front().bytes;
+        _batches.pop_front();
+        _batch_put_cond.notify_one();
+    }
+
+    std::mutex _batch_lock;
+    std::condition_variable _batch_put_cond;
+    std::condition_variable _batch_get_cond;
+    std::deque<Batch> _batches;
+    size_t _buffered_bytes = 0;
+    const size_t _max_buffered_bytes;
+    bool _batch_finished = false;
+    bool _batch_cancelled = false;
+    // the byte following every msg read by read(), kNoRowDelimiter for json
+    int _row_delimiter = kNoRowDelimiter;
+
+    // the msg of the front batch read next by read() or read_one_message()
+    size_t _read_msg = 0;
+    // the bytes of the payload of _read_msg read by read(), the row delimiter is left if it equals the length
+    size_t _read_pos = 0;
 };
 
 } // end namespace starrocks
@@ -0,0 +1,101 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/shuffle_skew_monitor.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+static constexpr size_t kSampleStride = 16;
+static constexpr size_t kMinSketchCapacity = 32;
+static constexpr size_t kMaxSketchCapacity = 128;
+// Don't report heavy hitters before enough rows have been sampled.
+static constexpr uint64_t kMinSampledRows = 1024;
+
+void ShuffleSkewMonitor::init(RuntimeProfile* profile, size_t num_channels) {
+    _enabled = config::enable_exchange_skew_detection && num_channels > 1;
+    if (!_enabled) {
+        return;
+    }
+    _num_channels = num_channels;
+    _profile = profile;
+    _channel_rows.assign(num_channels, 0);
+    _total_bytes_counter = ADD_COUNTER(profile, "ShuffleChannelBytes", TUnit::BYTES);
+    _channel_bytes_counters.resize(num_channels);
+    for (size_t i = 0; i < num_channels; i++) {
+        _channel_bytes_counters[i] =
+                ADD_CHILD_COUNTER(profile, fmt::format("Channel{}", i), TUnit::BYTES, "ShuffleChannelBytes");
+    }
+    _max_channel_bytes_counter = ADD_COUNTER(profile, "MaxChannelBytes", TUnit::BYTES);
+    _skewed_rows_counter = ADD_COUNTER(profile, "SkewedKeyRows", TUnit::UNIT);
+    // Any key above the fair share of a channel must stay monitored by the sketch.
+    size_t capacity = std::clamp(2 * num_channels, kMinSketchCapacity, kMaxSketchCapacity);
+    _sketch = std::make_unique<SpaceSaving<uint32_t>>(capacity);
+}
+
+void ShuffleSkewMonitor::sample(const uint32_t* hash_values, size_t num_rows) {
+    if (!_enabled) {
+        return;
+    }
+    size_t i = _next_sample;
+    for (; i < num_rows; i += kSampleStride) {
+        _sketch->add(hash_values[i]);
+    }
+    _next_sample = i - num_rows;
+}
+
+void ShuffleSkewMonitor::add_rows(size_t channel, size_t rows, int64_t bytes) {
+    if (!_enabled) {
+        return;
+    }
+    _channel_rows[channel] += rows;
+    COUNTER_UPDATE(_channel_bytes_counters[channel], bytes);
+    COUNTER_UPDATE(_total_bytes_counter, bytes);
+}
+
+void ShuffleSkewMonitor::close() {
+    if (!_enabled) {
+        return;
+    }
+    int64_t max_bytes = 0;
+    int64_t total_rows = 0;
+    for (size_t i = 0; i < _num_channels; i++) {
+        max_bytes = std::max(max_bytes, _channel_bytes_counters[i]->value());
+        total_rows += _channel_rows[i];
+    }
+    COUNTER_SET(_max_channel_bytes_counter, max_bytes);
+
+    uint64_t sampled = _sketch->total();
+    if (sampled < kMinSampledRows) {
+        return;
+    }
+    // A key above the fair share of a channel overloads its channel on its own.
+    uint64_t fair_share = sampled / _num_channels;
+    std::string keys;
+    int64_t skewed_rows = 0;
+    for (const auto& entry : _sketch->top(fair_share + 1)) {
+        // Only trust the part of the estimation that is guaranteed.
+        uint64_t count = entry.count - entry.error;
+        if (count <= fair_share) {
+            continue;
+        }
+        double share = static_cast<double>(count) / sampled;
+        skewed_rows += static_cast<int64_t>(share * total_rows);
+        if (!keys.empty()) {
+            keys.append(", ");
+        }
+        keys.append(fmt::format("{:#010x}: {:.1f}% -> Channel{}", entry.item, share * 100,
+                                entry.item % _num_channels));
+    }
+    if (keys.empty()) {
+        return;
+    }
+    COUNTER_SET(_skewed_rows_counter, skewed_rows);
+    _profile->add_info_string("SkewedKeys", keys);
+}
+
+} // namespace starrocks
@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "util/runtime_profile.h"
+#include "util/space_saving.h"
+
+namespace starrocks {
+
+// Watches the rows a hash-partitioning exchange routes to its channels, so that skewed
+// shuffles can be spotted from the query profile.
+//
+// It records the rows and the in-memory bytes dispatched to every channel, and samples
+// the partition hashes into a SpaceSaving sketch to find the heavy hitters, i.e. the keys
+// that alone take more than the fair share of one channel. They are reported on close()
+// together with the channel they land on.
+//
+// All methods are no-ops unless config::enable_exchange_skew_detection was set on init().
+class ShuffleSkewMonitor {
+public:
+    void init(RuntimeProfile* profile, size_t num_channels);
+
+    bool enabled() const { return _enabled; }
+
+    // |hash_values| are the partition hashes of a chunk, before being mapped to channels.
+    void sample(const uint32_t* hash_values, size_t num_rows);
+
+    // |rows| rows of a chunk occupying |bytes| bytes in memory were routed to |channel|.
+    void add_rows(size_t channel, size_t rows, int64_t bytes);
+
+    // Publish the per-channel summary and the heavy hitters to the profile.
+    void close();
+
+private:
+    bool _enabled = false;
+    size_t _num_channels = 0;
+    RuntimeProfile* _profile = nullptr;
+    RuntimeProfile::Counter* _total_bytes_counter = nullptr;
+    std::vector<RuntimeProfile::Counter*> _channel_bytes_counters;
+    std::vector<int64_t> _channel_rows;
+    RuntimeProfile::Counter* _max_channel_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _skewed_rows_counter = nullptr;
+
+    // Sample one row out of every kSampleStride rows, carried over between chunks.
+    size_t _next_sample = 0;
+    std::unique_ptr<SpaceSaving<uint32_t>> _sketch;
+};
+
+} // namespace starrocks
@@ -116,6 +116,56 @@ public:
         return st;
     }
 
+    // Like read_one_message() above, but returns the message in |buf|, which is set to null if there is no more
+    // message. A buffer appended to the pipe is returned as it is if it holds the whole message, e.g. a kafka
+    // message or a small stream load body, so that the message is not copied.
+    virtual Status read_one_message(ByteBufferPtr* buf) {
+        if (_total_length < -1) {
+            std::stringstream ss;
+            ss << "invalid, _total_length is: " << _total_length;
+            return Status::InternalError(ss.str());
+        } else if (_total_length == 0) {
+            // no data
+            buf->reset();
+            return Status::OK();
+        }
+
+        if (_total_length == -1) {
+            return _read_next_buffer(buf);
+        }
+
+        {
+            std::unique_lock<std::mutex> l(_lock);
+            while (!_cancelled && !_finished && _buf_queue.empty()) {
+                _get_cond.wait(l);
+            }
+            if (_cancelled) {
+                return Status::InternalError("cancelled");
+            }
+            if (!_buf_queue.empty() && static_cast<int64_t>(_buf_queue.front()->remaining()) == _total_length) {
+                *buf = _buf_queue.front();
+                _buf_queue.pop_front();
+                _buffered_bytes -= (*buf)->limit;
+                _put_cond.notify_one();
+                return Status::OK();
+            }
+        }
+
+        // _total_length > 0, read the entire data
+        ByteBufferPtr data = ByteBuffer::allocate(_total_length);
+        size_t length = _total_length;
+        bool eof = false;
+        RETURN_IF_ERROR(read(reinterpret_cast<uint8_t*>(data->ptr), &length, &eof));
+        if (eof) {
+            buf->reset();
+            return Status::OK();
+        }
+        data->pos = length;
+        data->flip();
+        *buf = std::move(data);
+        return Status::OK();
+    }
+
     Status read(uint8_t* data, size_t* data_size, bool* eof) override {
         size_t bytes_read = 0;
         while (bytes_read < *data_size) {
@@ -192,6 +242,21 @@ public:
 private:
     // read the next buffer from _buf_queue
     Status _read_next_buffer(std::unique_ptr<uint8_t[]>* data, size_t* length) {
+        ByteBufferPtr buf;
+        RETURN_IF_ERROR(_read_next_buffer(&buf));
+        if (buf == nullptr) {
+            data->reset();
+            *length = 0;
+            return Status::OK();
+        }
+        *length = buf->remaining();
+        data->reset(new uint8_t[*length]);
+        buf->get_bytes((char*)(data->get()), *length);
+        return Status::OK();
+    }
+
+    // pop the next buffer from _buf_queue, |buf| is set to null if the pipe is finished
+    Status _read_next_buffer(ByteBufferPtr* buf) {
         std::unique_lock<std::mutex> l(_lock);
         while (!_cancelled && !_finished && _buf_queue.empty()) {
             _get_cond.wait(l);
@@ -203,17 +268,12 @@ private:
         // finished
         if (_buf_queue.empty()) {
             DCHECK(_finished);
-            data->reset();
-            *length = 0;
+            buf->reset();
             return Status::OK();
         }
-        auto buf = _buf_queue.front();
-        *length = buf->remaining();
-        data->reset(new uint8_t[*length]);
-        buf->get_bytes((char*)(data->get()), *length);
-
+        *buf = _buf_queue.front();
         _buf_queue.pop_front();
-        _buffered_bytes -= buf->limit;
+        _buffered_bytes -= (*buf)->limit;
         _put_cond.notify_one();
         return Status::OK();
     }
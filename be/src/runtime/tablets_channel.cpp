@@ -30,6 +30,8 @@
 #include "storage/memtable.h"
 #include "storage/vectorized/delta_writer.h"
 #include "storage/vectorized/memtable.h"
+#include "util/block_compression.h"
+#include "util/faststring.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
@@ -148,7 +150,18 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
     }
 
     vectorized::Chunk chunk;
-    RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+    if (!pchunk.has_compress_type() || pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
+        RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+    } else {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(pchunk.compress_type(), &codec));
+        size_t uncompressed_size = pchunk.uncompressed_size();
+        faststring uncompressed_buffer;
+        uncompressed_buffer.resize(uncompressed_size);
+        Slice output{uncompressed_buffer.data(), uncompressed_size};
+        RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+        RETURN_IF_ERROR(chunk.deserialize(uncompressed_buffer.data(), uncompressed_size, _chunk_meta));
+    }
     DCHECK_EQ(params.tablet_ids_size(), chunk.num_rows());
 
     size_t channel_size = _tablet_id_to_sorted_indexes.size();
@@ -333,6 +346,13 @@ Status TabletsChannel::close(int sender_id, bool* finished,
             // tablet_vec will only contains success tablet, and then let FE judge it.
             it.second->close_wait(tablet_vec);
         }
+
+        // 3. wait the secondary replicas of a single replica load, which have been shipped the segments
+        // by close_wait() of all the tablets.
+        for (auto& it : need_wait_writers) {
+            std::lock_guard<std::mutex> l(_tablet_locks[it.first & k_shard_size]);
+            it.second->wait_replicas(tablet_vec);
+        }
     }
 
     return Status::OK();
@@ -455,6 +475,7 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
             request.load_id = params.id();
             request.tuple_desc = _tuple_desc;
             request.slots = index_slots;
+            request.secondary_replicas.assign(tablet.secondary_replicas().begin(), tablet.secondary_replicas().end());
 
             vectorized::DeltaWriter* writer = nullptr;
             auto st = vectorized::DeltaWriter::open(&request, _mem_tracker.get(), &writer);
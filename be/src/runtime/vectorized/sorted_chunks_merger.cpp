@@ -2,10 +2,29 @@
 
 #include "sorted_chunks_merger.h"
 
+#include "column/chunk.h"
 #include "exec/sort_exec_exprs.h"
+#include "exprs/expr.h"
 
 namespace starrocks::vectorized {
 
+// A sorted stream and its current row.
+class SortedChunksMerger::MergeCursor {
+public:
+    explicit MergeCursor(ChunkSupplier supplier) : supplier(std::move(supplier)) {}
+
+    bool is_valid() const { return chunk != nullptr; }
+
+    ChunkSupplier supplier;
+    // The current chunk, nullptr once the stream is exhausted.
+    ChunkPtr chunk;
+    size_t pos = 0;
+    // The sort columns of the current chunk.
+    Columns order_by_columns;
+    // The normalized sort keys of the current chunk, if the keys can be normalized.
+    BinaryColumn keys;
+};
+
 SortedChunksMerger::SortedChunksMerger() {}
 
 SortedChunksMerger::~SortedChunksMerger() {}
@@ -14,36 +33,48 @@ Status SortedChunksMerger::init(const ChunkSuppliers& suppliers, const std::vect
                                 const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first) {
     if (suppliers.size() == 1) {
         _single_supplier = suppliers[0];
-    } else {
-        _cursors.reserve(suppliers.size());
-        _min_heap.reserve(suppliers.size());
-        for (auto& supplier : suppliers) {
-            _cursors.emplace_back(std::make_unique<ChunkCursor>(supplier, sort_exprs, is_asc, is_null_first));
-            ChunkCursor* cursor = _cursors.rbegin()->get();
-            cursor->next();
-            if (cursor->is_valid()) {
-                _min_heap.push_back(cursor);
-            }
+        return Status::OK();
+    }
+
+    DCHECK_EQ(sort_exprs->size(), is_asc->size());
+    DCHECK_EQ(is_asc->size(), is_null_first->size());
+    _sort_exprs = sort_exprs;
+    size_t col_num = is_asc->size();
+    _sort_order_flag.resize(col_num);
+    _null_first_flag.resize(col_num);
+    std::vector<PrimitiveType> types(col_num);
+    for (size_t i = 0; i < col_num; ++i) {
+        _sort_order_flag[i] = (*is_asc)[i] ? 1 : -1;
+        if ((*is_asc)[i]) {
+            _null_first_flag[i] = (*is_null_first)[i] ? -1 : 1;
+        } else {
+            _null_first_flag[i] = (*is_null_first)[i] ? 1 : -1;
         }
-        std::make_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
+        types[i] = (*sort_exprs)[i]->root()->type().type;
+    }
+    auto encoder = std::make_unique<SortKeyEncoder>(std::move(types), *is_asc, *is_null_first);
+    if (encoder->is_supported()) {
+        _key_encoder = std::move(encoder);
     }
+
+    _cursors.reserve(suppliers.size());
+    for (auto& supplier : suppliers) {
+        _cursors.emplace_back(std::make_unique<MergeCursor>(supplier));
+        RETURN_IF_ERROR(_next_chunk(_cursors.back().get()));
+    }
+    _build_tree();
     return Status::OK();
 }
 
 void SortedChunksMerger::set_profile(RuntimeProfile* profile) {
     _total_timer = ADD_TIMER(profile, "MergeSortedChunks");
+    _encode_timer = ADD_CHILD_TIMER(profile, "EncodeSortKeyTime", "MergeSortedChunks");
 }
 
 Status SortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
     ScopedTimer<MonotonicStopWatch> timer(_total_timer);
 
     DCHECK(chunk != nullptr);
-    if (_min_heap.empty() && !_single_supplier) {
-        *eos = true;
-        *chunk = nullptr;
-        return Status::OK();
-    }
-
     // single source
     if (_single_supplier) {
         Chunk* tmp_chunk = nullptr;
@@ -53,52 +84,166 @@ Status SortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
         return status;
     }
 
+    if (_losers.empty() || !_cursors[_losers[0]]->is_valid()) {
+        *eos = true;
+        *chunk = nullptr;
+        return Status::OK();
+    }
+
     // multiple sources
     *eos = false;
-    ChunkCursor* cursor = _min_heap[0];
-    *chunk = cursor->clone_empty_chunk(config::vector_chunk_size);
-
-    ChunkPtr current_chunk = cursor->get_current_chunk();
-    std::vector<uint32_t> selective_values; // for append_selective call
-    selective_values.reserve(config::vector_chunk_size);
-    selective_values.push_back(cursor->get_current_position_in_chunk());
-    size_t row_number = 1;
-
-    std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-    cursor->next();
-    if (cursor->is_valid()) {
-        std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-    } else {
-        _min_heap.pop_back();
-    }
-
-    while (row_number < config::vector_chunk_size && !_min_heap.empty()) {
-        cursor = _min_heap[0];
-        const auto& ptr = cursor->get_current_chunk();
-        if (current_chunk == ptr) {
-            selective_values.push_back(cursor->get_current_position_in_chunk());
-        } else {
-            (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
-            current_chunk = ptr;
-            selective_values.clear();
-            selective_values.push_back(cursor->get_current_position_in_chunk());
+    *chunk = _cursors[_losers[0]]->chunk->clone_empty_with_slot(config::vector_chunk_size);
+    size_t row_number = 0;
+    while (row_number < config::vector_chunk_size) {
+        int winner_index = _losers[0];
+        MergeCursor& winner = *_cursors[winner_index];
+        if (!winner.is_valid()) {
+            break;
+        }
+        int runner_up = _runner_up();
+        size_t end = _winner_run_end(winner, runner_up >= 0 ? _cursors[runner_up].get() : nullptr,
+                                     config::vector_chunk_size - row_number);
+        (*chunk)->append(*winner.chunk, winner.pos, end - winner.pos);
+        row_number += end - winner.pos;
+        winner.pos = end;
+        if (winner.pos >= winner.chunk->num_rows()) {
+            RETURN_IF_ERROR(_next_chunk(&winner));
+        }
+        _replay(winner_index);
+    }
+    (*chunk)->set_num_rows(row_number); // set constant column in chunk with right size.
+
+    return Status::OK();
+}
+
+Status SortedChunksMerger::_next_chunk(MergeCursor* cursor) {
+    cursor->chunk = nullptr;
+    cursor->pos = 0;
+    cursor->order_by_columns.clear();
+    while (true) {
+        Chunk* tmp_chunk = nullptr;
+        RETURN_IF_ERROR(cursor->supplier(&tmp_chunk));
+        if (tmp_chunk == nullptr) {
+            return Status::OK();
+        }
+        cursor->chunk.reset(tmp_chunk);
+        if (tmp_chunk->num_rows() > 0) {
+            break;
         }
+    }
+
+    // Evaluate the sort keys once for the whole chunk.
+    cursor->order_by_columns.reserve(_sort_exprs->size());
+    for (ExprContext* expr_ctx : *_sort_exprs) {
+        cursor->order_by_columns.push_back(expr_ctx->evaluate(cursor->chunk.get()));
+    }
+    if (_key_encoder != nullptr) {
+        SCOPED_TIMER(_encode_timer);
+        _key_encoder->encode(cursor->order_by_columns, cursor->chunk->num_rows(), &cursor->keys);
+    }
+    return Status::OK();
+}
+
+bool SortedChunksMerger::_less(size_t a, size_t b) const {
+    const MergeCursor& left = *_cursors[a];
+    const MergeCursor& right = *_cursors[b];
+    if (!left.is_valid()) {
+        return false;
+    }
+    if (!right.is_valid()) {
+        return true;
+    }
+    return _less_row(left, left.pos, right, right.pos);
+}
+
+bool SortedChunksMerger::_less_row(const MergeCursor& a, size_t row_a, const MergeCursor& b, size_t row_b) const {
+    if (_key_encoder != nullptr) {
+        return a.keys.get_slice(row_a).compare(b.keys.get_slice(row_b)) < 0;
+    }
+    for (size_t col = 0; col < a.order_by_columns.size(); ++col) {
+        int cmp = a.order_by_columns[col]->compare_at(row_a, row_b, *b.order_by_columns[col], _null_first_flag[col]);
+        if (cmp != 0) {
+            return (_sort_order_flag[col] > 0) ? (cmp < 0) : (cmp > 0);
+        }
+    }
+    return false;
+}
 
-        std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-        cursor->next();
-        if (cursor->is_valid()) {
-            std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
+void SortedChunksMerger::_build_tree() {
+    size_t k = _cursors.size();
+    if (k == 0) {
+        _losers.clear();
+        return;
+    }
+    // winners[k + i] is the leaf of cursor i, winners[1] the root.
+    std::vector<int> winners(2 * k);
+    _losers.assign(k, -1);
+    for (size_t i = 0; i < k; ++i) {
+        winners[k + i] = i;
+    }
+    for (size_t node = k - 1; node >= 1; --node) {
+        int left = winners[2 * node];
+        int right = winners[2 * node + 1];
+        if (_less(right, left)) {
+            winners[node] = right;
+            _losers[node] = left;
         } else {
-            _min_heap.pop_back();
+            winners[node] = left;
+            _losers[node] = right;
         }
+    }
+    _losers[0] = winners[1];
+}
 
-        ++row_number;
+void SortedChunksMerger::_replay(size_t cursor) {
+    int winner = cursor;
+    for (size_t node = (cursor + _cursors.size()) / 2; node >= 1; node /= 2) {
+        if (_less(_losers[node], winner)) {
+            std::swap(_losers[node], winner);
+        }
     }
+    _losers[0] = winner;
+}
 
-    (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
-    (*chunk)->set_num_rows(row_number); // set constant column in chunk with right size.
+int SortedChunksMerger::_runner_up() const {
+    // The runner-up must have lost a match against the winner, on the winner's path to the root.
+    int winner = _losers[0];
+    int runner_up = -1;
+    for (size_t node = (winner + _cursors.size()) / 2; node >= 1; node /= 2) {
+        if (runner_up < 0 || _less(_losers[node], runner_up)) {
+            runner_up = _losers[node];
+        }
+    }
+    return runner_up;
+}
 
-    return Status::OK();
+size_t SortedChunksMerger::_winner_run_end(const MergeCursor& winner, const MergeCursor* runner_up,
+                                           size_t limit) const {
+    size_t end = std::min(winner.chunk->num_rows(), winner.pos + limit);
+    if (runner_up == nullptr || !runner_up->is_valid()) {
+        return end;
+    }
+    // Rows not after the runner-up, the current row of the winner is one of them.
+    auto is_before = [&](size_t row) { return !_less_row(*runner_up, runner_up->pos, winner, row); };
+
+    // Gallop from the current row, most runs are short when many streams are interleaved.
+    size_t lo = winner.pos;
+    size_t step = 1;
+    while (lo + step < end && is_before(lo + step)) {
+        lo += step;
+        step *= 2;
+    }
+    // Binary search the first row after the runner-up in (lo, hi).
+    size_t hi = std::min(lo + step, end);
+    while (lo + 1 < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (is_before(mid)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo + 1;
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+} // namespace starrocks::vectorized
@@ -2,8 +2,7 @@
 
 #pragma once
 
-#include <queue>
-
+#include "column/sort_key_encoder.h"
 #include "runtime/vectorized/chunk_cursor.h"
 #include "util/runtime_profile.h"
 
@@ -14,6 +13,12 @@ class SortExecExprs;
 namespace vectorized {
 
 // Merge a group of sorted Chunks to one Chunk in order.
+//
+// The sorted streams are merged with a loser tree. When a chunk arrives, its sort keys are
+// evaluated once and, if all the sort columns can be normalized, encoded into memcmp-comparable
+// keys (see SortKeyEncoder), so that replaying a match of the tree is a single memcmp.
+// Once the winner is known, all its following rows that are not after the runner-up are
+// copied at once, so that streams with clustered keys are merged range by range.
 class SortedChunksMerger {
 public:
     SortedChunksMerger();
@@ -28,17 +33,39 @@ public:
     Status get_next(ChunkPtr* chunk, bool* eos);
 
 private:
+    class MergeCursor;
+
+    // Move |cursor| to the first row of the next non-empty chunk of its stream and
+    // compute the sort keys of that chunk.
+    Status _next_chunk(MergeCursor* cursor);
+
+    // Whether the current row of cursor |a| goes before the one of cursor |b|.
+    // Exhausted cursors go after everything.
+    bool _less(size_t a, size_t b) const;
+    bool _less_row(const MergeCursor& a, size_t row_a, const MergeCursor& b, size_t row_b) const;
+
+    void _build_tree();
+    // Let the cursor of the last winner play its matches up to the root again.
+    void _replay(size_t cursor);
+    // The cursor that would win if the current winner was removed, or -1 if there is none.
+    int _runner_up() const;
+    // The end of the rows of |winner|'s current chunk that do not go after |runner_up|'s
+    // current row, starting from the winner's current row and taking at most |limit| rows.
+    size_t _winner_run_end(const MergeCursor& winner, const MergeCursor* runner_up, size_t limit) const;
+
     ChunkSupplier _single_supplier;
-    std::vector<std::unique_ptr<ChunkCursor>> _cursors;
+    std::vector<std::unique_ptr<MergeCursor>> _cursors;
+
+    const std::vector<ExprContext*>* _sort_exprs = nullptr;
+    std::vector<int> _sort_order_flag; // 1 for ascending, -1 for descending.
+    std::vector<int> _null_first_flag; // nan_direction_hint of Column::compare_at().
+    std::unique_ptr<SortKeyEncoder> _key_encoder;
 
-    struct CursorCmpGreater {
-        // if a is greater than b.
-        inline bool operator()(const ChunkCursor* a, const ChunkCursor* b) { return b->operator<(*a); }
-    };
-    CursorCmpGreater _cursor_cmp_greater;
-    std::vector<ChunkCursor*> _min_heap;
+    // _losers[i] is the cursor that lost the match at node i, _losers[0] is the winner.
+    std::vector<int> _losers;
 
     RuntimeProfile::Counter* _total_timer = nullptr;
+    RuntimeProfile::Counter* _encode_timer = nullptr;
 };
 
 } // namespace vectorized
@@ -34,6 +34,7 @@
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/brpc.h"
+#include "storage/vectorized/segment_replicator.h"
 #include "util/thrift_util.h"
 #include "util/uid_util.h"
 
@@ -41,7 +42,9 @@ namespace starrocks {
 
 template <typename T>
 PInternalServiceImpl<T>::PInternalServiceImpl(ExecEnv* exec_env)
-        : _exec_env(exec_env), _tablet_worker_pool(config::number_tablet_writer_threads, 10240) {}
+        : _exec_env(exec_env),
+          _tablet_worker_pool(config::number_tablet_writer_threads, 10240),
+          _segment_worker_pool(config::number_segment_replicate_threads, 10240) {}
 
 template <typename T>
 PInternalServiceImpl<T>::~PInternalServiceImpl() {}
@@ -227,6 +230,26 @@ void PInternalServiceImpl<T>::tablet_writer_cancel(google::protobuf::RpcControll
     }
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::tablet_writer_add_segments(google::protobuf::RpcController* controller,
+                                                         const PTabletWriterAddSegmentsRequest* request,
+                                                         PTabletWriterAddSegmentsResult* response,
+                                                         google::protobuf::Closure* done) {
+    VLOG_RPC << "tablet writer add segments, id=" << request->id() << ", tablet_id=" << request->tablet_id()
+             << ", txn_id=" << request->txn_id();
+    // downloading the segments may take a long time, so it is done in a local thread pool as add_chunk.
+    _segment_worker_pool.offer([request, response, done]() {
+        brpc::ClosureGuard closure_guard(done);
+        auto st = vectorized::SegmentReplicator::add_segments(*request);
+        if (!st.ok()) {
+            LOG(WARNING) << "tablet writer add segments failed, message=" << st.get_error_msg()
+                         << ", id=" << print_id(request->id()) << ", tablet_id=" << request->tablet_id()
+                         << ", txn_id=" << request->txn_id();
+        }
+        st.to_protobuf(response->mutable_status());
+    });
+}
+
 template <typename T>
 Status PInternalServiceImpl<T>::_exec_plan_fragment(brpc::Controller* cntl) {
     auto ser_request = cntl->request_attachment().to_string();
@@ -74,6 +74,10 @@ public:
     void tablet_writer_cancel(google::protobuf::RpcController* controller, const PTabletWriterCancelRequest* request,
                               PTabletWriterCancelResult* response, google::protobuf::Closure* done) override;
 
+    void tablet_writer_add_segments(google::protobuf::RpcController* controller,
+                                    const PTabletWriterAddSegmentsRequest* request,
+                                    PTabletWriterAddSegmentsResult* response, google::protobuf::Closure* done) override;
+
     void trigger_profile_report(google::protobuf::RpcController* controller,
                                 const PTriggerProfileReportRequest* request, PTriggerProfileReportResult* result,
                                 google::protobuf::Closure* done) override;
@@ -87,6 +91,9 @@ private:
 private:
     ExecEnv* _exec_env;
     PriorityThreadPool _tablet_worker_pool;
+    // The primary replicas wait for the secondary replicas adding their segments in _tablet_worker_pool,
+    // so the segments are added in another pool.
+    PriorityThreadPool _segment_worker_pool;
 };
 
 } // namespace starrocks
@@ -414,6 +414,7 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
     segment_v2::SegmentWriterOptions writer_options;
     writer_options.storage_format_version = _context.storage_format_version;
     writer_options.mem_tracker = _context.mem_tracker;
+    writer_options.encode_pool = ExecEnv::GetInstance()->segment_encode_thread_pool();
     const auto* schema = _rowset_schema != nullptr ? _rowset_schema.get() : _context.tablet_schema;
     std::unique_ptr<SegmentWriter> segment_writer =
             std::make_unique<segment_v2::SegmentWriter>(std::move(wblock), _num_segment, schema, writer_options);
@@ -21,11 +21,13 @@
 
 #include "storage/rowset/segment_v2/segment_writer.h"
 
+#include <atomic>
 #include <memory>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "storage/fs/block_manager.h"
@@ -38,6 +40,7 @@
 #include "storage/vectorized/seek_tuple.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "util/threadpool.h"
 
 namespace starrocks::segment_v2 {
 
@@ -52,6 +55,9 @@ SegmentWriter::SegmentWriter(std::unique_ptr<fs::WritableBlock> wblock, uint32_t
 }
 
 SegmentWriter::~SegmentWriter() {
+    if (_encode_token != nullptr) {
+        _encode_token->shutdown();
+    }
     _mem_tracker->release(_mem_tracker->consumption());
 }
 
@@ -111,6 +117,10 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         _column_writers.push_back(std::move(writer));
     }
     _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    size_t min_parallel_columns = std::max(config::segment_parallel_encode_min_columns, 2);
+    if (_opts.encode_pool != nullptr && _column_writers.size() >= min_parallel_columns) {
+        _encode_token = _opts.encode_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    }
     return Status::OK();
 }
 
@@ -150,9 +160,7 @@ uint64_t SegmentWriter::estimate_segment_size() {
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
-    for (auto& column_writer : _column_writers) {
-        RETURN_IF_ERROR(column_writer->finish());
-    }
+    RETURN_IF_ERROR(_for_each_column_writer([this](size_t i) { return _column_writers[i]->finish(); }));
     RETURN_IF_ERROR(_write_data());
     uint64_t index_offset = _wblock->bytes_appended();
     RETURN_IF_ERROR(_write_ordinal_index());
@@ -246,10 +254,10 @@ Status SegmentWriter::_write_raw_data(const std::vector<Slice>& slices) {
 
 Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
     DCHECK_EQ(_column_writers.size(), chunk.num_columns());
-    for (size_t i = 0; i < _column_writers.size(); ++i) {
+    RETURN_IF_ERROR(_for_each_column_writer([this, &chunk](size_t i) {
         const vectorized::Column* col = chunk.get_column_by_index(i).get();
-        RETURN_IF_ERROR(_column_writers[i]->append(*col));
-    }
+        return _column_writers[i]->append(*col);
+    }));
 
     for (size_t i = 0; i < chunk.num_rows(); i++) {
         // At the begin of one block, so add a short key index entry
@@ -265,4 +273,37 @@ Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
     return Status::OK();
 }
 
+Status SegmentWriter::_for_each_column_writer(const std::function<Status(size_t)>& func) {
+    const size_t num_columns = _column_writers.size();
+    if (_encode_token == nullptr) {
+        for (size_t i = 0; i < num_columns; ++i) {
+            RETURN_IF_ERROR(func(i));
+        }
+        return Status::OK();
+    }
+
+    // The columns are taken one at a time by the tasks and by this thread, so a few expensive
+    // columns don't leave the other threads idle.
+    std::vector<Status> statuses(num_columns);
+    std::atomic<size_t> next_column{0};
+    auto encode = [&]() {
+        for (size_t i = next_column.fetch_add(1); i < num_columns; i = next_column.fetch_add(1)) {
+            statuses[i] = func(i);
+        }
+    };
+    size_t num_tasks = std::min<size_t>(config::segment_encode_thread_pool_size, num_columns);
+    for (size_t i = 1; i < num_tasks; ++i) {
+        if (!_encode_token->submit_func(encode).ok()) {
+            // the columns left are encoded by this thread
+            break;
+        }
+    }
+    encode();
+    _encode_token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks::segment_v2
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory> // unique_ptr
 #include <string>
 #include <vector>
@@ -38,6 +39,8 @@ class TabletSchema;
 class TabletColumn;
 class ShortKeyIndexBuilder;
 class MemTracker;
+class ThreadPool;
+class ThreadPoolToken;
 
 namespace fs {
 class WritableBlock;
@@ -58,6 +61,8 @@ struct SegmentWriterOptions {
     uint32_t storage_format_version = 1;
     uint32_t num_rows_per_block = 1024;
     MemTracker* mem_tracker = nullptr;
+    // if not null, the columns of a wide segment are encoded concurrently on this pool
+    ThreadPool* encode_pool = nullptr;
 };
 
 class SegmentWriter {
@@ -94,6 +99,9 @@ private:
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
     void _init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, const TabletColumn& column);
+    // Calls |func| with the index of every column writer, concurrently on _encode_token if it is not null.
+    // Returns the first error in the order of columns.
+    Status _for_each_column_writer(const std::function<Status(size_t)>& func);
 
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
     uint32_t _segment_id;
@@ -105,6 +113,10 @@ private:
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    // Column writers only encode and compress pages in memory before finalize(), and each of them
+    // is fed by one task at a time, so the encoding of different columns may run concurrently.
+    // The pages are still written to the file column by column in finalize().
+    std::unique_ptr<ThreadPoolToken> _encode_token;
     uint32_t _row_count = 0;
 };
 
@@ -10,7 +10,10 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet_updates.h"
 #include "storage/update_manager.h"
+#include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/memtable.h"
+#include "storage/vectorized/memtable_spiller.h"
+#include "storage/vectorized/segment_replicator.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -137,6 +140,15 @@ Status DeltaWriter::init() {
     _tablet_schema = &(_tablet->tablet_schema());
     _reset_mem_table();
 
+    // Spilled runs of other keys types would have to be aggregated with each other when merged.
+    if (config::memtable_spill_enable && _tablet->keys_type() == KeysType::DUP_KEYS) {
+        // named like the files of the rowset, so that it is protected by the pending id of the rowset while
+        // loading, and reclaimed by the path gc of rowset ids if the BE exits before deleting it.
+        auto path = Substitute("$0/$1_spill", _tablet->tablet_path(), writer_context.rowset_id.to_string());
+        _spiller = std::make_unique<MemTableSpiller>(ChunkHelper::convert_schema_to_format_v2(*_tablet_schema),
+                                                     std::move(path));
+    }
+
     // create flush handler
     olap_status = _storage_engine->memtable_flush_executor()->create_flush_token(&_flush_token);
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
@@ -183,6 +195,11 @@ Status DeltaWriter::flush_memtable_async() {
         // equal means there is no memtable in flush queue, just flush this memtable
         VLOG(3) << "flush memtable to reduce mem consumption. memtable size: " << _mem_table->memory_usage()
                 << ", tablet: " << _req.tablet_id << ", load id: " << print_id(_req.load_id);
+        if (_spiller != nullptr) {
+            // a small memtable is spilled rather than written out as a small segment
+            _mem_table->set_spiller(_spiller.get());
+            _has_spilled = true;
+        }
         RETURN_IF_ERROR(_flush_memtable_async());
         _reset_mem_table();
     } else {
@@ -225,6 +242,10 @@ Status DeltaWriter::close() {
         RETURN_IF_ERROR(init());
     }
 
+    if (_has_spilled) {
+        // the last memtable is merged with the spilled ones
+        _mem_table->set_spiller(_spiller.get());
+    }
     RETURN_IF_ERROR(_flush_memtable_async());
     _mem_table.reset();
     return Status::OK();
@@ -241,6 +262,15 @@ Status DeltaWriter::close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>*
         return Status::InternalError("Fail to flush memtable");
     }
     DCHECK_EQ(_mem_tracker->consumption(), 0);
+    if (_has_spilled) {
+        Status st = _spiller->merge(_rowset_writer.get());
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to merge spilled memtables. tablet_id=" << _req.tablet_id
+                         << " err=" << st.to_string();
+            return st;
+        }
+    }
+    _spiller.reset();
 
     // use rowset meta manager to save meta
     _cur_rowset = _rowset_writer->build();
@@ -264,11 +294,24 @@ Status DeltaWriter::close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>*
     }
     _delta_written_success = true;
 
+    if (!_req.secondary_replicas.empty()) {
+        // the replicas are waited in wait_replicas(), so that the tablets of a load ship their segments in parallel
+        _replicator = std::make_unique<SegmentReplicator>(_req.secondary_replicas);
+        _replicator->replicate(_req.load_id, _req.txn_id, _req.partition_id, *_tablet, *_cur_rowset);
+    }
+
     const FlushStatistic& stat = _flush_token->get_stats();
     LOG(INFO) << "Closed delta writer. tablet_id=" << _tablet->tablet_id() << " stats=" << stat;
     return Status::OK();
 }
 
+void DeltaWriter::wait_replicas(google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec) {
+    if (_replicator != nullptr) {
+        _replicator->wait(tablet_vec);
+        _replicator.reset();
+    }
+}
+
 Status DeltaWriter::cancel() {
     if (_is_cancelled) {
         return Status::OK();
@@ -281,6 +324,7 @@ Status DeltaWriter::cancel() {
         // cancel and wait all memtables in flush queue to be finished
         _flush_token->cancel();
     }
+    _spiller.reset();
     _is_cancelled = true;
     DCHECK_EQ(_mem_tracker->consumption(), 0);
     return Status::OK();
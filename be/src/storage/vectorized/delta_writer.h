@@ -19,6 +19,8 @@ class SlotDescriptor;
 namespace vectorized {
 
 class MemTable;
+class MemTableSpiller;
+class SegmentReplicator;
 
 enum WriteType { LOAD = 1, LOAD_DELETE = 2, DELETE = 3 };
 
@@ -32,6 +34,8 @@ struct WriteRequest {
     TupleDescriptor* tuple_desc;
     // slots are in order of tablet's schema
     const std::vector<SlotDescriptor*>* slots;
+    // the other replicas of the tablet, which add the segments written by this one, in a single replica load
+    std::vector<PReplicaInfo> secondary_replicas;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -51,6 +55,9 @@ public:
     // wait for all memtables to be flushed.
     // mem_consumption() should be 0 after this function returns.
     Status close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
+    // wait for the secondary replicas to add the segments of the committed rowset, must call it after
+    // close_wait(). the secondary replicas that succeed are added to |tablet_vec|.
+    void wait_replicas(google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
 
     // abandon current memtable and wait for all pending-flushing memtables to be destructed.
     // mem_consumption() should be 0 after this function returns.
@@ -82,6 +89,11 @@ private:
     RowsetSharedPtr _cur_rowset;
     std::unique_ptr<RowsetWriter> _rowset_writer;
     std::shared_ptr<MemTable> _mem_table;
+    // keeps the memtables flushed under memory pressure, null if they are not spilled
+    std::unique_ptr<MemTableSpiller> _spiller;
+    bool _has_spilled = false;
+    // ships the segments to the secondary replicas, null if there are none
+    std::unique_ptr<SegmentReplicator> _replicator;
     const TabletSchema* _tablet_schema;
     bool _delta_written_success;
 
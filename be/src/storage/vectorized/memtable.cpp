@@ -10,6 +10,7 @@
 #include "storage/rowset/rowset_writer.h"
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/memtable_spiller.h"
 #include "util/orlp/pdqsort.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
@@ -45,6 +46,18 @@ MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const s
         // otherwise it will take up a lot of memory and may not be released.
         _aggregator = std::make_unique<ChunkAggregator>(&_vectorized_schema, 0, INT_MAX, 0);
     }
+
+    size_t num_key_columns = _tablet_schema->num_key_columns();
+    std::vector<PrimitiveType> key_types;
+    for (size_t i = 0; i < num_key_columns; i++) {
+        key_types.push_back((*_slot_descs)[i]->type().type);
+    }
+    // The sort is ascending with nulls first, as compare_at() with nan_direction_hint -1.
+    auto encoder = std::make_unique<SortKeyEncoder>(std::move(key_types), std::vector<bool>(num_key_columns, true),
+                                                    std::vector<bool>(num_key_columns, true));
+    if (encoder->is_supported()) {
+        _sort_key_encoder = std::move(encoder);
+    }
 }
 
 MemTable::~MemTable() {
@@ -194,7 +207,14 @@ OLAPStatus MemTable::flush() {
     int64_t duration_ns = 0;
     {
         SCOPED_RAW_TIMER(&duration_ns);
-        if (!_deletes || _deletes->size() == 0) {
+        if (_spiller != nullptr) {
+            DCHECK(!_deletes || _deletes->size() == 0);
+            Status st = _spiller->spill(*_result_chunk);
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to spill memtable. tablet_id=" << _tablet_id << " err=" << st.to_string();
+                return OLAP_ERR_IO_ERROR;
+            }
+        } else if (!_deletes || _deletes->size() == 0) {
             RETURN_NOT_OK(_rowset_writer->flush_chunk(*_result_chunk));
         } else {
             RETURN_NOT_OK(_rowset_writer->flush_chunk_with_deletes(*_result_chunk, *_deletes));
@@ -252,7 +272,9 @@ void MemTable::_sort(bool is_final) {
     for (uint32_t i = 0; i < _chunk->num_rows(); ++i) {
         _permutations[i] = {i, i};
     }
-    if (_tablet_schema->num_key_columns() <= 3) {
+    if (_sort_key_encoder != nullptr) {
+        _sort_chunk_by_normalized_keys();
+    } else if (_tablet_schema->num_key_columns() <= 3) {
         _sort_chunk_by_columns();
     } else {
         _sort_chunk_by_rows();
@@ -557,4 +579,21 @@ void MemTable::_sort_chunk_by_rows() {
             });
 }
 
+void MemTable::_sort_chunk_by_normalized_keys() {
+    const size_t num_rows = _chunk->num_rows();
+    const size_t num_key_columns = _tablet_schema->num_key_columns();
+    Columns key_columns(_chunk->columns().begin(), _chunk->columns().begin() + num_key_columns);
+    BinaryColumn keys;
+    _sort_key_encoder->encode(key_columns, num_rows, &keys);
+
+    _selective_values.resize(num_rows);
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        _selective_values[i] = i;
+    }
+    SortKeyEncoder::sort(keys, &_selective_values);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _permutations[i] = {_selective_values[i], static_cast<uint32_t>(i)};
+    }
+}
+
 } // namespace starrocks::vectorized
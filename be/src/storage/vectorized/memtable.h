@@ -5,6 +5,7 @@
 #include <ostream>
 
 #include "column/chunk.h"
+#include "column/sort_key_encoder.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "storage/olap_define.h"
 #include "storage/vectorized/chunk_aggregator.h"
@@ -17,6 +18,8 @@ class TabletSchema;
 
 namespace vectorized {
 
+class MemTableSpiller;
+
 class MemTable {
 public:
     MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const std::vector<SlotDescriptor*>* slot_descs,
@@ -38,12 +41,16 @@ public:
 
     bool is_full() const;
 
+    // If set, flush() spills the sorted rows to |spiller| instead of writing a segment of them.
+    void set_spiller(MemTableSpiller* spiller) { _spiller = spiller; }
+
 private:
     void _merge();
 
     void _sort(bool is_final);
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
+    void _sort_chunk_by_normalized_keys();
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest);
 
     void _aggregate(bool is_final);
@@ -66,6 +73,8 @@ private:
     Permutation _permutations;
     std::vector<uint32_t> _selective_values;
     Schema _vectorized_schema;
+    // encoder of the key columns, null if any of them can't be normalized
+    std::unique_ptr<SortKeyEncoder> _sort_key_encoder;
 
     int64_t _tablet_id;
     const TabletSchema* _tablet_schema;
@@ -74,6 +83,7 @@ private:
     KeysType _keys_type;
 
     RowsetWriter* _rowset_writer;
+    MemTableSpiller* _spiller = nullptr;
 
     // aggregate
     std::unique_ptr<ChunkAggregator> _aggregator;
@@ -0,0 +1,135 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/memtable_spiller.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/merge_iterator.h"
+#include "util/raw_container.h"
+
+namespace starrocks::vectorized {
+
+// Reads the blocks of one run back from the spill file, in order.
+class MemTableSpiller::RunIterator final : public ChunkIterator {
+public:
+    RunIterator(Schema schema, const RandomAccessFile* file, const Run* run)
+            : ChunkIterator(std::move(schema)), _file(file), _run(run) {}
+
+    void close() override { _buffer.clear(); }
+
+protected:
+    Status do_get_next(Chunk* chunk) override {
+        if (_next_block == _run->size()) {
+            return Status::EndOfFile("end of spilled run");
+        }
+        const Block& block = (*_run)[_next_block++];
+        raw::make_room(&_buffer, block.size);
+        RETURN_IF_ERROR(_file->read_at(block.offset, Slice(_buffer.data(), block.size)));
+
+        // deserialize_column() replaces the content of a column, so |chunk| is expected to be empty.
+        DCHECK_EQ(0, chunk->num_rows());
+        const uint8_t* p = _buffer.data();
+        for (auto& column : chunk->columns()) {
+            p = column->deserialize_column(p);
+        }
+        if (UNLIKELY(p != _buffer.data() + block.size || chunk->num_rows() != block.num_rows)) {
+            return Status::Corruption(strings::Substitute("bad spilled block. offset: $0, size: $1, rows: $2",
+                                                          block.offset, block.size, block.num_rows));
+        }
+        return Status::OK();
+    }
+
+private:
+    const RandomAccessFile* _file;
+    const Run* _run;
+    size_t _next_block = 0;
+    std::vector<uint8_t> _buffer;
+};
+
+MemTableSpiller::MemTableSpiller(Schema schema, std::string path)
+        : _schema(std::move(schema)), _path(std::move(path)) {}
+
+MemTableSpiller::~MemTableSpiller() {
+    if (_file != nullptr) {
+        _file.reset();
+        Status st = Env::Default()->delete_file(_path);
+        LOG_IF(WARNING, !st.ok()) << "Fail to delete memtable spill file " << _path << ": " << st.to_string();
+    }
+}
+
+Status MemTableSpiller::spill(const Chunk& chunk) {
+    if (_file == nullptr) {
+        RETURN_IF_ERROR(Env::Default()->new_writable_file(_path, &_file));
+    }
+    // The run is cut into blocks of chunk size, so that the merge holds one block of each run in memory.
+    Run run;
+    std::vector<uint8_t> buffer;
+    for (size_t offset = 0; offset < chunk.num_rows(); offset += config::vector_chunk_size) {
+        size_t num_rows = std::min<size_t>(config::vector_chunk_size, chunk.num_rows() - offset);
+        auto block = chunk.clone_empty_with_schema(num_rows);
+        block->append(chunk, offset, num_rows);
+
+        size_t size = 0;
+        for (const auto& column : block->columns()) {
+            size += column->serialize_size();
+        }
+        raw::make_room(&buffer, size);
+        uint8_t* p = buffer.data();
+        for (auto& column : block->columns()) {
+            p = column->serialize_column(p);
+        }
+        DCHECK_EQ(buffer.data() + size, p);
+        RETURN_IF_ERROR(_file->append(Slice(buffer.data(), size)));
+        run.push_back(Block{_file_size, size, num_rows});
+        _file_size += size;
+    }
+    if (!run.empty()) {
+        _runs.emplace_back(std::move(run));
+    }
+    return Status::OK();
+}
+
+Status MemTableSpiller::merge(RowsetWriter* writer) {
+    if (_runs.empty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_file->flush(WritableFile::FLUSH_SYNC));
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(_path, &file));
+
+    std::vector<ChunkIteratorPtr> runs;
+    runs.reserve(_runs.size());
+    for (const Run& run : _runs) {
+        runs.emplace_back(std::make_shared<RunIterator>(_schema, file.get(), &run));
+    }
+    auto iter = new_merge_iterator(runs);
+    auto chunk = ChunkHelper::new_chunk(_schema, config::vector_chunk_size);
+    while (true) {
+        chunk->reset();
+        Status st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        } else if (!st.ok()) {
+            iter->close();
+            return st;
+        }
+        OLAPStatus olap_status = writer->add_chunk(*chunk);
+        if (olap_status != OLAP_SUCCESS) {
+            iter->close();
+            return Status::InternalError(strings::Substitute("Fail to add merged chunk. err: $0", olap_status));
+        }
+    }
+    iter->close();
+    OLAPStatus olap_status = writer->flush();
+    if (olap_status != OLAP_SUCCESS) {
+        return Status::InternalError(strings::Substitute("Fail to flush merged chunks. err: $0", olap_status));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,61 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/schema.h"
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+
+namespace starrocks {
+
+class RowsetWriter;
+class WritableFile;
+
+namespace vectorized {
+
+// Keeps the sorted memtables of a DUP_KEYS tablet flushed under memory pressure in a local file,
+// one run per memtable, instead of writing each of them out as a small segment. At close the runs
+// are merged by the key columns and written to the rowset as few, well-sized segments.
+//
+// spill() may be called from the flush thread while the memtables of one DeltaWriter are flushed
+// serially, merge() must be called after all of them have been flushed.
+class MemTableSpiller {
+public:
+    // |path| is the file the runs are spilled to, which is deleted on destruction.
+    MemTableSpiller(Schema schema, std::string path);
+
+    ~MemTableSpiller();
+
+    // Appends the rows of |chunk|, which are sorted by the key columns, as a new run.
+    Status spill(const Chunk& chunk);
+
+    // Merges all the runs into |writer|, and flushes the last segment of it.
+    Status merge(RowsetWriter* writer);
+
+    size_t num_runs() const { return _runs.size(); }
+
+private:
+    class RunIterator;
+
+    // the location of a block of rows in the spill file
+    struct Block {
+        uint64_t offset;
+        uint64_t size;
+        size_t num_rows;
+    };
+    using Run = std::vector<Block>;
+
+    Schema _schema;
+    std::string _path;
+    std::unique_ptr<WritableFile> _file;
+    uint64_t _file_size = 0;
+    std::vector<Run> _runs;
+};
+
+} // namespace vectorized
+
+} // namespace starrocks
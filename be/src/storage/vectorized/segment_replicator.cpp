@@ -0,0 +1,203 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/segment_replicator.h"
+
+#include <filesystem>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "http/http_client.h"
+#include "runtime/exec_env.h"
+#include "service/backend_options.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "storage/txn_manager.h"
+#include "storage/update_manager.h"
+#include "util/brpc_stub_cache.h"
+#include "util/uid_util.h"
+
+namespace starrocks::vectorized {
+
+// the same as the ones used by clone
+static const std::string kDownloadPath = "/api/_tablet/_download";
+static const uint32_t kDownloadFileMaxRetry = 3;
+static const uint32_t kGetLengthTimeoutS = 10;
+
+static Status download_file(const std::string& url, const std::string& local_path, DataDir* data_dir) {
+    uint64_t file_size = 0;
+    auto get_file_size_cb = [&url, &file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(url));
+        client->set_timeout_ms(kGetLengthTimeoutS * 1000);
+        RETURN_IF_ERROR(client->head());
+        file_size = client->get_content_length();
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(HttpClient::execute_with_retry(kDownloadFileMaxRetry, 1, get_file_size_cb));
+    if (data_dir->reach_capacity_limit(file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
+
+    uint64_t timeout_s = std::max<uint64_t>(file_size / config::download_low_speed_limit_kbps / 1024,
+                                            config::download_low_speed_time);
+    auto download_cb = [&url, &local_path, file_size, timeout_s](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(url));
+        client->set_timeout_ms(timeout_s * 1000);
+        RETURN_IF_ERROR(client->download(local_path));
+        uint64_t local_file_size = std::filesystem::file_size(local_path);
+        if (local_file_size != file_size) {
+            LOG(WARNING) << "Fail to download " << url << ". file_size=" << local_file_size << "/" << file_size;
+            return Status::InternalError("mismatched file size");
+        }
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(kDownloadFileMaxRetry, 1, download_cb);
+}
+
+SegmentReplicator::SegmentReplicator(std::vector<PReplicaInfo> replicas) : _replicas(std::move(replicas)) {}
+
+SegmentReplicator::~SegmentReplicator() {
+    wait(nullptr);
+}
+
+void SegmentReplicator::replicate(const PUniqueId& load_id, int64_t txn_id, int64_t partition_id,
+                                  const Tablet& tablet, const Rowset& rowset) {
+    DCHECK(_closures.empty());
+    _tablet_id = tablet.tablet_id();
+    _schema_hash = tablet.schema_hash();
+
+    PTabletWriterAddSegmentsRequest request;
+    *request.mutable_id() = load_id;
+    request.set_txn_id(txn_id);
+    request.set_partition_id(partition_id);
+    request.set_tablet_id(_tablet_id);
+    request.set_schema_hash(_schema_hash);
+    if (!rowset.rowset_meta()->serialize(request.mutable_rowset_meta())) {
+        LOG(WARNING) << "Fail to serialize rowset meta. tablet_id=" << _tablet_id << " txn_id=" << txn_id;
+        return;
+    }
+    request.set_host(BackendOptions::get_localhost());
+    request.set_http_port(config::webserver_port);
+    request.set_rowset_path(rowset.rowset_path());
+
+    for (const auto& replica : _replicas) {
+        auto* stub = ExecEnv::GetInstance()->brpc_stub_cache()->get_stub(replica.host(), replica.brpc_port());
+        if (stub == nullptr) {
+            LOG(WARNING) << "Get rpc stub failed, host=" << replica.host() << ", port=" << replica.brpc_port();
+            continue;
+        }
+        auto* closure = new Closure();
+        closure->ref();
+        // This ref is for RPC's reference
+        closure->ref();
+        closure->cntl.set_timeout_ms(config::streaming_load_rpc_max_alive_time_sec * 1000);
+        stub->tablet_writer_add_segments(&closure->cntl, &request, &closure->result, closure);
+        _closures.emplace_back(replica.node_id(), closure);
+    }
+}
+
+void SegmentReplicator::wait(google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec) {
+    for (auto& [node_id, closure] : _closures) {
+        closure->join();
+        if (closure->cntl.Failed()) {
+            LOG(WARNING) << "Fail to add segments to replica. tablet_id=" << _tablet_id << " node_id=" << node_id
+                         << " err=" << closure->cntl.ErrorText();
+        } else if (Status st(closure->result.status()); !st.ok()) {
+            LOG(WARNING) << "Fail to add segments to replica. tablet_id=" << _tablet_id << " node_id=" << node_id
+                         << " err=" << st.to_string();
+        } else if (tablet_vec != nullptr) {
+            PTabletInfo* tablet_info = tablet_vec->Add();
+            tablet_info->set_tablet_id(_tablet_id);
+            tablet_info->set_schema_hash(_schema_hash);
+            tablet_info->set_node_id(node_id);
+        }
+        if (closure->unref()) {
+            delete closure;
+        }
+    }
+    _closures.clear();
+}
+
+Status SegmentReplicator::add_segments(const PTabletWriterAddSegmentsRequest& request) {
+    StorageEngine* engine = StorageEngine::instance();
+    TabletSharedPtr tablet = engine->tablet_manager()->get_tablet(request.tablet_id(), request.schema_hash());
+    if (tablet == nullptr) {
+        return Status::NotFound(strings::Substitute("tablet $0 not found", request.tablet_id()));
+    }
+    auto rowset_meta = std::make_shared<RowsetMeta>();
+    if (!rowset_meta->init(request.rowset_meta())) {
+        return Status::Corruption(strings::Substitute("bad rowset meta of tablet $0", request.tablet_id()));
+    }
+
+    OLAPStatus res =
+            engine->txn_manager()->prepare_txn(request.partition_id(), tablet, request.txn_id(), request.id());
+    if (res != OLAP_SUCCESS) {
+        return Status::InternalError(
+                strings::Substitute("Fail to prepare transaction $0. err: $1", request.txn_id(), res));
+    }
+
+    // The files are downloaded under a new rowset id, as rowset ids are unique within a BE only.
+    RowsetId rowset_id = engine->next_rowset_id();
+    std::vector<std::pair<std::string, std::string>> files;
+    for (int i = 0; i < rowset_meta->num_segments(); i++) {
+        files.emplace_back(BetaRowset::segment_file_path(request.rowset_path(), rowset_meta->rowset_id(), i),
+                           BetaRowset::segment_file_path(tablet->tablet_path(), rowset_id, i));
+    }
+    for (int i = 0; i < rowset_meta->get_num_delete_files(); i++) {
+        files.emplace_back(BetaRowset::segment_del_file_path(request.rowset_path(), rowset_meta->rowset_id(), i),
+                           BetaRowset::segment_del_file_path(tablet->tablet_path(), rowset_id, i));
+    }
+
+    Status st;
+    for (const auto& [remote_path, local_path] : files) {
+        std::string url = strings::Substitute("http://$0:$1$2?token=$3&file=$4", request.host(), request.http_port(),
+                                              kDownloadPath, ExecEnv::GetInstance()->token(), remote_path);
+        st = download_file(url, local_path, tablet->data_dir());
+        if (!st.ok()) {
+            break;
+        }
+    }
+
+    RowsetSharedPtr rowset;
+    bool committed = false;
+    if (st.ok()) {
+        rowset_meta->set_rowset_id(rowset_id);
+        rowset_meta->set_tablet_uid(tablet->tablet_uid());
+        if (RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), &tablet->tablet_schema(),
+                                         tablet->tablet_path(), rowset_meta, &rowset) != OLAP_SUCCESS) {
+            st = Status::InternalError("Fail to create rowset");
+        }
+    }
+    if (st.ok()) {
+        res = engine->txn_manager()->commit_txn(request.partition_id(), tablet, request.txn_id(), request.id(), rowset,
+                                                false);
+        if (res != OLAP_SUCCESS && res != OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST) {
+            st = Status::InternalError(
+                    strings::Substitute("Fail to commit transaction $0. err: $1", request.txn_id(), res));
+        } else {
+            committed = true;
+        }
+    }
+    if (st.ok() && tablet->keys_type() == KeysType::PRIMARY_KEYS) {
+        st = engine->update_manager()->on_rowset_finished(tablet.get(), rowset.get());
+    }
+
+    if (!committed) {
+        for (const auto& [remote_path, local_path] : files) {
+            (void)Env::Default()->delete_file(local_path);
+        }
+        engine->txn_manager()->rollback_txn(request.partition_id(), tablet, request.txn_id());
+        engine->release_rowset_id(rowset_id);
+    }
+    if (st.ok()) {
+        LOG(INFO) << "Added segments of replica. tablet_id=" << request.tablet_id() << " txn_id=" << request.txn_id()
+                  << " load_id=" << print_id(request.id()) << " from=" << request.host()
+                  << " segments=" << rowset_meta->num_segments();
+    }
+    return st;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "util/ref_count_closure.h"
+
+namespace starrocks {
+
+class Rowset;
+class Tablet;
+
+namespace vectorized {
+
+// In a single replica load only the primary replica of a tablet receives the loaded rows. Once it has
+// committed its rowset, the secondary replicas are asked to add the segments of the rowset, which they
+// download from the primary replica through the tablet download action used by clone, and commit to
+// the same transaction. So the rows are sorted and encoded once instead of once per replica.
+class SegmentReplicator {
+public:
+    explicit SegmentReplicator(std::vector<PReplicaInfo> replicas);
+
+    ~SegmentReplicator();
+
+    // Called on the primary replica, asks every secondary replica to add the segments of |rowset|
+    // without waiting for them.
+    void replicate(const PUniqueId& load_id, int64_t txn_id, int64_t partition_id, const Tablet& tablet,
+                   const Rowset& rowset);
+
+    // Waits for the secondary replicas, and adds the ones that have committed the segments to |tablet_vec|.
+    void wait(google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
+
+    // Called on a secondary replica, downloads the segments written by the primary replica and commits them.
+    static Status add_segments(const PTabletWriterAddSegmentsRequest& request);
+
+private:
+    using Closure = RefCountClosure<PTabletWriterAddSegmentsResult>;
+
+    std::vector<PReplicaInfo> _replicas;
+    int64_t _tablet_id = 0;
+    int32_t _schema_hash = 0;
+    // node id of the secondary replica -> closure of the rpc in flight
+    std::vector<std::pair<int64_t, Closure*>> _closures;
+};
+
+} // namespace vectorized
+
+} // namespace starrocks
@@ -186,6 +186,9 @@ public:
     template <typename UINT_T>
     bool get_lleb_128(UINT_T* v);
 
+    /// Returns the number of bytes left in the stream.
+    int64_t bytes_left() const { return _buffer_end - _buffer_pos; }
+
 private:
     /// Returns the number of bytes left in the stream.
     int _bytes_left() { return _buffer_end - _buffer_pos; }
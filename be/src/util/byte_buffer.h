@@ -39,7 +39,18 @@ struct ByteBuffer {
         return ptr;
     }
 
-    ~ByteBuffer() { delete[] ptr; }
+    // Returns a buffer ready to be read, which refers to the |size| bytes at |data| instead of copying them.
+    // The bytes are kept alive by |owner| until the buffer is destroyed, and must not be written.
+    static ByteBufferPtr wrap(char* data, size_t size, std::shared_ptr<void> owner) {
+        ByteBufferPtr ptr(new ByteBuffer(data, size, std::move(owner)));
+        return ptr;
+    }
+
+    ~ByteBuffer() {
+        if (_owner == nullptr) {
+            delete[] ptr;
+        }
+    }
 
     void put_bytes(const char* data, size_t size) {
         memcpy(ptr + pos, data, size);
@@ -67,6 +78,11 @@ struct ByteBuffer {
 
 private:
     ByteBuffer(size_t capacity_) : ptr(new char[capacity_]), pos(0), limit(capacity_), capacity(capacity_) {}
+    ByteBuffer(char* data, size_t size, std::shared_ptr<void> owner)
+            : ptr(data), pos(0), limit(size), capacity(size), _owner(std::move(owner)) {}
+
+    // not null if the bytes are not owned by this buffer
+    std::shared_ptr<void> _owner;
 };
 
 } // namespace starrocks
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "common/config.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/types.pb.h"
 
@@ -38,4 +39,35 @@ public:
     }
 };
 
+// Decides whether a stream of blocks (e.g. exchanged chunks) is worth compressing.
+// When several blocks in a row compress poorly the data is most likely incompressible,
+// so the following blocks are sent as is instead of paying the compression CPU for nothing.
+// Compression is re-tried once the skip window has passed.
+class AdaptiveCompressionPolicy {
+public:
+    bool should_compress() {
+        if (_skip_remaining > 0) {
+            --_skip_remaining;
+            return false;
+        }
+        return true;
+    }
+
+    // Report the ratio (uncompressed / compressed) achieved by the last compressed block.
+    void update(double compress_ratio) {
+        if (compress_ratio > config::rpc_compress_ratio_threshold) {
+            _poor_ratio_blocks = 0;
+            return;
+        }
+        if (++_poor_ratio_blocks >= config::rpc_compress_poor_ratio_chunks) {
+            _poor_ratio_blocks = 0;
+            _skip_remaining = config::rpc_compress_skip_chunks;
+        }
+    }
+
+private:
+    int32_t _poor_ratio_blocks = 0;
+    int32_t _skip_remaining = 0;
+};
+
 } // namespace starrocks
@@ -0,0 +1,338 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/json_binary.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "common/logging.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+namespace {
+
+// The count and the payload size of arrays and objects.
+constexpr size_t kContainerHeaderSize = 8;
+constexpr size_t kArrayEntrySize = 4;
+constexpr size_t kObjectEntrySize = 12;
+constexpr size_t kObjectIndexSize = 4;
+// Values nested deeper are decoded as null, so that malformed data can't exhaust the stack.
+constexpr int kMaxDecodeDepth = 1024;
+
+void set_fixed32_le(std::string* out, size_t pos, uint32_t value) {
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(out->data() + pos), value);
+}
+
+} // namespace
+
+bool JsonBinary::encode(const Slice& json, std::string* out) {
+    rapidjson::Document document;
+    document.Parse(json.data, json.size);
+    if (document.HasParseError()) {
+        return false;
+    }
+    encode(document, out);
+    return true;
+}
+
+void JsonBinary::encode(const rapidjson::Value& value, std::string* out) {
+    out->push_back(static_cast<char>(kMagic));
+    _encode_value(value, out);
+}
+
+void JsonBinary::_encode_value(const rapidjson::Value& value, std::string* out) {
+    switch (value.GetType()) {
+    case rapidjson::kNullType:
+        out->push_back(NULL_VALUE);
+        break;
+    case rapidjson::kFalseType:
+        out->push_back(FALSE_VALUE);
+        break;
+    case rapidjson::kTrueType:
+        out->push_back(TRUE_VALUE);
+        break;
+    case rapidjson::kNumberType:
+        if (value.IsInt64()) {
+            out->push_back(INT64);
+            put_fixed64_le(out, static_cast<uint64_t>(value.GetInt64()));
+        } else {
+            out->push_back(DOUBLE);
+            double d = value.GetDouble();
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(d));
+            put_fixed64_le(out, bits);
+        }
+        break;
+    case rapidjson::kStringType:
+        out->push_back(STRING);
+        put_fixed32_le(out, value.GetStringLength());
+        out->append(value.GetString(), value.GetStringLength());
+        break;
+    case rapidjson::kArrayType: {
+        out->push_back(ARRAY);
+        size_t payload = out->size();
+        uint32_t count = value.Size();
+        put_fixed32_le(out, count);
+        put_fixed32_le(out, 0);
+        out->append(count * kArrayEntrySize, '\0');
+        for (uint32_t i = 0; i < count; i++) {
+            set_fixed32_le(out, payload + kContainerHeaderSize + i * kArrayEntrySize, out->size() - payload);
+            _encode_value(value[i], out);
+        }
+        set_fixed32_le(out, payload + 4, out->size() - payload);
+        break;
+    }
+    case rapidjson::kObjectType: {
+        // The members are kept in the order of the document, duplicated keys included, as the
+        // text is printed. Their positions in the byte order of the keys are used for lookups.
+        uint32_t count = value.MemberCount();
+        std::vector<uint32_t> sorted(count);
+        std::iota(sorted.begin(), sorted.end(), 0);
+        auto key_of = [&value](uint32_t i) {
+            const auto& name = (value.MemberBegin() + i)->name;
+            return Slice(name.GetString(), name.GetStringLength());
+        };
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [&key_of](uint32_t lhs, uint32_t rhs) { return key_of(lhs).compare(key_of(rhs)) < 0; });
+
+        out->push_back(OBJECT);
+        size_t payload = out->size();
+        put_fixed32_le(out, count);
+        put_fixed32_le(out, 0);
+        out->append(count * (kObjectEntrySize + kObjectIndexSize), '\0');
+        size_t index = payload + kContainerHeaderSize + count * kObjectEntrySize;
+        for (uint32_t i = 0; i < count; i++) {
+            set_fixed32_le(out, index + i * kObjectIndexSize, sorted[i]);
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            auto it = value.MemberBegin() + i;
+            size_t entry = payload + kContainerHeaderSize + i * kObjectEntrySize;
+            set_fixed32_le(out, entry, out->size() - payload);
+            set_fixed32_le(out, entry + 4, it->name.GetStringLength());
+            out->append(it->name.GetString(), it->name.GetStringLength());
+            set_fixed32_le(out, entry + 8, out->size() - payload);
+            _encode_value(it->value, out);
+        }
+        set_fixed32_le(out, payload + 4, out->size() - payload);
+        break;
+    }
+    }
+}
+
+void JsonBinary::to_json_string(const Slice& data, std::string* out) {
+    rapidjson::Document document;
+    JsonBinaryValue::root(data).to_rapidjson(&document, document.GetAllocator());
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    document.Accept(writer);
+    out->append(buffer.GetString(), buffer.GetSize());
+}
+
+JsonBinaryValue::JsonBinaryValue(const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    auto type = static_cast<JsonBinary::Type>(data[0]);
+    _payload = data + 1;
+    _size = size - 1;
+    switch (type) {
+    case JsonBinary::NULL_VALUE:
+    case JsonBinary::FALSE_VALUE:
+    case JsonBinary::TRUE_VALUE:
+        _type = type;
+        break;
+    case JsonBinary::INT64:
+    case JsonBinary::DOUBLE:
+        if (_size >= sizeof(uint64_t)) {
+            _type = type;
+        }
+        break;
+    case JsonBinary::STRING:
+        if (_size >= sizeof(uint32_t) && decode_fixed32_le(_payload) <= _size - sizeof(uint32_t)) {
+            _type = type;
+        }
+        break;
+    case JsonBinary::ARRAY:
+    case JsonBinary::OBJECT: {
+        if (_size < kContainerHeaderSize) {
+            break;
+        }
+        uint32_t count = decode_fixed32_le(_payload);
+        uint32_t payload_size = decode_fixed32_le(_payload + 4);
+        size_t entry_size = type == JsonBinary::ARRAY ? kArrayEntrySize : kObjectEntrySize + kObjectIndexSize;
+        if (payload_size > _size || payload_size < kContainerHeaderSize ||
+            (payload_size - kContainerHeaderSize) / entry_size < count) {
+            break;
+        }
+        _size = payload_size;
+        _count = count;
+        _type = type;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+size_t JsonBinaryValue::_data_begin() const {
+    return kContainerHeaderSize +
+           _count * (_type == JsonBinary::ARRAY ? kArrayEntrySize : kObjectEntrySize + kObjectIndexSize);
+}
+
+JsonBinaryValue JsonBinaryValue::root(const Slice& document) {
+    if (!JsonBinary::is_encoded(document)) {
+        return {};
+    }
+    return {reinterpret_cast<const uint8_t*>(document.data) + 1, document.size - 1};
+}
+
+int64_t JsonBinaryValue::get_int64() const {
+    DCHECK_EQ(JsonBinary::INT64, _type);
+    return static_cast<int64_t>(decode_fixed64_le(_payload));
+}
+
+double JsonBinaryValue::get_double() const {
+    DCHECK_EQ(JsonBinary::DOUBLE, _type);
+    uint64_t bits = decode_fixed64_le(_payload);
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+Slice JsonBinaryValue::get_string() const {
+    DCHECK_EQ(JsonBinary::STRING, _type);
+    return {reinterpret_cast<const char*>(_payload) + sizeof(uint32_t), decode_fixed32_le(_payload)};
+}
+
+bool JsonBinaryValue::element(uint32_t index, JsonBinaryValue* value) const {
+    if (_type != JsonBinary::ARRAY || index >= _count) {
+        return false;
+    }
+    uint32_t offset = decode_fixed32_le(_payload + kContainerHeaderSize + index * kArrayEntrySize);
+    if (offset < _data_begin() || offset >= _size) {
+        return false;
+    }
+    *value = JsonBinaryValue(_payload + offset, _size - offset);
+    return value->type() != JsonBinary::INVALID;
+}
+
+bool JsonBinaryValue::member_at(uint32_t index, Slice* key, JsonBinaryValue* value) const {
+    if (_type != JsonBinary::OBJECT || index >= _count) {
+        return false;
+    }
+    const uint8_t* entry = _payload + kContainerHeaderSize + index * kObjectEntrySize;
+    uint32_t key_offset = decode_fixed32_le(entry);
+    uint32_t key_size = decode_fixed32_le(entry + 4);
+    uint32_t value_offset = decode_fixed32_le(entry + 8);
+    if (key_offset < _data_begin() || key_offset > _size || key_size > _size - key_offset ||
+        value_offset < _data_begin() || value_offset >= _size) {
+        return false;
+    }
+    *key = Slice(reinterpret_cast<const char*>(_payload) + key_offset, key_size);
+    if (value != nullptr) {
+        *value = JsonBinaryValue(_payload + value_offset, _size - value_offset);
+        return value->type() != JsonBinary::INVALID;
+    }
+    return true;
+}
+
+bool JsonBinaryValue::member(const Slice& key, JsonBinaryValue* value) const {
+    if (_type != JsonBinary::OBJECT) {
+        return false;
+    }
+    // The first sorted position of |key|, i.e. its first member in the document like in
+    // rapidjson lookups.
+    const uint8_t* sorted = _payload + kContainerHeaderSize + _count * kObjectEntrySize;
+    uint32_t lo = 0;
+    uint32_t hi = _count;
+    Slice member_key;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (!member_at(decode_fixed32_le(sorted + mid * kObjectIndexSize), &member_key, nullptr)) {
+            return false;
+        }
+        if (member_key.compare(key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == _count) {
+        return false;
+    }
+    uint32_t index = decode_fixed32_le(sorted + lo * kObjectIndexSize);
+    if (!member_at(index, &member_key, nullptr) || member_key != key) {
+        return false;
+    }
+    return member_at(index, &member_key, value);
+}
+
+void JsonBinaryValue::to_rapidjson(rapidjson::Value* out, rapidjson::Document::AllocatorType& allocator) const {
+    _to_rapidjson(out, allocator, 0);
+}
+
+void JsonBinaryValue::_to_rapidjson(rapidjson::Value* out, rapidjson::Document::AllocatorType& allocator,
+                                    int depth) const {
+    if (depth > kMaxDecodeDepth) {
+        out->SetNull();
+        return;
+    }
+    switch (_type) {
+    case JsonBinary::FALSE_VALUE:
+        out->SetBool(false);
+        break;
+    case JsonBinary::TRUE_VALUE:
+        out->SetBool(true);
+        break;
+    case JsonBinary::INT64:
+        out->SetInt64(get_int64());
+        break;
+    case JsonBinary::DOUBLE:
+        out->SetDouble(get_double());
+        break;
+    case JsonBinary::STRING: {
+        Slice s = get_string();
+        out->SetString(s.data, s.size, allocator);
+        break;
+    }
+    case JsonBinary::ARRAY: {
+        out->SetArray();
+        out->Reserve(_count, allocator);
+        for (uint32_t i = 0; i < _count; i++) {
+            JsonBinaryValue element_value;
+            rapidjson::Value element_json;
+            if (element(i, &element_value)) {
+                element_value._to_rapidjson(&element_json, allocator, depth + 1);
+            }
+            out->PushBack(element_json, allocator);
+        }
+        break;
+    }
+    case JsonBinary::OBJECT: {
+        out->SetObject();
+        for (uint32_t i = 0; i < _count; i++) {
+            Slice key;
+            JsonBinaryValue member_value;
+            if (!member_at(i, &key, &member_value)) {
+                continue;
+            }
+            rapidjson::Value key_json(key.data, key.size, allocator);
+            rapidjson::Value member_json;
+            member_value._to_rapidjson(&member_json, allocator, depth + 1);
+            out->AddMember(key_json, member_json, allocator);
+        }
+        break;
+    }
+    default:
+        out->SetNull();
+        break;
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,103 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "common/compiler_util.h"
+DIAGNOSTIC_PUSH
+DIAGNOSTIC_IGNORE("-Wclass-memaccess")
+#include <rapidjson/document.h>
+DIAGNOSTIC_POP
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// A binary encoding of JSON documents, stored in VARCHAR columns, which the json path
+// functions read without parsing the text again.
+//
+// An encoded document is the byte kMagic followed by its root value. A value is a type byte
+// followed by its payload, all integers are little endian:
+//  - NULL, FALSE, TRUE: no payload.
+//  - INT64, DOUBLE:     8 bytes.
+//  - STRING:            uint32 length followed by the bytes.
+//  - ARRAY:             uint32 count, uint32 payload size, uint32 offset of each element, then
+//                       the elements.
+//  - OBJECT:            uint32 count, uint32 payload size, (uint32 key offset, uint32 key length,
+//                       uint32 value offset) of each member in the order of the document, the
+//                       uint32 index of each member in the byte order of the keys, then the keys
+//                       and the values. A key is found by binary search on the sorted indexes.
+// Offsets are relative to the beginning of the payload. A text document never starts with
+// kMagic, which tells the two apart.
+class JsonBinary {
+public:
+    enum Type : uint8_t { NULL_VALUE = 0, FALSE_VALUE, TRUE_VALUE, INT64, DOUBLE, STRING, ARRAY, OBJECT, INVALID };
+
+    static constexpr uint8_t kMagic = 0x01;
+
+    static bool is_encoded(const Slice& data) { return data.size > 0 && static_cast<uint8_t>(data[0]) == kMagic; }
+
+    // Append the encoding of the text document |json| to |out|. Returns false if it is not valid JSON.
+    static bool encode(const Slice& json, std::string* out);
+
+    // Append the encoding of |value| to |out|.
+    static void encode(const rapidjson::Value& value, std::string* out);
+
+    // Append the text of the encoded document |data| to |out|.
+    static void to_json_string(const Slice& data, std::string* out);
+
+private:
+    static void _encode_value(const rapidjson::Value& value, std::string* out);
+};
+
+// A read-only view on an encoded value. Malformed data reads as INVALID values instead of
+// going out of bounds, a VARCHAR column may hold anything.
+class JsonBinaryValue {
+public:
+    JsonBinaryValue() = default;
+
+    // |data| holds a value followed by |size| - (value size) unrelated bytes.
+    JsonBinaryValue(const uint8_t* data, size_t size);
+
+    // The root value of the encoded document |document|.
+    static JsonBinaryValue root(const Slice& document);
+
+    JsonBinary::Type type() const { return _type; }
+
+    int64_t get_int64() const;
+    double get_double() const;
+    Slice get_string() const;
+
+    // Number of elements of an array or members of an object.
+    uint32_t size() const { return _count; }
+
+    // The element |index| of an array.
+    bool element(uint32_t index, JsonBinaryValue* value) const;
+
+    // The first member |key| of an object, in O(log n).
+    bool member(const Slice& key, JsonBinaryValue* value) const;
+
+    // The member |index| of an object, in the order of the document.
+    bool member_at(uint32_t index, Slice* key, JsonBinaryValue* value) const;
+
+    // Copy the value into |out|, allocating with |allocator|. Values nested too deep to be
+    // decoded safely are copied as null.
+    void to_rapidjson(rapidjson::Value* out, rapidjson::Document::AllocatorType& allocator) const;
+
+private:
+    void _to_rapidjson(rapidjson::Value* out, rapidjson::Document::AllocatorType& allocator, int depth) const;
+
+    // Offset of the first key or value of a container. Values are only looked for after it, so
+    // that nested values are strictly smaller than their container, even in malformed data.
+    size_t _data_begin() const;
+
+    JsonBinary::Type _type = JsonBinary::INVALID;
+    // The payload, after the type byte, and the number of bytes available for it.
+    const uint8_t* _payload = nullptr;
+    size_t _size = 0;
+    uint32_t _count = 0;
+};
+
+} // namespace starrocks
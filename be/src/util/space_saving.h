@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starrocks {
+
+// Space-Saving sketch (Metwally et al.) to find the most frequent items of a stream
+// with a fixed number of counters.
+//
+// Every monitored item keeps an estimated count that over-estimates its real frequency
+// by at most the recorded error. Any item whose real frequency is larger than
+// total() / capacity is guaranteed to be monitored.
+//
+// The counters are kept in a small array and looked up linearly, which is cheaper than
+// a hash table for the few dozen counters this is meant for.
+template <typename T>
+class SpaceSaving {
+public:
+    struct Entry {
+        T item;
+        uint64_t count;
+        // Upper bound of the over-estimation of count.
+        uint64_t error;
+    };
+
+    explicit SpaceSaving(size_t capacity) : _capacity(std::max<size_t>(capacity, 1)) {
+        _entries.reserve(_capacity);
+    }
+
+    void add(const T& item, uint64_t count = 1) {
+        _total += count;
+        size_t min_index = 0;
+        for (size_t i = 0; i < _entries.size(); i++) {
+            if (_entries[i].item == item) {
+                _entries[i].count += count;
+                return;
+            }
+            if (_entries[i].count < _entries[min_index].count) {
+                min_index = i;
+            }
+        }
+        if (_entries.size() < _capacity) {
+            _entries.push_back({item, count, 0});
+            return;
+        }
+        // Replace the least frequent item, the new item inherits its count as error.
+        Entry& victim = _entries[min_index];
+        victim.item = item;
+        victim.error = victim.count;
+        victim.count += count;
+    }
+
+    uint64_t total() const { return _total; }
+
+    // Items whose estimated count is at least |min_count|, most frequent first.
+    std::vector<Entry> top(uint64_t min_count) const {
+        std::vector<Entry> result;
+        for (const auto& entry : _entries) {
+            if (entry.count >= min_count) {
+                result.push_back(entry);
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) { return a.count > b.count; });
+        return result;
+    }
+
+    void clear() {
+        _entries.clear();
+        _total = 0;
+    }
+
+private:
+    const size_t _capacity;
+    std::vector<Entry> _entries;
+    uint64_t _total = 0;
+};
+
+} // namespace starrocks
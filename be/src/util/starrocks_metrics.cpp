@@ -28,6 +28,7 @@
 #include "util/debug_util.h"
 #include "util/file_utils.h"
 #include "util/system_metrics.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -145,6 +146,10 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
 
     _metrics.register_metric("stream_load", MetricLabels().add("type", "receive_bytes"), &stream_receive_bytes_total);
     _metrics.register_metric("stream_load", MetricLabels().add("type", "load_rows"), &stream_load_rows_total);
+    _metrics.register_metric("routine_load", MetricLabels().add("type", "receive_rows"),
+                             &routine_load_receive_rows_total);
+    _metrics.register_metric("routine_load", MetricLabels().add("type", "receive_bytes"),
+                             &routine_load_receive_bytes_total);
     _metrics.register_metric("load_rows", &load_rows_total);
     _metrics.register_metric("load_bytes", &load_bytes_total);
 
@@ -202,6 +207,44 @@ void StarRocksMetrics::initialize(const std::vector<std::string>& paths, bool in
     }
 }
 
+std::shared_ptr<StarRocksMetrics::RoutineLoadPartitionMetrics> StarRocksMetrics::routine_load_partition_metrics(
+        const std::string& topic, int32_t partition) {
+    std::lock_guard<std::mutex> l(_routine_load_partition_lock);
+    auto& metrics = _routine_load_partition_metrics[{topic, partition}];
+    if (metrics == nullptr) {
+        metrics = std::make_shared<RoutineLoadPartitionMetrics>();
+        MetricLabels labels;
+        labels.add("topic", topic).add("partition", std::to_string(partition));
+        auto with_type = [&labels](const std::string& type) { return MetricLabels(labels).add("type", type); };
+        _metrics.register_metric("routine_load_partition", with_type("receive_rows"), &metrics->receive_rows);
+        _metrics.register_metric("routine_load_partition", with_type("receive_bytes"), &metrics->receive_bytes);
+        _metrics.register_metric("routine_load_partition", with_type("filtered_rows"), &metrics->filtered_rows);
+        // gauges are collected apart from counters
+        _metrics.register_metric("routine_load_partition_lag", labels, &metrics->lag);
+    }
+    metrics->last_used_s = MonotonicSeconds();
+    return metrics;
+}
+
+void StarRocksMetrics::expire_routine_load_partition_metrics(int64_t idle_s) {
+    int64_t now = MonotonicSeconds();
+    std::lock_guard<std::mutex> l(_routine_load_partition_lock);
+    auto iter = _routine_load_partition_metrics.begin();
+    while (iter != _routine_load_partition_metrics.end()) {
+        const auto& metrics = iter->second;
+        // only the map holds the metrics once the tasks of the partition are done
+        if (metrics.use_count() > 1 || now - metrics->last_used_s < idle_s) {
+            ++iter;
+            continue;
+        }
+        _metrics.deregister_metric(&metrics->receive_rows);
+        _metrics.deregister_metric(&metrics->receive_bytes);
+        _metrics.deregister_metric(&metrics->filtered_rows);
+        _metrics.deregister_metric(&metrics->lag);
+        iter = _routine_load_partition_metrics.erase(iter);
+    }
+}
+
 void StarRocksMetrics::_update() {
     _update_process_thread_num();
     _update_process_fd_num();
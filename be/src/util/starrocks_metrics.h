@@ -22,6 +22,9 @@
 #ifndef STARROCKS_BE_SRC_COMMON_UTIL_STARROCKS_METRICS_H
 #define STARROCKS_BE_SRC_COMMON_UTIL_STARROCKS_METRICS_H
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -137,6 +140,8 @@ public:
     METRIC_DEFINE_INT_COUNTER(txn_exec_plan_total, MetricUnit::OPERATIONS);
     METRIC_DEFINE_INT_COUNTER(stream_receive_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(stream_load_rows_total, MetricUnit::ROWS);
+    METRIC_DEFINE_INT_COUNTER(routine_load_receive_rows_total, MetricUnit::ROWS);
+    METRIC_DEFINE_INT_COUNTER(routine_load_receive_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(load_rows_total, MetricUnit::ROWS);
     METRIC_DEFINE_INT_COUNTER(load_bytes_total, MetricUnit::BYTES);
 
@@ -213,6 +218,18 @@ public:
     METRIC_DEFINE_UINT_GAUGE(brpc_endpoint_stub_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(tablet_writer_count, MetricUnit::NOUNIT);
 
+    // The metrics of a partition of a kafka topic consumed by routine load.
+    struct RoutineLoadPartitionMetrics {
+        METRIC_DEFINE_INT_COUNTER(receive_rows, MetricUnit::ROWS);
+        METRIC_DEFINE_INT_COUNTER(receive_bytes, MetricUnit::BYTES);
+        // rows of the partition filtered out by the scanner as invalid
+        METRIC_DEFINE_INT_COUNTER(filtered_rows, MetricUnit::ROWS);
+        // msgs left in the partition after the last routine load task
+        METRIC_DEFINE_INT_GAUGE(lag, MetricUnit::NOUNIT);
+        // MonotonicSeconds() of the last routine_load_partition_metrics() call for the partition
+        int64_t last_used_s = 0;
+    };
+
     static StarRocksMetrics* instance() {
         static StarRocksMetrics instance;
         return &instance;
@@ -227,6 +244,14 @@ public:
     MetricRegistry* metrics() { return &_metrics; }
     SystemMetrics* system_metrics() { return &_system_metrics; }
 
+    // Returns the metrics of |partition| of |topic|, they are registered by the first call.
+    std::shared_ptr<RoutineLoadPartitionMetrics> routine_load_partition_metrics(const std::string& topic,
+                                                                                int32_t partition);
+
+    // Deregisters the metrics of the partitions that are not held by any routine load task and
+    // were not asked for in the last |idle_s| seconds, i.e. no routine load job consumes them any more.
+    void expire_routine_load_partition_metrics(int64_t idle_s);
+
 private:
     // Don't allow constrctor
     StarRocksMetrics();
@@ -241,6 +266,10 @@ private:
 
     MetricRegistry _metrics;
     SystemMetrics _system_metrics;
+
+    std::mutex _routine_load_partition_lock;
+    std::map<std::pair<std::string, int32_t>, std::shared_ptr<RoutineLoadPartitionMetrics>>
+            _routine_load_partition_metrics;
 };
 
 }; // namespace starrocks
@@ -0,0 +1,121 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_encoder.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized {
+
+class ColumnEncoderTest : public testing::Test {
+protected:
+    // Encode |column|, decode it into an empty clone and return the encoding tag.
+    uint8_t round_trip(const ColumnPtr& column, ColumnPtr* result) {
+        faststring buffer;
+        ColumnEncoder::encode(column.get(), &buffer);
+        EXPECT_LE(buffer.size(), column->serialize_size() + 1);
+
+        *result = column->clone_empty();
+        const uint8_t* src = buffer.data();
+        EXPECT_TRUE(ColumnEncoder::decode(&src, buffer.data() + buffer.size(), result->get()).ok());
+        EXPECT_EQ(buffer.data() + buffer.size(), src);
+        EXPECT_EQ(column->size(), (*result)->size());
+        for (size_t i = 0; i < column->size(); i++) {
+            EXPECT_EQ(0, column->compare_at(i, i, **result, -1)) << "row " << i;
+        }
+        return buffer[0];
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_plain) {
+    auto column = Int64Column::create();
+    for (int64_t i = 0; i < 1000; i++) {
+        column->append(i * 7919 * 104729 * 1299709);
+    }
+    ColumnPtr result;
+    ASSERT_EQ(ColumnEncoder::PLAIN, round_trip(column, &result));
+
+    auto small = Int32Column::create();
+    small->append(1);
+    ASSERT_EQ(ColumnEncoder::PLAIN, round_trip(small, &result));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_rle) {
+    auto column = Int32Column::create();
+    for (int32_t i = 0; i < 4096; i++) {
+        column->append(i / 100);
+    }
+    ColumnPtr result;
+    ASSERT_EQ(ColumnEncoder::RLE, round_trip(column, &result));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_for) {
+    auto column = Int64Column::create();
+    for (int64_t i = 0; i < 4096; i++) {
+        column->append(1000000000000L + (i * 31) % 997);
+    }
+    ColumnPtr result;
+    ASSERT_EQ(ColumnEncoder::FOR, round_trip(column, &result));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_dict) {
+    auto column = BinaryColumn::create();
+    std::vector<std::string> values = {"beijing", "shanghai", "shenzhen", "hangzhou"};
+    for (size_t i = 0; i < 4096; i++) {
+        column->append(values[(i * 7) % values.size()]);
+    }
+    ColumnPtr result;
+    ASSERT_EQ(ColumnEncoder::DICT, round_trip(column, &result));
+
+    auto unique = BinaryColumn::create();
+    for (size_t i = 0; i < 4096; i++) {
+        unique->append("value_" + std::to_string(i));
+    }
+    ASSERT_EQ(ColumnEncoder::PLAIN, round_trip(unique, &result));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_nullable) {
+    auto data = BinaryColumn::create();
+    auto nulls = NullColumn::create();
+    for (size_t i = 0; i < 4096; i++) {
+        data->append(i % 3 == 0 ? "" : "abc");
+        nulls->append(i % 3 == 0);
+    }
+    auto column = NullableColumn::create(data, nulls);
+    ColumnPtr result;
+    ASSERT_EQ(ColumnEncoder::NULLABLE, round_trip(column, &result));
+    ASSERT_TRUE(result->has_null());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_const) {
+    auto data = Int32Column::create();
+    data->append(42);
+    auto column = ConstColumn::create(data, 4096);
+    ColumnPtr result;
+    ASSERT_EQ(ColumnEncoder::PLAIN, round_trip(column, &result));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnEncoderTest, test_truncated) {
+    auto column = Int32Column::create();
+    for (int32_t i = 0; i < 4096; i++) {
+        column->append(i / 100);
+    }
+    faststring buffer;
+    ColumnEncoder::encode(column.get(), &buffer);
+    auto result = column->clone_empty();
+    const uint8_t* src = buffer.data();
+    ASSERT_FALSE(ColumnEncoder::decode(&src, buffer.data() + buffer.size() / 2, result.get()).ok());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,146 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/sort_key_encoder.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::vectorized {
+
+class SortKeyEncoderTest : public testing::Test {
+protected:
+    // Check that the memcmp order of the encoded keys is the order of compare_at(), for every pair of rows.
+    void check_order(const Columns& columns, const std::vector<PrimitiveType>& types, const std::vector<bool>& is_asc,
+                     const std::vector<bool>& is_null_first) {
+        SortKeyEncoder encoder(types, is_asc, is_null_first);
+        ASSERT_TRUE(encoder.is_supported());
+        size_t num_rows = columns[0]->size();
+        BinaryColumn keys;
+        encoder.encode(columns, num_rows, &keys);
+        ASSERT_EQ(num_rows, keys.size());
+
+        for (size_t i = 0; i < num_rows; i++) {
+            for (size_t j = 0; j < num_rows; j++) {
+                int expected = 0;
+                for (size_t col = 0; col < columns.size() && expected == 0; col++) {
+                    int null_first_flag = (is_asc[col] == is_null_first[col]) ? -1 : 1;
+                    expected = columns[col]->compare_at(i, j, *columns[col], null_first_flag);
+                    expected = is_asc[col] ? expected : -expected;
+                }
+                int actual = keys.get_slice(i).compare(keys.get_slice(j));
+                ASSERT_EQ(expected < 0, actual < 0) << "rows " << i << " and " << j;
+                ASSERT_EQ(expected == 0, actual == 0) << "rows " << i << " and " << j;
+            }
+        }
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_integers) {
+    auto column = Int32Column::create();
+    for (int32_t v : {0, -1, 1, INT32_MIN, INT32_MAX, 256, -256, 1, 0}) {
+        column->append(v);
+    }
+    Columns columns{column};
+    check_order(columns, {TYPE_INT}, {true}, {true});
+    check_order(columns, {TYPE_INT}, {false}, {true});
+}
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_doubles) {
+    auto column = DoubleColumn::create();
+    for (double v : {0.0, -1.5, 1.5, 1e300, -1e300, 3.0, -0.25}) {
+        column->append(v);
+    }
+    Columns columns{column};
+    check_order(columns, {TYPE_DOUBLE}, {true}, {true});
+    check_order(columns, {TYPE_DOUBLE}, {false}, {false});
+}
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_strings) {
+    auto column = BinaryColumn::create();
+    for (const std::string& v : {std::string(""), std::string("a"), std::string("ab"), std::string("a\0b", 3),
+                                 std::string("a\0", 2), std::string("b"), std::string("\xff"), std::string("a")}) {
+        column->append(Slice(v));
+    }
+    Columns columns{column};
+    check_order(columns, {TYPE_VARCHAR}, {true}, {true});
+    check_order(columns, {TYPE_VARCHAR}, {false}, {true});
+}
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_nulls) {
+    for (bool is_asc : {true, false}) {
+        for (bool is_null_first : {true, false}) {
+            auto column = NullableColumn::create(Int64Column::create(), NullColumn::create());
+            column->append_datum(Datum(int64_t(3)));
+            column->append_nulls(1);
+            column->append_datum(Datum(int64_t(-3)));
+            column->append_datum(Datum(int64_t(0)));
+            column->append_nulls(1);
+            Columns columns{column};
+            check_order(columns, {TYPE_BIGINT}, {is_asc}, {is_null_first});
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_multiple_columns) {
+    auto strings = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    auto ints = Int32Column::create();
+    for (int i = 0; i < 24; i++) {
+        if (i % 5 == 0) {
+            strings->append_nulls(1);
+        } else {
+            std::string value(i % 3, 'x');
+            strings->append_datum(Datum(Slice(value)));
+        }
+        ints->append(i % 4 - 2);
+    }
+    Columns columns{strings, ints};
+    check_order(columns, {TYPE_VARCHAR, TYPE_INT}, {true, false}, {false, true});
+    check_order(columns, {TYPE_VARCHAR, TYPE_INT}, {false, true}, {true, true});
+}
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_unsupported) {
+    ASSERT_FALSE(SortKeyEncoder::is_supported(TYPE_HLL));
+    SortKeyEncoder encoder({TYPE_INT, TYPE_HLL}, {true, true}, {true, true});
+    ASSERT_FALSE(encoder.is_supported());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SortKeyEncoderTest, test_sort) {
+    // enough rows with long common prefixes to be distributed by the radix sort, and duplicates.
+    auto strings = BinaryColumn::create();
+    auto ints = Int64Column::create();
+    for (int i = 0; i < 5000; i++) {
+        std::string value = std::string(i % 2 ? 20 : 0, 'p') + std::to_string((i * 7919) % 1000);
+        strings->append_datum(Datum(Slice(value)));
+        ints->append((i * 31) % 7 - 3);
+    }
+    Columns columns{strings, ints};
+    SortKeyEncoder encoder({TYPE_VARCHAR, TYPE_BIGINT}, {true, true}, {true, true});
+    BinaryColumn keys;
+    encoder.encode(columns, strings->size(), &keys);
+
+    std::vector<uint32_t> rows(strings->size());
+    for (uint32_t i = 0; i < rows.size(); i++) {
+        rows[i] = i;
+    }
+    std::vector<uint32_t> expected = rows;
+    SortKeyEncoder::sort(keys, &rows);
+    std::stable_sort(expected.begin(), expected.end(), [&](uint32_t l, uint32_t r) {
+        int c = strings->compare_at(l, r, *strings, -1);
+        return c != 0 ? c < 0 : ints->compare_at(l, r, *ints, -1) < 0;
+    });
+    ASSERT_EQ(expected, rows);
+}
+
+} // namespace starrocks::vectorized
@@ -4,10 +4,15 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <type_traits>
+
 #include "column/binary_column.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "exec/parquet/encoding_dict.h"
 #include "exec/parquet/encoding_plain.h"
+#include "util/faststring.h"
 
 namespace starrocks::parquet {
 class ParquetEncodingTest : public testing::Test {
@@ -331,4 +336,336 @@ TEST_F(ParquetEncodingTest, FixedString) {
     }
 }
 
+// Skip and read |step| values alternately, and check the values read.
+template <typename T>
+static void check_skip(const std::vector<T>& values, const Slice& encoded_data, Decoder* decoder, size_t step) {
+    using ColumnType = std::conditional_t<std::is_same_v<T, Slice>, vectorized::BinaryColumn,
+                                          vectorized::FixedLengthColumn<T>>;
+    auto column = ColumnType::create();
+    std::vector<T> expected;
+
+    auto st = decoder->set_data(encoded_data);
+    ASSERT_TRUE(st.ok());
+    for (size_t i = 0; i < values.size(); i += 2 * step) {
+        size_t count = std::min(step, values.size() - i);
+        st = decoder->skip(count);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        if (i + count < values.size()) {
+            size_t read_count = std::min(step, values.size() - i - count);
+            st = decoder->next_batch(read_count, ColumnContentType::VALUE, column.get());
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            expected.insert(expected.end(), values.begin() + i + count, values.begin() + i + count + read_count);
+        }
+    }
+    ASSERT_EQ(expected.size(), column->size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i], column->get(i).template get<T>());
+    }
+}
+
+TEST_F(ParquetEncodingTest, Skip) {
+    std::vector<int32_t> int32_values;
+    std::vector<float> float_values;
+    std::vector<std::string> strings;
+    for (int i = 0; i < 300; i++) {
+        int32_values.push_back(i % 3 == 0 ? -i : i * 1000);
+        float_values.push_back(i * 0.5f);
+        strings.push_back("starrocks_" + std::to_string(i / 4));
+    }
+    std::vector<Slice> slices;
+    for (const auto& value : strings) {
+        slices.push_back(value);
+    }
+
+    for (auto encoding : {tparquet::Encoding::PLAIN, tparquet::Encoding::DELTA_BINARY_PACKED}) {
+        const EncodingInfo* encoding_info = nullptr;
+        EncodingInfo::get(tparquet::Type::INT32, encoding, &encoding_info);
+        ASSERT_TRUE(encoding_info != nullptr);
+
+        std::unique_ptr<Decoder> decoder;
+        auto st = encoding_info->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = encoding_info->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&int32_values[0]), int32_values.size());
+        ASSERT_TRUE(st.ok());
+        Slice encoded = encoder->build();
+
+        for (size_t step : {1, 7, 100, 129}) {
+            check_skip(int32_values, encoded, decoder.get(), step);
+        }
+
+        // out-of-bounds skip
+        st = decoder->set_data(encoded);
+        ASSERT_TRUE(st.ok());
+        st = decoder->skip(int32_values.size() + 1);
+        ASSERT_FALSE(st.ok());
+    }
+
+    {
+        const EncodingInfo* encoding_info = nullptr;
+        EncodingInfo::get(tparquet::Type::FLOAT, tparquet::Encoding::BYTE_STREAM_SPLIT, &encoding_info);
+        ASSERT_TRUE(encoding_info != nullptr);
+
+        std::unique_ptr<Decoder> decoder;
+        auto st = encoding_info->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = encoding_info->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&float_values[0]), float_values.size());
+        ASSERT_TRUE(st.ok());
+
+        Slice encoded = encoder->build();
+        for (size_t step : {1, 7, 100}) {
+            check_skip(float_values, encoded, decoder.get(), step);
+        }
+    }
+
+    for (auto encoding : {tparquet::Encoding::PLAIN, tparquet::Encoding::DELTA_LENGTH_BYTE_ARRAY,
+                          tparquet::Encoding::DELTA_BYTE_ARRAY}) {
+        const EncodingInfo* encoding_info = nullptr;
+        EncodingInfo::get(tparquet::Type::BYTE_ARRAY, encoding, &encoding_info);
+        ASSERT_TRUE(encoding_info != nullptr);
+
+        std::unique_ptr<Decoder> decoder;
+        auto st = encoding_info->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = encoding_info->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&slices[0]), slices.size());
+        ASSERT_TRUE(st.ok());
+        Slice encoded = encoder->build();
+
+        for (size_t step : {1, 7, 100}) {
+            check_skip(slices, encoded, decoder.get(), step);
+        }
+    }
+
+    // dict
+    {
+        const EncodingInfo* plain_encoding = nullptr;
+        EncodingInfo::get(tparquet::Type::BYTE_ARRAY, tparquet::Encoding::PLAIN, &plain_encoding);
+        ASSERT_TRUE(plain_encoding != nullptr);
+        const EncodingInfo* dict_encoding = nullptr;
+        EncodingInfo::get(tparquet::Type::BYTE_ARRAY, tparquet::Encoding::RLE_DICTIONARY, &dict_encoding);
+        ASSERT_TRUE(dict_encoding != nullptr);
+
+        std::unique_ptr<Decoder> decoder;
+        auto st = dict_encoding->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = dict_encoding->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&slices[0]), slices.size());
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> dict_encoder;
+        st = plain_encoding->create_encoder(&dict_encoder);
+        ASSERT_TRUE(st.ok());
+        size_t num_dicts = 0;
+        st = encoder->encode_dict(dict_encoder.get(), &num_dicts);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Decoder> dict_decoder;
+        st = plain_encoding->create_decoder(&dict_decoder);
+        ASSERT_TRUE(st.ok());
+        dict_decoder->set_data(dict_encoder->build());
+        st = decoder->set_dict(num_dicts, dict_decoder.get());
+        ASSERT_TRUE(st.ok());
+        Slice encoded = encoder->build();
+
+        for (size_t step : {1, 7, 100}) {
+            check_skip(slices, encoded, decoder.get(), step);
+        }
+    }
+}
+
+TEST_F(ParquetEncodingTest, DeltaBinaryPacked) {
+    // More than a block of 128 values, with deltas of both signs and up to the full width.
+    std::vector<int32_t> int32_values;
+    std::vector<int64_t> int64_values;
+    for (int i = 0; i < 300; i++) {
+        int32_values.push_back(i % 7 == 0 ? -i * 1000 : i);
+        int64_values.push_back(i % 5 == 0 ? std::numeric_limits<int64_t>::min() + i : (int64_t)i * i);
+    }
+    int64_values.back() = std::numeric_limits<int64_t>::max();
+
+    const EncodingInfo* int32_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::INT32, tparquet::Encoding::DELTA_BINARY_PACKED, &int32_encoding);
+    ASSERT_TRUE(int32_encoding != nullptr);
+    {
+        std::unique_ptr<Decoder> decoder;
+        auto st = int32_encoding->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = int32_encoding->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&int32_values[0]), int32_values.size());
+        ASSERT_TRUE(st.ok());
+
+        DecoderChecker<int32_t, false>::check(int32_values, encoder->build(), decoder.get());
+    }
+
+    const EncodingInfo* int64_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::INT64, tparquet::Encoding::DELTA_BINARY_PACKED, &int64_encoding);
+    ASSERT_TRUE(int64_encoding != nullptr);
+    {
+        std::unique_ptr<Decoder> decoder;
+        auto st = int64_encoding->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = int64_encoding->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&int64_values[0]), int64_values.size());
+        ASSERT_TRUE(st.ok());
+        Slice encoded = encoder->build();
+
+        DecoderChecker<int64_t, false>::check(int64_values, encoded, decoder.get());
+
+        // decode in batches, which end inside miniblocks
+        st = decoder->set_data(encoded);
+        ASSERT_TRUE(st.ok());
+        std::vector<int64_t> checks(int64_values.size());
+        for (size_t i = 0; i < checks.size(); i += 45) {
+            size_t count = std::min<size_t>(45, checks.size() - i);
+            st = decoder->next_batch(count, reinterpret_cast<uint8_t*>(&checks[i]));
+            ASSERT_TRUE(st.ok());
+        }
+        ASSERT_EQ(int64_values, checks);
+
+        // truncated page
+        st = decoder->set_data(Slice(encoded.data, encoded.size / 2));
+        if (st.ok()) {
+            st = decoder->next_batch(checks.size(), reinterpret_cast<uint8_t*>(&checks[0]));
+        }
+        ASSERT_FALSE(st.ok());
+    }
+}
+
+TEST_F(ParquetEncodingTest, DeltaByteArray) {
+    // Values sharing prefixes of different lengths, and empty values.
+    std::vector<std::string> values;
+    for (int i = 0; i < 200; i++) {
+        values.push_back(i % 10 == 0 ? "" : "starrocks_" + std::to_string(i * 37));
+    }
+
+    std::vector<Slice> slices;
+    for (const auto& value : values) {
+        slices.push_back(value);
+    }
+
+    for (auto encoding : {tparquet::Encoding::DELTA_LENGTH_BYTE_ARRAY, tparquet::Encoding::DELTA_BYTE_ARRAY}) {
+        const EncodingInfo* delta_encoding = nullptr;
+        EncodingInfo::get(tparquet::Type::BYTE_ARRAY, encoding, &delta_encoding);
+        ASSERT_TRUE(delta_encoding != nullptr);
+
+        std::unique_ptr<Decoder> decoder;
+        auto st = delta_encoding->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = delta_encoding->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&slices[0]), slices.size());
+        ASSERT_TRUE(st.ok());
+        Slice encoded = encoder->build();
+
+        DecoderChecker<Slice, false>::check(slices, encoded, decoder.get());
+
+        // decode in batches, the prefixes refer to the last value of the previous batch
+        st = decoder->set_data(encoded);
+        ASSERT_TRUE(st.ok());
+        auto column = starrocks::vectorized::BinaryColumn::create();
+        for (size_t i = 0; i < slices.size(); i += 33) {
+            st = decoder->next_batch(std::min<size_t>(33, slices.size() - i), ColumnContentType::VALUE, column.get());
+            ASSERT_TRUE(st.ok());
+        }
+        ASSERT_EQ(slices.size(), column->size());
+        for (size_t i = 0; i < slices.size(); i++) {
+            ASSERT_EQ(slices[i], column->get_slice(i));
+        }
+
+        // more values than the page holds
+        decoder->set_num_values(slices.size() - 1);
+        st = decoder->set_data(encoded);
+        ASSERT_EQ(TStatusCode::CORRUPTION, st.code()) << st.to_string();
+        decoder->set_num_values(slices.size());
+        ASSERT_TRUE(decoder->set_data(encoded).ok());
+
+        // a header of 2^40 values, without the blocks to encode them
+        faststring header;
+        for (uint64_t value : {128UL, 4UL, 1UL << 40, 0UL}) {
+            for (; value >= 0x80; value >>= 7) {
+                header.push_back(static_cast<uint8_t>(value | 0x80));
+            }
+            header.push_back(static_cast<uint8_t>(value));
+        }
+        header.append("abcdefgh", 8);
+        decoder->set_num_values(std::numeric_limits<size_t>::max());
+        st = decoder->set_data(Slice(header.data(), header.size()));
+        ASSERT_EQ(TStatusCode::CORRUPTION, st.code()) << st.to_string();
+    }
+}
+
+TEST_F(ParquetEncodingTest, ByteStreamSplit) {
+    std::vector<float> float_values;
+    std::vector<double> double_values;
+    for (int i = 0; i < 100; i++) {
+        float_values.push_back(i * 1.5f - 20);
+        double_values.push_back(i * -3.25 + 1e10);
+    }
+
+    const EncodingInfo* float_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::FLOAT, tparquet::Encoding::BYTE_STREAM_SPLIT, &float_encoding);
+    ASSERT_TRUE(float_encoding != nullptr);
+    {
+        std::unique_ptr<Decoder> decoder;
+        auto st = float_encoding->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = float_encoding->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&float_values[0]), float_values.size());
+        ASSERT_TRUE(st.ok());
+
+        DecoderChecker<float, false>::check(float_values, encoder->build(), decoder.get());
+    }
+
+    const EncodingInfo* double_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::DOUBLE, tparquet::Encoding::BYTE_STREAM_SPLIT, &double_encoding);
+    ASSERT_TRUE(double_encoding != nullptr);
+    {
+        std::unique_ptr<Decoder> decoder;
+        auto st = double_encoding->create_decoder(&decoder);
+        ASSERT_TRUE(st.ok());
+
+        std::unique_ptr<Encoder> encoder;
+        st = double_encoding->create_encoder(&encoder);
+        ASSERT_TRUE(st.ok());
+
+        st = encoder->append(reinterpret_cast<uint8_t*>(&double_values[0]), double_values.size());
+        ASSERT_TRUE(st.ok());
+
+        DecoderChecker<double, false>::check(double_values, encoder->build(), decoder.get());
+    }
+}
+
 } // namespace starrocks::parquet
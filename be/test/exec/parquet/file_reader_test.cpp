@@ -4,10 +4,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/env_memory.h"
 #include "exec/parquet/column_chunk_reader.h"
 #include "exec/parquet/metadata.h"
 #include "exec/parquet/page_reader.h"
@@ -15,13 +21,198 @@
 #include "exprs/literal.h"
 #include "exprs/slot_ref.h"
 #include "exprs/vectorized/binary_predicate.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/descriptor_helper.h"
+#include "util/faststring.h"
+#include "util/rle_encoding.h"
+#include "util/thrift_util.h"
 
 namespace starrocks::parquet {
 
 static vectorized::HdfsScanStats g_hdfs_scan_stats;
 using starrocks::vectorized::HdfsFileReaderParam;
 
+// The rows of the file written by write_page_index_file().
+static constexpr int kPageIndexRows = 1000;
+
+// c1 of the file, the values of the rows of every 100 rows are shuffled in these 100 rows.
+static int32_t page_index_c1(int row) {
+    return row / 100 * 100 + row % 100 * 37 % 100;
+}
+
+// c2 of the file, null if the row is a multiple of 7.
+static bool page_index_c2_is_null(int row) {
+    return row % 7 == 0;
+}
+
+template <typename T>
+static std::string serialize_thrift_msg(T* obj) {
+    ThriftSerializer ser(true, 1024);
+    std::string buffer;
+    ser.serialize(obj, &buffer);
+    return buffer;
+}
+
+template <typename T>
+static void append_plain(std::string* buffer, T value) {
+    buffer->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Write the rows of a column in plain encoded pages of |page_rows| rows, and return its column chunk
+// with the page index of the pages.
+static tparquet::ColumnChunk write_page_index_column(std::string* file, const std::string& name,
+                                                     tparquet::Type::type type, bool optional, int page_rows,
+                                                     const std::function<int64_t(int)>& value_of,
+                                                     tparquet::ColumnIndex* column_index,
+                                                     tparquet::OffsetIndex* offset_index) {
+    int64_t start_offset = file->size();
+    column_index->__set_boundary_order(tparquet::BoundaryOrder::UNORDERED);
+    for (int first_row = 0; first_row < kPageIndexRows; first_row += page_rows) {
+        int end_row = std::min(first_row + page_rows, kPageIndexRows);
+        std::string data;
+        if (optional) {
+            faststring levels;
+            RleEncoder<level_t> encoder(&levels, 1);
+            for (int row = first_row; row < end_row; row++) {
+                encoder.Put(page_index_c2_is_null(row) ? 0 : 1);
+            }
+            encoder.Flush();
+            append_plain<uint32_t>(&data, levels.size());
+            data.append(reinterpret_cast<const char*>(levels.data()), levels.size());
+        }
+        int64_t min_value = std::numeric_limits<int64_t>::max();
+        int64_t max_value = std::numeric_limits<int64_t>::min();
+        for (int row = first_row; row < end_row; row++) {
+            if (optional && page_index_c2_is_null(row)) {
+                continue;
+            }
+            int64_t value = value_of(row);
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+            if (type == tparquet::Type::type::INT32) {
+                append_plain<int32_t>(&data, value);
+            } else {
+                append_plain<int64_t>(&data, value);
+            }
+        }
+
+        tparquet::DataPageHeader data_page_header;
+        data_page_header.__set_num_values(end_row - first_row);
+        data_page_header.__set_encoding(tparquet::Encoding::PLAIN);
+        data_page_header.__set_definition_level_encoding(tparquet::Encoding::RLE);
+        data_page_header.__set_repetition_level_encoding(tparquet::Encoding::RLE);
+        tparquet::PageHeader page_header;
+        page_header.__set_type(tparquet::PageType::DATA_PAGE);
+        page_header.__set_uncompressed_page_size(data.size());
+        page_header.__set_compressed_page_size(data.size());
+        page_header.__set_data_page_header(data_page_header);
+
+        tparquet::PageLocation location;
+        location.__set_offset(file->size());
+        location.__set_first_row_index(first_row);
+        file->append(serialize_thrift_msg(&page_header));
+        file->append(data);
+        location.__set_compressed_page_size(file->size() - location.offset);
+        offset_index->page_locations.emplace_back(location);
+
+        bool null_page = min_value > max_value;
+        std::string min_buffer;
+        std::string max_buffer;
+        if (!null_page && type == tparquet::Type::type::INT32) {
+            append_plain<int32_t>(&min_buffer, min_value);
+            append_plain<int32_t>(&max_buffer, max_value);
+        } else if (!null_page) {
+            append_plain<int64_t>(&min_buffer, min_value);
+            append_plain<int64_t>(&max_buffer, max_value);
+        }
+        column_index->null_pages.emplace_back(null_page);
+        column_index->min_values.emplace_back(min_buffer);
+        column_index->max_values.emplace_back(max_buffer);
+    }
+
+    tparquet::ColumnMetaData meta_data;
+    meta_data.__set_type(type);
+    meta_data.__set_encodings({tparquet::Encoding::PLAIN, tparquet::Encoding::RLE});
+    meta_data.__set_path_in_schema({name});
+    meta_data.__set_codec(tparquet::CompressionCodec::UNCOMPRESSED);
+    meta_data.__set_num_values(kPageIndexRows);
+    meta_data.__set_total_uncompressed_size(file->size() - start_offset);
+    meta_data.__set_total_compressed_size(file->size() - start_offset);
+    meta_data.__set_data_page_offset(start_offset);
+    tparquet::ColumnChunk column_chunk;
+    column_chunk.__set_file_offset(start_offset);
+    column_chunk.__set_meta_data(meta_data);
+    return column_chunk;
+}
+
+// Write a file of a row group of kPageIndexRows rows with the page index of its columns, whose pages
+// are of different sizes:
+//
+// c1 int (required)   c2 bigint (optional)   c3 int (required)
+// ---------------------------------------------------------------
+// page_index_c1(row)  NULL or row * 10       row
+// 100 rows a page     64 rows a page         50 rows a page
+static std::string write_page_index_file() {
+    std::string file = "PAR1";
+    tparquet::ColumnIndex column_indexes[3];
+    tparquet::OffsetIndex offset_indexes[3];
+    std::vector<tparquet::ColumnChunk> column_chunks;
+    column_chunks.emplace_back(write_page_index_column(&file, "c1", tparquet::Type::type::INT32, false, 100,
+                                                       page_index_c1, &column_indexes[0], &offset_indexes[0]));
+    column_chunks.emplace_back(write_page_index_column(
+            &file, "c2", tparquet::Type::type::INT64, true, 64, [](int row) { return row * 10L; },
+            &column_indexes[1], &offset_indexes[1]));
+    column_chunks.emplace_back(write_page_index_column(&file, "c3", tparquet::Type::type::INT32, false, 50,
+                                                       [](int row) { return row; }, &column_indexes[2],
+                                                       &offset_indexes[2]));
+    int64_t total_byte_size = file.size() - 4;
+
+    // the page index follows the column chunks
+    for (size_t i = 0; i < column_chunks.size(); i++) {
+        std::string buffer = serialize_thrift_msg(&column_indexes[i]);
+        column_chunks[i].__set_column_index_offset(file.size());
+        column_chunks[i].__set_column_index_length(buffer.size());
+        file.append(buffer);
+    }
+    for (size_t i = 0; i < column_chunks.size(); i++) {
+        std::string buffer = serialize_thrift_msg(&offset_indexes[i]);
+        column_chunks[i].__set_offset_index_offset(file.size());
+        column_chunks[i].__set_offset_index_length(buffer.size());
+        file.append(buffer);
+    }
+
+    std::vector<tparquet::SchemaElement> schema(4);
+    schema[0].__set_name("schema");
+    schema[0].__set_num_children(3);
+    schema[1].__set_name("c1");
+    schema[1].__set_type(tparquet::Type::type::INT32);
+    schema[1].__set_repetition_type(tparquet::FieldRepetitionType::REQUIRED);
+    schema[2].__set_name("c2");
+    schema[2].__set_type(tparquet::Type::type::INT64);
+    schema[2].__set_repetition_type(tparquet::FieldRepetitionType::OPTIONAL);
+    schema[3].__set_name("c3");
+    schema[3].__set_type(tparquet::Type::type::INT32);
+    schema[3].__set_repetition_type(tparquet::FieldRepetitionType::REQUIRED);
+
+    tparquet::RowGroup row_group;
+    row_group.__set_columns(column_chunks);
+    row_group.__set_total_byte_size(total_byte_size);
+    row_group.__set_num_rows(kPageIndexRows);
+    row_group.__set_file_offset(4);
+
+    tparquet::FileMetaData file_metadata;
+    file_metadata.__set_version(1);
+    file_metadata.__set_schema(schema);
+    file_metadata.__set_num_rows(kPageIndexRows);
+    file_metadata.__set_row_groups({row_group});
+
+    std::string footer = serialize_thrift_msg(&file_metadata);
+    file.append(footer);
+    append_plain<uint32_t>(&file, footer.size());
+    file.append("PAR1");
+    return file;
+}
+
 // TODO: min/max conjunct
 class FileReaderTest : public testing::Test {
 public:
@@ -49,6 +240,12 @@ private:
     void _create_conjunct_ctxs_for_min_max(std::vector<ExprContext*>* conjunct_ctxs);
     void _create_conjunct_ctxs_for_filter_file(std::vector<ExprContext*>* conjunct_ctxs);
     void _create_conjunct_ctxs_for_dict_filter(std::vector<ExprContext*>* conjunct_ctxs);
+    void _create_int_conjunct_ctxs(TExprOpcode::type opcode, SlotId slot_id, int value,
+                                   std::vector<ExprContext*>* conjunct_ctxs);
+
+    HdfsFileReaderParam* _create_param_for_page_index(uint64_t file_size);
+    static vectorized::ChunkPtr _create_chunk_for_page_index();
+    std::vector<std::string> _read_page_index_file(const std::string& file_content);
 
     // c1      c2      c3       c4
     // -------------------------------------------
@@ -216,6 +413,53 @@ void FileReaderTest::_create_conjunct_ctxs_for_dict_filter(std::vector<ExprConte
     Expr::create_expr_trees(&_pool, t_conjuncts, conjunct_ctxs);
 }
 
+void FileReaderTest::_create_int_conjunct_ctxs(TExprOpcode::type opcode, SlotId slot_id, int value,
+                                               std::vector<ExprContext*>* conjunct_ctxs) {
+    std::vector<TExprNode> nodes;
+
+    TExprNode node0;
+    node0.node_type = TExprNodeType::BINARY_PRED;
+    node0.opcode = opcode;
+    node0.child_type = TPrimitiveType::INT;
+    node0.num_children = 2;
+    node0.__isset.opcode = true;
+    node0.__isset.child_type = true;
+    node0.type = gen_type_desc(TPrimitiveType::BOOLEAN);
+    node0.use_vectorized = true;
+    nodes.emplace_back(node0);
+
+    TExprNode node1;
+    node1.node_type = TExprNodeType::SLOT_REF;
+    node1.type = gen_type_desc(TPrimitiveType::INT);
+    node1.num_children = 0;
+    TSlotRef t_slot_ref = TSlotRef();
+    t_slot_ref.slot_id = slot_id;
+    t_slot_ref.tuple_id = 0;
+    node1.__set_slot_ref(t_slot_ref);
+    node1.use_vectorized = true;
+    node1.is_nullable = true;
+    nodes.emplace_back(node1);
+
+    TExprNode node2;
+    node2.node_type = TExprNodeType::INT_LITERAL;
+    node2.type = gen_type_desc(TPrimitiveType::INT);
+    node2.num_children = 0;
+    TIntLiteral int_literal;
+    int_literal.value = value;
+    node2.__set_int_literal(int_literal);
+    node2.use_vectorized = true;
+    node2.is_nullable = false;
+    nodes.emplace_back(node2);
+
+    TExpr t_expr;
+    t_expr.nodes = nodes;
+
+    std::vector<TExpr> t_conjuncts;
+    t_conjuncts.emplace_back(t_expr);
+
+    Expr::create_expr_trees(&_pool, t_conjuncts, conjunct_ctxs);
+}
+
 std::unique_ptr<RandomAccessFile> FileReaderTest::_create_file(const std::string& file_path) {
     auto* env = Env::Default();
     std::unique_ptr<RandomAccessFile> file;
@@ -480,6 +724,92 @@ HdfsFileReaderParam* FileReaderTest::_create_param_for_dict_filter() {
     return param;
 }
 
+HdfsFileReaderParam* FileReaderTest::_create_param_for_page_index(uint64_t file_size) {
+    auto* param = _pool.add(new HdfsFileReaderParam());
+
+    // tuple desc
+    TDescriptorTableBuilder table_desc_builder;
+    TSlotDescriptorBuilder slot_desc_builder;
+    auto slot1 = slot_desc_builder.type(PrimitiveType::TYPE_INT)
+                         .column_name("c1")
+                         .column_pos(0)
+                         .nullable(true)
+                         .id(0)
+                         .build();
+    auto slot2 = slot_desc_builder.type(PrimitiveType::TYPE_BIGINT)
+                         .column_name("c2")
+                         .column_pos(1)
+                         .nullable(true)
+                         .id(1)
+                         .build();
+    auto slot3 = slot_desc_builder.type(PrimitiveType::TYPE_INT)
+                         .column_name("c3")
+                         .column_pos(2)
+                         .nullable(true)
+                         .id(2)
+                         .build();
+    TTupleDescriptorBuilder tuple_desc_builder;
+    tuple_desc_builder.add_slot(slot1);
+    tuple_desc_builder.add_slot(slot2);
+    tuple_desc_builder.add_slot(slot3);
+    tuple_desc_builder.build(&table_desc_builder);
+    DescriptorTbl* tbl = nullptr;
+    DescriptorTbl::create(&_pool, table_desc_builder.desc_tbl(), &tbl);
+    param->tuple_desc = tbl->get_tuple_descriptor(0);
+
+    // materialized columns
+    HdfsFileReaderParam::ColumnInfo c1;
+    c1.col_name = "c1";
+    c1.col_idx = 0;
+    c1.col_type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    c1.slot_id = 0;
+
+    HdfsFileReaderParam::ColumnInfo c2;
+    c2.col_name = "c2";
+    c2.col_idx = 1;
+    c2.col_type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_BIGINT);
+    c2.slot_id = 1;
+
+    HdfsFileReaderParam::ColumnInfo c3;
+    c3.col_name = "c3";
+    c3.col_idx = 2;
+    c3.col_type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    c3.slot_id = 2;
+
+    param->materialized_columns.emplace_back(c1);
+    param->materialized_columns.emplace_back(c2);
+    param->materialized_columns.emplace_back(c3);
+
+    // scan range
+    auto* scan_range = _pool.add(new THdfsScanRange());
+    scan_range->relative_path = "page_index.parquet";
+    scan_range->offset = 4;
+    scan_range->length = file_size;
+    scan_range->file_length = file_size;
+    param->scan_ranges.emplace_back(scan_range);
+
+    // min max tuple desc
+    TDescriptorTableBuilder min_max_table_desc_builder;
+    TTupleDescriptorBuilder min_max_tuple_desc_builder;
+    min_max_tuple_desc_builder.add_slot(slot1);
+    min_max_tuple_desc_builder.build(&min_max_table_desc_builder);
+    DescriptorTbl* min_max_tbl = nullptr;
+    DescriptorTbl::create(&_pool, min_max_table_desc_builder.desc_tbl(), &min_max_tbl);
+    param->min_max_tuple_desc = min_max_tbl->get_tuple_descriptor(0);
+
+    // c1 >= 250 and c1 <= 740, for both the page index and the rows
+    _create_int_conjunct_ctxs(TExprOpcode::GE, 0, 250, &param->min_max_conjunct_ctxs);
+    _create_int_conjunct_ctxs(TExprOpcode::LE, 0, 740, &param->min_max_conjunct_ctxs);
+    param->conjunct_ctxs_by_slot[0] = std::vector<ExprContext*>();
+    _create_int_conjunct_ctxs(TExprOpcode::GE, 0, 250, &param->conjunct_ctxs_by_slot[0]);
+    _create_int_conjunct_ctxs(TExprOpcode::LE, 0, 740, &param->conjunct_ctxs_by_slot[0]);
+
+    param->timezone = "Asia/Shanghai";
+    param->stats = &g_hdfs_scan_stats;
+
+    return param;
+}
+
 THdfsScanRange* FileReaderTest::_create_scan_range() {
     auto* scan_range = _pool.add(new THdfsScanRange());
 
@@ -525,6 +855,39 @@ vectorized::ChunkPtr FileReaderTest::_create_chunk_for_not_exist() {
     return chunk;
 }
 
+vectorized::ChunkPtr FileReaderTest::_create_chunk_for_page_index() {
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    auto c1 =
+            vectorized::ColumnHelper::create_column(TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT), true);
+    auto c2 = vectorized::ColumnHelper::create_column(TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_BIGINT),
+                                                      true);
+    auto c3 =
+            vectorized::ColumnHelper::create_column(TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT), true);
+    chunk->append_column(c1, 0);
+    chunk->append_column(c2, 1);
+    chunk->append_column(c3, 2);
+    return chunk;
+}
+
+std::vector<std::string> FileReaderTest::_read_page_index_file(const std::string& file_content) {
+    StringRandomAccessFile file(file_content);
+    auto file_reader = std::make_shared<FileReader>(&file, file_content.size());
+    auto* param = _create_param_for_page_index(file_content.size());
+    Status status = file_reader->init(*param);
+    EXPECT_TRUE(status.ok()) << status.to_string();
+
+    std::vector<std::string> rows;
+    while (status.ok()) {
+        auto chunk = _create_chunk_for_page_index();
+        status = file_reader->get_next(&chunk);
+        EXPECT_TRUE(status.ok() || status.is_end_of_file()) << status.to_string();
+        for (size_t i = 0; status.ok() && i < chunk->num_rows(); i++) {
+            rows.emplace_back(chunk->debug_row(i));
+        }
+    }
+    return rows;
+}
+
 TEST_F(FileReaderTest, TestInit) {
     // create file
     auto file = _create_file(_file_path);
@@ -678,4 +1041,42 @@ TEST_F(FileReaderTest, TestGetNextDictFilter) {
     ASSERT_TRUE(status.is_end_of_file());
 }
 
+TEST_F(FileReaderTest, TestPageIndexAndLazyColumns) {
+    std::string file_content = write_page_index_file();
+    int32_t vector_chunk_size = config::vector_chunk_size;
+    bool page_index_enable = config::parquet_page_index_enable;
+    bool late_materialization_enable = config::parquet_late_materialization_enable;
+    // the batches cross the pages of the columns
+    config::vector_chunk_size = 128;
+
+    // c2 and c3 are read lazily, skipping the rows and the pages of the rows filtered by c1
+    config::parquet_page_index_enable = true;
+    config::parquet_late_materialization_enable = true;
+    int64_t filtered_rows = g_hdfs_scan_stats.page_index_filtered_rows;
+    std::vector<std::string> rows = _read_page_index_file(file_content);
+    filtered_rows = g_hdfs_scan_stats.page_index_filtered_rows - filtered_rows;
+
+    config::parquet_page_index_enable = false;
+    config::parquet_late_materialization_enable = false;
+    std::vector<std::string> all_read_rows = _read_page_index_file(file_content);
+
+    config::vector_chunk_size = vector_chunk_size;
+    config::parquet_page_index_enable = page_index_enable;
+    config::parquet_late_materialization_enable = late_materialization_enable;
+
+    // the pages of c1 of the rows [0, 200) and [800, 1000) are filtered by the page index
+    ASSERT_EQ(400, filtered_rows);
+    ASSERT_EQ(all_read_rows, rows);
+
+    std::vector<std::string> expected_rows;
+    for (int row = 0; row < kPageIndexRows; row++) {
+        int32_t c1 = page_index_c1(row);
+        if (c1 >= 250 && c1 <= 740) {
+            std::string c2 = page_index_c2_is_null(row) ? "NULL" : std::to_string(row * 10L);
+            expected_rows.emplace_back(strings::Substitute("[$0, $1, $2]", c1, c2, row));
+        }
+    }
+    ASSERT_EQ(expected_rows, rows);
+}
+
 } // namespace starrocks::parquet
@@ -4,10 +4,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "env/env.h"
+#include "exprs/expr_context.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/descriptor_helper.h"
 
 namespace starrocks::parquet {
@@ -116,6 +120,49 @@ private:
     tparquet::Type::type _type = tparquet::Type::type::INT32;
 };
 
+// Column reader of a row group of |num_rows| rows that can skip rows, the value of a row
+// is the row number for INT32 and ten times of it for INT64.
+class MockSkipColumnReader : public ColumnReader {
+public:
+    MockSkipColumnReader(tparquet::Type::type type, size_t num_rows) : _type(type), _num_rows(num_rows) {}
+    ~MockSkipColumnReader() override = default;
+
+    Status prepare_batch(size_t* num_records, ColumnContentType content_type, vectorized::Column* column) override {
+        size_t num_rows = std::min(*num_records, _num_rows - _next_row);
+        for (size_t i = _next_row; i < _next_row + num_rows; i++) {
+            if (_type == tparquet::Type::type::INT32) {
+                column->append_datum(static_cast<int32_t>(i));
+            } else {
+                column->append_datum(static_cast<int64_t>(i * 10));
+            }
+        }
+        _next_row += num_rows;
+        _num_rows_read += num_rows;
+        *num_records = num_rows;
+        return Status::OK();
+    }
+
+    Status finish_batch() override { return Status::OK(); }
+
+    Status skip_records(size_t num_records) override {
+        if (_next_row + num_records > _num_rows) {
+            return Status::InternalError("skip out of the row group");
+        }
+        _next_row += num_records;
+        return Status::OK();
+    }
+
+    void get_levels(int16_t** def_levels, int16_t** rep_levels, size_t* num_levels) override {}
+
+    size_t num_rows_read() const { return _num_rows_read; }
+
+private:
+    tparquet::Type::type _type;
+    size_t _num_rows;
+    size_t _next_row = 0;
+    size_t _num_rows_read = 0;
+};
+
 class GroupReaderTest : public ::testing::Test {
 protected:
     void SetUp() override {}
@@ -130,6 +177,10 @@ private:
     tparquet::SchemaElement* _create_schema_element(const std::string& col_name, tparquet::Type::type type);
     Status _create_filemeta(FileMetaData** file_meta, GroupReaderParam* param);
     GroupReaderParam* _create_group_reader_param();
+    GroupReaderParam* _create_lazy_group_reader_param();
+    void _create_int_conjunct_ctxs(TExprOpcode::type opcode, SlotId slot_id, int value,
+                                   std::vector<ExprContext*>* conjunct_ctxs);
+    std::vector<std::string> _read_lazy_group(bool late_materialization, size_t* lazy_rows_read);
     static vectorized::ChunkPtr _create_chunk(GroupReaderParam* param);
 
     static void _check_int32_column(vectorized::Column* column, size_t start, size_t count);
@@ -411,4 +462,161 @@ TEST_F(GroupReaderTest, TestGetNext) {
     _check_chunk(param, chunk, 8, 4);
 }
 
+void GroupReaderTest::_create_int_conjunct_ctxs(TExprOpcode::type opcode, SlotId slot_id, int value,
+                                                std::vector<ExprContext*>* conjunct_ctxs) {
+    std::vector<TExprNode> nodes;
+
+    TExprNode node0;
+    node0.node_type = TExprNodeType::BINARY_PRED;
+    node0.opcode = opcode;
+    node0.child_type = TPrimitiveType::INT;
+    node0.num_children = 2;
+    node0.__isset.opcode = true;
+    node0.__isset.child_type = true;
+    node0.type = gen_type_desc(TPrimitiveType::BOOLEAN);
+    node0.use_vectorized = true;
+    nodes.emplace_back(node0);
+
+    TExprNode node1;
+    node1.node_type = TExprNodeType::SLOT_REF;
+    node1.type = gen_type_desc(TPrimitiveType::INT);
+    node1.num_children = 0;
+    TSlotRef t_slot_ref = TSlotRef();
+    t_slot_ref.slot_id = slot_id;
+    t_slot_ref.tuple_id = 0;
+    node1.__set_slot_ref(t_slot_ref);
+    node1.use_vectorized = true;
+    node1.is_nullable = true;
+    nodes.emplace_back(node1);
+
+    TExprNode node2;
+    node2.node_type = TExprNodeType::INT_LITERAL;
+    node2.type = gen_type_desc(TPrimitiveType::INT);
+    node2.num_children = 0;
+    TIntLiteral int_literal;
+    int_literal.value = value;
+    node2.__set_int_literal(int_literal);
+    node2.use_vectorized = true;
+    node2.is_nullable = false;
+    nodes.emplace_back(node2);
+
+    TExpr t_expr;
+    t_expr.nodes = nodes;
+
+    std::vector<TExpr> t_conjuncts;
+    t_conjuncts.emplace_back(t_expr);
+
+    Expr::create_expr_trees(&_pool, t_conjuncts, conjunct_ctxs);
+}
+
+// c0 int, c1 bigint and c2 int of the rows [1, 5) and [7, 12), filtered by c0 != 1, c0 != 4 and c0 != 10.
+GroupReaderParam* GroupReaderTest::_create_lazy_group_reader_param() {
+    auto* param = _pool.add(new GroupReaderParam());
+    param->read_cols.emplace_back(
+            _create_group_reader_param_of_column(0, tparquet::Type::type::INT32, PrimitiveType::TYPE_INT));
+    param->read_cols.emplace_back(
+            _create_group_reader_param_of_column(1, tparquet::Type::type::INT64, PrimitiveType::TYPE_BIGINT));
+    param->read_cols.emplace_back(
+            _create_group_reader_param_of_column(2, tparquet::Type::type::INT32, PrimitiveType::TYPE_INT));
+
+    TDescriptorTableBuilder table_desc_builder;
+    TSlotDescriptorBuilder slot_desc_builder;
+    TTupleDescriptorBuilder tuple_desc_builder;
+    tuple_desc_builder.add_slot(slot_desc_builder.type(PrimitiveType::TYPE_INT)
+                                        .column_name("c0")
+                                        .column_pos(0)
+                                        .nullable(true)
+                                        .id(0)
+                                        .build());
+    tuple_desc_builder.add_slot(slot_desc_builder.type(PrimitiveType::TYPE_BIGINT)
+                                        .column_name("c1")
+                                        .column_pos(1)
+                                        .nullable(true)
+                                        .id(1)
+                                        .build());
+    tuple_desc_builder.add_slot(slot_desc_builder.type(PrimitiveType::TYPE_INT)
+                                        .column_name("c2")
+                                        .column_pos(2)
+                                        .nullable(true)
+                                        .id(2)
+                                        .build());
+    tuple_desc_builder.build(&table_desc_builder);
+    DescriptorTbl* tbl = nullptr;
+    DescriptorTbl::create(&_pool, table_desc_builder.desc_tbl(), &tbl);
+    param->tuple_desc = tbl->get_tuple_descriptor(0);
+
+    std::vector<ExprContext*>& conjunct_ctxs = param->conjunct_ctxs_by_slot[0];
+    _create_int_conjunct_ctxs(TExprOpcode::NE, 0, 1, &conjunct_ctxs);
+    _create_int_conjunct_ctxs(TExprOpcode::NE, 0, 4, &conjunct_ctxs);
+    _create_int_conjunct_ctxs(TExprOpcode::NE, 0, 10, &conjunct_ctxs);
+
+    param->row_ranges.add(vectorized::Range(1, 5));
+    param->row_ranges.add(vectorized::Range(7, 12));
+    param->stats = &g_hdfs_scan_stats;
+    return param;
+}
+
+// Read the row group of _create_lazy_group_reader_param() in batches of 6 rows.
+std::vector<std::string> GroupReaderTest::_read_lazy_group(bool late_materialization, size_t* lazy_rows_read) {
+    bool late_materialization_enable = config::parquet_late_materialization_enable;
+    config::parquet_late_materialization_enable = late_materialization;
+
+    auto* file = _create_file();
+    auto* param = _create_lazy_group_reader_param();
+    FileMetaData* file_meta;
+    Status status = _create_filemeta(&file_meta, param);
+    EXPECT_TRUE(status.ok());
+    auto* group_reader = _pool.add(new GroupReader(file, file_meta, 0));
+    status = group_reader->init(*param);
+    EXPECT_TRUE(status.is_end_of_file());
+
+    // init the group reader with the mock column readers
+    std::vector<MockSkipColumnReader*> column_readers;
+    group_reader->_column_readers.clear();
+    for (const auto& column : param->read_cols) {
+        auto r = std::make_unique<MockSkipColumnReader>(column.col_type_in_parquet, 12);
+        column_readers.emplace_back(r.get());
+        group_reader->_column_readers[column.slot_id] = std::move(r);
+    }
+    group_reader->_pre_process_columns_and_conjunct_ctxs();
+    group_reader->_init_read_chunk();
+    EXPECT_EQ(late_materialization ? 2 : 0, group_reader->_lazy_read_columns.size());
+
+    std::vector<std::string> rows;
+    do {
+        auto chunk = _create_chunk(param);
+        size_t row_count = 6;
+        status = group_reader->get_next(&chunk, &row_count);
+        EXPECT_TRUE(status.ok() || status.is_end_of_file()) << status.to_string();
+        EXPECT_EQ(row_count, chunk->num_rows());
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            rows.emplace_back(chunk->debug_row(i));
+        }
+    } while (status.ok());
+
+    *lazy_rows_read = column_readers[1]->num_rows_read();
+    EXPECT_EQ(*lazy_rows_read, column_readers[2]->num_rows_read());
+    config::parquet_late_materialization_enable = late_materialization_enable;
+    return rows;
+}
+
+TEST_F(GroupReaderTest, TestLazyReadColumns) {
+    size_t lazy_rows_read = 0;
+    std::vector<std::string> rows = _read_lazy_group(true, &lazy_rows_read);
+    // the first batch reads the rows [1, 5) and [7, 9), of which the rows 1 and 4 are filtered,
+    // and the second batch reads the rows [9, 12), of which the row 10 is filtered.
+    std::vector<std::string> expected_rows;
+    for (int64_t row : {2, 3, 7, 8, 9, 11}) {
+        expected_rows.emplace_back(strings::Substitute("[$0, $1, $2]", row, row * 10, row));
+    }
+    ASSERT_EQ(expected_rows, rows);
+    // the lazy columns read from the first to the last selected row of each range only,
+    // i.e. [2, 4), [7, 9) and [9, 12).
+    ASSERT_EQ(7, lazy_rows_read);
+
+    size_t rows_read = 0;
+    ASSERT_EQ(rows, _read_lazy_group(false, &rows_read));
+    ASSERT_EQ(9, rows_read);
+}
+
 } // namespace starrocks::parquet
@@ -0,0 +1,241 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "common/config.h"
+#include "exec/pipeline/pipeline_driver_dispatcher.h"
+#include "service/brpc.h"
+
+namespace starrocks::pipeline {
+
+// Keeps the transmit_chunk RPCs in flight until the test finishes them.
+class MockBackendService : public PBackendService_Stub {
+public:
+    MockBackendService() : PBackendService_Stub(nullptr) {}
+
+    void transmit_chunk(google::protobuf::RpcController* controller, const PTransmitChunkParams* request,
+                        PTransmitChunkResult* response, google::protobuf::Closure* done) override {
+        std::lock_guard<std::mutex> l(_mutex);
+        _rpcs.push_back({*request, static_cast<brpc::Controller*>(controller), response, done});
+    }
+
+    size_t num_rpcs() {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _rpcs.size();
+    }
+
+    PTransmitChunkParams params(size_t i) {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _rpcs[i].params;
+    }
+
+    // Reply to the |i|th RPC with |status|, or fail it in brpc if |rpc_failed|. The sink
+    // buffer may send its next RPC from there.
+    void finish(size_t i, const Status& status = Status::OK(), bool rpc_failed = false) {
+        Rpc rpc;
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            rpc = _rpcs[i];
+        }
+        if (rpc_failed) {
+            rpc.cntl->SetFailed("connection refused");
+        } else {
+            status.to_protobuf(rpc.response->mutable_status());
+        }
+        rpc.done->Run();
+    }
+
+private:
+    struct Rpc {
+        PTransmitChunkParams params;
+        brpc::Controller* cntl = nullptr;
+        PTransmitChunkResult* response = nullptr;
+        google::protobuf::Closure* done = nullptr;
+    };
+
+    std::mutex _mutex;
+    std::vector<Rpc> _rpcs;
+};
+
+class CountingDispatcher : public DriverDispatcher {
+public:
+    void notify_blocked_drivers() override { num_notifications++; }
+    void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean) override {}
+
+    std::atomic<int> num_notifications{0};
+};
+
+class SinkBufferTest : public testing::Test {
+public:
+    void SetUp() override { _bytes_per_destination = config::pipeline_sink_buffer_bytes_per_destination; }
+
+    void TearDown() override { config::pipeline_sink_buffer_bytes_per_destination = _bytes_per_destination; }
+
+    static PUniqueId instance_id(int64_t lo) {
+        PUniqueId id;
+        id.set_hi(1);
+        id.set_lo(lo);
+        return id;
+    }
+
+    // A request to the fragment instance |dest| carrying one chunk of |bytes| bytes, or none if 0.
+    TransmitChunkInfo make_request(int64_t dest, size_t bytes, bool eos = false) {
+        TransmitChunkInfo request;
+        *request.params.mutable_finst_id() = instance_id(dest);
+        request.params.set_eos(eos);
+        if (bytes > 0) {
+            request.params.add_chunks()->set_data(std::string(bytes, 'x'));
+        }
+        request.brpc_stub = &_stub;
+        return request;
+    }
+
+    // The sequences of the RPCs sent to every destination, in the order they were sent.
+    std::map<int64_t, std::vector<int64_t>> sent_sequences() {
+        std::map<int64_t, std::vector<int64_t>> sequences;
+        for (size_t i = 0; i < _stub.num_rpcs(); i++) {
+            auto params = _stub.params(i);
+            sequences[params.finst_id().lo()].push_back(params.sequence());
+        }
+        return sequences;
+    }
+
+protected:
+    int64_t _bytes_per_destination = 0;
+    MockBackendService _stub;
+    CountingDispatcher _dispatcher;
+};
+
+TEST_F(SinkBufferTest, one_rpc_in_flight_per_destination) {
+    SinkBuffer buffer(&_dispatcher);
+    buffer.register_sinker(instance_id(1));
+    buffer.register_sinker(instance_id(2));
+
+    for (int i = 0; i < 3; i++) {
+        buffer.add_request(make_request(1, 8));
+    }
+    for (int i = 0; i < 2; i++) {
+        buffer.add_request(make_request(2, 8));
+    }
+    // the others wait for the first RPC of their destination
+    ASSERT_EQ(2, _stub.num_rpcs());
+    ASSERT_EQ(1, _stub.params(0).finst_id().lo());
+    ASSERT_EQ(2, _stub.params(1).finst_id().lo());
+
+    // the next request of a destination is sent once its previous one is acknowledged
+    _stub.finish(0);
+    ASSERT_EQ(3, _stub.num_rpcs());
+    ASSERT_EQ(1, _stub.params(2).finst_id().lo());
+    ASSERT_EQ(1, _dispatcher.num_notifications);
+
+    buffer.add_request(make_request(2, 0, true));
+    _stub.finish(1);
+    _stub.finish(2);
+    ASSERT_EQ(5, _stub.num_rpcs());
+    _stub.finish(3);
+    ASSERT_EQ(6, _stub.num_rpcs());
+    ASSERT_TRUE(_stub.params(5).eos());
+    ASSERT_FALSE(buffer.is_finished());
+    _stub.finish(4);
+    _stub.finish(5);
+    ASSERT_EQ(6, _stub.num_rpcs());
+    ASSERT_TRUE(buffer.is_finished());
+    ASSERT_FALSE(buffer.is_cancelled());
+    ASSERT_EQ(6, _dispatcher.num_notifications);
+
+    // the receiver drops the packets whose sequence doesn't follow the previous one
+    auto sequences = sent_sequences();
+    ASSERT_EQ((std::vector<int64_t>{0, 1, 2}), sequences[1]);
+    ASSERT_EQ((std::vector<int64_t>{0, 1, 2}), sequences[2]);
+}
+
+TEST_F(SinkBufferTest, full_destination) {
+    config::pipeline_sink_buffer_bytes_per_destination = 10;
+    SinkBuffer buffer(&_dispatcher);
+    buffer.register_sinker(instance_id(1));
+    buffer.register_sinker(instance_id(2));
+
+    // the request in flight is not queued any more
+    buffer.add_request(make_request(1, 8));
+    ASSERT_FALSE(buffer.is_full(instance_id(1)));
+    buffer.add_request(make_request(1, 8));
+    ASSERT_FALSE(buffer.is_full(instance_id(1)));
+    buffer.add_request(make_request(1, 8));
+    ASSERT_TRUE(buffer.is_full(instance_id(1)));
+    // the other destinations are not blocked
+    ASSERT_FALSE(buffer.is_full(instance_id(2)));
+    ASSERT_FALSE(buffer.is_full(instance_id(3)));
+
+    _stub.finish(0);
+    ASSERT_FALSE(buffer.is_full(instance_id(1)));
+    _stub.finish(1);
+    _stub.finish(2);
+    ASSERT_TRUE(buffer.is_finished());
+}
+
+TEST_F(SinkBufferTest, eos_of_the_last_sinker) {
+    SinkBuffer buffer(&_dispatcher);
+    buffer.register_sinker(instance_id(1));
+    buffer.register_sinker(instance_id(1));
+
+    // the chunks of the first sinker are sent without its eos
+    buffer.add_request(make_request(1, 8, true));
+    ASSERT_EQ(1, _stub.num_rpcs());
+    ASSERT_FALSE(_stub.params(0).eos());
+    ASSERT_EQ(1, _stub.params(0).chunks_size());
+
+    buffer.add_request(make_request(1, 0, true));
+    _stub.finish(0);
+    ASSERT_EQ(2, _stub.num_rpcs());
+    ASSERT_TRUE(_stub.params(1).eos());
+    _stub.finish(1);
+    ASSERT_TRUE(buffer.is_finished());
+
+    // an empty eos that is not the last one is not sent at all
+    SinkBuffer buffer2(&_dispatcher);
+    buffer2.register_sinker(instance_id(1));
+    buffer2.register_sinker(instance_id(1));
+    buffer2.add_request(make_request(1, 0, true));
+    ASSERT_EQ(2, _stub.num_rpcs());
+    ASSERT_TRUE(buffer2.is_finished());
+}
+
+TEST_F(SinkBufferTest, error_status_cancels) {
+    SinkBuffer buffer(&_dispatcher);
+    buffer.register_sinker(instance_id(1));
+    buffer.register_sinker(instance_id(2));
+    buffer.add_request(make_request(1, 8));
+    buffer.add_request(make_request(1, 8));
+    buffer.add_request(make_request(2, 8));
+    ASSERT_EQ(2, _stub.num_rpcs());
+
+    _stub.finish(0, Status::InternalError("receiver is gone"));
+    ASSERT_TRUE(buffer.is_cancelled());
+    // the sink operators stop waiting for the buffer
+    ASSERT_TRUE(buffer.is_finished());
+    ASSERT_EQ(1, _dispatcher.num_notifications);
+
+    // nothing is sent any more, to any destination
+    buffer.add_request(make_request(2, 8));
+    _stub.finish(1);
+    ASSERT_EQ(2, _stub.num_rpcs());
+}
+
+TEST_F(SinkBufferTest, rpc_failure_cancels) {
+    SinkBuffer buffer(&_dispatcher);
+    buffer.register_sinker(instance_id(1));
+    buffer.add_request(make_request(1, 8));
+    buffer.add_request(make_request(1, 8));
+
+    _stub.finish(0, Status::OK(), true);
+    ASSERT_TRUE(buffer.is_cancelled());
+    ASSERT_TRUE(buffer.is_finished());
+    ASSERT_EQ(1, _stub.num_rpcs());
+}
+
+} // namespace starrocks::pipeline
@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "common/config.h"
 #include "gen_cpp/HeartbeatService_types.h"
 #include "gen_cpp/internal_service.pb.h"
@@ -702,5 +704,33 @@ TEST_F(OlapTableSinkTest, decimal) {
     // ASSERT_TRUE(output_set.count("[(14 999.99)]") > 0);
 }
 
+TEST_F(OlapTableSinkTest, single_replica_commit_infos) {
+    // the primary replica on node 1 reports the secondary replicas of tablet 10 on node 2 and 3,
+    // the one on node 4 failed to add the segments
+    PTabletWriterAddBatchResult result;
+    for (int64_t tablet_id : {10, 11}) {
+        PTabletInfo* tablet = result.add_tablet_vec();
+        tablet->set_tablet_id(tablet_id);
+        tablet->set_schema_hash(1234);
+    }
+    for (int64_t node_id : {2, 3}) {
+        PTabletInfo* tablet = result.add_tablet_vec();
+        tablet->set_tablet_id(10);
+        tablet->set_schema_hash(1234);
+        tablet->set_node_id(node_id);
+    }
+
+    NodeChannel channel(nullptr, 1, 1, 1234);
+    channel._add_tablet_commit_infos(result.tablet_vec());
+
+    std::set<std::pair<int64_t, int64_t>> commit_infos;
+    for (const auto& commit_info : channel._tablet_commit_infos) {
+        commit_infos.emplace(commit_info.tabletId, commit_info.backendId);
+    }
+    std::set<std::pair<int64_t, int64_t>> expected{{10, 1}, {10, 2}, {10, 3}, {11, 1}};
+    ASSERT_EQ(4, channel._tablet_commit_infos.size());
+    ASSERT_EQ(expected, commit_infos);
+}
+
 } // namespace stream_load
 } // namespace starrocks
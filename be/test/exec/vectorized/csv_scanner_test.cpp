@@ -13,7 +13,13 @@
 #include "gen_cpp/Descriptors_types.h"
 #include "runtime/descriptor_helper.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mock_kafka_consumer.h"
+#include "runtime/routine_load/kafka_consumer_pipe.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 
 namespace starrocks::vectorized {
 
@@ -23,7 +29,8 @@ protected:
     void TearDown() override {}
 
     std::unique_ptr<CSVScanner> create_csv_scanner(const std::vector<TypeDescriptor>& types,
-                                                   const std::vector<TBrokerRangeDesc>& ranges) {
+                                                   const std::vector<TBrokerRangeDesc>& ranges,
+                                                   ExecEnv* exec_env = nullptr) {
         /// Init DescriptorTable
         TDescriptorTableBuilder desc_tbl_builder;
         TTupleDescriptorBuilder tuple_desc_builder;
@@ -39,7 +46,7 @@ protected:
         CHECK(st.ok()) << st.to_string();
 
         /// Init RuntimeState
-        RuntimeState* state = _obj_pool.add(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr));
+        RuntimeState* state = _obj_pool.add(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), exec_env));
         state->set_desc_tbl(desc_tbl);
         state->init_instance_mem_tracker();
 
@@ -602,4 +609,114 @@ TEST_F(CSVScannerTest, test_empty) {
     run_test(TYPE_DATETIME);
 }
 
+TEST_F(CSVScannerTest, test_parse_in_parallel) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_BIGINT)};
+
+    // every 1000th record has an invalid field and is filtered out in strict mode.
+    const std::string path = "./csv_scanner_test_parse_in_parallel.csv";
+    const int num_records = config::vector_chunk_size * 3 + 10;
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < num_records; i++) {
+            if (i % 1000 == 999) {
+                out << "x|" << i << '\n';
+            } else {
+                out << i << '|' << i * 2L << '\n';
+            }
+        }
+    }
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.__set_path(path);
+    range.__set_start_offset(0);
+    range.__set_num_of_columns_from_file(types.size());
+    ranges.push_back(range);
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("csv_parse_test").set_max_threads(4).build(&pool).ok());
+
+    auto scanner = create_csv_scanner(types, ranges);
+    ASSERT_TRUE(scanner->open().ok());
+    scanner->_parse_token = pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+
+    int expect = 0;
+    int num_rows = 0;
+    while (true) {
+        auto res = scanner->get_next();
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        ChunkPtr chunk = res.value();
+        for (int row = 0; row < chunk->num_rows(); row++, expect++) {
+            if (expect % 1000 == 999) {
+                expect++;
+            }
+            ASSERT_EQ(expect, chunk->get(row)[0].get_int32());
+            ASSERT_EQ(expect * 2L, chunk->get(row)[1].get_int64());
+        }
+        num_rows += chunk->num_rows();
+    }
+    scanner->close();
+    EXPECT_EQ(num_records - num_records / 1000, num_rows);
+    EXPECT_EQ(num_records / 1000, scanner->_counter->num_rows_filtered);
+    std::remove(path.c_str());
+}
+
+TEST_F(CSVScannerTest, test_kafka_msgs) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_BIGINT)};
+
+    ExecEnv env;
+    env._load_stream_mgr = new LoadStreamMgr();
+    auto pipe = std::make_shared<KafkaConsumerPipe>();
+    UniqueId load_id = UniqueId::gen_uid();
+    ASSERT_TRUE(env.load_stream_mgr()->put(load_id, pipe).ok());
+
+    // the msgs of the partitions are interleaved, and the invalid one is filtered out in strict mode
+    std::map<int32_t, int64_t> next_offsets;
+    ASSERT_TRUE(pipe->append_batch_with_row_delimiter(
+                            make_kafka_batch({0, 1, 0, 1}, {"1|10", "2|20", "x|30", "4|40"}, &next_offsets), '\n')
+                        .ok());
+    ASSERT_TRUE(pipe->append_batch_with_row_delimiter(make_kafka_batch({1}, {"5|50"}, &next_offsets), '\n').ok());
+    ASSERT_TRUE(pipe->finish().ok());
+
+    auto metrics = StarRocksMetrics::instance()->routine_load_partition_metrics("test_topic", 0);
+    int64_t filtered_rows = metrics->filtered_rows.value();
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.__set_file_type(TFileType::FILE_STREAM);
+    range.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+    range.__set_load_id(load_id.to_thrift());
+    range.__set_start_offset(0);
+    range.__set_num_of_columns_from_file(types.size());
+    ranges.push_back(range);
+
+    auto scanner = create_csv_scanner(types, ranges, &env);
+    ASSERT_TRUE(scanner->open().ok());
+
+    // the msgs of a batch are parsed partition by partition
+    std::vector<std::pair<int32_t, int64_t>> expected{{1, 10}, {2, 20}, {4, 40}, {5, 50}};
+    std::vector<std::pair<int32_t, int64_t>> rows;
+    while (true) {
+        auto res = scanner->get_next();
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        ChunkPtr chunk = res.value();
+        for (int row = 0; row < chunk->num_rows(); row++) {
+            rows.emplace_back(chunk->get(row)[0].get_int32(), chunk->get(row)[1].get_int64());
+        }
+    }
+    scanner->close();
+    ASSERT_EQ(expected, rows);
+    ASSERT_EQ(1, scanner->_counter->num_rows_filtered);
+    ASSERT_EQ(1, metrics->filtered_rows.value() - filtered_rows);
+
+    delete env._load_stream_mgr;
+    env._load_stream_mgr = nullptr;
+}
+
 } // namespace starrocks::vectorized
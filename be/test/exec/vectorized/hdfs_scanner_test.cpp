@@ -220,6 +220,44 @@ TEST_F(HdfsScannerTest, TestParquetGetNext) {
     ASSERT_TRUE(status.ok());
 }
 
+TEST_F(HdfsScannerTest, TestParquetMorsels) {
+    auto access_file = _create_file_handler(parquet_file);
+    auto* tuple_desc = _create_tuple_desc(parquet_descs);
+    auto meta_cache = std::make_shared<HdfsFileMetaCache>();
+
+    // the row group starts in the first morsel
+    auto* range1 = _create_scan_range(access_file, 4, 1);
+    auto* range2 = _create_scan_range(access_file, 5, 1019);
+    auto* param1 = _create_param(access_file, range1, tuple_desc);
+    auto* param2 = _create_param(access_file, range2, tuple_desc);
+    param1->meta_cache = meta_cache;
+    param2->meta_cache = meta_cache;
+
+    auto scanner1 = std::make_shared<HdfsParquetScanner>();
+    auto scanner2 = std::make_shared<HdfsParquetScanner>();
+    ASSERT_TRUE(scanner1->init(_runtime_state, *param1).ok());
+    ASSERT_TRUE(scanner2->init(_runtime_state, *param2).ok());
+    ASSERT_TRUE(scanner1->open(_runtime_state).ok());
+    auto metadata = meta_cache->parquet_metadata;
+    ASSERT_TRUE(metadata != nullptr);
+    ASSERT_TRUE(scanner2->open(_runtime_state).ok());
+    ASSERT_EQ(metadata, meta_cache->parquet_metadata);
+
+    auto chunk = vectorized::ChunkHelper::new_chunk(*tuple_desc, 0);
+    Status status = scanner1->get_next(_runtime_state, &chunk);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(chunk->num_rows(), 4);
+    status = scanner1->get_next(_runtime_state, &chunk);
+    ASSERT_TRUE(status.is_end_of_file());
+
+    chunk = vectorized::ChunkHelper::new_chunk(*tuple_desc, 0);
+    status = scanner2->get_next(_runtime_state, &chunk);
+    ASSERT_TRUE(status.is_end_of_file());
+
+    ASSERT_TRUE(scanner1->close(_runtime_state).ok());
+    ASSERT_TRUE(scanner2->close(_runtime_state).ok());
+}
+
 static TTypeDesc create_primitive_type_desc(TPrimitiveType::type type) {
     TTypeDesc result;
     TTypeNode node;
@@ -74,7 +74,8 @@ protected:
                                                starrocks_home + "./be/test/exec/test_data/json_scanner/test5.json",
                                                starrocks_home + "./be/test/exec/test_data/json_scanner/test6.json",
                                                starrocks_home + "./be/test/exec/test_data/json_scanner/test7.json",
-                                               starrocks_home + "./be/test/exec/test_data/json_scanner/test8.json"};
+                                               starrocks_home + "./be/test/exec/test_data/json_scanner/test8.json",
+                                               starrocks_home + "./be/test/exec/test_data/json_scanner/test9.json"};
     }
 
     void TearDown() override {}
@@ -334,4 +335,36 @@ TEST_F(JsonScannerTest, test_json_with_long_string) {
     EXPECT_EQ("['{\"area\":\"beijing\",\"country\":\"china\"}', '[\"478472290\",\"478473274\"]']", chunk->debug_row(0));
 }
 
+TEST_F(JsonScannerTest, test_ndjson) {
+    std::vector<TypeDescriptor> types;
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TypeDescriptor::create_varchar_type(20));
+    types.emplace_back(TYPE_DOUBLE);
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.format_type = TFileFormatType::FORMAT_JSON;
+    range.strip_outer_array = false;
+    range.__isset.strip_outer_array = true;
+    range.__isset.jsonpaths = false;
+    range.__isset.json_root = false;
+    range.__set_path("./be/test/exec/test_data/json_scanner/test9.json");
+    ranges.emplace_back(range);
+
+    auto scanner = create_json_scanner(types, ranges, {"category", "author", "title", "price"});
+
+    Status st;
+    st = scanner->open();
+    ASSERT_TRUE(st.ok());
+
+    ChunkPtr chunk = scanner->get_next().value();
+    EXPECT_EQ(4, chunk->num_columns());
+    EXPECT_EQ(3, chunk->num_rows());
+
+    EXPECT_EQ("['reference', 'NigelRees', 'SayingsoftheCentury', 8.95]", chunk->debug_row(0));
+    EXPECT_EQ("['fiction', 'EvelynWaugh', 'SwordofHonour', 12.99]", chunk->debug_row(1));
+    EXPECT_EQ("['fiction', 'HermanMelville', 'MobyDick', 8.99]", chunk->debug_row(2));
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,101 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/starrocks_to_arrow_converter.h"
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "runtime/date_value.h"
+#include "runtime/vectorized/time_types.h"
+
+namespace starrocks::vectorized {
+
+class StarRocksToArrowConverterTest : public ::testing::Test {
+protected:
+    void SetUp() override { date::init_date_cache(); }
+
+    static std::shared_ptr<arrow::Array> convert(const TypeDescriptor& type, const ColumnPtr& column) {
+        std::shared_ptr<arrow::Array> array;
+        Status st = convert_column_to_arrow(type, column, arrow::default_memory_pool(), &array);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        return array;
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(StarRocksToArrowConverterTest, test_nullable_int) {
+    auto data = Int32Column::create();
+    auto nulls = NullColumn::create();
+    for (int i = 0; i < 20; i++) {
+        data->append(i);
+        nulls->append(i % 3 == 0);
+    }
+    ColumnPtr column = NullableColumn::create(data, nulls);
+
+    auto array = convert(TypeDescriptor(TYPE_INT), column);
+    ASSERT_EQ(arrow::Type::INT32, array->type_id());
+    ASSERT_EQ(20, array->length());
+    ASSERT_EQ(7, array->null_count());
+    const auto& ints = static_cast<const arrow::Int32Array&>(*array);
+    for (int i = 0; i < 20; i++) {
+        ASSERT_EQ(i % 3 == 0, ints.IsNull(i));
+        if (i % 3 != 0) {
+            ASSERT_EQ(i, ints.Value(i));
+        }
+    }
+    // The values are shared with the column.
+    ASSERT_EQ(reinterpret_cast<const uint8_t*>(data->get_data().data()), ints.values()->data());
+}
+
+// NOLINTNEXTLINE
+TEST_F(StarRocksToArrowConverterTest, test_string) {
+    auto column = BinaryColumn::create();
+    column->append(Slice("starrocks"));
+    column->append(Slice(""));
+    column->append(Slice("arrow"));
+
+    auto array = convert(TypeDescriptor::create_varchar_type(10), column);
+    ASSERT_EQ(arrow::Type::STRING, array->type_id());
+    ASSERT_EQ(0, array->null_count());
+    const auto& strings = static_cast<const arrow::StringArray&>(*array);
+    ASSERT_EQ("starrocks", strings.GetString(0));
+    ASSERT_EQ("", strings.GetString(1));
+    ASSERT_EQ("arrow", strings.GetString(2));
+}
+
+// NOLINTNEXTLINE
+TEST_F(StarRocksToArrowConverterTest, test_boolean_and_const) {
+    auto column = BooleanColumn::create();
+    for (int i = 0; i < 10; i++) {
+        column->append(i % 2);
+    }
+    auto array = convert(TypeDescriptor(TYPE_BOOLEAN), column);
+    const auto& booleans = static_cast<const arrow::BooleanArray&>(*array);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(i % 2 == 1, booleans.Value(i));
+    }
+
+    ColumnPtr const_column = ColumnHelper::create_const_column<TYPE_BIGINT>(42, 5);
+    array = convert(TypeDescriptor(TYPE_BIGINT), const_column);
+    ASSERT_EQ(5, array->length());
+    const auto& bigints = static_cast<const arrow::Int64Array&>(*array);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(42, bigints.Value(i));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(StarRocksToArrowConverterTest, test_date) {
+    auto column = DateColumn::create();
+    column->append(DateValue::create(2021, 10, 1));
+    auto array = convert(TypeDescriptor(TYPE_DATE), column);
+    ASSERT_EQ(arrow::Type::STRING, array->type_id());
+    ASSERT_EQ("2021-10-01", static_cast<const arrow::StringArray&>(*array).GetString(0));
+}
+
+} // namespace starrocks::vectorized
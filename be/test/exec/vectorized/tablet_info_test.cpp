@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/tablet_info.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "runtime/descriptor_helper.h"
+
+namespace starrocks::vectorized {
+
+class VectorizedOlapTablePartitionParamTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("c1").column_pos(1).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("c2").column_pos(2).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().string_type(20).column_name("c3").column_pos(3).build());
+        tuple_builder.build(&dtb);
+        _t_desc_tbl = dtb.desc_tbl();
+
+        TOlapTableSchemaParam t_schema;
+        t_schema.db_id = 1;
+        t_schema.table_id = 2;
+        t_schema.version = 0;
+        t_schema.slot_descs = _t_desc_tbl.slotDescriptors;
+        t_schema.tuple_desc = _t_desc_tbl.tupleDescriptors[0];
+        t_schema.indexes.resize(1);
+        t_schema.indexes[0].id = 4;
+        t_schema.indexes[0].columns = {"c1", "c2", "c3"};
+
+        _schema = std::make_shared<OlapTableSchemaParam>();
+        ASSERT_TRUE(_schema->init(t_schema).ok());
+    }
+
+    TExprNode _int_key(int64_t value) {
+        TExprNode key;
+        key.node_type = TExprNodeType::INT_LITERAL;
+        key.type = _t_desc_tbl.slotDescriptors[1].slotType;
+        key.num_children = 0;
+        key.__isset.int_literal = true;
+        key.int_literal.value = value;
+        return key;
+    }
+
+    TDescriptorTable _t_desc_tbl;
+    std::shared_ptr<OlapTableSchemaParam> _schema;
+};
+
+TEST_F(VectorizedOlapTablePartitionParamTest, find_tablets) {
+    // (-oo, 10) | [10, 50) | [60, +oo)
+    TOlapTablePartitionParam t_partition_param;
+    t_partition_param.db_id = 1;
+    t_partition_param.table_id = 2;
+    t_partition_param.version = 0;
+    t_partition_param.__set_partition_columns({"c2"});
+    t_partition_param.__set_distributed_columns({"c1", "c3"});
+    t_partition_param.partitions.resize(3);
+    t_partition_param.partitions[0].id = 10;
+    t_partition_param.partitions[0].__set_end_keys({_int_key(10)});
+    t_partition_param.partitions[0].num_buckets = 1;
+    t_partition_param.partitions[0].indexes.resize(1);
+    t_partition_param.partitions[0].indexes[0].index_id = 4;
+    t_partition_param.partitions[0].indexes[0].tablets = {21};
+
+    t_partition_param.partitions[1].id = 11;
+    t_partition_param.partitions[1].__set_start_keys({_int_key(10)});
+    t_partition_param.partitions[1].__set_end_keys({_int_key(50)});
+    t_partition_param.partitions[1].num_buckets = 2;
+    t_partition_param.partitions[1].indexes.resize(1);
+    t_partition_param.partitions[1].indexes[0].index_id = 4;
+    t_partition_param.partitions[1].indexes[0].tablets = {31, 32};
+
+    t_partition_param.partitions[2].id = 12;
+    t_partition_param.partitions[2].__set_start_keys({_int_key(60)});
+    t_partition_param.partitions[2].num_buckets = 4;
+    t_partition_param.partitions[2].indexes.resize(1);
+    t_partition_param.partitions[2].indexes[0].index_id = 4;
+    t_partition_param.partitions[2].indexes[0].tablets = {41, 42, 43, 44};
+
+    OlapTablePartitionParam part(_schema, t_partition_param);
+    ASSERT_TRUE(part.init().ok());
+
+    // runs of rows in the same partition, and a row between two partitions
+    std::vector<int64_t> keys = {5, 20, 30, 5, 70, 55, 65, 65};
+    std::vector<int64_t> expected_partitions = {10, 11, 11, 10, 12, -1, 12, 12};
+    auto c1 = Int32Column::create();
+    auto c2 = Int64Column::create();
+    auto c3 = BinaryColumn::create();
+    for (size_t i = 0; i < keys.size(); i++) {
+        c1->append(static_cast<int32_t>(i));
+        c2->append(keys[i]);
+        c3->append_string("abc" + std::to_string(i));
+    }
+    const auto& slots = _schema->tuple_desc()->slots();
+    Chunk chunk;
+    chunk.append_column(c1, slots[0]->id());
+    chunk.append_column(c2, slots[1]->id());
+    chunk.append_column(c3, slots[2]->id());
+
+    std::vector<OlapTablePartition*> partitions;
+    std::vector<uint32_t> indexes;
+    std::vector<uint8_t> selection(keys.size(), 1);
+    int invalid_row_index = -1;
+    part.find_tablets(&chunk, &partitions, &indexes, &selection, &invalid_row_index);
+
+    ASSERT_EQ(5, invalid_row_index);
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (expected_partitions[i] < 0) {
+            ASSERT_EQ(0, selection[i]);
+            ASSERT_TRUE(partitions[i] == nullptr);
+        } else {
+            ASSERT_EQ(1, selection[i]);
+            ASSERT_EQ(expected_partitions[i], partitions[i]->id);
+            ASSERT_LT(indexes[i], partitions[i]->num_buckets);
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::vectorized {
+
+class CommonSubExprTest : public ::testing::Test {
+protected:
+    static TExprNode slot_ref(SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.num_children = 0;
+        TSlotRef ref;
+        ref.slot_id = slot_id;
+        ref.tuple_id = 0;
+        node.__set_slot_ref(ref);
+        return node;
+    }
+
+    static TExprNode int_literal(int64_t value) {
+        TExprNode node;
+        node.node_type = TExprNodeType::INT_LITERAL;
+        node.num_children = 0;
+        TIntLiteral literal;
+        literal.value = value;
+        node.__set_int_literal(literal);
+        return node;
+    }
+
+    static TExprNode function(const std::string& name, int num_children) {
+        TExprNode node;
+        node.node_type = TExprNodeType::FUNCTION_CALL;
+        node.num_children = num_children;
+        TFunction fn;
+        fn.name.function_name = name;
+        node.__set_fn(fn);
+        return node;
+    }
+
+    static TExpr expr(std::vector<TExprNode> nodes) {
+        TExpr expr;
+        expr.nodes = std::move(nodes);
+        return expr;
+    }
+
+    static int64_t eliminate(std::vector<TExpr>* exprs, std::vector<std::pair<SlotId, TExpr>>* common_sub_exprs) {
+        std::vector<TExpr*> targets;
+        for (auto& expr : *exprs) {
+            targets.push_back(&expr);
+        }
+        return eliminate_common_sub_exprs(targets, 100, common_sub_exprs);
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(CommonSubExprTest, test_repeated_subtree) {
+    // upper(substr(s1, 1)), length(substr(s1, 1)), s2
+    std::vector<TExpr> exprs;
+    exprs.push_back(expr({function("upper", 1), function("substr", 2), slot_ref(1), int_literal(1)}));
+    exprs.push_back(expr({function("length", 1), function("substr", 2), slot_ref(1), int_literal(1)}));
+    exprs.push_back(expr({slot_ref(2)}));
+
+    std::vector<std::pair<SlotId, TExpr>> common_sub_exprs;
+    ASSERT_EQ(1, eliminate(&exprs, &common_sub_exprs));
+
+    ASSERT_EQ(1, common_sub_exprs.size());
+    ASSERT_EQ(100, common_sub_exprs[0].first);
+    ASSERT_EQ(expr({function("substr", 2), slot_ref(1), int_literal(1)}), common_sub_exprs[0].second);
+
+    ASSERT_EQ(2, exprs[0].nodes.size());
+    ASSERT_EQ(function("upper", 1), exprs[0].nodes[0]);
+    ASSERT_EQ(100, exprs[0].nodes[1].slot_ref.slot_id);
+    ASSERT_EQ(2, exprs[1].nodes.size());
+    ASSERT_EQ(function("length", 1), exprs[1].nodes[0]);
+    ASSERT_EQ(100, exprs[1].nodes[1].slot_ref.slot_id);
+    ASSERT_EQ(expr({slot_ref(2)}), exprs[2]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CommonSubExprTest, test_nested_subtrees) {
+    // f(g(s1)) twice in an expression, g(s1) once more in another one.
+    std::vector<TExpr> exprs;
+    exprs.push_back(expr({function("add", 2), function("f", 1), function("g", 1), slot_ref(1), function("f", 1),
+                          function("g", 1), slot_ref(1)}));
+    exprs.push_back(expr({function("h", 1), function("g", 1), slot_ref(1)}));
+
+    std::vector<std::pair<SlotId, TExpr>> common_sub_exprs;
+    ASSERT_EQ(2, eliminate(&exprs, &common_sub_exprs));
+
+    // g(s1) is extracted from f(g(s1)) after it, so it is computed first.
+    ASSERT_EQ(2, common_sub_exprs.size());
+    ASSERT_EQ(101, common_sub_exprs[0].first);
+    ASSERT_EQ(expr({function("g", 1), slot_ref(1)}), common_sub_exprs[0].second);
+    ASSERT_EQ(100, common_sub_exprs[1].first);
+    ASSERT_EQ(2, common_sub_exprs[1].second.nodes.size());
+    ASSERT_EQ(101, common_sub_exprs[1].second.nodes[1].slot_ref.slot_id);
+
+    ASSERT_EQ(3, exprs[0].nodes.size());
+    ASSERT_EQ(100, exprs[0].nodes[1].slot_ref.slot_id);
+    ASSERT_EQ(100, exprs[0].nodes[2].slot_ref.slot_id);
+    ASSERT_EQ(2, exprs[1].nodes.size());
+    ASSERT_EQ(101, exprs[1].nodes[1].slot_ref.slot_id);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CommonSubExprTest, test_kept_subtrees) {
+    // Constant and non-deterministic subtrees are evaluated for every occurrence.
+    std::vector<TExpr> exprs;
+    exprs.push_back(expr({function("abs", 1), int_literal(-1)}));
+    exprs.push_back(expr({function("abs", 1), int_literal(-1)}));
+    exprs.push_back(expr({function("rand", 1), slot_ref(1)}));
+    exprs.push_back(expr({function("rand", 1), slot_ref(1)}));
+    std::vector<TExpr> expected = exprs;
+
+    std::vector<std::pair<SlotId, TExpr>> common_sub_exprs;
+    ASSERT_EQ(0, eliminate(&exprs, &common_sub_exprs));
+    ASSERT_TRUE(common_sub_exprs.empty());
+    ASSERT_EQ(expected, exprs);
+}
+
+} // namespace starrocks::vectorized
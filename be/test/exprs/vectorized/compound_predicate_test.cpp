@@ -4,7 +4,9 @@
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
+#include "column/chunk.h"
 #include "column/fixed_length_column.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
@@ -387,5 +389,68 @@ TEST_F(VectorizedCompoundPredicateTest, testOnlyNullAndZeroRow) {
     }
 }
 
+// An expensive predicate on the int slot 1, true for even values.
+class SlowEvenPredicate final : public Expr {
+public:
+    explicit SlowEvenPredicate(const TExprNode& node) : Expr(node) {}
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new SlowEvenPredicate(*this)); }
+
+    int get_slot_ids(std::vector<SlotId>* slot_ids) const override {
+        slot_ids->push_back(1);
+        return 1;
+    }
+
+    ColumnPtr evaluate(ExprContext*, Chunk* chunk) override {
+        const auto& values = ColumnHelper::cast_to_raw<TYPE_INT>(chunk->get_column_by_slot_id(1))->get_data();
+        auto result = BooleanColumn::create();
+        for (int32_t value : values) {
+            result->append(value % 2 == 0);
+        }
+        evaluated_rows += values.size();
+        usleep(1000);
+        return result;
+    }
+
+    size_t evaluated_rows = 0;
+};
+
+// The right child is evaluated only on the rows not decided by the left child, once it is known to be expensive.
+TEST_F(VectorizedCompoundPredicateTest, selectiveRightChild) {
+    const int32_t num_rows = 1024;
+    auto slot = Int32Column::create();
+    auto sparse = BooleanColumn::create();
+    auto dense = BooleanColumn::create();
+    for (int32_t i = 0; i < num_rows; ++i) {
+        slot->append(i);
+        sparse->append(i % 8 == 0);
+        dense->append(i % 8 != 3);
+    }
+    Chunk chunk;
+    chunk.append_column(slot, 1);
+
+    for (auto opcode : {TExprOpcode::COMPOUND_AND, TExprOpcode::COMPOUND_OR}) {
+        expr_node.opcode = opcode;
+        bool is_and = opcode == TExprOpcode::COMPOUND_AND;
+        std::unique_ptr<Expr> expr(VectorizedCompoundPredicateFactory::from_thrift(expr_node));
+        MockExpr left(expr_node, is_and ? sparse : dense);
+        SlowEvenPredicate right(expr_node);
+        expr->_children.push_back(&left);
+        expr->_children.push_back(&right);
+
+        for (int round = 0; round < 2; ++round) {
+            ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+            ASSERT_EQ(num_rows, ptr->size());
+            auto v = std::static_pointer_cast<BooleanColumn>(ptr);
+            for (int32_t i = 0; i < num_rows; ++i) {
+                bool expected = is_and ? (i % 8 == 0 && i % 2 == 0) : (i % 8 != 3 || i % 2 == 0);
+                ASSERT_EQ(expected, v->get_data()[i] != 0) << i;
+            }
+        }
+        // All the rows the first time, the 128 undecided rows the second time.
+        ASSERT_EQ(num_rows + num_rows / 8, right.evaluated_rows);
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
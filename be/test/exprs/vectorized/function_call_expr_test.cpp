@@ -5,12 +5,18 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <math.h>
+#include <iostream>
 
 #include "butil/time.h"
+#include "column/binary_column.h"
+#include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
 #include "exprs/vectorized/cast_expr.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -270,5 +276,182 @@ TEST_F(VectorizedFunctionCallExprTest, prepareFaileCase) {
     exprContext.close(nullptr);
 }
 
+TEST_F(VectorizedFunctionCallExprTest, md5OnDictTest) {
+    TFunction function;
+    TFunctionName functionName;
+    functionName.__set_db_name("db");
+    functionName.__set_function_name("md5");
+
+    function.__set_name(functionName);
+    function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+
+    std::vector<TTypeDesc> vec;
+    function.__set_arg_types(vec);
+    function.__set_has_var_args(false);
+    function.__set_fid(120140);
+
+    expr_node.__set_fn(function);
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+
+    VectorizedFunctionCallExpr expr(expr_node);
+
+    // 1024 rows of 4 distinct values, every 7th row is null.
+    auto column = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    const std::vector<std::string> values{"beijing", "shanghai", "Hangzhou", ""};
+    for (int i = 0; i < 1024; ++i) {
+        if (i % 7 == 0) {
+            column->append_nulls(1);
+        } else {
+            column->append_datum(Datum(Slice(values[i % values.size()])));
+        }
+    }
+    MockExpr col1(expr_node, column);
+    expr.add_child(&col1);
+
+    Chunk chunk;
+    chunk.append_column(column, 0);
+
+    ExprContext exprContext(&expr);
+    exprContext._is_clone = true;
+    starrocks::RowDescriptor rd;
+
+    WARN_IF_ERROR(expr.prepare(nullptr, rd, &exprContext), "");
+    WARN_IF_ERROR(expr.open(nullptr, &exprContext, FunctionContext::FunctionStateScope::THREAD_LOCAL), "");
+    ASSERT_TRUE(expr._is_dict_evaluable);
+
+    ColumnPtr result = expr.evaluate(&exprContext, &chunk);
+    config::enable_string_function_dict_evaluation = false;
+    ColumnPtr expected = expr.evaluate(&exprContext, &chunk);
+    config::enable_string_function_dict_evaluation = true;
+
+    ASSERT_TRUE(result->is_nullable());
+    ASSERT_EQ(1024, result->size());
+    ASSERT_EQ(expected->size(), result->size());
+    for (int i = 0; i < 1024; ++i) {
+        ASSERT_EQ(expected->debug_item(i), result->debug_item(i)) << "row " << i;
+        ASSERT_EQ(i % 7 == 0, result->is_null(i));
+    }
+
+    exprContext.close(nullptr);
+}
+
+// md5 of 4096 rows of 16 distinct values, on the dictionary and row by row.
+TEST_F(VectorizedFunctionCallExprTest, md5OnDictBenchmark) {
+    TFunction function;
+    TFunctionName functionName;
+    functionName.__set_db_name("db");
+    functionName.__set_function_name("md5");
+
+    function.__set_name(functionName);
+    function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+
+    std::vector<TTypeDesc> vec;
+    function.__set_arg_types(vec);
+    function.__set_has_var_args(false);
+    function.__set_fid(120140);
+
+    expr_node.__set_fn(function);
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+
+    VectorizedFunctionCallExpr expr(expr_node);
+
+    auto column = BinaryColumn::create();
+    for (int i = 0; i < 4096; ++i) {
+        column->append(Slice("http://www.starrocks.com/path/to/page_" + std::to_string(i % 16) + ".html"));
+    }
+    MockExpr col1(expr_node, column);
+    expr.add_child(&col1);
+
+    Chunk chunk;
+    chunk.append_column(column, 0);
+
+    ExprContext exprContext(&expr);
+    exprContext._is_clone = true;
+    starrocks::RowDescriptor rd;
+
+    WARN_IF_ERROR(expr.prepare(nullptr, rd, &exprContext), "");
+    WARN_IF_ERROR(expr.open(nullptr, &exprContext, FunctionContext::FunctionStateScope::THREAD_LOCAL), "");
+
+    for (bool on_dict : {true, false}) {
+        config::enable_string_function_dict_evaluation = on_dict;
+        int64_t evaluate_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&evaluate_ns);
+            for (int i = 0; i < 100; ++i) {
+                ASSERT_EQ(4096, expr.evaluate(&exprContext, &chunk)->size());
+            }
+        }
+        std::cout << "md5 of 100 chunks " << (on_dict ? "on dict" : "row by row") << " use:" << evaluate_ns << "ns"
+                  << std::endl;
+    }
+    config::enable_string_function_dict_evaluation = true;
+
+    exprContext.close(nullptr);
+}
+
+TEST_F(VectorizedFunctionCallExprTest, md5sumOnNullableInputTest) {
+    TFunction function;
+    TFunctionName functionName;
+    functionName.__set_db_name("db");
+    functionName.__set_function_name("md5sum");
+
+    function.__set_name(functionName);
+    function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+
+    std::vector<TTypeDesc> vec;
+    function.__set_arg_types(vec);
+    function.__set_has_var_args(true);
+    function.__set_fid(120150);
+
+    expr_node.__set_fn(function);
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+
+    VectorizedFunctionCallExpr expr(expr_node);
+
+    // 512 rows of 4 distinct values, every 5th row is null. md5sum skips null arguments,
+    // so the null rows must hash the constant argument instead of becoming null.
+    auto column = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    const std::vector<std::string> values{"beijing", "shanghai", "Hangzhou", ""};
+    for (int i = 0; i < 512; ++i) {
+        if (i % 5 == 0) {
+            column->append_nulls(1);
+        } else {
+            column->append_datum(Datum(Slice(values[i % values.size()])));
+        }
+    }
+    auto suffix = ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice("x"), 512);
+    MockExpr col1(expr_node, column);
+    MockExpr col2(expr_node, suffix);
+    expr.add_child(&col1);
+    expr.add_child(&col2);
+
+    Chunk chunk;
+    chunk.append_column(column, 0);
+
+    ExprContext exprContext(&expr);
+    exprContext._is_clone = true;
+    starrocks::RowDescriptor rd;
+
+    WARN_IF_ERROR(expr.prepare(nullptr, rd, &exprContext), "");
+    WARN_IF_ERROR(expr.open(nullptr, &exprContext, FunctionContext::FunctionStateScope::THREAD_LOCAL), "");
+
+    ASSERT_TRUE(config::enable_string_function_dict_evaluation);
+    ColumnPtr result = expr.evaluate(&exprContext, &chunk);
+    config::enable_string_function_dict_evaluation = false;
+    ColumnPtr expected = expr.evaluate(&exprContext, &chunk);
+    config::enable_string_function_dict_evaluation = true;
+
+    ASSERT_EQ(512, result->size());
+    ASSERT_EQ(expected->size(), result->size());
+    for (int i = 0; i < 512; ++i) {
+        ASSERT_FALSE(result->is_null(i)) << "row " << i;
+        ASSERT_EQ(expected->debug_item(i), result->debug_item(i)) << "row " << i;
+    }
+    // md5("x")
+    ASSERT_EQ("9dd4e461268c8034f5c8564e155c67a6", result->get(0).get_slice().to_string());
+
+    exprContext.close(nullptr);
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -236,5 +236,45 @@ TEST_F(JsonFunctionsTest, get_json_emptyTest) {
     }
 }
 
+TEST_F(JsonFunctionsTest, get_json_string_on_binaryTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto strings = BinaryColumn::create();
+    auto paths = BinaryColumn::create();
+
+    std::string values[] = {"{\"k1\":\"v1\", \"k2\":\"v2\"}", "{\"k1\":\"v1\", \"my.key\":[\"e1\", \"e2\", \"e3\"]}",
+                            "{\"k1.key\":{\"k2\":[\"v1\", \"v2\"]}}",
+                            "[{\"k1\":\"v1\"}, {\"k2\":\"v2\"}, {\"k1\":\"v3\"}, {\"k1\":\"v4\"}]", "{\"k1\":"};
+
+    std::string strs[] = {"$.k1", "$.\"my.key\"[1]", "$.\"k1.key\".k2[0]", "$.k1", "$.k1"};
+    std::string length_strings[] = {"v1", "e2", "v1", "[\"v1\",\"v3\",\"v4\"]"};
+
+    for (int j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+        strings->append(values[j]);
+        paths->append(strs[j]);
+    }
+
+    // Invalid JSON texts are encoded as NULL.
+    ColumnPtr encoded = JsonFunctions::parse_json(ctx.get(), Columns{strings});
+    ASSERT_TRUE(encoded->is_null(4));
+
+    Columns columns{encoded, paths};
+    ctx.get()->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+
+    ColumnPtr result = JsonFunctions::get_json_string(ctx.get(), columns);
+    for (int j = 0; j < sizeof(length_strings) / sizeof(length_strings[0]); ++j) {
+        ASSERT_FALSE(result->is_null(j));
+        ASSERT_EQ("'" + length_strings[j] + "'", result->debug_item(j));
+    }
+    ASSERT_TRUE(result->is_null(4));
+
+    ColumnPtr text = JsonFunctions::json_string(ctx.get(), Columns{encoded});
+    ASSERT_EQ("'{\"k1\":\"v1\",\"k2\":\"v2\"}'", text->debug_item(0));
+
+    ASSERT_TRUE(JsonFunctions::json_path_close(ctx.get(),
+                                               FunctionContext::FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                        .ok());
+}
+
 } // namespace vectorized
 } // namespace starrocks
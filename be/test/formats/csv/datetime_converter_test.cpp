@@ -30,6 +30,23 @@ TEST_F(DatetimeConverterTest, test_read_string) {
     EXPECT_EQ("1990-01-01 01:02:03", col->get(1).get_timestamp().to_string());
 }
 
+// NOLINTNEXTLINE
+TEST_F(DatetimeConverterTest, test_read_strings) {
+    auto conv = csv::get_converter(_type, false);
+    auto col = ColumnHelper::create_column(_type, false);
+
+    std::vector<Slice> fields{"1990-01-01 01:02:03", "19900101010203", "1990-02-30 01:02:03", "1990-01-01 24:00:00",
+                              "2000-02-29 23:59:59", "DorisDB"};
+    std::vector<uint8_t> invalid(fields.size());
+    EXPECT_EQ(3, conv->read_strings(col.get(), fields.data(), fields.size(), Converter::Options(), invalid.data()));
+
+    EXPECT_EQ(fields.size(), col->size());
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, 1, 1, 0, 1}), invalid);
+    EXPECT_EQ("1990-01-01 01:02:03", col->get(0).get_timestamp().to_string());
+    EXPECT_EQ("1990-01-01 01:02:03", col->get(1).get_timestamp().to_string());
+    EXPECT_EQ("2000-02-29 23:59:59", col->get(4).get_timestamp().to_string());
+}
+
 // NOLINTNEXTLINE
 TEST_F(DatetimeConverterTest, test_read_string_invalid_value) {
     auto conv = csv::get_converter(_type, false);
@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "formats/csv/delimiter_index.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace starrocks::vectorized::csv {
+
+// NOLINTNEXTLINE
+TEST(DelimiterIndexTest, test_match64) {
+    std::string s(64, 'a');
+    s[0] = '|';
+    s[31] = '|';
+    s[32] = '|';
+    s[63] = '|';
+    EXPECT_EQ((1ULL << 0) | (1ULL << 31) | (1ULL << 32) | (1ULL << 63), DelimiterIndex::match64(s.data(), '|'));
+    EXPECT_EQ(0, DelimiterIndex::match64(s.data(), '\n'));
+}
+
+// NOLINTNEXTLINE
+TEST(DelimiterIndexTest, test_split) {
+    // records span several blocks of 64 bytes, the last one is not ended.
+    std::string wide(100, 'x');
+    std::string buf = "a|bb|ccc\n\n" + wide + "|" + wide + "\n|\nlast|record";
+    DelimiterIndex index('\n', '|');
+
+    size_t n = index.split(buf.data(), buf.data() + buf.size(), 100);
+    EXPECT_EQ(buf.find("last"), n);
+    ASSERT_EQ(4, index.num_records());
+
+    EXPECT_EQ("a|bb|ccc", index.record(0).to_string());
+    ASSERT_EQ(3, index.num_fields(0));
+    EXPECT_EQ("a", index.fields(0)[0].to_string());
+    EXPECT_EQ("bb", index.fields(0)[1].to_string());
+    EXPECT_EQ("ccc", index.fields(0)[2].to_string());
+
+    EXPECT_EQ("", index.record(1).to_string());
+    ASSERT_EQ(1, index.num_fields(1));
+    EXPECT_EQ("", index.fields(1)[0].to_string());
+
+    ASSERT_EQ(2, index.num_fields(2));
+    EXPECT_EQ(wide, index.fields(2)[0].to_string());
+    EXPECT_EQ(wide, index.fields(2)[1].to_string());
+
+    ASSERT_EQ(2, index.num_fields(3));
+    EXPECT_EQ("", index.fields(3)[0].to_string());
+    EXPECT_EQ("", index.fields(3)[1].to_string());
+
+    EXPECT_EQ(buf.find(wide), index.truncate(2));
+    EXPECT_EQ(2, index.num_records());
+    EXPECT_EQ(0, index.truncate(0));
+    EXPECT_EQ(0, index.num_records());
+}
+
+// NOLINTNEXTLINE
+TEST(DelimiterIndexTest, test_split_max_records) {
+    std::string buf;
+    for (int i = 0; i < 100; i++) {
+        buf += std::to_string(i) + "|" + std::to_string(i * 2) + "\n";
+    }
+    DelimiterIndex index('\n', '|');
+    size_t n = index.split(buf.data(), buf.data() + buf.size(), 10);
+    ASSERT_EQ(10, index.num_records());
+    EXPECT_EQ(buf.find("10|"), n);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(2, index.num_fields(i));
+        EXPECT_EQ(std::to_string(i), index.fields(i)[0].to_string());
+        EXPECT_EQ(std::to_string(i * 2), index.fields(i)[1].to_string());
+    }
+
+    n = index.split(buf.data(), buf.data() + buf.size(), 1000);
+    EXPECT_EQ(100, index.num_records());
+    EXPECT_EQ(buf.size(), n);
+    EXPECT_EQ("99", index.fields(99)[0].to_string());
+}
+
+} // namespace starrocks::vectorized::csv
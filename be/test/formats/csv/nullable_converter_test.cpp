@@ -85,6 +85,32 @@ TEST_F(NullableConverterTest, test_read_string_invalid_value_as_error) {
     EXPECT_EQ(0, col->size());
 }
 
+// NOLINTNEXTLINE
+TEST_F(NullableConverterTest, test_read_strings) {
+    auto conv = csv::get_converter(_type, true);
+    std::vector<Slice> fields{"1", "\\N", "abc", "-1"};
+
+    auto col = ColumnHelper::create_column(_type, true);
+    std::vector<uint8_t> invalid(fields.size());
+    Converter::Options options;
+    options.invalid_field_as_null = true;
+    EXPECT_EQ(0, conv->read_strings(col.get(), fields.data(), fields.size(), options, invalid.data()));
+    EXPECT_EQ(4, col->size());
+    EXPECT_EQ(1, col->get(0).get_int32());
+    EXPECT_TRUE(col->get(1).is_null());
+    EXPECT_TRUE(col->get(2).is_null());
+    EXPECT_EQ(-1, col->get(3).get_int32());
+    EXPECT_TRUE(col->has_null());
+
+    col = ColumnHelper::create_column(_type, true);
+    std::fill(invalid.begin(), invalid.end(), 0);
+    options.invalid_field_as_null = false;
+    EXPECT_EQ(1, conv->read_strings(col.get(), fields.data(), fields.size(), options, invalid.data()));
+    EXPECT_EQ(4, col->size());
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, 1, 0}), invalid);
+    EXPECT_TRUE(col->get(1).is_null());
+}
+
 // NOLINTNEXTLINE
 TEST_F(NullableConverterTest, test_write_string) {
     auto conv = csv::get_converter(_type, true);
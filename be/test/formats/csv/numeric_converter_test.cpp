@@ -161,6 +161,23 @@ TEST_F(NumericConverterTest, test_read_string_invalid_value) {
     EXPECT_EQ(0, col->size());
 }
 
+// NOLINTNEXTLINE
+TEST_F(NumericConverterTest, test_read_strings) {
+    auto conv = csv::get_converter(_type, false);
+    auto col = ColumnHelper::create_column(_type, false);
+
+    std::vector<Slice> fields{"1", "-32768", "32768", "007", "1.9", "abc", "-"};
+    std::vector<uint8_t> invalid(fields.size());
+    EXPECT_EQ(3, conv->read_strings(col.get(), fields.data(), fields.size(), Converter::Options(), invalid.data()));
+
+    EXPECT_EQ(fields.size(), col->size());
+    EXPECT_EQ((std::vector<uint8_t>{0, 0, 1, 0, 0, 1, 1}), invalid);
+    EXPECT_EQ(1, col->get(0).get_int16());
+    EXPECT_EQ(-32768, col->get(1).get_int16());
+    EXPECT_EQ(7, col->get(3).get_int16());
+    EXPECT_EQ(1, col->get(4).get_int16());
+}
+
 // NOLINTNEXTLINE
 TEST_F(NumericConverterTest, test_write_string) {
     auto conv = csv::get_converter(_type, false);
@@ -0,0 +1,157 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/routine_load/data_consumer_group.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "runtime/exec_env.h"
+#include "runtime/mock_kafka_consumer.h"
+#include "runtime/routine_load/kafka_consumer_pipe.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+class KafkaDataConsumerGroupTest : public testing::Test {
+public:
+    void SetUp() override {
+        _env._load_stream_mgr = new LoadStreamMgr();
+
+        _ctx = std::make_unique<StreamLoadContext>(&_env);
+        TKafkaLoadInfo t_info;
+        t_info.brokers = "127.0.0.1:9092";
+        t_info.topic = "data_consumer_group_test";
+        t_info.partition_begin_offset = {{0, 10}, {1, 20}};
+        _ctx->kafka_info = std::make_unique<KafkaLoadInfo>(t_info);
+        _ctx->format = TFileFormatType::FORMAT_CSV_PLAIN;
+        _ctx->max_interval_s = 10;
+        _pipe = std::make_shared<KafkaConsumerPipe>();
+        _ctx->body_sink = _pipe;
+        _next_offsets = {{0, 10}, {1, 20}};
+    }
+
+    void TearDown() override {
+        _ctx.reset();
+        delete _env._load_stream_mgr;
+        _env._load_stream_mgr = nullptr;
+    }
+
+protected:
+    std::shared_ptr<MockKafkaDataConsumer> make_consumer(
+            const std::vector<std::pair<std::vector<int32_t>, std::vector<std::string>>>& batches,
+            std::map<int32_t, int64_t> high_watermarks, Status status = Status::OK()) {
+        std::vector<std::unique_ptr<KafkaMessageBatch>> msgs;
+        for (const auto& [partitions, payloads] : batches) {
+            msgs.emplace_back(make_kafka_batch(partitions, payloads, &_next_offsets));
+        }
+        return std::make_shared<MockKafkaDataConsumer>(_ctx.get(), std::move(msgs), std::move(high_watermarks),
+                                                       std::move(status));
+    }
+
+    // the rows read from the pipe by the csv scanner, sorted
+    std::vector<std::string> read_rows() {
+        std::vector<std::string> rows;
+        while (true) {
+            std::unique_ptr<KafkaMessageBatch> batch;
+            EXPECT_TRUE(_pipe->read_batch(&batch).ok());
+            if (batch == nullptr) {
+                break;
+            }
+            for (const auto& msg : *batch) {
+                rows.emplace_back(static_cast<const char*>(msg->payload()), msg->len());
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    ExecEnv _env;
+    std::unique_ptr<StreamLoadContext> _ctx;
+    std::shared_ptr<KafkaConsumerPipe> _pipe;
+    std::map<int32_t, int64_t> _next_offsets;
+};
+
+TEST_F(KafkaDataConsumerGroupTest, start_all) {
+    auto metrics0 = StarRocksMetrics::instance()->routine_load_partition_metrics(_ctx->kafka_info->topic, 0);
+    auto metrics1 = StarRocksMetrics::instance()->routine_load_partition_metrics(_ctx->kafka_info->topic, 1);
+    int64_t rows0 = metrics0->receive_rows.value();
+    int64_t bytes0 = metrics0->receive_bytes.value();
+    int64_t rows1 = metrics1->receive_rows.value();
+    int64_t bytes1 = metrics1->receive_bytes.value();
+
+    KafkaDataConsumerGroup group;
+    group.add_consumer(make_consumer({{{0, 0}, {"1,a", "2,b"}}, {{0}, {"3,c"}}}, {{0, 20}}));
+    group.add_consumer(make_consumer({{{1, 1}, {"4,dd", "5,ee"}}}, {{1, 25}}));
+    ASSERT_TRUE(group.start_all(_ctx.get()).ok());
+
+    // the offsets of the last msgs consumed
+    ASSERT_EQ(12, _ctx->kafka_info->cmt_offset[0]);
+    ASSERT_EQ(21, _ctx->kafka_info->cmt_offset[1]);
+    ASSERT_EQ(17, _ctx->receive_bytes);
+
+    std::vector<std::string> expected{"1,a", "2,b", "3,c", "4,dd", "5,ee"};
+    ASSERT_EQ(expected, read_rows());
+
+    ASSERT_EQ(3, metrics0->receive_rows.value() - rows0);
+    ASSERT_EQ(9, metrics0->receive_bytes.value() - bytes0);
+    ASSERT_EQ(2, metrics1->receive_rows.value() - rows1);
+    ASSERT_EQ(8, metrics1->receive_bytes.value() - bytes1);
+    ASSERT_EQ(7, metrics0->lag.value());
+    ASSERT_EQ(3, metrics1->lag.value());
+}
+
+TEST_F(KafkaDataConsumerGroupTest, consumer_failed) {
+    KafkaDataConsumerGroup group;
+    group.add_consumer(make_consumer({{{0}, {"1,a"}}}, {{0, 20}}));
+    group.add_consumer(make_consumer({}, {{1, 25}}, Status::InternalError("broker is down")));
+    Status st = group.start_all(_ctx.get());
+    ASSERT_FALSE(st.ok());
+    ASSERT_NE(std::string::npos, st.to_string().find("broker is down"));
+    // nothing is committed
+    ASSERT_EQ(9, _ctx->kafka_info->cmt_offset[0]);
+    ASSERT_EQ(19, _ctx->kafka_info->cmt_offset[1]);
+}
+
+TEST_F(KafkaDataConsumerGroupTest, nothing_consumed) {
+    KafkaDataConsumerGroup group;
+    group.add_consumer(make_consumer({}, {{0, 20}}));
+    ASSERT_TRUE(group.start_all(_ctx.get()).is_cancelled());
+
+    std::unique_ptr<KafkaMessageBatch> batch;
+    ASSERT_FALSE(_pipe->read_batch(&batch).ok());
+}
+
+// The metrics of a partition are deregistered once the tasks consuming it are done and it stays idle.
+TEST_F(KafkaDataConsumerGroupTest, expire_partition_metrics) {
+    auto* registry = StarRocksMetrics::instance()->metrics();
+    MetricLabels labels;
+    labels.add("topic", "expire_topic").add("partition", "0");
+    {
+        _ctx->kafka_info->topic = "expire_topic";
+        KafkaDataConsumerGroup group;
+        group.add_consumer(make_consumer({{{0}, {"1,a"}}}, {{0, 20}}));
+        ASSERT_TRUE(group.start_all(_ctx.get()).ok());
+        ASSERT_NE(nullptr, registry->get_metric("routine_load_partition_lag", labels));
+
+        // held by the consumer group
+        StarRocksMetrics::instance()->expire_routine_load_partition_metrics(0);
+        ASSERT_NE(nullptr, registry->get_metric("routine_load_partition_lag", labels));
+    }
+    // not idle for long enough
+    StarRocksMetrics::instance()->expire_routine_load_partition_metrics(3600);
+    ASSERT_NE(nullptr, registry->get_metric("routine_load_partition_lag", labels));
+
+    StarRocksMetrics::instance()->expire_routine_load_partition_metrics(0);
+    ASSERT_EQ(nullptr, registry->get_metric("routine_load_partition_lag", labels));
+    labels.add("type", "receive_rows");
+    ASSERT_EQ(nullptr, registry->get_metric("routine_load_partition", labels));
+
+    // registered again for the next task
+    auto metrics = StarRocksMetrics::instance()->routine_load_partition_metrics("expire_topic", 0);
+    ASSERT_EQ(static_cast<Metric*>(&metrics->receive_rows), registry->get_metric("routine_load_partition", labels));
+}
+
+} // namespace starrocks
@@ -0,0 +1,220 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/data_stream_sender.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "runtime/bufferpool/reservation_tracker.h"
+#include "runtime/data_stream_mgr.h"
+#include "runtime/data_stream_recvr.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/exec_env.h"
+#include "runtime/query_statistics.h"
+#include "runtime/runtime_state.h"
+#include "runtime/thread_resource_mgr.h"
+#include "service/backend_options.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "util/brpc_stub_cache.h"
+
+namespace starrocks {
+
+class DataStreamSenderTest : public testing::Test {
+public:
+    void SetUp() override {
+        _pass_through = config::enable_exchange_pass_through;
+        _localhost = BackendOptions::_s_localhost;
+        config::enable_exchange_pass_through = true;
+        BackendOptions::_s_localhost = "127.0.0.1";
+
+        // The metric hooks registered by the stream manager refer to it, it is never deleted.
+        static DataStreamMgr* s_stream_mgr = new DataStreamMgr();
+        _env = ExecEnv::GetInstance();
+        _env->_thread_mgr = new ThreadResourceMgr();
+        _env->_buffer_reservation = new ReservationTracker();
+        _env->_brpc_stub_cache = new BrpcStubCache();
+        _env->_stream_mgr = s_stream_mgr;
+
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("c1").column_pos(0).build());
+        tuple_builder.build(&table_builder);
+        DescriptorTbl* desc_tbl = nullptr;
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, table_builder.desc_tbl(), &desc_tbl).ok());
+        _tuple_desc = desc_tbl->get_tuple_descriptor(0);
+        _row_desc = std::make_unique<RowDescriptor>(*desc_tbl, std::vector<TTupleId>{0}, std::vector<bool>{false});
+
+        _fragment_instance_id.hi = 100;
+        _fragment_instance_id.lo = 200;
+        _state = std::make_unique<RuntimeState>(_fragment_instance_id, TQueryOptions(), TQueryGlobals(), _env);
+        _state->init_mem_trackers(TUniqueId());
+    }
+
+    void TearDown() override {
+        _state.reset();
+        _env->_stream_mgr = nullptr;
+        SAFE_DELETE(_env->_brpc_stub_cache);
+        SAFE_DELETE(_env->_buffer_reservation);
+        SAFE_DELETE(_env->_thread_mgr);
+        BackendOptions::_s_localhost = _localhost;
+        config::enable_exchange_pass_through = _pass_through;
+    }
+
+    // The receiver of the exchange node kDestNodeId of the fragment instance, buffering
+    // |buffer_size| bytes at most.
+    std::shared_ptr<DataStreamRecvr> create_recvr(int buffer_size) {
+        _recvr_profile = std::make_shared<RuntimeProfile>("DataStreamRecvr");
+        return _env->stream_mgr()->create_recvr(_state.get(), *_row_desc, _fragment_instance_id, kDestNodeId, 1,
+                                                buffer_size, _recvr_profile, false, _query_statistics_recvr);
+    }
+
+    // A broadcasting sender to the fragment instance on this BE.
+    std::unique_ptr<DataStreamSender> create_sender() {
+        TDataSink t_sink;
+        t_sink.type = TDataSinkType::DATA_STREAM_SINK;
+        t_sink.stream_sink.dest_node_id = kDestNodeId;
+        t_sink.stream_sink.output_partition.type = TPartitionType::UNPARTITIONED;
+
+        TPlanFragmentDestination destination;
+        destination.fragment_instance_id = _fragment_instance_id;
+        destination.server.hostname = "127.0.0.1";
+        destination.server.port = config::be_port;
+        destination.__isset.brpc_server = true;
+        destination.brpc_server.hostname = "127.0.0.1";
+        destination.brpc_server.port = config::brpc_port;
+
+        auto sender = std::make_unique<DataStreamSender>(&_pool, true, 0, *_row_desc, t_sink.stream_sink,
+                                                         std::vector<TPlanFragmentDestination>{destination}, 16 * 1024,
+                                                         false);
+        sender->set_query_statistics(std::make_shared<QueryStatistics>());
+        EXPECT_TRUE(sender->init(t_sink).ok());
+        EXPECT_TRUE(sender->prepare(_state.get()).ok());
+        EXPECT_TRUE(sender->open(_state.get()).ok());
+        return sender;
+    }
+
+    // |num_rows| rows of c1 from |start|
+    vectorized::ChunkPtr gen_chunk(int32_t start, size_t num_rows) const {
+        auto chunk = vectorized::ChunkHelper::new_chunk(*_tuple_desc, num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            chunk->get_column_by_index(0)->append_datum(vectorized::Datum(static_cast<int32_t>(start + i)));
+        }
+        return chunk;
+    }
+
+    // Send |num_chunks| chunks of |chunk_rows| rows from a thread, and check the rows got by the receiver.
+    void send_and_receive(DataStreamRecvr* recvr, size_t num_chunks, size_t chunk_rows) {
+        auto sender = create_sender();
+        int64_t sender_consumption = sender->_mem_tracker->consumption();
+
+        std::thread send_thread([&] {
+            for (size_t i = 0; i < num_chunks; i++) {
+                auto chunk = gen_chunk(i * chunk_rows, chunk_rows);
+                EXPECT_TRUE(sender->send_chunk(_state.get(), chunk.get()).ok());
+            }
+            EXPECT_TRUE(sender->close(_state.get(), Status::OK()).ok());
+        });
+
+        int32_t expected = 0;
+        while (true) {
+            std::unique_ptr<vectorized::Chunk> chunk;
+            ASSERT_TRUE(recvr->get_chunk(&chunk).ok());
+            if (chunk == nullptr) {
+                break;
+            }
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                ASSERT_EQ(expected++, chunk->get_column_by_index(0)->get(i).get_int32());
+            }
+        }
+        send_thread.join();
+        ASSERT_EQ(num_chunks * chunk_rows, expected);
+
+        // no chunk went through brpc
+        ASSERT_EQ(num_chunks, sender->profile()->get_counter("PassThroughChunkNum")->value());
+        ASSERT_EQ(0, sender->profile()->get_counter("BytesSent")->value());
+        ASSERT_EQ(num_chunks, _recvr_profile->get_counter("LocalChunksReceived")->value());
+        // the copies handed over are accounted nowhere once they are received
+        ASSERT_EQ(sender_consumption, sender->_mem_tracker->consumption());
+        ASSERT_EQ(0, recvr->mem_tracker()->consumption());
+    }
+
+protected:
+    static constexpr PlanNodeId kDestNodeId = 1;
+
+    bool _pass_through = false;
+    std::string _localhost;
+    ExecEnv* _env = nullptr;
+    ObjectPool _pool;
+    TupleDescriptor* _tuple_desc = nullptr;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    TUniqueId _fragment_instance_id;
+    std::unique_ptr<RuntimeState> _state;
+    std::shared_ptr<RuntimeProfile> _recvr_profile;
+    std::shared_ptr<QueryStatisticsRecvr> _query_statistics_recvr = std::make_shared<QueryStatisticsRecvr>();
+};
+
+TEST_F(DataStreamSenderTest, pass_through) {
+    auto recvr = create_recvr(1024 * 1024);
+    send_and_receive(recvr.get(), 10, 100);
+    recvr->close();
+}
+
+// The receiver keeps the sender waiting as long as its buffer is full.
+TEST_F(DataStreamSenderTest, pass_through_buffer_full) {
+    auto recvr = create_recvr(1);
+    send_and_receive(recvr.get(), 10, 100);
+    recvr->close();
+}
+
+// The chunks queued by the receiver are accounted on its tracker rather than on the sender's.
+TEST_F(DataStreamSenderTest, pass_through_accounting) {
+    auto recvr = create_recvr(1024 * 1024);
+    auto sender = create_sender();
+    int64_t sender_consumption = sender->_mem_tracker->consumption();
+
+    const size_t num_chunks = 10;
+    for (size_t i = 0; i < num_chunks; i++) {
+        auto chunk = gen_chunk(i * 100, 100);
+        ASSERT_TRUE(sender->send_chunk(_state.get(), chunk.get()).ok());
+    }
+    ASSERT_TRUE(sender->close(_state.get(), Status::OK()).ok());
+    ASSERT_EQ(sender_consumption, sender->_mem_tracker->consumption());
+    int64_t queued_bytes = recvr->mem_tracker()->consumption();
+    ASSERT_GT(queued_bytes, 0);
+
+    int64_t received_bytes = 0;
+    size_t num_received = 0;
+    while (true) {
+        std::unique_ptr<vectorized::Chunk> chunk;
+        ASSERT_TRUE(recvr->get_chunk(&chunk).ok());
+        if (chunk == nullptr) {
+            break;
+        }
+        received_bytes += chunk->memory_usage();
+        num_received++;
+        ASSERT_EQ(queued_bytes - received_bytes, recvr->mem_tracker()->consumption());
+    }
+    ASSERT_EQ(num_chunks, num_received);
+    ASSERT_EQ(queued_bytes, received_bytes);
+    ASSERT_EQ(0, recvr->mem_tracker()->consumption());
+    recvr->close();
+}
+
+// The chunks left in the queue are released when the receiver is closed, the tracker of
+// the receiver checks that nothing is consumed any more when it is destroyed.
+TEST_F(DataStreamSenderTest, pass_through_close_with_queued_chunks) {
+    auto recvr = create_recvr(1024 * 1024);
+    auto sender = create_sender();
+    for (size_t i = 0; i < 3; i++) {
+        auto chunk = gen_chunk(i * 100, 100);
+        ASSERT_TRUE(sender->send_chunk(_state.get(), chunk.get()).ok());
+    }
+    ASSERT_GT(recvr->mem_tracker()->consumption(), 0);
+    recvr->close();
+    ASSERT_TRUE(sender->close(_state.get(), Status::OK()).ok());
+}
+
+} // namespace starrocks
@@ -23,6 +23,12 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "runtime/mock_kafka_consumer.h"
+
 namespace starrocks {
 
 class KafkaConsumerPipeTest : public testing::Test {
@@ -34,7 +40,13 @@ public:
 
     void TearDown() override {}
 
+protected:
+    std::unique_ptr<KafkaMessageBatch> make_batch(const std::vector<std::string>& payloads, int32_t partition = 0) {
+        return make_kafka_batch(std::vector<int32_t>(payloads.size(), partition), payloads, &_next_offsets);
+    }
+
 private:
+    std::map<int32_t, int64_t> _next_offsets;
 };
 
 TEST_F(KafkaConsumerPipeTest, append_read) {
@@ -45,9 +57,9 @@ TEST_F(KafkaConsumerPipeTest, append_read) {
 
     Status st;
     char row_delimiter = '\n';
-    st = k_pipe.append_with_row_delimiter(msg1.c_str(), msg1.length(), row_delimiter);
+    st = k_pipe.append_batch_with_row_delimiter(make_batch({msg1}), row_delimiter);
     ASSERT_TRUE(st.ok());
-    st = k_pipe.append_with_row_delimiter(msg2.c_str(), msg2.length(), row_delimiter);
+    st = k_pipe.append_batch_with_row_delimiter(make_batch({msg2}), row_delimiter);
     ASSERT_TRUE(st.ok());
     st = k_pipe.finish();
     ASSERT_TRUE(st.ok());
@@ -59,6 +71,7 @@ TEST_F(KafkaConsumerPipeTest, append_read) {
     ASSERT_TRUE(st.ok());
     ASSERT_EQ(data_size, msg1.length() + msg2.length() + 2);
     ASSERT_EQ(eof, false);
+    ASSERT_EQ(msg1 + "\n" + msg2 + "\n", std::string(buf, data_size));
 
     data_size = 1024;
     st = k_pipe.read((uint8_t*)buf, &data_size, &eof);
@@ -67,4 +80,147 @@ TEST_F(KafkaConsumerPipeTest, append_read) {
     ASSERT_EQ(eof, true);
 }
 
+TEST_F(KafkaConsumerPipeTest, append_batch_with_row_delimiter) {
+    KafkaConsumerPipe k_pipe;
+
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"1,a", "", "22,bb"}), '|').ok());
+    // an empty batch is dropped
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({}), '|').ok());
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"333,ccc"}), '|').ok());
+    ASSERT_TRUE(k_pipe.finish().ok());
+
+    // small reads cross the bounds of the msgs and of the batches
+    std::string content;
+    while (true) {
+        char buf[3];
+        size_t data_size = sizeof(buf);
+        bool eof = false;
+        ASSERT_TRUE(k_pipe.read((uint8_t*)buf, &data_size, &eof).ok());
+        if (eof) {
+            ASSERT_EQ(0, data_size);
+            break;
+        }
+        ASSERT_GT(data_size, 0);
+        content.append(buf, data_size);
+    }
+    ASSERT_EQ("1,a||22,bb|333,ccc|", content);
+}
+
+TEST_F(KafkaConsumerPipeTest, append_json_batch) {
+    KafkaConsumerPipe k_pipe;
+
+    auto batch = make_batch({R"({"k1": 1})", R"({"k1": 22})"});
+    const void* payload0 = (*batch)[0]->payload();
+    const void* payload1 = (*batch)[1]->payload();
+    ASSERT_TRUE(k_pipe.append_json_batch(std::move(batch)).ok());
+    ASSERT_TRUE(k_pipe.append_json_batch(make_batch({R"({"k1": 333})"})).ok());
+    ASSERT_TRUE(k_pipe.finish().ok());
+
+    // the buffers hold the payloads of the msgs instead of copies
+    ByteBufferPtr buf;
+    ASSERT_TRUE(k_pipe.read_one_message(&buf).ok());
+    ASSERT_TRUE(buf != nullptr);
+    ASSERT_EQ(payload0, static_cast<const void*>(buf->ptr));
+    ASSERT_EQ(R"({"k1": 1})", std::string(buf->ptr, buf->remaining()));
+    ASSERT_TRUE(k_pipe.read_one_message(&buf).ok());
+    ASSERT_EQ(payload1, static_cast<const void*>(buf->ptr));
+    ASSERT_EQ(R"({"k1": 22})", std::string(buf->ptr, buf->remaining()));
+
+    std::unique_ptr<uint8_t[]> data;
+    size_t length = 0;
+    ASSERT_TRUE(k_pipe.read_one_message(&data, &length).ok());
+    ASSERT_EQ(R"({"k1": 333})", std::string(reinterpret_cast<char*>(data.get()), length));
+
+    ASSERT_TRUE(k_pipe.read_one_message(&buf).ok());
+    ASSERT_TRUE(buf == nullptr);
+    ASSERT_TRUE(k_pipe.read_one_message(&data, &length).ok());
+    ASSERT_EQ(0, length);
+}
+
+TEST_F(KafkaConsumerPipeTest, read_json_bytes) {
+    KafkaConsumerPipe k_pipe;
+
+    ASSERT_TRUE(k_pipe.append_json_batch(make_batch({R"({"k1": 1})", R"({"k1": 22})"})).ok());
+    ASSERT_TRUE(k_pipe.finish().ok());
+
+    // no row delimiter follows the json msgs
+    char buf[1024];
+    size_t data_size = sizeof(buf);
+    bool eof = false;
+    ASSERT_TRUE(k_pipe.read((uint8_t*)buf, &data_size, &eof).ok());
+    ASSERT_FALSE(eof);
+    ASSERT_EQ(R"({"k1": 1}{"k1": 22})", std::string(buf, data_size));
+}
+
+TEST_F(KafkaConsumerPipeTest, read_batch) {
+    KafkaConsumerPipe k_pipe;
+
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"a", "b"}, 0), '\n').ok());
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"c"}, 1), '\n').ok());
+    ASSERT_TRUE(k_pipe.finish().ok());
+
+    std::unique_ptr<KafkaMessageBatch> batch;
+    ASSERT_TRUE(k_pipe.read_batch(&batch).ok());
+    ASSERT_EQ(2, batch->size());
+    ASSERT_EQ(0, (*batch)[0]->partition());
+    ASSERT_EQ(0, (*batch)[0]->offset());
+    ASSERT_EQ(1, (*batch)[1]->offset());
+    ASSERT_EQ("b", std::string(static_cast<const char*>((*batch)[1]->payload()), (*batch)[1]->len()));
+
+    ASSERT_TRUE(k_pipe.read_batch(&batch).ok());
+    ASSERT_EQ(1, batch->size());
+    ASSERT_EQ(1, (*batch)[0]->partition());
+
+    ASSERT_TRUE(k_pipe.read_batch(&batch).ok());
+    ASSERT_TRUE(batch == nullptr);
+}
+
+TEST_F(KafkaConsumerPipeTest, bound_buffered_bytes) {
+    KafkaConsumerPipe k_pipe(10, 10);
+
+    // a batch larger than the bound is appended if nothing is buffered
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"0123456789abc"}), '\n').ok());
+
+    std::atomic<bool> appended{false};
+    std::thread producer([&] {
+        ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"xyz"}), '\n').ok());
+        appended = true;
+        ASSERT_TRUE(k_pipe.finish().ok());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(appended);
+
+    std::unique_ptr<KafkaMessageBatch> batch;
+    ASSERT_TRUE(k_pipe.read_batch(&batch).ok());
+    ASSERT_EQ(1, batch->size());
+    ASSERT_TRUE(k_pipe.read_batch(&batch).ok());
+    ASSERT_TRUE(appended);
+    ASSERT_EQ("xyz", std::string(static_cast<const char*>((*batch)[0]->payload()), (*batch)[0]->len()));
+    producer.join();
+
+    ASSERT_TRUE(k_pipe.read_batch(&batch).ok());
+    ASSERT_TRUE(batch == nullptr);
+}
+
+TEST_F(KafkaConsumerPipeTest, cancel) {
+    KafkaConsumerPipe k_pipe(10, 10);
+    ASSERT_TRUE(k_pipe.append_batch_with_row_delimiter(make_batch({"0123456789"}), '\n').ok());
+
+    // the blocked producer is woken up by the cancellation
+    std::thread producer([&] { ASSERT_FALSE(k_pipe.append_batch_with_row_delimiter(make_batch({"a"}), '\n').ok()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    k_pipe.cancel();
+    producer.join();
+
+    std::unique_ptr<KafkaMessageBatch> batch;
+    ASSERT_FALSE(k_pipe.read_batch(&batch).ok());
+    ByteBufferPtr buf;
+    ASSERT_FALSE(k_pipe.read_one_message(&buf).ok());
+}
+
+TEST_F(KafkaConsumerPipeTest, append_bytes) {
+    KafkaConsumerPipe k_pipe;
+    ASSERT_TRUE(k_pipe.append("abc", 3).is_not_supported());
+}
+
 } // namespace starrocks
@@ -0,0 +1,99 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "librdkafka/rdkafkacpp.h"
+#include "runtime/routine_load/data_consumer.h"
+
+namespace starrocks {
+
+// A consumed kafka msg, which owns its payload.
+class MockKafkaMessage : public RdKafka::Message {
+public:
+    MockKafkaMessage(int32_t partition, int64_t offset, std::string payload, std::string topic = "test_topic")
+            : _partition(partition), _offset(offset), _payload(std::move(payload)), _topic(std::move(topic)) {}
+
+    ~MockKafkaMessage() override = default;
+
+    std::string errstr() const override { return ""; }
+    RdKafka::ErrorCode err() const override { return RdKafka::ERR_NO_ERROR; }
+    RdKafka::Topic* topic() const override { return nullptr; }
+    std::string topic_name() const override { return _topic; }
+    int32_t partition() const override { return _partition; }
+    void* payload() const override { return const_cast<char*>(_payload.data()); }
+    size_t len() const override { return _payload.size(); }
+    const std::string* key() const override { return nullptr; }
+    const void* key_pointer() const override { return nullptr; }
+    size_t key_len() const override { return 0; }
+    int64_t offset() const override { return _offset; }
+    RdKafka::MessageTimestamp timestamp() const override { return RdKafka::MessageTimestamp(); }
+    void* msg_opaque() const override { return nullptr; }
+    int64_t latency() const override { return -1; }
+    struct rd_kafka_message_s* c_ptr() override { return nullptr; }
+    RdKafka::Headers* headers() override { return nullptr; }
+    RdKafka::Headers* headers(RdKafka::ErrorCode* err) override {
+        *err = RdKafka::ERR__NOENT;
+        return nullptr;
+    }
+
+private:
+    int32_t _partition;
+    int64_t _offset;
+    std::string _payload;
+    std::string _topic;
+};
+
+// Returns a batch of msgs, one for each of |payloads| and |partitions|, whose offsets follow |next_offsets|.
+inline std::unique_ptr<KafkaMessageBatch> make_kafka_batch(const std::vector<int32_t>& partitions,
+                                                           const std::vector<std::string>& payloads,
+                                                           std::map<int32_t, int64_t>* next_offsets) {
+    auto batch = std::make_unique<KafkaMessageBatch>();
+    for (size_t i = 0; i < payloads.size(); i++) {
+        int64_t offset = (*next_offsets)[partitions[i]]++;
+        batch->emplace_back(std::make_unique<MockKafkaMessage>(partitions[i], offset, payloads[i]));
+    }
+    return batch;
+}
+
+// A consumer of a routine load, which hands prepared batches of msgs over to its group instead of
+// consuming a kafka broker, and knows the high watermarks of its partitions.
+class MockKafkaDataConsumer : public KafkaDataConsumer {
+public:
+    MockKafkaDataConsumer(StreamLoadContext* ctx, std::vector<std::unique_ptr<KafkaMessageBatch>> batches,
+                          std::map<int32_t, int64_t> high_watermarks, Status status = Status::OK())
+            : KafkaDataConsumer(ctx),
+              _batches(std::move(batches)),
+              _high_watermarks(std::move(high_watermarks)),
+              _status(std::move(status)) {}
+
+    Status group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms) override {
+        for (auto& batch : _batches) {
+            if (!queue->blocking_put(batch.get())) {
+                break;
+            }
+            batch.release();
+        }
+        return _status;
+    }
+
+    void get_partition_lags(const std::map<int32_t, int64_t>& cmt_offset, std::map<int32_t, int64_t>* lags) override {
+        for (const auto& [partition, high] : _high_watermarks) {
+            auto iter = cmt_offset.find(partition);
+            if (iter != cmt_offset.end()) {
+                (*lags)[partition] = high - iter->second - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<KafkaMessageBatch>> _batches;
+    std::map<int32_t, int64_t> _high_watermarks;
+    Status _status;
+};
+
+} // namespace starrocks
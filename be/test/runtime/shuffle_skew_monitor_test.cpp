@@ -0,0 +1,90 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/shuffle_skew_monitor.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class ShuffleSkewMonitorTest : public testing::Test {
+public:
+    void SetUp() override { _detection_enable = config::enable_exchange_skew_detection; }
+    void TearDown() override { config::enable_exchange_skew_detection = _detection_enable; }
+
+protected:
+    // Key 7 takes a third of the rows, all other keys are unique.
+    static std::vector<uint32_t> gen_hash_values(size_t num_rows, uint32_t* next) {
+        std::vector<uint32_t> hash_values(num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            hash_values[i] = (i % 3 == 0) ? 7 : (*next)++;
+        }
+        return hash_values;
+    }
+
+    bool _detection_enable = false;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ShuffleSkewMonitorTest, disabled) {
+    config::enable_exchange_skew_detection = false;
+    RuntimeProfile profile("test");
+    ShuffleSkewMonitor monitor;
+    monitor.init(&profile, 4);
+    ASSERT_FALSE(monitor.enabled());
+
+    uint32_t next = 1000;
+    auto hash_values = gen_hash_values(4096, &next);
+    monitor.sample(hash_values.data(), hash_values.size());
+    monitor.add_rows(0, 100, 1000);
+    monitor.close();
+    ASSERT_EQ(nullptr, profile.get_counter("ShuffleChannelBytes"));
+    ASSERT_EQ(nullptr, profile.get_info_string("SkewedKeys"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ShuffleSkewMonitorTest, report_channel_bytes) {
+    config::enable_exchange_skew_detection = true;
+    RuntimeProfile profile("test");
+    ShuffleSkewMonitor monitor;
+    monitor.init(&profile, 4);
+    ASSERT_TRUE(monitor.enabled());
+
+    uint32_t next = 1000;
+    for (int i = 0; i < 8; i++) {
+        auto hash_values = gen_hash_values(4096, &next);
+        monitor.sample(hash_values.data(), hash_values.size());
+    }
+    monitor.add_rows(0, 100, 1000);
+    monitor.add_rows(1, 10, 100);
+    monitor.add_rows(0, 50, 500);
+    monitor.close();
+
+    ASSERT_EQ(1600, profile.get_counter("ShuffleChannelBytes")->value());
+    ASSERT_EQ(1500, profile.get_counter("Channel0")->value());
+    ASSERT_EQ(1500, profile.get_counter("MaxChannelBytes")->value());
+    // only key 7 is above the fair share of a channel
+    const std::string* keys = profile.get_info_string("SkewedKeys");
+    ASSERT_NE(nullptr, keys);
+    ASSERT_EQ(0, keys->find("0x00000007"));
+    ASSERT_EQ(std::string::npos, keys->find(", "));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ShuffleSkewMonitorTest, too_few_rows_sampled) {
+    config::enable_exchange_skew_detection = true;
+    RuntimeProfile profile("test");
+    ShuffleSkewMonitor monitor;
+    monitor.init(&profile, 4);
+
+    uint32_t next = 1000;
+    auto hash_values = gen_hash_values(4096, &next);
+    monitor.sample(hash_values.data(), hash_values.size());
+    monitor.add_rows(0, 4096, 4096);
+    monitor.close();
+    ASSERT_EQ(4096, profile.get_counter("MaxChannelBytes")->value());
+    ASSERT_EQ(nullptr, profile.get_info_string("SkewedKeys"));
+}
+
+} // namespace starrocks
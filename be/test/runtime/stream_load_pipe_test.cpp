@@ -259,4 +259,37 @@ TEST_F(StreamLoadPipeTest, close) {
     t1.join();
 }
 
+TEST_F(StreamLoadPipeTest, read_one_message_without_copy) {
+    auto owner = std::make_shared<std::string>("0123456789");
+    std::weak_ptr<std::string> weak_owner = owner;
+    {
+        StreamLoadPipe pipe(1024, 64, owner->size());
+        auto wrapped = ByteBuffer::wrap(owner->data(), owner->size(), owner);
+        owner.reset();
+        ASSERT_TRUE(pipe.append(wrapped).ok());
+        ASSERT_TRUE(pipe.finish().ok());
+
+        ByteBufferPtr message;
+        ASSERT_TRUE(pipe.read_one_message(&message).ok());
+        // the buffer appended holds the whole message, so it is returned as it is
+        ASSERT_EQ(wrapped, message);
+        ASSERT_EQ("0123456789", std::string(message->ptr + message->pos, message->remaining()));
+        wrapped.reset();
+        ASSERT_FALSE(weak_owner.expired());
+        message.reset();
+    }
+    ASSERT_TRUE(weak_owner.expired());
+
+    // a message split into several buffers is copied into one
+    StreamLoadPipe pipe(1024, 64, 20);
+    for (int i = 0; i < 2; i++) {
+        auto data = std::make_shared<std::string>("abcdefghij");
+        ASSERT_TRUE(pipe.append(ByteBuffer::wrap(data->data(), data->size(), data)).ok());
+    }
+    ASSERT_TRUE(pipe.finish().ok());
+    ByteBufferPtr message;
+    ASSERT_TRUE(pipe.read_one_message(&message).ok());
+    ASSERT_EQ("abcdefghijabcdefghij", std::string(message->ptr + message->pos, message->remaining()));
+}
+
 } // namespace starrocks
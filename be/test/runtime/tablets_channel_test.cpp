@@ -0,0 +1,206 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/tablets_channel.h"
+
+#include <gtest/gtest.h>
+
+#include "exec/tablet_info.h"
+#include "exec/tablet_sink.h"
+#include "gen_cpp/AgentService_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/rowset.h"
+#include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/txn_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "util/block_compression.h"
+
+namespace starrocks {
+
+class TabletsChannelTest : public testing::Test {
+public:
+    void SetUp() override {
+        _mem_tracker = std::make_unique<MemTracker>(-1, "tablets channel test");
+
+        TCreateTabletReq request;
+        request.tablet_id = kTabletId;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+
+        auto st = StorageEngine::instance()->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(kTabletId, kSchemaHash);
+        ASSERT_TRUE(_tablet != nullptr);
+
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("k1").column_pos(0).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v1").column_pos(1).build());
+        tuple_builder.build(&dtb);
+        TDescriptorTable t_desc_tbl = dtb.desc_tbl();
+
+        TOlapTableSchemaParam t_schema;
+        t_schema.db_id = 1;
+        t_schema.table_id = 2;
+        t_schema.version = 0;
+        t_schema.slot_descs = t_desc_tbl.slotDescriptors;
+        t_schema.tuple_desc = t_desc_tbl.tupleDescriptors[0];
+        t_schema.indexes.resize(1);
+        t_schema.indexes[0].id = kIndexId;
+        t_schema.indexes[0].columns = {"k1", "v1"};
+        t_schema.indexes[0].schema_hash = kSchemaHash;
+        _schema = std::make_unique<OlapTableSchemaParam>();
+        ASSERT_TRUE(_schema->init(t_schema).ok());
+    }
+
+    void TearDown() override {
+        if (_tablet != nullptr) {
+            StorageEngine::instance()->tablet_manager()->drop_tablet(_tablet->tablet_id(), _tablet->schema_hash(),
+                                                                     false);
+            _tablet.reset();
+        }
+    }
+
+    // rows from |start| whose v1 repeat, so that the chunk compresses well
+    vectorized::ChunkPtr gen_chunk(int64_t start, size_t num_rows) const {
+        auto chunk = vectorized::ChunkHelper::new_chunk(*_schema->tuple_desc(), num_rows);
+        for (size_t i = 0; i < num_rows; i++) {
+            int64_t key = start + i;
+            chunk->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+            chunk->get_column_by_index(1)->append_datum(vectorized::Datum(static_cast<int32_t>(key % 10)));
+        }
+        return chunk;
+    }
+
+    PTabletWriterAddChunkRequest add_chunk_request(int64_t packet_seq, ChunkPB* pchunk, size_t num_rows) const {
+        PTabletWriterAddChunkRequest request;
+        request.mutable_id()->set_hi(kLoadIdHi);
+        request.mutable_id()->set_lo(kLoadIdLo);
+        request.set_index_id(kIndexId);
+        request.set_sender_id(0);
+        request.set_eos(false);
+        request.set_packet_seq(packet_seq);
+        for (size_t i = 0; i < num_rows; i++) {
+            request.add_tablet_ids(kTabletId);
+        }
+        request.mutable_chunk()->Swap(pchunk);
+        return request;
+    }
+
+protected:
+    static constexpr int64_t kTabletId = 23456;
+    static constexpr int32_t kSchemaHash = 2222;
+    static constexpr int64_t kIndexId = 10;
+    static constexpr int64_t kPartitionId = 20;
+    static constexpr int64_t kTxnId = 30;
+    static constexpr int64_t kLoadIdHi = 1;
+    static constexpr int64_t kLoadIdLo = 2;
+
+    ObjectPool _pool;
+    std::unique_ptr<MemTracker> _mem_tracker;
+    TabletSharedPtr _tablet;
+    std::unique_ptr<OlapTableSchemaParam> _schema;
+};
+
+// The chunks compressed by the sink are decompressed by the tablets channel, mixed with
+// the uncompressed ones.
+TEST_F(TabletsChannelTest, add_compressed_chunk) {
+    PTabletWriterOpenRequest open_request;
+    open_request.mutable_id()->set_hi(kLoadIdHi);
+    open_request.mutable_id()->set_lo(kLoadIdLo);
+    open_request.set_index_id(kIndexId);
+    open_request.set_txn_id(kTxnId);
+    _schema->to_protobuf(open_request.mutable_schema());
+    auto* tablet = open_request.add_tablets();
+    tablet->set_partition_id(kPartitionId);
+    tablet->set_tablet_id(kTabletId);
+    open_request.set_num_senders(1);
+    open_request.set_need_gen_rollup(false);
+    open_request.set_is_vectorized(true);
+
+    TabletsChannel channel(TabletsChannelKey(open_request.id(), kIndexId), _mem_tracker.get());
+    ASSERT_TRUE(channel.open(open_request).ok());
+
+    Status st;
+    RowDescriptor row_desc(_schema->tuple_desc(), false);
+    stream_load::OlapTableSink sink(&_pool, row_desc, {}, &st, true);
+    ASSERT_TRUE(st.ok());
+    stream_load::NodeChannel node_channel(&sink, kIndexId, 1, kSchemaHash);
+    // as init() does with config::olap_table_sink_compress_chunks
+    ASSERT_TRUE(get_block_compression_codec(CompressionTypePB::LZ4, &node_channel._compress_codec).ok());
+
+    const size_t num_rows = 4096;
+    ChunkPB compressed;
+    ASSERT_TRUE(node_channel._serialize_chunk(gen_chunk(0, num_rows).get(), &compressed).ok());
+    ASSERT_EQ(CompressionTypePB::LZ4, compressed.compress_type());
+    ASSERT_LT(compressed.data().size(), compressed.uncompressed_size());
+    st = channel.add_chunk(add_chunk_request(0, &compressed, num_rows));
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    node_channel._compress_codec = nullptr;
+    ChunkPB uncompressed;
+    ASSERT_TRUE(node_channel._serialize_chunk(gen_chunk(num_rows, num_rows).get(), &uncompressed).ok());
+    ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, uncompressed.compress_type());
+    st = channel.add_chunk(add_chunk_request(1, &uncompressed, num_rows));
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    bool finished = false;
+    google::protobuf::RepeatedField<int64_t> partition_ids;
+    partition_ids.Add(kPartitionId);
+    google::protobuf::RepeatedPtrField<PTabletInfo> tablet_vec;
+    ASSERT_TRUE(channel.close(0, &finished, partition_ids, &tablet_vec).ok());
+    ASSERT_TRUE(finished);
+    ASSERT_EQ(1, tablet_vec.size());
+
+    std::map<TabletInfo, RowsetSharedPtr> tablet_infos;
+    StorageEngine::instance()->txn_manager()->get_txn_related_tablets(kTxnId, kPartitionId, &tablet_infos);
+    ASSERT_EQ(1, tablet_infos.size());
+    RowsetSharedPtr rowset = tablet_infos.begin()->second;
+    ASSERT_EQ(2 * num_rows, rowset->num_rows());
+
+    vectorized::Schema schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto iter = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(iter.ok()) << iter.status().to_string();
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    int64_t expected = 0;
+    while (true) {
+        chunk->reset();
+        st = (*iter)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected, chunk->get_column_by_index(0)->get(i).get_int64());
+            ASSERT_EQ(expected % 10, chunk->get_column_by_index(1)->get(i).get_int32());
+            expected++;
+        }
+    }
+    (*iter)->close();
+    ASSERT_EQ(2 * num_rows, expected);
+}
+
+} // namespace starrocks
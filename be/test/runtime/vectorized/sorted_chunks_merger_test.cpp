@@ -270,4 +270,69 @@ TEST_F(SortedChunksMergerTest, three_suppliers) {
     }
 }
 
+// Many streams, each split in several chunks, with interleaved and clustered keys.
+TEST_F(SortedChunksMergerTest, many_suppliers) {
+    const size_t num_suppliers = 9;
+    const size_t num_chunks = 4;
+    const size_t chunk_rows = 300;
+    std::vector<std::vector<ChunkPtr>> chunks(num_suppliers);
+    std::vector<size_t> chunk_index(num_suppliers, 0);
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(2);
+    map[0] = 0;
+    for (size_t i = 0; i < num_suppliers; ++i) {
+        int32_t value = 0;
+        for (size_t c = 0; c < num_chunks; ++c) {
+            auto column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+            for (size_t r = 0; r < chunk_rows; ++r) {
+                // Odd streams have runs of equal keys, even streams interleave with each other.
+                value += (i % 2 == 1) ? (r % 50 == 0) * 7 : static_cast<int32_t>(i % 4 + 1);
+                column->append_datum(value);
+            }
+            chunks[i].push_back(std::make_shared<Chunk>(Columns{column}, map));
+        }
+    }
+
+    ChunkSuppliers suppliers;
+    for (size_t i = 0; i < num_suppliers; ++i) {
+        suppliers.push_back([&chunks, &chunk_index, i](Chunk** cnk) -> Status {
+            if (chunk_index[i] < chunks[i].size()) {
+                ChunkPtr& src_chunk = chunks[i][chunk_index[i]++];
+                *cnk = src_chunk->clone_empty_with_slot(src_chunk->num_rows()).release();
+                (*cnk)->append(*src_chunk, 0, src_chunk->num_rows());
+            } else {
+                *cnk = nullptr;
+            }
+            return Status::OK();
+        });
+    }
+
+    SlotRef expr(TypeDescriptor(TYPE_INT), 0, 0);
+    ExprContext ctx(&expr);
+    std::vector<ExprContext*> sort_exprs = {&ctx};
+    std::vector<bool> is_asc = {true};
+    std::vector<bool> is_null_first = {true};
+    SortedChunksMerger merger;
+    ASSERT_TRUE(merger.init(suppliers, &sort_exprs, &is_asc, &is_null_first).ok());
+
+    size_t num_rows = 0;
+    int32_t last = INT32_MIN;
+    bool eos = false;
+    while (true) {
+        ChunkPtr page;
+        ASSERT_TRUE(merger.get_next(&page, &eos).ok());
+        if (eos) {
+            break;
+        }
+        ASSERT_LE(page->num_rows(), config::vector_chunk_size);
+        for (size_t r = 0; r < page->num_rows(); ++r) {
+            int32_t value = page->get(r).get(0).get_int32();
+            ASSERT_LE(last, value);
+            last = value;
+        }
+        num_rows += page->num_rows();
+    }
+    ASSERT_EQ(num_suppliers * num_chunks * chunk_rows, num_rows);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/vectorized/StringSearcher.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+namespace starrocks::vectorized {
+
+static size_t search(const std::string& haystack, const std::string& needle) {
+    FirstLastByteStringSearcher searcher(needle.data(), needle.size());
+    return searcher.search(haystack.data(), haystack.size()) - haystack.data();
+}
+
+// NOLINTNEXTLINE
+TEST(FirstLastByteStringSearcherTest, test_basic) {
+    std::string haystack = "2021-10-01 12:00:00 [INFO] ok; 2021-10-01 12:00:01 [ERROR] disk error on /dev/sda";
+    ASSERT_EQ(haystack.find("error"), search(haystack, "error"));
+    ASSERT_EQ(haystack.find("ERROR"), search(haystack, "ERROR"));
+    ASSERT_EQ(haystack.find("/dev/sda"), search(haystack, "/dev/sda"));
+    ASSERT_EQ(haystack.find("e"), search(haystack, "e"));
+    ASSERT_EQ(0, search(haystack, ""));
+    ASSERT_EQ(haystack.size(), search(haystack, "warning"));
+    ASSERT_EQ(3, search("abc", "abcd"));
+    ASSERT_EQ(0, search("", ""));
+}
+
+// NOLINTNEXTLINE
+TEST(FirstLastByteStringSearcherTest, test_random) {
+    // A small alphabet makes many candidates pass the first and last byte filter.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> byte('a', 'c');
+    for (int round = 0; round < 2000; round++) {
+        std::string haystack(rng() % 200, ' ');
+        for (char& c : haystack) {
+            c = byte(rng);
+        }
+        std::string needle(1 + rng() % 8, ' ');
+        for (char& c : needle) {
+            c = byte(rng);
+        }
+        size_t expected = haystack.find(needle);
+        ASSERT_EQ(expected == std::string::npos ? haystack.size() : expected, search(haystack, needle))
+                << haystack << " " << needle;
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -41,7 +41,9 @@
 #include "storage/rowset/segment_v2/segment_writer.h"
 #include "storage/tablet_schema.h"
 #include "storage/tablet_schema_helper.h"
+#include "storage/vectorized/chunk_helper.h"
 #include "util/file_utils.h"
+#include "util/threadpool.h"
 
 #define ASSERT_OK(expr)                                   \
     do {                                                  \
@@ -1159,5 +1161,50 @@ TEST_F(SegmentReaderWriterTest, TestBloomFilterIndexUniqueModel) {
     ASSERT_TRUE(column_contains_index(seg2->footer().columns(3), BLOOM_FILTER_INDEX));
 }
 
+// The segment written with the columns encoded concurrently must be the same as the one
+// written column by column.
+TEST_F(SegmentReaderWriterTest, TestParallelEncode) {
+    std::vector<TabletColumn> columns{create_int_key(0)};
+    for (int i = 1; i < 40; i++) {
+        columns.push_back(create_int_value(i));
+    }
+    TabletSchema tablet_schema = create_schema(columns);
+    auto chunk = vectorized::ChunkHelper::new_chunk(
+            vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema), 4096);
+    for (size_t cid = 0; cid < columns.size(); cid++) {
+        auto& column = chunk->get_column_by_index(cid);
+        for (int32_t rid = 0; rid < 4096; rid++) {
+            column->append_datum(vectorized::Datum(static_cast<int32_t>(rid * 10 + cid)));
+        }
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("segment_encode").set_max_threads(4).build(&pool));
+    std::string contents[2];
+    for (int i = 0; i < 2; i++) {
+        std::string filename = strings::Substitute("$0/parallel_encode_$1.dat", kSegmentDir, i);
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions block_opts({filename});
+        ASSERT_OK(_block_mgr->create_block(block_opts, &wblock));
+        SegmentWriterOptions opts;
+        opts.storage_format_version = 2;
+        opts.mem_tracker = _mem_tracker.get();
+        opts.encode_pool = (i == 0) ? nullptr : pool.get();
+        SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+        ASSERT_OK(writer.init(10));
+        ASSERT_EQ(i == 1, writer._encode_token != nullptr);
+        ASSERT_OK(writer.append_chunk(*chunk));
+        ASSERT_OK(writer.append_chunk(*chunk));
+        uint64_t file_size, index_size;
+        ASSERT_OK(writer.finalize(&file_size, &index_size));
+
+        std::unique_ptr<RandomAccessFile> rfile;
+        ASSERT_OK(_env->new_random_access_file(filename, &rfile));
+        contents[i].resize(file_size);
+        ASSERT_OK(rfile->read_at(0, Slice(contents[i])));
+    }
+    ASSERT_EQ(contents[0], contents[1]);
+}
+
 } // namespace segment_v2
 } // namespace starrocks
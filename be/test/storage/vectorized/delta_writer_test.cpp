@@ -0,0 +1,194 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/delta_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+
+#include "common/config.h"
+#include "gen_cpp/AgentService_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/rowset.h"
+#include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/txn_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::vectorized {
+
+class DeltaWriterTest : public testing::Test {
+public:
+    void SetUp() override {
+        _spill_enable = config::memtable_spill_enable;
+        _mem_tracker = std::make_unique<MemTracker>(-1, "delta writer test");
+
+        TCreateTabletReq request;
+        request.tablet_id = 12345;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = 1111;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+
+        auto st = StorageEngine::instance()->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request.tablet_id, 1111);
+        ASSERT_TRUE(_tablet != nullptr);
+
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("k1").column_pos(0).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v1").column_pos(1).build());
+        tuple_builder.build(&dtb);
+        DescriptorTbl* desc_tbl = nullptr;
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, dtb.desc_tbl(), &desc_tbl).ok());
+        _tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    }
+
+    void TearDown() override {
+        config::memtable_spill_enable = _spill_enable;
+        if (_tablet != nullptr) {
+            StorageEngine::instance()->tablet_manager()->drop_tablet(_tablet->tablet_id(), _tablet->schema_hash(),
+                                                                     false);
+            _tablet.reset();
+        }
+    }
+
+    // the spill files in the tablet path
+    std::vector<std::string> spill_files() const {
+        std::vector<std::string> files;
+        for (const auto& entry : std::filesystem::directory_iterator(_tablet->tablet_path())) {
+            const std::string path = entry.path().string();
+            if (path.size() > 6 && path.compare(path.size() - 6, 6, "_spill") == 0) {
+                files.push_back(path);
+            }
+        }
+        return files;
+    }
+
+    // rows whose k1 are the multiples of |num_writes| plus |round|, in a random order
+    std::shared_ptr<Chunk> gen_chunk(size_t num_rows, size_t num_writes, size_t round) const {
+        auto chunk = ChunkHelper::new_chunk(*_tuple_desc, num_rows);
+        std::vector<int64_t> keys;
+        for (size_t i = round; i < num_rows * num_writes; i += num_writes) {
+            keys.push_back(i);
+        }
+        std::random_shuffle(keys.begin(), keys.end());
+        for (int64_t key : keys) {
+            chunk->get_column_by_index(0)->append_datum(Datum(key));
+            chunk->get_column_by_index(1)->append_datum(Datum(static_cast<int32_t>(key * 3)));
+        }
+        return chunk;
+    }
+
+protected:
+    bool _spill_enable = false;
+    ObjectPool _pool;
+    std::unique_ptr<MemTracker> _mem_tracker;
+    TabletSharedPtr _tablet;
+    TupleDescriptor* _tuple_desc = nullptr;
+};
+
+TEST_F(DeltaWriterTest, spill_flushed_memtables) {
+    config::memtable_spill_enable = true;
+
+    WriteRequest request;
+    request.tablet_id = _tablet->tablet_id();
+    request.schema_hash = _tablet->schema_hash();
+    request.write_type = WriteType::LOAD;
+    request.txn_id = 100;
+    request.partition_id = 10;
+    request.load_id.set_hi(1);
+    request.load_id.set_lo(2);
+    request.tuple_desc = _tuple_desc;
+    request.slots = &_tuple_desc->slots();
+
+    DeltaWriter* writer = nullptr;
+    ASSERT_TRUE(DeltaWriter::open(&request, _mem_tracker.get(), &writer).ok());
+    std::unique_ptr<DeltaWriter> writer_guard(writer);
+
+    const size_t num_rows = 1000;
+    const size_t num_writes = 3;
+    std::vector<uint32_t> indexes(num_rows);
+    for (uint32_t i = 0; i < num_rows; i++) {
+        indexes[i] = i;
+    }
+    for (size_t round = 0; round < num_writes; round++) {
+        auto chunk = gen_chunk(num_rows, num_writes, round);
+        ASSERT_TRUE(writer->write(chunk.get(), indexes.data(), 0, num_rows).ok());
+        if (round + 1 < num_writes) {
+            // as the load channel does to reduce its memory usage
+            ASSERT_TRUE(writer->flush_memtable_async().ok());
+            ASSERT_TRUE(writer->wait_memtable_flushed().ok());
+        }
+    }
+
+    // the spill file is visible to the path gc of rowset ids
+    auto files = spill_files();
+    ASSERT_EQ(1, files.size());
+    RowsetId rowset_id;
+    ASSERT_TRUE(StorageEngine::instance()->tablet_manager()->get_rowset_id_from_path(files[0], &rowset_id));
+
+    ASSERT_TRUE(writer->close().ok());
+    google::protobuf::RepeatedPtrField<PTabletInfo> tablet_vec;
+    ASSERT_TRUE(writer->close_wait(&tablet_vec).ok());
+
+    std::map<TabletInfo, RowsetSharedPtr> tablet_infos;
+    StorageEngine::instance()->txn_manager()->get_txn_related_tablets(request.txn_id, request.partition_id,
+                                                                      &tablet_infos);
+    ASSERT_EQ(1, tablet_infos.size());
+    RowsetSharedPtr rowset = tablet_infos.begin()->second;
+    ASSERT_EQ(rowset_id.to_string(), rowset->rowset_id().to_string());
+    // the spilled memtables and the last one are merged into one segment
+    ASSERT_EQ(1, rowset->num_segments());
+    ASSERT_EQ(num_rows * num_writes, rowset->num_rows());
+
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    OlapReaderStatistics stats;
+    RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto iter = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(iter.ok()) << iter.status().to_string();
+    auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    int64_t expected = 0;
+    while (true) {
+        chunk->reset();
+        Status st = (*iter)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected, chunk->get_column_by_index(0)->get(i).get_int64());
+            ASSERT_EQ(expected * 3, chunk->get_column_by_index(1)->get(i).get_int32());
+            expected++;
+        }
+    }
+    (*iter)->close();
+    ASSERT_EQ(num_rows * num_writes, expected);
+
+    writer_guard.reset();
+    ASSERT_TRUE(spill_files().empty());
+}
+
+} // namespace starrocks::vectorized
@@ -16,6 +16,7 @@
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/memtable_spiller.h"
 #include "util/file_utils.h"
 
 namespace starrocks::vectorized {
@@ -264,6 +265,58 @@ TEST_F(MemTableTest, testDupKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testDupKeysSpillMerge) {
+    const string path = "./ut_dir/MemTableTest_testDupKeysSpillMerge";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::DUP_KEYS, path);
+    MemTableSpiller spiller(ChunkHelper::convert_schema_to_format_v2(*_schema), path + "/memtable.spill");
+    const size_t n = 3000;
+    const size_t num_memtables = 3;
+    auto pchunk = gen_chunk(*_slots, n);
+    for (size_t m = 0; m < num_memtables; m++) {
+        vector<uint32_t> indexes;
+        for (uint32_t i = m; i < n; i += num_memtables) {
+            indexes.emplace_back(i);
+        }
+        std::random_shuffle(indexes.begin(), indexes.end());
+        MemTable mem_table(1, _schema.get(), _slots, _writer.get(), _mem_tracker.get());
+        mem_table.set_spiller(&spiller);
+        mem_table.insert(pchunk.get(), indexes.data(), 0, indexes.size());
+        ASSERT_TRUE(mem_table.finalize().ok());
+        ASSERT_EQ(OLAP_SUCCESS, mem_table.flush());
+    }
+    ASSERT_EQ(num_memtables, spiller.num_runs());
+    ASSERT_TRUE(spiller.merge(_writer.get()).ok());
+    RowsetSharedPtr rowset = _writer->build();
+    ASSERT_EQ(1, rowset->num_segments());
+
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t pkey_read = 0;
+    int last_value = 0;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        auto column = chunk->get_column_by_name("pk");
+        for (size_t i = 0; i < column->size(); i++) {
+            int new_value = column->get(i).get_int32();
+            ASSERT_EQ(last_value == 0 ? 3 : last_value + 1, new_value);
+            last_value = new_value;
+        }
+        pkey_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(n, pkey_read);
+}
+
 TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     const string path = "./ut_dir/MemTableTest_testUniqKeysInsertFlushRead";
     MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
@@ -0,0 +1,268 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/segment_replicator.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "common/config.h"
+#include "gen_cpp/AgentService_types.h"
+#include "gen_cpp/HeartbeatService_types.h"
+#include "http/download_action.h"
+#include "http/ev_http_server.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/rowset/rowset.h"
+#include "storage/rowset/unique_rowset_id_generator.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/txn_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/delta_writer.h"
+
+namespace starrocks::vectorized {
+
+static const int64_t kPartitionId = 20;
+
+class SegmentReplicatorTest : public testing::Test {
+public:
+    void SetUp() override {
+        _mem_tracker = std::make_unique<MemTracker>(-1, "segment replicator test");
+        _exec_env = ExecEnv::GetInstance();
+        _exec_env->_master_info = new TMasterInfo();
+        _exec_env->_master_info->token = "segment_replicator_test";
+        _exec_env->_tablet_meta_mem_tracker = _mem_tracker.get();
+
+        // the primary replica serves its segments through the download action of clone
+        _download_action = std::make_unique<DownloadAction>(
+                _exec_env, std::vector<std::string>{std::filesystem::absolute(config::storage_root_path).string()});
+        _server = std::make_unique<EvHttpServer>(0);
+        _server->register_handler(HEAD, "/api/_tablet/_download", _download_action.get());
+        _server->register_handler(GET, "/api/_tablet/_download", _download_action.get());
+        ASSERT_TRUE(_server->start().ok());
+
+        _primary = create_tablet(23451);
+        _secondary = create_tablet(23452);
+
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("k1").column_pos(0).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v1").column_pos(1).build());
+        tuple_builder.build(&dtb);
+        DescriptorTbl* desc_tbl = nullptr;
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, dtb.desc_tbl(), &desc_tbl).ok());
+        _tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    }
+
+    void TearDown() override {
+        if (_server != nullptr) {
+            _server->stop();
+            _server->join();
+            _server.reset();
+        }
+        for (auto* tablet : {&_primary, &_secondary}) {
+            if (*tablet != nullptr) {
+                StorageEngine::instance()->tablet_manager()->drop_tablet((*tablet)->tablet_id(),
+                                                                         (*tablet)->schema_hash(), false);
+                tablet->reset();
+            }
+        }
+        delete _exec_env->_master_info;
+        _exec_env->_master_info = nullptr;
+        _exec_env->_tablet_meta_mem_tracker = nullptr;
+    }
+
+    TabletSharedPtr create_tablet(int64_t tablet_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = 1111;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+
+        auto st = StorageEngine::instance()->create_tablet(request);
+        CHECK(st.ok()) << st.to_string();
+        return StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, 1111);
+    }
+
+    // loads |num_rows| rows into the primary replica, and returns its committed rowset
+    RowsetSharedPtr load_primary(size_t num_rows) {
+        WriteRequest request;
+        request.tablet_id = _primary->tablet_id();
+        request.schema_hash = _primary->schema_hash();
+        request.write_type = WriteType::LOAD;
+        request.txn_id = _txn_id;
+        request.partition_id = kPartitionId;
+        request.load_id = _load_id;
+        request.tuple_desc = _tuple_desc;
+        request.slots = &_tuple_desc->slots();
+
+        DeltaWriter* writer = nullptr;
+        CHECK(DeltaWriter::open(&request, _mem_tracker.get(), &writer).ok());
+        std::unique_ptr<DeltaWriter> writer_guard(writer);
+
+        auto chunk = ChunkHelper::new_chunk(*_tuple_desc, num_rows);
+        std::vector<uint32_t> indexes;
+        for (size_t i = 0; i < num_rows; i++) {
+            chunk->get_column_by_index(0)->append_datum(Datum(static_cast<int64_t>(i)));
+            chunk->get_column_by_index(1)->append_datum(Datum(static_cast<int32_t>(i * 3)));
+            indexes.push_back(i);
+        }
+        CHECK(writer->write(chunk.get(), indexes.data(), 0, num_rows).ok());
+        CHECK(writer->close().ok());
+        google::protobuf::RepeatedPtrField<PTabletInfo> tablet_vec;
+        CHECK(writer->close_wait(&tablet_vec).ok());
+        return committed_rowset(_primary);
+    }
+
+    RowsetSharedPtr committed_rowset(const TabletSharedPtr& tablet) {
+        std::map<TabletInfo, RowsetSharedPtr> tablet_infos;
+        StorageEngine::instance()->txn_manager()->get_txn_related_tablets(_txn_id, kPartitionId, &tablet_infos);
+        for (const auto& [tablet_info, rowset] : tablet_infos) {
+            if (tablet_info.tablet_id == tablet->tablet_id()) {
+                return rowset;
+            }
+        }
+        return nullptr;
+    }
+
+    // the request the primary replica sends to the secondary one
+    PTabletWriterAddSegmentsRequest make_request(const Rowset& rowset) {
+        PTabletWriterAddSegmentsRequest request;
+        *request.mutable_id() = _load_id;
+        request.set_txn_id(_txn_id);
+        request.set_partition_id(kPartitionId);
+        request.set_tablet_id(_secondary->tablet_id());
+        request.set_schema_hash(_secondary->schema_hash());
+        // the replicas of a tablet share the tablet id, unlike the two tablets of this test
+        RowsetMeta rowset_meta;
+        std::string meta_pb;
+        CHECK(rowset.rowset_meta()->serialize(&meta_pb));
+        CHECK(rowset_meta.init(meta_pb));
+        rowset_meta.set_tablet_id(_secondary->tablet_id());
+        CHECK(rowset_meta.serialize(request.mutable_rowset_meta()));
+        request.set_host("127.0.0.1");
+        request.set_http_port(_server->get_real_port());
+        request.set_rowset_path(rowset.rowset_path());
+        return request;
+    }
+
+    size_t num_files(const TabletSharedPtr& tablet) const {
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(tablet->tablet_path())) {
+            count += entry.is_regular_file();
+        }
+        return count;
+    }
+
+    size_t num_rowset_ids_in_use() const {
+        auto* generator = static_cast<UniqueRowsetIdGenerator*>(StorageEngine::instance()->_rowset_id_generator.get());
+        std::lock_guard<SpinLock> l(generator->_lock);
+        return generator->_valid_rowset_id_hi.size();
+    }
+
+protected:
+    ExecEnv* _exec_env = nullptr;
+    ObjectPool _pool;
+    std::unique_ptr<MemTracker> _mem_tracker;
+    std::unique_ptr<DownloadAction> _download_action;
+    std::unique_ptr<EvHttpServer> _server;
+    TabletSharedPtr _primary;
+    TabletSharedPtr _secondary;
+    TupleDescriptor* _tuple_desc = nullptr;
+    PUniqueId _load_id;
+    // every test loads its own transaction, as the committed ones are kept by the txn manager
+    int64_t _txn_id = 0;
+};
+
+TEST_F(SegmentReplicatorTest, add_segments) {
+    _txn_id = 200;
+    const size_t num_rows = 1000;
+    RowsetSharedPtr primary_rowset = load_primary(num_rows);
+    ASSERT_TRUE(primary_rowset != nullptr);
+    ASSERT_EQ(1, primary_rowset->num_segments());
+
+    size_t rowset_ids = num_rowset_ids_in_use();
+    auto st = SegmentReplicator::add_segments(make_request(*primary_rowset));
+    ASSERT_TRUE(st.ok()) << st.to_string();
+
+    // the segments are committed under a new rowset id of the secondary replica
+    RowsetSharedPtr rowset = committed_rowset(_secondary);
+    ASSERT_TRUE(rowset != nullptr);
+    ASSERT_NE(primary_rowset->rowset_id().to_string(), rowset->rowset_id().to_string());
+    ASSERT_EQ(rowset_ids + 1, num_rowset_ids_in_use());
+    ASSERT_TRUE(StorageEngine::instance()->rowset_id_in_use(rowset->rowset_id()));
+    ASSERT_EQ(num_rows, rowset->num_rows());
+    ASSERT_EQ(1, rowset->num_segments());
+    ASSERT_EQ(1, num_files(_secondary));
+    ASSERT_EQ(std::filesystem::file_size(BetaRowset::segment_file_path(primary_rowset->rowset_path(),
+                                                                       primary_rowset->rowset_id(), 0)),
+              std::filesystem::file_size(BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), 0)));
+
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(_secondary->tablet_schema());
+    OlapReaderStatistics stats;
+    RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto iter = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(iter.ok()) << iter.status().to_string();
+    auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    int64_t expected = 0;
+    while (true) {
+        chunk->reset();
+        Status st = (*iter)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected, chunk->get_column_by_index(0)->get(i).get_int64());
+            ASSERT_EQ(expected * 3, chunk->get_column_by_index(1)->get(i).get_int32());
+            expected++;
+        }
+    }
+    (*iter)->close();
+    ASSERT_EQ(num_rows, expected);
+}
+
+TEST_F(SegmentReplicatorTest, download_failed) {
+    _txn_id = 201;
+    RowsetSharedPtr primary_rowset = load_primary(100);
+    ASSERT_TRUE(primary_rowset != nullptr);
+
+    // nothing listens on the port of the primary replica
+    auto request = make_request(*primary_rowset);
+    request.set_http_port(1);
+    size_t rowset_ids = num_rowset_ids_in_use();
+    ASSERT_FALSE(SegmentReplicator::add_segments(request).ok());
+
+    // the transaction is rolled back, and neither the files nor the rowset id are left behind
+    ASSERT_TRUE(committed_rowset(_secondary) == nullptr);
+    ASSERT_EQ(0, num_files(_secondary));
+    ASSERT_EQ(rowset_ids, num_rowset_ids_in_use());
+
+    // the secondary replica can add the segments again
+    ASSERT_TRUE(SegmentReplicator::add_segments(make_request(*primary_rowset)).ok());
+    ASSERT_TRUE(committed_rowset(_secondary) != nullptr);
+}
+
+} // namespace starrocks::vectorized
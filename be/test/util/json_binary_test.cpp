@@ -0,0 +1,112 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/json_binary.h"
+
+#include <gtest/gtest.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(JsonBinaryTest, test_round_trip) {
+    std::string json = R"({"b":[1,-2,3.5,"x",null,true,false],"a":{"c":"d"},"e":9223372036854775807})";
+    std::string encoded;
+    ASSERT_TRUE(JsonBinary::encode(Slice(json), &encoded));
+    ASSERT_TRUE(JsonBinary::is_encoded(Slice(encoded)));
+    ASSERT_FALSE(JsonBinary::is_encoded(Slice(json)));
+
+    // Members are kept in the order of the document.
+    std::string text;
+    JsonBinary::to_json_string(Slice(encoded), &text);
+    ASSERT_EQ(json, text);
+}
+
+// The text of an encoded document is the text the json functions print for the document itself.
+// NOLINTNEXTLINE
+TEST(JsonBinaryTest, test_same_text_as_rapidjson) {
+    std::string json = R"({"z":1,"a":{"y":[],"x":{}},"m":"n","a":2,"":[{"q":null,"p":0.5}]})";
+    rapidjson::Document document;
+    document.Parse(json.data(), json.size());
+    ASSERT_FALSE(document.HasParseError());
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    document.Accept(writer);
+
+    std::string encoded;
+    JsonBinary::encode(document, &encoded);
+    std::string text;
+    JsonBinary::to_json_string(Slice(encoded), &text);
+    ASSERT_EQ(std::string(buffer.GetString(), buffer.GetSize()), text);
+    ASSERT_EQ(json, text);
+}
+
+// NOLINTNEXTLINE
+TEST(JsonBinaryTest, test_lookup) {
+    std::string json = R"({"k3":{"n":[10,{"x":"y"}]},"k1":1,"k2":"v2","k1":2})";
+    std::string encoded;
+    ASSERT_TRUE(JsonBinary::encode(Slice(json), &encoded));
+    JsonBinaryValue root = JsonBinaryValue::root(Slice(encoded));
+    ASSERT_EQ(JsonBinary::OBJECT, root.type());
+    ASSERT_EQ(4, root.size());
+
+    JsonBinaryValue value;
+    // The first of duplicated keys wins.
+    ASSERT_TRUE(root.member(Slice("k1"), &value));
+    ASSERT_EQ(JsonBinary::INT64, value.type());
+    ASSERT_EQ(1, value.get_int64());
+    ASSERT_TRUE(root.member(Slice("k2"), &value));
+    ASSERT_EQ("v2", value.get_string().to_string());
+    ASSERT_FALSE(root.member(Slice("k0"), &value));
+    ASSERT_FALSE(root.member(Slice("k4"), &value));
+
+    Slice key;
+    ASSERT_TRUE(root.member_at(3, &key, &value));
+    ASSERT_EQ("k1", key.to_string());
+    ASSERT_EQ(2, value.get_int64());
+
+    JsonBinaryValue nested;
+    ASSERT_TRUE(root.member(Slice("k3"), &value));
+    ASSERT_TRUE(value.member(Slice("n"), &nested));
+    ASSERT_EQ(JsonBinary::ARRAY, nested.type());
+    ASSERT_EQ(2, nested.size());
+    ASSERT_TRUE(nested.element(1, &value));
+    ASSERT_TRUE(value.member(Slice("x"), &value));
+    ASSERT_EQ("y", value.get_string().to_string());
+    ASSERT_FALSE(nested.element(2, &value));
+}
+
+// NOLINTNEXTLINE
+TEST(JsonBinaryTest, test_invalid) {
+    std::string encoded;
+    ASSERT_FALSE(JsonBinary::encode(Slice("{\"a\":"), &encoded));
+
+    std::string json = R"({"a":[1,2,3],"b":"c"})";
+    ASSERT_TRUE(JsonBinary::encode(Slice(json), &encoded));
+    // Truncated documents never read out of bounds.
+    for (size_t size = 0; size < encoded.size(); size++) {
+        std::string truncated = encoded.substr(0, size);
+        JsonBinaryValue root = JsonBinaryValue::root(Slice(truncated));
+        JsonBinaryValue value;
+        ASSERT_NE(JsonBinary::OBJECT, root.type());
+        ASSERT_FALSE(root.member(Slice("b"), &value));
+        std::string text;
+        JsonBinary::to_json_string(Slice(truncated), &text);
+        ASSERT_EQ("null", text);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(JsonBinaryTest, test_max_depth) {
+    const size_t depth = 1100;
+    std::string json = std::string(depth, '[') + std::string(depth, ']');
+    std::string encoded;
+    ASSERT_TRUE(JsonBinary::encode(Slice(json), &encoded));
+
+    // The values nested below the decoded depth are null.
+    std::string text;
+    JsonBinary::to_json_string(Slice(encoded), &text);
+    ASSERT_EQ(std::string(1025, '[') + "null" + std::string(1025, ']'), text);
+}
+
+} // namespace starrocks
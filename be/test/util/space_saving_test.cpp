@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/space_saving.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(SpaceSavingTest, exact_when_under_capacity) {
+    SpaceSaving<uint32_t> sketch(8);
+    for (uint32_t i = 0; i < 4; i++) {
+        sketch.add(i, i + 1);
+    }
+    ASSERT_EQ(10, sketch.total());
+    auto top = sketch.top(3);
+    ASSERT_EQ(2, top.size());
+    ASSERT_EQ(3, top[0].item);
+    ASSERT_EQ(4, top[0].count);
+    ASSERT_EQ(0, top[0].error);
+    ASSERT_EQ(2, top[1].item);
+}
+
+// NOLINTNEXTLINE
+TEST(SpaceSavingTest, heavy_hitters) {
+    SpaceSaving<uint32_t> sketch(16);
+    // Key 7 takes 30% and key 42 takes 10% of a stream of 10000 rows, all other keys are unique.
+    uint32_t next = 1000;
+    for (uint32_t i = 0; i < 10000; i++) {
+        if (i % 10 < 3) {
+            sketch.add(7);
+        } else if (i % 10 == 3) {
+            sketch.add(42);
+        } else {
+            sketch.add(next++);
+        }
+    }
+    ASSERT_EQ(10000, sketch.total());
+    auto top = sketch.top(10000 / 16 + 1);
+    ASSERT_GE(top.size(), 2);
+    ASSERT_EQ(7, top[0].item);
+    ASSERT_EQ(42, top[1].item);
+    ASSERT_LE(top[0].count - top[0].error, 3000);
+    ASSERT_GE(top[0].count, 3000);
+    ASSERT_GE(top[1].count, 1000);
+
+    sketch.clear();
+    ASSERT_EQ(0, sketch.total());
+    ASSERT_TRUE(sketch.top(0).empty());
+}
+
+} // namespace starrocks
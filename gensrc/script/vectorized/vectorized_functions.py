@@ -463,6 +463,8 @@ vectorized_functions = [
      "JsonFunctions::json_path_prepare", "JsonFunctions::json_path_close"],
     [110002, "get_json_string", "VARCHAR", ["VARCHAR", "VARCHAR"], "JsonFunctions::get_json_string",
      "JsonFunctions::json_path_prepare", "JsonFunctions::json_path_close"],
+    [110003, "parse_json", "VARCHAR", ["VARCHAR"], "JsonFunctions::parse_json"],
+    [110004, "json_string", "VARCHAR", ["VARCHAR"], "JsonFunctions::json_string"],
 
     # aes and base64 function
     [120100, "aes_encrypt", "VARCHAR", ["VARCHAR", "VARCHAR"], "EncryptionFunctions::aes_encrypt"],